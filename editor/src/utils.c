@@ -19,9 +19,9 @@
 #include "editor.h"
 #include "tile.h"
 #include "utils.h"
+#include "world.h"
 #include "world_editor.h"
-
-static int string_width( dString_t* string, int start );
+#include "map_parse.h"
 
 void e_GetOrigin( World_t* world, int* originx, int* originy )
 {
@@ -247,194 +247,124 @@ void e_LoadColorPalette( aColor_t palette[MAX_COLOR_GROUPS][MAX_COLOR_PALETTE],
   fclose( file );
 }
 
-static int string_width( dString_t* string, int start )
+/* ---- .map loading, through the game's shared parser ---- */
+
+static void ed_InitCell( World_t* w, int index )
 {
-  int width_count = 0;
-  const char* raw_str = d_StringPeek(string);
-  for ( size_t i = start; i < string->len; i++ )
-  {
-    if ( raw_str[i] == ' ' )
-    {
-      break;
-    }
+  w->background[index].solid       = 0;
+  w->background[index].tile        = 0;
+  w->background[index].glyph_index = TILE_EMPTY;
+  w->background[index].glyph       = ".";
+  w->background[index].glyph_fg    = (aColor_t){ 0x39, 0x4a, 0x50, 255 };
+  w->background[index].glyph_bg    = (aColor_t){ 0x09, 0x0a, 0x14, 255 };
+
+  w->midground[index].solid       = 0;
+  w->midground[index].tile        = TILE_EMPTY;
+  w->midground[index].glyph_index = TILE_EMPTY;
+  w->midground[index].glyph       = "";
+  w->midground[index].glyph_fg    = (aColor_t){ 0xc7, 0xcf, 0xcc, 255 };
+  w->midground[index].glyph_bg    = (aColor_t){ 0, 0, 0, 0 };
+
+  w->foreground[index].solid       = 0;
+  w->foreground[index].tile        = TILE_EMPTY;
+  w->foreground[index].glyph_index = TILE_EMPTY;
+  w->foreground[index].glyph       = "";
+  w->foreground[index].glyph_fg    = (aColor_t){ 0xc7, 0xcf, 0xcc, 255 };
+  w->foreground[index].glyph_bg    = (aColor_t){ 0, 0, 0, 0 };
+
+  w->room_ids[index] = TILE_EMPTY;
+}
 
-    width_count++;
-  }
+static int ed_MapSize( int width, int height, void* user )
+{
+  World_t* w = user;
+
+  w->width      = width;
+  w->height     = height;
+  w->tile_count = width * height;
+
+  w->background = malloc( sizeof(Tile_t) * w->tile_count );
+  w->midground  = malloc( sizeof(Tile_t) * w->tile_count );
+  w->foreground = malloc( sizeof(Tile_t) * w->tile_count );
+  w->room_ids   = malloc( sizeof(uint16_t) * w->tile_count );
+  if ( !w->background || !w->midground || !w->foreground || !w->room_ids )
+    return 0;
 
-  return width_count;
+  for ( int i = 0; i < w->tile_count; i++ )
+    ed_InitCell( w, i );
+  return 1;
 }
 
-World_t* convert_mats_worlds( const char* filename )
+static void ed_MapWall( int x, int y, void* user )
 {
-  int file_size = 0;
-  int newline_count = 0;
-  char* file_string;
-  char** lines;
-  
-  int world_width  = 0;
-  int world_height = 0;
-  
-  dArray_t* door_positions = d_ArrayInit( 10, sizeof( dVec2_t ) );
+  World_t* w = user;
+  int index = y * w->width + x;
 
-  World_t* new_world = malloc( sizeof( World_t ) );
-  if ( new_world == NULL ) return NULL;
+  w->background[index].tile        = GlyphTileConverter( TILE_GLYPH_WALL, 0 );
+  w->background[index].glyph_index = TILE_GLYPH_WALL-1;
+}
 
-  file_string = a_ReadFile( filename, &file_size );
-  
-  newline_count = a_CountNewLines( file_string, file_size );
+static void ed_MapFloor( int x, int y, int room_id, void* user )
+{
+  World_t* w = user;
+  int index = y * w->width + x;
 
-  lines = a_ParseLinesInFile( file_string, file_size, newline_count );
-   
-  char* string = lines[0];
-  if ( string != NULL )
-  {
-    if ( string[0] == '/' && string[1] == '/' )
-    {
-      dString_t* line   = d_StringInit();
-      dString_t* width  = d_StringInit();
-      dString_t* height = d_StringInit();
-      d_StringSet( line, string );
-      int num_start = 3;
-      int first_num_w  = string_width( line, num_start );
-      first_num_w += num_start;
-      int second_num_w = string_width( line, first_num_w+1 );
-      second_num_w += first_num_w+1;
-
-      d_StringSlice( width,  d_StringPeek( line ), 3, num_start+first_num_w );
-      d_StringSlice( height, d_StringPeek( line ), first_num_w+1, second_num_w );
-      world_width  = atoi( d_StringPeek( width ) );
-      world_height = atoi( d_StringPeek( height ) );
-      d_StringDestroy( line );
-      d_StringDestroy( width );
-      d_StringDestroy( height );
-    }
+  w->background[index].tile        = TILE_LVL1_FLOOR;
+  w->background[index].glyph_index = TILE_GLYPH_FLOOR-1;
+  if ( room_id != MAP_ROOM_NONE )
+    w->room_ids[index] = MapRoomIdToChar( room_id )-1;
+}
 
-    new_world->width  = world_width;
-    new_world->height = world_height;
+static void ed_MapDoor( int x, int y, char glyph, int vertical, void* user )
+{
+  World_t* w = user;
+  int index = y * w->width + x;
 
-    new_world->tile_w = 16;
-    new_world->tile_h = 16;
+  w->background[index].tile        = TILE_LVL1_FLOOR;
+  w->background[index].glyph_index = glyph-1;
+  w->midground[index].tile         = GlyphTileConverter( glyph, !vertical );
+  w->midground[index].glyph_index  = glyph-1;
+}
 
-    new_world->tile_count = world_width * world_height;
-    new_world->filename = malloc( sizeof(char) * MAX_FILENAME_LENGTH );
-    if (new_world->filename == NULL ) return NULL;
-    STRNCPY(new_world->filename, filename, MAX_FILENAME_LENGTH);
+/* Interactive tiles round-trip through room_ids as their raw glyph */
+static void ed_MapITile( int x, int y, char glyph, void* user )
+{
+  World_t* w = user;
+  int index = y * w->width + x;
 
-    new_world->background = malloc( sizeof(Tile_t) * new_world->tile_count );
-    if ( new_world->background == NULL ) return NULL;
-    memset( new_world->background, 0, sizeof(Tile_t) * new_world->tile_count );
-    
-    new_world->midground = malloc( sizeof(Tile_t) * new_world->tile_count );
-    if ( new_world->midground == NULL ) return NULL;
-    memset( new_world->midground, 0, sizeof(Tile_t) * new_world->tile_count );
-    
-    new_world->foreground = malloc( sizeof(Tile_t) *  new_world->tile_count );
-    if ( new_world->foreground == NULL ) return NULL;
-    memset( new_world->foreground, 0, sizeof(Tile_t) * new_world->tile_count );
-    
-    new_world->room_ids = malloc( sizeof(uint16_t) * new_world->tile_count );
-    if ( new_world->room_ids == NULL ) return NULL;
-    memset( new_world->room_ids, 0, sizeof(uint16_t) * new_world->tile_count );
-    
-    int line_pos = 1;
-    for ( int j = 0; j < world_height; j++ )
-    {
-      for ( int i = 0; i < world_width; i++ )
-      {
-        char* current_line = lines[line_pos];
-        int tile = current_line[i];
-        int index = j * world_width + i;
-        
-        new_world->background[index].solid       = 0;
-        new_world->background[index].tile        = 0;
-        new_world->background[index].glyph_index = TILE_EMPTY;
-        new_world->background[index].glyph       = ".";
-        new_world->background[index].glyph_fg    = (aColor_t){ 0x39, 0x4a, 0x50, 255 };
-        new_world->background[index].glyph_bg    = (aColor_t){ 0x09, 0x0a, 0x14, 255 };
-
-        new_world->midground[index].solid       = 0;
-        new_world->midground[index].tile = TILE_EMPTY;
-        new_world->midground[index].glyph_index = TILE_EMPTY;
-        new_world->midground[index].glyph       = "";
-        new_world->midground[index].glyph_fg    = (aColor_t){ 0xc7, 0xcf, 0xcc, 255 };
-        new_world->midground[index].glyph_bg    = (aColor_t){ 0, 0, 0, 0 };
-
-        new_world->foreground[index].solid       = 0;
-        new_world->foreground[index].tile = TILE_EMPTY;
-        new_world->foreground[index].glyph_index = TILE_EMPTY;
-        new_world->foreground[index].glyph       = "";
-        new_world->foreground[index].glyph_fg    = (aColor_t){ 0xc7, 0xcf, 0xcc, 255 };
-        new_world->foreground[index].glyph_bg    = (aColor_t){ 0, 0, 0, 0 };
-        
-        new_world->room_ids[index] = TILE_EMPTY;
-
-        if ( tile == TILE_GLYPH_WALL || tile == TILE_GLYPH_FLOOR )
-        {
-          new_world->background[index].tile = GlyphTileConverter( tile, 0 );
-          new_world->background[index].glyph_index = tile-1;
-        }
-
-        else if ( tile == TILE_GLYPH_RED_DOOR ||
-                  tile == TILE_GLYPH_GREEN_DOOR ||
-                  tile == TILE_GLYPH_BLUE_DOOR ||
-                  tile == TILE_GLYPH_WHITE_DOOR )
-        {
-          new_world->background[index].tile        = TILE_LVL1_FLOOR;
-          new_world->background[index].glyph_index = tile-1;
-          new_world->midground[index].tile = GlyphTileConverter( tile, 0 );
-          new_world->midground[index].glyph_index = tile;
-          dVec2_t pos = { .x = i, .y = j };
-          d_ArrayAppend( door_positions, &pos );
-        }
-
-        else
-        {
-          new_world->background[index].tile = TILE_LVL1_FLOOR;
-          new_world->background[index].glyph_index = TILE_GLYPH_FLOOR-1;
-          new_world->midground[index].tile = TILE_EMPTY;
-          new_world->midground[index].glyph_index = TILE_EMPTY;
-          new_world->room_ids[index] = tile-1;
-        }
-      }
+  w->background[index].tile        = TILE_LVL1_FLOOR;
+  w->background[index].glyph_index = TILE_GLYPH_FLOOR-1;
+  w->room_ids[index]               = glyph-1;
+}
 
-      line_pos++;
-    }
+World_t* convert_mats_worlds( const char* filename )
+{
+  static const MapParseFns_t fns = {
+    ed_MapSize, ed_MapWall, ed_MapFloor, ed_MapDoor, ed_MapITile
+  };
+
+  World_t* new_world = calloc( 1, sizeof( World_t ) );
+  if ( new_world == NULL ) return NULL;
+
+  new_world->tile_w = 16;
+  new_world->tile_h = 16;
+
+  MapParseError_t err;
+  if ( !MapParseFile( filename, &fns, new_world, &err ) )
+  {
+    printf( "EDITOR: %s:%d:%d: %s\n", filename, err.line, err.column, err.message );
+    WorldDestroy( new_world );
+    return NULL;
   }
 
-  for ( size_t i = 0; i < door_positions->count; i++ )
+  new_world->filename = malloc( sizeof(char) * MAX_FILENAME_LENGTH );
+  if ( new_world->filename == NULL )
   {
-    dVec2_t* pos = d_ArrayGet( door_positions, i );
-    int door_index = pos->y * world_width + pos->x;
-    int tile_index = new_world->midground[door_index].glyph_index;
-    
-    dVec2_t n = { .x = pos->x ,    .y = pos->y + 1 };
-    dVec2_t e = { .x = pos->x + 1, .y = pos->y };
-    dVec2_t s = { .x = pos->x,     .y = pos->y - 1 };
-    dVec2_t w = { .x = pos->x - 1, .y = pos->y };
-    
-    int index_n = n.y * world_width + n.x;
-    int index_e = e.y * world_width + e.x;
-    int index_s = s.y * world_width + s.x;
-    int index_w = w.y * world_width + w.x;
-    
-    if ( new_world->background[index_n].tile == TILE_LVL1_WALL &&
-         new_world->background[index_s].tile == TILE_LVL1_WALL )
-    {
-      new_world->midground[door_index].tile = GlyphTileConverter( tile_index, 0 );
-    }
-    
-    else if ( new_world->background[index_e].tile == TILE_LVL1_WALL &&
-              new_world->background[index_w].tile == TILE_LVL1_WALL )
-    {
-      new_world->midground[door_index].tile = GlyphTileConverter( tile_index, 1 );
-    }
-    
-    new_world->midground[door_index].glyph_index = tile_index-1;
+    WorldDestroy( new_world );
+    return NULL;
   }
+  STRNCPY(new_world->filename, filename, MAX_FILENAME_LENGTH);
 
-  d_ArrayDestroy( door_positions );
-  free( lines );
-  free( file_string );
   e_GetOrigin( new_world, &new_world->originx, &new_world->originy );
   return new_world;
 }
@@ -0,0 +1,39 @@
+#ifndef __ASSET_LOADER_H__
+#define __ASSET_LOADER_H__
+
+#include <Archimedes.h>
+
+#define ASSET_MAX_JOBS         512
+#define ASSET_WORKERS          2      /* decode threads, native builds only */
+#define ASSET_FRAME_BUDGET_MS  8      /* main-thread time per pumped frame */
+#define ASSET_PATH_LEN         128
+
+/* Runs on the main thread once path is decoded. surface is NULL if the
+   decode failed; ownership passes to the callback either way. */
+typedef void ( *AssetImageDoneFn_t )( const char* path, SDL_Surface* surface,
+                                      void* user );
+
+/* Main-thread step, for loaders that need the renderer or the mixer */
+typedef void ( *AssetCallFn_t )( void* user );
+
+void AssetLoaderInit( void );
+void AssetLoaderQuit( void );
+
+/* Decode a PNG off the main thread (inline, a slice per frame, on
+   Emscripten), then hand the surface to done. */
+void AssetQueueImage( const char* path, AssetImageDoneFn_t done, void* user );
+
+/* Run fn on the main thread as part of the current batch. */
+void AssetQueueCall( AssetCallFn_t fn, void* user );
+
+/* Run completions in queue order for up to budget_ms.
+   Returns 1 while the batch still has work left. */
+int AssetLoaderPump( int budget_ms );
+
+/* Block until the current batch is drained. */
+void AssetLoaderFinish( void );
+
+int   AssetLoaderBusy( void );
+float AssetLoaderProgress( void );   /* 0..1 across the current batch */
+
+#endif
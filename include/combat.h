@@ -8,6 +8,7 @@
 #include "world.h"
 
 void CombatInit( Console_t* con );
+void CombatReleaseSounds( void );
 void CombatSetEnemies( Enemy_t* list, int* count );
 void CombatSetGroundItems( GroundItem_t* list, int* count );
 void CombatUpdate( float dt );
@@ -6,17 +6,33 @@
 
 #define CONSOLE_MAX_LINES   64
 #define CONSOLE_VISIBLE      8
+#define CONSOLE_LINE_LEN   512
 
 typedef struct
 {
-  dString_t* text;
+  char text[CONSOLE_LINE_LEN];
   aColor_t color;
+  aImage_t baked;                       /* text rendered once, on push */
 } ConsoleLine_t;
 
+/* Fixed-capacity ring of lines: once full the oldest slot is overwritten
+   in place. Each line is rendered to a texture when it is pushed (and
+   that texture freed when its slot is overwritten), so drawing is a blit
+   per visible line rather than a glyph run. */
 typedef struct
 {
-  dArray_t* lines;
+  ConsoleLine_t lines[CONSOLE_MAX_LINES];
+  int head;                             /* slot of the oldest line */
+  int count;
   int scroll_offset;
+
+  /* Retained draw state - rebuilt only on push/scroll/clear/resize */
+  int      dirty;
+  aRectf_t cached_rect;
+  int      num_visible;
+  int      visible[CONSOLE_VISIBLE];    /* slots, newest first */
+  float    line_y[CONSOLE_VISIBLE];
+  float    thumb_y, thumb_h;
 } Console_t;
 
 void ConsoleInit( Console_t* c );
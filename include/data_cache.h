@@ -0,0 +1,44 @@
+#ifndef __DATA_CACHE_H__
+#define __DATA_CACHE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DATA_CACHE_DIR          "resources/cache"
+#define DATA_CACHE_VERSION      2     /* bump when the blob layout changes */
+#define DATA_CACHE_MAX_SOURCES  32
+#define DATA_CACHE_PATH_LEN     128
+
+/* One flat table of already-resolved structs (g_consumables, ...).
+   Pointer fields are stored as garbage - callers re-resolve them. */
+typedef struct
+{
+  void*    data;
+  size_t   elem_size;
+  int      max;        /* capacity of data, in elements */
+  int*     count;      /* elements to save / elements loaded */
+  uint32_t layout;     /* DataCacheLayout of the element, 0 = size only */
+} DataCacheTable_t;
+
+/* Hash of the facts a table's bytes depend on - sizeof / offsetof of
+   its fields and the counts of any enums stored in it - so a blob from
+   a build where a field moved, or an enum grew, misses even when the
+   element size came out the same */
+uint32_t DataCacheLayout( const size_t* facts, int num_facts );
+
+/* Fill tables from resources/cache/<name>.bin. Returns 0 (and leaves the
+   tables untouched) if the blob is missing, from another version, has a
+   different struct layout, or any source DUF - or the mounted resource
+   pack - changed since it was written. */
+int DataCacheLoad( const char* name,
+                   const char* const* sources, int num_sources,
+                   DataCacheTable_t* tables, int num_tables );
+
+/* Write tables to resources/cache/<name>.bin, stamped with the sources'
+   (and the mounted pack's) current mtimes and sizes. Returns 1 on
+   success. */
+int DataCacheSave( const char* name,
+                   const char* const* sources, int num_sources,
+                   const DataCacheTable_t* tables, int num_tables );
+
+#endif
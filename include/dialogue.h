@@ -87,6 +87,14 @@ void FlagSet( const char* name, int value );
 void FlagIncr( const char* name );
 void FlagClear( const char* name );
 void FlagsInit( void );
+int  FlagsVersion( void );  /* changes whenever any flag changes */
+
+/* The same by id - intern a name once at load and skip the lookup on
+   every use. -1 (table full) is ignored everywhere. */
+int  FlagIntern( const char* name );
+int  FlagGetId( int id );
+void FlagSetId( int id, int value );
+void FlagIncrId( int id );
 
 /* Init / destroy helpers */
 void DialogueEntryInit( DialogueEntry_t* de );
@@ -97,6 +105,7 @@ void DialogueDestroyAll( void );
 
 /* Loading */
 void DialogueLoadAll( void );
+void DialogueReloadFile( const char* path );
 int  NPCTypeByKey( const char* key );
 
 /* Runtime */
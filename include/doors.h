@@ -4,22 +4,18 @@
 #include "world.h"
 #include "console.h"
 
-/* Horizontal doors (walls left/right, passage up/down) */
-#define DOOR_BLUE    2   /* Mage */
-#define DOOR_GREEN   3   /* Rogue */
-#define DOOR_RED     4   /* Mercenary */
-#define DOOR_WHITE   5   /* Anyone */
-
-/* Vertical doors (walls above/below, passage left/right) */
-#define DOOR_BLUE_V   11
-#define DOOR_GREEN_V  12
-#define DOOR_RED_V    13
-#define DOOR_WHITE_V  14
+/* Door types for DoorPlace - the tile type is picked from these plus
+   the orientation (TILE_DOOR_* in tile_defs.h) */
+#define DOOR_BLUE    0   /* Mage */
+#define DOOR_GREEN   1   /* Rogue */
+#define DOOR_RED     2   /* Mercenary */
+#define DOOR_WHITE   3   /* Anyone */
 
 void  DoorsInit( Console_t* con );
+void  DoorsReleaseSounds( void );
 void  DoorPlace( World_t* w, int x, int y, int type, int vertical );
-int   DoorIsDoor( uint32_t tile );
-int   DoorCanOpen( uint32_t tile );
+int   DoorIsDoor( Tile_t tile );
+int   DoorCanOpen( Tile_t tile );
 int   DoorTryOpen( World_t* w, int x, int y );
 void  DoorDescribe( World_t* w, int x, int y );
 
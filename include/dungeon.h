@@ -7,19 +7,17 @@
 #include "npc.h"
 #include "ground_items.h"
 
-#define DUNGEON_W 100
-#define DUNGEON_H 75
-
 extern int g_current_floor;
 
-/* Map format */
-int  DungeonCharToRoomId( char c );
-char DungeonRoomIdToChar( int id );
+/* Map format - parsing lives in map_parse.h */
 int  DungeonSaveMap( const char* path, const char** rows, int width, int height );
 
-/* Builder */
-void DungeonBuild( World_t* world );
-void DungeonPlayerStart( float* wx, float* wy );
+/* Builder - the world is sized to the floor's .map header */
+const char* DungeonMapPath( void );
+const char* DungeonRoomsPath( void );
+World_t* DungeonBuild( int tile_w, int tile_h );
+int      DungeonReloadMap( World_t* world, const char* path );
+void     DungeonPlayerStart( World_t* world, float* wx, float* wy );
 
 /* Spawner */
 void DungeonSpawn( NPC_t* npcs, int* num_npcs,
@@ -3,8 +3,25 @@
 
 #include <Archimedes.h>
 
-#define MAX_ENEMY_TYPES  32
-#define MAX_ENEMIES      64
+#include "pathfinding.h"
+#include "room_graph.h"
+#include "slot_pool.h"
+
+#define MAX_ENEMY_TYPES  32          /* owns_mask is one bit per type */
+#ifndef MAX_ENEMIES
+#define MAX_ENEMIES      64          /* slots are int16 - keep under 32768 */
+#endif
+#define MAX_ENEMY_OWNS   4
+
+/* Chase paths - see EnemyPathStep */
+#define ENEMY_PATH_CACHE   24    /* steps kept per enemy */
+#define ENEMY_PATH_BUDGET  256   /* tiles one replan may expand */
+#define ENEMY_PATH_SLACK   6     /* search radius past sight_range */
+#define ENEMY_PATH_DETOUR  4     /* extra steps a patched path may carry */
+
+/* AI level of detail - see EnemiesStartTurn */
+#define ENEMY_WAKE_HOPS    2     /* zones from the player that stay awake */
+#define ENEMY_WAKE_PERIOD  8     /* a sleeper still gets a turn this often */
 
 typedef struct
 {
@@ -18,16 +35,44 @@ typedef struct
   char     description[256];
   int      range;
   int      sight_range;                 /* aggro range (Manhattan), default 6 */
+  int      speed;                       /* energy per turn, see turn_scheduler.h */
   char     drop_item[MAX_NAME_LENGTH];  /* DUF key of consumable to drop on death */
   int      gold_drop;                  /* gold dropped on death (0 = none) */
   char     death_flag[MAX_NAME_LENGTH]; /* flag to set when this enemy dies */
   char     on_death[MAX_NAME_LENGTH];  /* death hazard, e.g. "poison_pool" */
   int      pool_duration;
   int      pool_damage;
+  char     death_npc[MAX_NAME_LENGTH]; /* NPC key to leave beside the body */
+  char     owns[MAX_ENEMY_OWNS][MAX_NAME_LENGTH]; /* types that die with it */
+  char     link_verb[MAX_NAME_LENGTH]; /* "The <name> <verb>!" dying with its owner */
+  aColor_t link_color;
   aColor_t color;
+  char     image_path[128];            /* re-resolved after a cache load */
   aImage_t* image;
+
+  /* Filled in from the above once every type is loaded */
+  int      death_effect;               /* ENEMY_DEATH_* */
+  uint32_t owns_mask;                  /* bit per type index */
+  uint32_t owned_by_mask;
+  char     link_text[MAX_NAME_LENGTH]; /* floating "<Verb>!" */
+  int      kill_flag;                  /* "<key>_kills" */
+  int      death_flag_id;
+  int      immobile;                   /* static / stone AIs never step aside */
 } EnemyType_t;
 
+#define ENEMY_DEATH_NONE         0
+#define ENEMY_DEATH_POISON_POOL  1
+
+/* A chase path kept between turns. node[step] is where the enemy
+   should be standing; the last node is the goal it was planned for. */
+typedef struct
+{
+  PathNode_t node[ENEMY_PATH_CACHE];
+  int        len;                      /* 0 = nothing cached */
+  int        step;
+  uint32_t   move_rev;                 /* world->move_rev when planned */
+} EnemyPath_t;
+
 typedef struct Enemy_t
 {
   int   type_idx;
@@ -50,25 +95,88 @@ typedef struct Enemy_t
   int   burn_dmg;
   int   stun_turns;
   int   root_turns;
+  EnemyPath_t path;
+  int   dormant;                       /* far from the player, not ticking */
+  int   dormant_since;                 /* first enemy turn it slept through */
+  int   energy;                        /* acts once per TURN_ENERGY_COST */
+  uint32_t rng;                        /* this turn's stream - EnemyRandom */
+  /* Linked deaths - handles, so a link to a slot that has since gone to
+     someone else reads as none. SLOT_HANDLE_NONE = none. */
+  SlotHandle_t owner;
+  SlotHandle_t first_child;
+  SlotHandle_t next_sibling;
 } Enemy_t;
 
 extern EnemyType_t g_enemy_types[MAX_ENEMY_TYPES];
 extern int         g_num_enemy_types;
 
 void     EnemiesLoadTypes( void );
+void     EnemiesReloadFile( const char* path );
 int      EnemyTypeByKey( const char* key );
+/* The list EnemiesInit is given is pooled: dead slots are reused once
+   EnemiesCollect has run, so spawns only fail with MAX_ENEMIES alive */
 void     EnemiesInit( Enemy_t* list, int* count );
+void     EnemiesCollect( Enemy_t* list, int* count );
+
+/* Slots alive at the last collect plus spawns since - may include the
+   freshly dead, so check alive */
+const int16_t* EnemiesLive( Enemy_t* list, int count, int* n );
+
+/* Survive slot reuse: FromHandle is NULL once the enemy is dead or its
+   slot went to someone else */
+SlotHandle_t EnemyHandle( Enemy_t* list, Enemy_t* e );
+Enemy_t*     EnemyFromHandle( Enemy_t* list, SlotHandle_t h );
+
+/* Walk what e owns, dead or alive: for ( c = EnemyFirstChild( list, e );
+   c; c = EnemyNextSibling( list, c ) ) */
+Enemy_t*     EnemyFirstChild( Enemy_t* list, Enemy_t* e );
+Enemy_t*     EnemyNextSibling( Enemy_t* list, Enemy_t* e );
+
+/* For enemies placed with the floor. Also links the newcomer to its
+   owner - the nearest live enemy whose type owns its type - and takes
+   in any live, unowned enemies of the types its own type owns */
 Enemy_t* EnemySpawn( Enemy_t* list, int* count,
                      int type_idx, int row, int col,
                      int tile_w, int tile_h );
+
+/* Spawned mid-fight by spawner (a totem, a baby): its owner is the
+   spawner, if the spawner's type owns it - never whoever stands
+   nearest */
+Enemy_t* EnemySpawnChild( Enemy_t* list, int* count, Enemy_t* spawner,
+                          int type_idx, int row, int col,
+                          int tile_w, int tile_h );
 Enemy_t* EnemyAt( Enemy_t* list, int count, int row, int col );
 Enemy_t* EnemyMobileAt( Enemy_t* list, int count, int row, int col );
+
+/* While EnemiesStartTurn decides a turn, EnemyAt / EnemyMobileAt on its
+   list answer from a tile grid instead of scanning - the A* blockers
+   ask once per tile they look at. Build files every live enemy; Track
+   names the enemy about to act, whose position is read live until the
+   next Track or Release re-files it. EnemySpawn files newcomers. Any
+   other move mid-turn must go through Track too. */
+void     EnemyOccupancyBuild( Enemy_t* list, int count );
+void     EnemyOccupancyTrack( Enemy_t* e );
+void     EnemyOccupancyRelease( void );
 int      EnemiesInCombat( Enemy_t* list, int count );
 
+/* Per-enemy random numbers. Each enemy's stream is reseeded every turn
+   from the turn and its slot, so what it rolls doesn't depend on who
+   acted before it or on which thread decided it. */
+uint32_t EnemyRandom( Enemy_t* e );
+
 void EnemyBasicAITick( Enemy_t* e, int player_row, int player_col,
                    int (*walkable)(int,int),
                    Enemy_t* all, int count );
 
+/* EnemyBasicAITick's decision, safe off the main thread: reads the
+   world, the occupancy grid and NPCs without changing them, and only
+   writes e - which may be a copy. scratch is the thread's own; NULL
+   uses the main thread's. */
+void EnemyBasicAIPlan( Enemy_t* e, int player_row, int player_col,
+                       int (*walkable)(int,int),
+                       Enemy_t* all, int count,
+                       RoomGraphScratch_t* scratch );
+
 void EnemySkeletonTick( Enemy_t* e, int player_row, int player_col,
                         int (*walkable)(int,int),
                         Enemy_t* all, int count );
@@ -77,7 +185,7 @@ void EnemyShamanTick( Enemy_t* e, int player_row, int player_col,
                       int (*walkable)(int,int),
                       Enemy_t* all, int count );
 
-/* enemies.c - enemy turn management (owns its own tween manager) */
+/* enemies.c - actor turn management (drives the shared turn timeline) */
 #include "world.h"
 
 void EnemiesSetWorld( World_t* w );
@@ -86,16 +194,26 @@ void EnemiesSetList( Enemy_t* list, int* count );
 int  EnemyBlockedByNPC( int row, int col );
 int  EnemyGridW( void );
 int  EnemyGridH( void );
+uint32_t EnemyMoveRev( void );
+
+/* enemy_path.c - next step toward a goal, reusing the enemy's cached
+   path while the goal only shuffles and the walls stay put. blocked is
+   the AI's A* blocker, scratch the search memory (NULL = the main
+   thread's). Returns 1 with the step, 0 if there is none. */
+int  EnemyPathStep( Enemy_t* e, int goal_r, int goal_c,
+                    int (*blocked)( int r, int c, void* ctx ), void* ctx,
+                    RoomGraphScratch_t* scratch,
+                    int* out_r, int* out_c );
 int  EnemyTileW( void );
 int  EnemyTileH( void );
 
 /* Shaman totem spawn helper (uses stored list/count) */
-int  EnemyShamanSpawnTotem( int row, int col, int (*walkable)(int,int),
+int  EnemyShamanSpawnTotem( Enemy_t* shaman, int (*walkable)(int,int),
                             Enemy_t* all, int count );
 
 /* Boss spawn: Greta fight (despawns NPC, spawns Greta enemy + elder horror) */
 void EnemyBossGretaSpawn( int npc_type_idx );
-void EnemyOnGretaDeath( int row, int col );
+void EnemySpawnDeathNPC( const char* npc_key, int row, int col );
 
 /* Humming Stone AI */
 void EnemyStoneHealerTick( Enemy_t* e, int player_row, int player_col,
@@ -112,16 +230,41 @@ int  EnemyStoneTargetCol( void );
 void EnemyHorrorTick( Enemy_t* e, int player_row, int player_col,
                       int (*walkable)(int,int),
                       Enemy_t* all, int count );
-int  EnemyHorrorSpawnBaby( int row, int col, int (*walkable)(int,int),
-                            Enemy_t* all, int count );
+int  EnemyHorrorSpawnBaby( Enemy_t* horror, int row, int col,
+                           int (*walkable)(int,int),
+                           Enemy_t* all, int count );
 void EnemiesUpdate( float dt );
 int  EnemiesTurning( void );
 
-/* Start an enemy turn: AI moves + attack. Call once per player action. */
+/* Start an enemy turn: AI moves + attack. Call once per player action.
+   Enemies and combat NPCs (EnemiesSetNPCs) act from one queue ordered
+   by energy, so a fast type can act twice before a slow one acts at
+   all. Every action is decided up front; then all moves play together
+   on the turn timeline, then all attacks, so a turn lasts the same
+   however many actors are fighting.
+   Chasers (basic and baby_horror AIs) plan their first move of the turn
+   in parallel on the worker pool, all from the turn's starting
+   positions. Plans are then applied in queue order; one whose enemy
+   was moved, or whose tile was taken by an earlier mover, is thrown
+   away and the move decided again on the spot. Build with
+   ENEMY_DECIDE_SERIAL to plan on the main thread only, and with
+   ENEMY_DECIDE_CHECK (on in STRESS builds) to plan both ways and stop
+   if they disagree.
+   Only enemies near the player think: within ENEMY_WAKE_HOPS zones of
+   the room graph, in aggro range, on a visible tile or still chasing.
+   The rest sleep, and whatever poison, burn, stun and root they slept
+   through is settled in one go when they wake (or every
+   ENEMY_WAKE_PERIOD turns). */
 void EnemiesStartTurn( Enemy_t* list, int count,
                        int player_row, int player_col,
                        int (*walkable)(int,int) );
 
+/* Settle a sleeper's missed turns now. Call before hitting an enemy
+   with a new status effect, so turns it slept through don't count
+   against it. Damage it took while asleep may leave hp at or below 0 -
+   the caller's own death check deals with that. */
+void EnemyWake( Enemy_t* e );
+
 /* rendering.c - draw all alive enemies */
 #include "game_viewport.h"
 
@@ -18,6 +18,7 @@ typedef enum
 } GameEventType_t;
 
 void GameEventsInit( Console_t* c );
+void GameEventsReleaseSounds( void );
 void GameEventsSetWorld( World_t* world, Enemy_t* enemies, int* enemy_count );
 void GameEventsNewTurn( void );
 int  GameEventsConsumableUsed( void );
@@ -25,6 +26,9 @@ Console_t* GameEventsGetConsole( void );
 void GameEvent( GameEventType_t type, int index );
 void GameEventSwap( int new_idx, int old_idx );
 
+/* Fill use/target handlers on g_consumables - called by ItemsLoadAll */
+void GameEventsBindConsumables( void );
+
 /* Try to use a consumable. Returns 1 on success, 0 on failure (wrong type). */
 int  GameEventUseConsumable( int consumable_index );
 
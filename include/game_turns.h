@@ -12,6 +12,7 @@ void  GameTurnsInit( Console_t* con, aSoundEffect_t* click,
                      NPC_t* npcs, int* num_npcs,
                      GroundItem_t* items, int* num_items,
                      World_t* world );
+void  GameTurnsReleaseSounds( void );
 
 void  GameTurnsUpdateSystems( float dt );
 void  GameTurnsHandleTurnEnd( float dt, int turn_skipped );
@@ -20,6 +21,9 @@ void  GameTurnsGetPlayerTile( int* r, int* c );
 float GameTurnsEnemyDelay( void );
 void  GameTurnsSetEnemyDelay( float d );
 
+/* The actor turn is pending or still playing - the player waits */
+int   GameTurnsBusy( void );
+
 /* Hint arrow state */
 float GameTurnsHintTimer( void );
 float GameTurnsSkipHintTimer( void );
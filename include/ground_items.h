@@ -5,7 +5,9 @@
 #include "world.h"
 #include "game_viewport.h"
 
+#ifndef MAX_GROUND_ITEMS
 #define MAX_GROUND_ITEMS 96
+#endif
 
 #define GROUND_CONSUMABLE 0
 #define GROUND_MAP        1
@@ -20,7 +22,9 @@ typedef struct
   int   alive;             /* 1 = on ground, 0 = picked up */
 } GroundItem_t;
 
+/* Picked-up slots are reused once GroundItemsCollect has run */
 void          GroundItemsInit( GroundItem_t* list, int* count );
+void          GroundItemsCollect( GroundItem_t* list, int* count );
 GroundItem_t* GroundItemSpawn( GroundItem_t* list, int* count,
                                int consumable_idx, int row, int col,
                                int tile_w, int tile_h );
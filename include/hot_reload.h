@@ -0,0 +1,27 @@
+#ifndef __HOT_RELOAD_H__
+#define __HOT_RELOAD_H__
+
+#include "console.h"
+
+#define HOT_RELOAD_MAX_WATCHES  32
+#define HOT_RELOAD_MAX_DIRS     16
+#define HOT_RELOAD_PATH_LEN     128
+
+/* Called with the path of a changed file. Handlers patch their tables in
+   place - indices held by live entities must stay valid. */
+typedef void ( *HotReloadFn_t )( const char* path );
+
+/* Dev builds only (make DEV=1 on Linux); everywhere else these are no-ops.
+   Begin drops the previous scene's watches, so each scene re-registers
+   the files it cares about. Reload timings go to stdout and the console. */
+void HotReloadBegin( Console_t* console );
+void HotReloadQuit( void );
+
+/* One file, or every file under dir (recursive) ending in ext */
+void HotReloadWatchFile( const char* path, HotReloadFn_t fn );
+void HotReloadWatchDir( const char* dir, const char* ext, HotReloadFn_t fn );
+
+/* Drain pending file events and run their handlers. Once per frame. */
+int  HotReloadPoll( void );
+
+#endif
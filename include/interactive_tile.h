@@ -23,6 +23,7 @@ typedef struct {
 } ITile_t;
 
 void         ITileInit( void );
+void         ITileReleaseSounds( void );
 void         ITilePlace( World_t* world, int x, int y, int type );
 ITile_t*     ITileAt( int row, int col );
 void         ITileBreak( World_t* world, int row, int col );
@@ -20,10 +20,85 @@ typedef struct
   char description[256];
   char glyph[8];
   aColor_t color;
+  char image_path[128];              /* re-resolved after a cache load */
   aImage_t* image;
 } ClassInfo_t;
 
+/* Consumable categories - the DUF "type" string, resolved at load */
+typedef enum
+{
+  CONS_TYPE_NONE,
+  CONS_TYPE_FOOD,
+  CONS_TYPE_GADGET,
+  CONS_TYPE_SCROLL,
+  CONS_TYPE_POTION,
+  CONS_TYPE_QUEST,
+  CONS_TYPE_PICKUP,
+  CONS_TYPE_COUNT
+} ConsumableType_t;
+
+/* Consumable effects - the DUF "effect" string, resolved at load */
+typedef enum
+{
+  CONS_EFFECT_NONE,
+  CONS_EFFECT_HEAL,
+  CONS_EFFECT_EMPOWER,
+  CONS_EFFECT_LIFESTEAL,
+  CONS_EFFECT_LURE,
+  CONS_EFFECT_EAT_SANDWICH,
+  CONS_EFFECT_SHOOT,
+  CONS_EFFECT_PIERCE,
+  CONS_EFFECT_STEW_THROW,
+  CONS_EFFECT_POISON,
+  CONS_EFFECT_TRAP_ROOT,
+  CONS_EFFECT_SMOKE,
+  CONS_EFFECT_MAGIC_BOLT,
+  CONS_EFFECT_FREEZE,
+  CONS_EFFECT_AOE,
+  CONS_EFFECT_SWAP,
+  CONS_EFFECT_REACH,
+  CONS_EFFECT_CLEAVE,
+  CONS_EFFECT_FIRE_CONE,
+  CONS_EFFECT_COUNT
+} ConsumableEffect_t;
+
+/* Consumables with hard-coded pickup behavior, keyed by DUF entry name */
+typedef enum
+{
+  CONS_SPECIAL_NONE,
+  CONS_SPECIAL_CAVE_MUSHROOM,   /* counts toward mushrooms_collected */
+  CONS_SPECIAL_BAG,             /* +1 inventory slot */
+  CONS_SPECIAL_SACK,            /* +2 inventory slots */
+  CONS_SPECIAL_MAX_HEALTH,      /* +1 max hp */
+  CONS_SPECIAL_HEARTHSTONE,     /* sets has_relic */
+  CONS_SPECIAL_COUNT
+} ConsumableSpecial_t;
+
+struct ConsumableInfo_t;
+struct Enemy_t;
+
+/* Everything a targeted consumable needs - filled by GameEventResolveTarget */
 typedef struct
+{
+  int consumable_idx;
+  int inv_slot;
+  int target_row;
+  int target_col;
+  int player_row;
+  int player_col;
+  int damage;                        /* player damage + bonus + amplify */
+  struct Enemy_t* enemies;
+  int num_enemies;
+} ConsumableTarget_t;
+
+/* Instant use (potions, food, quest items) - 1 = used, 0 = refused */
+typedef int ( *ConsumableUseFn_t )( struct ConsumableInfo_t* c );
+
+/* Targeted use - 0 = refused, 2 = resolved as a free action */
+typedef int ( *ConsumableTargetFn_t )( struct ConsumableInfo_t* c,
+                                       ConsumableTarget_t* tg );
+
+typedef struct ConsumableInfo_t
 {
   char key[MAX_NAME_LENGTH];
   char name[MAX_NAME_LENGTH];
@@ -31,7 +106,12 @@ typedef struct
   char glyph[8];
   aColor_t color;
   int bonus_damage;
-  char effect[MAX_NAME_LENGTH];
+  char effect[MAX_NAME_LENGTH];      /* display name */
+  ConsumableType_t    type_id;
+  ConsumableEffect_t  effect_id;
+  ConsumableSpecial_t special_id;
+  ConsumableUseFn_t    use;          /* NULL = can't be used directly */
+  ConsumableTargetFn_t target;       /* NULL = no targeted behavior */
   int range;
   int requires_los;
   int heal;
@@ -45,6 +125,7 @@ typedef struct
   char action[MAX_NAME_LENGTH];      /* UI label: "Lure", "Eat", etc. (empty = "Use") */
   char gives[MAX_NAME_LENGTH];       /* consumable key to add on use (empty = none) */
   char use_message[256];             /* custom console message on use (empty = none) */
+  char image_path[128];              /* re-resolved after a cache load */
   aImage_t* image;
 } ConsumableInfo_t;
 
@@ -56,11 +137,31 @@ typedef struct
   aColor_t color;
   char required_type[MAX_NAME_LENGTH];
   char description[256];
+  char image_path[128];              /* re-resolved after a cache load */
   aImage_t* image;
 } OpenableInfo_t;
 
 #define MAX_EQUIPMENT     64
 
+/* Equipment effects - the DUF "effect" string is resolved to one of these
+   at load so combat and the HUD never compare effect names */
+typedef enum
+{
+  EQUIP_EFFECT_NONE,
+  EQUIP_EFFECT_FIRST_STRIKE,
+  EQUIP_EFFECT_SCROLL_ECHO,
+  EQUIP_EFFECT_BERSERK,
+  EQUIP_EFFECT_POISON,
+  EQUIP_EFFECT_AMPLIFY,
+  EQUIP_EFFECT_DODGE,
+  EQUIP_EFFECT_ARMOR_BREAK,
+  EQUIP_EFFECT_MANA_SHIELD,
+  EQUIP_EFFECT_COMPANION,
+  EQUIP_EFFECT_GOLD_BONUS,
+  EQUIP_EFFECT_THORNS,
+  EQUIP_EFFECT_COUNT
+} EquipEffect_t;
+
 typedef struct
 {
   char key[MAX_NAME_LENGTH];
@@ -71,10 +172,12 @@ typedef struct
   aColor_t color;
   int damage;
   int defense;
-  char effect[MAX_NAME_LENGTH];
+  char effect[MAX_NAME_LENGTH];      /* display name */
+  EquipEffect_t effect_id;
   int effect_value;
   char class_name[MAX_NAME_LENGTH]; /* which class gets this as starter */
   char description[256];
+  char image_path[128];              /* re-resolved after a cache load */
   aImage_t* image;
 } EquipmentInfo_t;
 
@@ -90,6 +193,8 @@ extern EquipmentInfo_t  g_equipment[MAX_EQUIPMENT];
 extern int              g_num_equipment;
 
 void ItemsLoadAll( void );
+void ItemsReloadFile( const char* path );
+void ItemsReleaseSounds( void );
 int  ItemsBuildFiltered( int class_idx, FilteredItem_t* out, int max_out, int include_universal );
 
 int  EquipSlotForKind( const char* kind );
@@ -99,6 +204,7 @@ int  InventoryAdd( int item_type, int index );
 void InventoryRemove( int slot );
 
 int  ConsumableByKey( const char* key );
+int  ConsumableTargeted( const ConsumableInfo_t* c );   /* needs target mode */
 int  EquipmentByKey( const char* key );
 
 const char* PlayerClassKey( void );
@@ -0,0 +1,11 @@
+#ifndef __LOADING_SCENE_H__
+#define __LOADING_SCENE_H__
+
+/* Call at the end of a scene Init, after its loaders have queued work.
+   If the asset loader has a batch pending, the scene's delegates are held
+   back behind a progress bar until it drains; then the atlas is uploaded,
+   the delegates restored and on_done (may be NULL) runs. With nothing
+   pending this uploads and calls on_done straight away. */
+void LoadingSceneBegin( const char* label, void ( *on_done )( void ) );
+
+#endif
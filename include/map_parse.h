@@ -0,0 +1,51 @@
+#ifndef __MAP_PARSE_H__
+#define __MAP_PARSE_H__
+
+#include <stddef.h>
+
+/* Shared by the game and the editor, so no Archimedes/Daedalus here */
+
+#define MAP_ROOM_NONE     -1
+#define MAP_ERROR_LEN     128
+
+/* .map format:
+     // W H          optional size header, first comment line only
+     #               wall
+     .               floor, no room
+     0-9 !@~ ... a-z floor in a room (see MapCharToRoomId)
+     B G R W         door (blue/green/red/white), on floor
+     H S ?           interactive tile (rat hole, hidden wall)
+   Rows shorter than the width, and rows missing past the end of the file,
+   read as walls. */
+
+typedef struct
+{
+  int  line;      /* 1-based, in the file */
+  int  column;    /* 1-based, 0 when the error isn't about one char */
+  char message[MAP_ERROR_LEN];
+} MapParseError_t;
+
+/* Any of these may be NULL. Cells arrive row by row, left to right. */
+typedef struct
+{
+  int  ( *size )( int width, int height, void* user );  /* before any cell, 0 aborts */
+  void ( *wall )( int x, int y, void* user );
+  void ( *floor )( int x, int y, int room_id, void* user );
+  void ( *door )( int x, int y, char glyph, int vertical, void* user );
+  void ( *itile )( int x, int y, char glyph, void* user );
+} MapParseFns_t;
+
+/* Parse a whole .map held in memory. Nothing is written to data and
+   nothing is allocated, so it can point straight into a pack or mmap.
+   Returns 1, or 0 with err filled in (err may be NULL). */
+int MapParse( const char* data, size_t size,
+              const MapParseFns_t* fns, void* user, MapParseError_t* err );
+
+/* Read path into one buffer and MapParse it. */
+int MapParseFile( const char* path,
+                  const MapParseFns_t* fns, void* user, MapParseError_t* err );
+
+int  MapCharToRoomId( char c );
+char MapRoomIdToChar( int id );
+
+#endif
@@ -4,6 +4,7 @@
 #include "world.h"
 
 void MovementInit( World_t* w );
+void MovementReleaseSounds( void );
 void MovementUpdate( float dt );
 
 void PlayerGetTile( int* row, int* col );
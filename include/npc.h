@@ -9,7 +9,9 @@
 
 typedef struct Enemy_t Enemy_t;
 
+#ifndef MAX_NPCS
 #define MAX_NPCS 32
+#endif
 
 /* NPC instance - spawned in world */
 typedef struct
@@ -22,7 +24,9 @@ typedef struct
   int   home_room;          /* room NPC was spawned in (combat NPCs stay here) */
 } NPC_t;
 
+/* Dead slots are reused once NPCsCollect has run */
 void   NPCsInit( NPC_t* list, int* count );
+void   NPCsCollect( NPC_t* list, int* count );
 NPC_t* NPCSpawn( NPC_t* list, int* count,
                   int type_idx, int row, int col,
                   int tile_w, int tile_h );
@@ -35,10 +39,17 @@ void NPCsDrawAll( aRectf_t vp_rect, GameCamera_t* cam,
 /* Idle bark tick - call once per turn, spawns floating text near visible NPCs */
 void NPCsIdleTick( NPC_t* list, int count, Console_t* con );
 
-/* Combat NPC tick - move toward + attack enemies in room (animated) */
-void NPCsCombatTick( NPC_t* list, int count,
-                     Enemy_t* enemies, int num_enemies );
-void NPCsUpdate( float dt );
-int  NPCsTurning( void );
+/* Combat NPCs fight inside the enemy turn - EnemiesStartTurn calls
+   these. Begin takes stock of the floor; Act then sends one NPC toward
+   the closest enemy in its home room along a room graph path, never
+   onto a tile another creature holds or another NPC has claimed. Moves
+   land at once and slide on the turn timeline. End closes the move
+   phase, and Attack strikes the enemies that were adjacent when each
+   NPC acted, if they are still alive. */
+void NPCsCombatBegin( NPC_t* list, int count, int player_row, int player_col,
+                      int (*walkable)(int,int) );
+void NPCCombatAct( NPC_t* list, int i );
+void NPCsCombatEnd( void );
+void NPCsCombatAttack( NPC_t* list, int count, float lunge_dist );
 
 #endif
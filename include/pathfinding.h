@@ -1,16 +1,60 @@
 #ifndef __PATHFINDING_H__
 #define __PATHFINDING_H__
 
+#include <stdint.h>
+
 #define PATH_MAX_LEN 256
 
 typedef struct { int row, col; } PathNode_t;
 
+/* A* working memory. Searches that may run at the same time each need
+   their own; the plain calls share one, for the main thread. Zero it to
+   start, PathScratchFree when done - buffers grow with the largest grid. */
+typedef struct
+{
+  struct PathHeapNode_t* heap;
+  int       heap_size;
+  int       grid_cap;
+  int*      g_score;
+  int*      came_from;
+  uint32_t* seen;
+  uint32_t* shut;
+  uint32_t  stamp;
+} PathScratch_t;
+
+void PathScratchFree( PathScratch_t* s );
+
+/* Caps for PathfindAStarBounded; 0 = no cap */
+typedef struct
+{
+  int max_nodes;    /* tiles expanded before giving up */
+  int max_radius;   /* Manhattan distance from start a tile may lie */
+  int partial;      /* out: 1 if the path stops short of the goal */
+} PathLimits_t;
+
 /* Returns path length (0 = no path).  Path stored in out[] from start to goal.
    blocker_fn returns 1 if tile is blocked (walls + entities, caller decides).
-   The goal tile is exempt from the blocker check. */
+   The goal tile is exempt from the blocker check.  Paths longer than
+   PATH_MAX_LEN come back as their first PATH_MAX_LEN steps. */
 int PathfindAStar( int start_r, int start_c, int goal_r, int goal_c,
                    int grid_w, int grid_h,
                    int (*blocked)( int r, int c, void* ctx ), void* ctx,
                    PathNode_t out[PATH_MAX_LEN] );
 
+/* As PathfindAStar, but when a cap stops the search it returns the path
+   to the tile that got closest to the goal and sets limits->partial. */
+int PathfindAStarBounded( int start_r, int start_c, int goal_r, int goal_c,
+                          int grid_w, int grid_h,
+                          int (*blocked)( int r, int c, void* ctx ), void* ctx,
+                          PathLimits_t* limits,
+                          PathNode_t out[PATH_MAX_LEN] );
+
+/* PathfindAStarBounded in the caller's scratch */
+int PathfindAStarIn( PathScratch_t* s,
+                     int start_r, int start_c, int goal_r, int goal_c,
+                     int grid_w, int grid_h,
+                     int (*blocked)( int r, int c, void* ctx ), void* ctx,
+                     PathLimits_t* limits,
+                     PathNode_t out[PATH_MAX_LEN] );
+
 #endif
@@ -6,5 +6,6 @@ void PauseMenuClose( void );
 int  PauseMenuActive( void );
 int  PauseMenuLogic( void );   /* 1 = consuming input, 2 = exit to main menu */
 void PauseMenuDraw( void );
+void PauseMenuReleaseSounds( void );
 
 #endif
@@ -4,6 +4,8 @@
 #include <Archimedes.h>
 #include <Daedalus.h>
 
+#include "items.h"
+
 #define INV_COLS         4
 #define INV_ROWS         5
 #define MAX_INVENTORY   32       /* array size: 4×8 absolute max */
@@ -25,10 +27,20 @@ typedef struct
 {
   int active;
   int bonus_damage;
-  char effect[MAX_NAME_LENGTH];
+  ConsumableEffect_t effect;
   int heal;
 } ConsumableBuff_t;
 
+/* Stats derived from class + equipment - only PlayerRecalcStats writes these */
+typedef struct
+{
+  int damage;
+  int defense;
+  int effect[EQUIP_EFFECT_COUNT];       /* summed effect_value per effect */
+  int effect_min[EQUIP_EFFECT_COUNT];   /* lowest value, halved when stacked */
+  int effect_item[EQUIP_EFFECT_COUNT];  /* first equipped source, -1 = none */
+} PlayerDerived_t;
+
 typedef struct
 {
   char name[MAX_NAME_LENGTH];
@@ -36,7 +48,7 @@ typedef struct
   int max_hp;
   int class_damage;                     /* immutable base from class */
   int class_defense;                    /* immutable base from class */
-  dStaticTable_t* stats;                /* computed stats: "damage", "defense" */
+  PlayerDerived_t derived;              /* see PlayerRecalcStats */
   char consumable_type[MAX_NAME_LENGTH];
   char description[256];
   char glyph[8];
@@ -69,11 +81,7 @@ typedef struct
   int companion_counter;                /* turns toward next companion nip */
 } Player_t;
 
-void PlayerInitStats( void );
-void PlayerRecalcStats( void );
-int  PlayerStat( const char* key );
-int  PlayerEquipEffect( const char* name );
-int  PlayerEquipEffectMin( const char* name );
+void PlayerRecalcStats( void );   /* call after any change to equipment */
 
 /* Gameplay state wrappers - funnel all mutations through these */
 void PlayerFullReset( int class_index );
@@ -81,7 +89,7 @@ void PlayerTakeDamage( int amount );
 void PlayerHeal( int amount );
 void PlayerAddGold( int amount );
 int  PlayerSpendGold( int amount );
-void PlayerApplyBuff( int bonus_dmg, const char* effect, int heal );
+void PlayerApplyBuff( int bonus_dmg, ConsumableEffect_t effect, int heal );
 void PlayerClearBuff( void );
 void PlayerSetWorldPos( float x, float y );
 void PlayerResetFirstStrike( void );
@@ -90,4 +98,8 @@ void PlayerTickTurnsSinceHit( void );
 void PlayerSetRoom( int room_id );
 void PlayerEquip( int slot, int index );
 
+/* Change tracking - HUD panels rebuild only when this moves */
+int  PlayerVersion( void );
+void PlayerTouch( void );   /* call after mutating player fields directly */
+
 #endif
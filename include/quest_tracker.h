@@ -3,6 +3,7 @@
 
 #include <Archimedes.h>
 
+void QuestTrackerInit( void );   /* load quest definitions from DUF */
 void QuestTrackerDraw( aRectf_t vp_rect );
 
 #endif
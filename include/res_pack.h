@@ -0,0 +1,74 @@
+#ifndef __RES_PACK_H__
+#define __RES_PACK_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* The web build only sees what `make em` preloads - it maps a built
+   pack to the root of the virtual filesystem */
+#ifdef __EMSCRIPTEN__
+#define RES_PACK_PATH     "/resources.pak"
+#else
+#define RES_PACK_PATH     "resources.pak"
+#endif
+#define RES_PACK_MAGIC    0x4b50474du   /* "MGPK" */
+#define RES_PACK_VERSION  1
+#define RES_PACK_ALIGN    16            /* blob alignment inside the pack */
+#define RES_PATH_LEN      128
+
+/* Pack layout (native endianness, built by `make pack`):
+     ResPackHeader_t
+     ResPackEntry_t x num_entries, sorted by path
+     blobs at RES_PACK_ALIGN offsets, each followed by at least one NUL
+     so text files can be parsed in place */
+typedef struct
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t num_entries;
+  uint32_t reserved;
+} ResPackHeader_t;
+
+typedef struct
+{
+  char     path[RES_PATH_LEN];   /* "resources/data/items.duf" */
+  uint32_t offset;               /* from the start of the pack */
+  uint32_t size;                 /* without the trailing NUL */
+} ResPackEntry_t;
+
+#ifndef RES_PACK_NO_LOADERS
+
+#include <Archimedes.h>
+#include <Daedalus.h>
+
+/* File contents from the pack (zero-copy) or a loose file (owned). */
+typedef struct
+{
+  const char* data;     /* always NUL-terminated */
+  size_t      size;
+  char*       owned;    /* non-NULL when data was read from disk */
+} ResFile_t;
+
+typedef void ( *ResListFn_t )( const char* path, void* user );
+
+/* Map the pack if it exists. Without one every lookup goes to loose
+   files, which is the normal dev setup. */
+int  ResPackOpen( const char* path );
+void ResPackClose( void );
+int  ResPackMounted( void );
+const char* ResPackPath( void );     /* NULL when nothing is mounted */
+
+int  ResOpen( const char* path, ResFile_t* out );
+void ResClose( ResFile_t* f );
+int  ResExists( const char* path );
+
+/* Call fn for every file under dir (recursive) ending in ext. */
+int  ResListDir( const char* dir, const char* ext, ResListFn_t fn, void* user );
+
+/* d_DUFParseFile / IMG_Load that look in the pack first. */
+dDUFError_t* ResParseDUF( const char* path, dDUFValue_t** root );
+SDL_Surface* ResLoadSurface( const char* path );
+
+#endif
+
+#endif
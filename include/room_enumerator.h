@@ -1,7 +1,9 @@
 #ifndef __ROOM_ENUMERATOR_H__
 #define __ROOM_ENUMERATOR_H__
 
-#define ROOM_NONE     -1
+#include "map_parse.h"
+
+#define ROOM_NONE     MAP_ROOM_NONE
 #define MAX_ROOMS      58
 
 enum {
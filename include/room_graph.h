@@ -0,0 +1,60 @@
+#ifndef __ROOM_GRAPH_H__
+#define __ROOM_GRAPH_H__
+
+#include "world.h"
+#include "pathfinding.h"
+
+#define ROOM_GRAPH_MAX_ZONES  256
+
+/* Abstract graph over the floor: a zone is a connected run of walkable
+   tiles sharing one room id (corridors are zones of ROOM_NONE), and two
+   zones are linked where their tiles touch. Closed doors and solid
+   interactive tiles split zones until they open.
+
+   The graph follows world->move_rev, so doors opening, tiles breaking
+   and hidden walls giving way are picked up on the next query without
+   anybody having to tell it. */
+void RoomGraphInit( World_t* world );
+void RoomGraphInvalidate( void );
+
+/* Could anything walk from start to goal, ignoring creatures? The goal
+   may be solid itself (a door, a wall being dug at) - then any open
+   neighbour of it counts. */
+int  RoomGraphReachable( int start_r, int start_c, int goal_r, int goal_c );
+
+/* How many zone links apart two tiles are: 0 for the same zone, 1 for
+   a corridor off the room, -1 if there is no way through. Tiles the
+   graph can't place (solid, or the graph gave up) count as 0. Distances
+   from the last from tile are kept, so asking about every enemy from
+   the player's tile costs one walk of the graph. */
+int  RoomGraphHops( int from_r, int from_c, int r, int c );
+
+/* PathfindAStar over the current floor, with the same contract, but
+   unreachable goals fail without a search and long paths are planned
+   zone to zone first so A* only looks at the zones on the way.
+   blocked must treat every WORLD_BLOCKS_MOVE tile as blocked. limits
+   may be NULL, see PathfindAStarBounded. */
+int  RoomGraphPath( int start_r, int start_c, int goal_r, int goal_c,
+                    int (*blocked)( int r, int c, void* ctx ), void* ctx,
+                    PathLimits_t* limits, PathNode_t out[PATH_MAX_LEN] );
+
+/* Per-search working memory, for searches running on several threads
+   at once. RoomGraphPath uses one of its own (main thread only). */
+typedef struct
+{
+  uint8_t       on_route[ROOM_GRAPH_MAX_ZONES];
+  PathScratch_t path;
+} RoomGraphScratch_t;
+
+/* Bring the graph up to date with the floor. Call on the main thread
+   before searching with RoomGraphPathIn from workers - the graph is
+   only read after that, as long as nothing changes move_rev. */
+void RoomGraphPrepare( void );
+
+int  RoomGraphPathIn( RoomGraphScratch_t* s,
+                      int start_r, int start_c, int goal_r, int goal_c,
+                      int (*blocked)( int r, int c, void* ctx ), void* ctx,
+                      PathLimits_t* limits, PathNode_t out[PATH_MAX_LEN] );
+void RoomGraphScratchFree( RoomGraphScratch_t* s );
+
+#endif
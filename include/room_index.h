@@ -0,0 +1,42 @@
+#ifndef __ROOM_INDEX_H__
+#define __ROOM_INDEX_H__
+
+#include "enemies.h"
+#include "npc.h"
+#include "ground_items.h"
+
+/* Which enemies, NPCs and ground items stand in each room, so room
+   questions cost the room's population rather than the floor's. Also
+   counts the enemies chasing the player.
+
+   Nothing is read back from the lists on a query - whoever spawns,
+   moves or kills an entity re-files it with RoomIndexEnemy / NPC /
+   Item afterwards. Entities in corridors (ROOM_NONE) are counted but
+   not listed. */
+void RoomIndexSetLists( Enemy_t* enemies, int* num_enemies,
+                        NPC_t* npcs, int* num_npcs,
+                        GroundItem_t* items, int* num_items );
+
+/* Re-file everything - after the room map itself changed */
+void RoomIndexRebuild( void );
+
+/* Re-file one entity from its current room and alive flag. Cheap when
+   nothing changed; entities from other lists are ignored. */
+void RoomIndexEnemy( Enemy_t* e );
+void RoomIndexNPC( NPC_t* n );
+void RoomIndexItem( GroundItem_t* g );
+
+/* for ( Enemy_t* e = RoomIndexEnemies( room ); e;
+         e = RoomIndexNextEnemy( e ) ) - order is unspecified */
+Enemy_t*      RoomIndexEnemies( int room );
+Enemy_t*      RoomIndexNextEnemy( Enemy_t* e );
+NPC_t*        RoomIndexNPCs( int room );
+NPC_t*        RoomIndexNextNPC( NPC_t* n );
+GroundItem_t* RoomIndexItems( int room );
+GroundItem_t* RoomIndexNextItem( GroundItem_t* g );
+
+/* Alive enemies with chase_turns left, or -1 for a list that isn't
+   indexed */
+int  RoomIndexChasing( Enemy_t* list );
+
+#endif
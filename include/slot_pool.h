@@ -0,0 +1,47 @@
+#ifndef __SLOT_POOL_H__
+#define __SLOT_POOL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Slot reuse for the fixed entity lists (enemies, NPCs, ground items).
+   A list still runs 0..count with dead entries in between; the pool
+   hands out dead slots before growing count, and keeps the live slots
+   in a dense array for loops that only care about those.
+
+   Slots die whenever the game says so, but only become reusable at
+   SlotPoolCollect - call it between turns, so anything that died this
+   turn keeps its slot (and whatever still points at it) until then.
+   Handles carry the slot's generation, so one kept across a collect
+   can tell its slot was handed to someone else. */
+typedef struct
+{
+  int16_t*  free;       /* reusable slots, lowest last */
+  int       num_free;
+  int16_t*  live;       /* live at the last collect, plus spawns since */
+  int       num_live;
+  uint16_t* gen;        /* bumped every time a slot is handed out */
+  int       cap;
+} SlotPool_t;
+
+typedef uint32_t SlotHandle_t;
+
+#define SLOT_HANDLE_NONE  0xffffffffu
+#define SLOT_HANDLE_SLOT( h )  ( (int)( ( h ) & 0xffff ) )  /* unchecked */
+
+void SlotPoolReset( SlotPool_t* p );
+
+/* A slot for a newcomer, or -1 when the list is full. Grows *count
+   only when nothing is free. */
+int  SlotPoolAlloc( SlotPool_t* p, int* count );
+
+/* Re-read the list: trim dead slots off the end of *count, then refill
+   the free list and the live array. alive_offset is offsetof() the
+   element's int alive flag. */
+void SlotPoolCollect( SlotPool_t* p, const void* list, size_t stride,
+                      size_t alive_offset, int* count );
+
+SlotHandle_t SlotPoolHandle( const SlotPool_t* p, int slot );
+int          SlotPoolResolve( const SlotPool_t* p, SlotHandle_t h ); /* -1 if stale */
+
+#endif
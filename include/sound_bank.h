@@ -0,0 +1,25 @@
+#ifndef __SOUND_BANK_H__
+#define __SOUND_BANK_H__
+
+#include <Archimedes.h>
+
+#define SOUND_BANK_MAX       64
+#define SOUND_BANK_PATH_LEN  128
+
+/* Point *slot at the shared entry for path and take a reference. Whatever
+   *slot held before is released afterwards, so re-running an Init with
+   the same path never reloads. Nothing is decoded until the first play. */
+void SoundBankAcquire( aSoundEffect_t** slot, const char* path );
+
+/* Drop the reference in *slot and NULL it; the chunk is freed when the
+   last holder lets go. */
+void SoundBankRelease( aSoundEffect_t** slot );
+
+/* a_AudioPlaySound that loads the chunk on first use. NULL is a no-op. */
+void SoundBankPlay( aSoundEffect_t* sfx, aAudioOptions_t* opts );
+
+/* Decode now as part of the current asset batch, so a long sound does
+   not hitch its first play. */
+void SoundBankPrefetch( aSoundEffect_t* sfx );
+
+#endif
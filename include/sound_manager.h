@@ -5,7 +5,10 @@
 
 #define MUSIC_FADE_MS  2000
 
-void SoundManagerInit( void );
+/* The dungeon's footsteps and ambience are held from PrefetchGame until
+   ReleaseGame, so they are only decoded while a floor is up */
+void SoundManagerPrefetchGame( void );
+void SoundManagerReleaseGame( void );
 void SoundManagerUpdate( float dt );
 void SoundManagerCrossfadeToGame( void );
 void SoundManagerPlayMenu( void );
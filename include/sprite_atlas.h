@@ -0,0 +1,31 @@
+#ifndef __SPRITE_ATLAS_H__
+#define __SPRITE_ATLAS_H__
+
+#include <Archimedes.h>
+
+#define ATLAS_PAGE_SIZE    1024
+#define ATLAS_MAX_PAGES    4
+#define ATLAS_MAX_REGIONS  256
+#define ATLAS_PADDING      1     /* gap between sprites, stops scaled bleed */
+
+/* Pack the PNG at path into an atlas page and return its region.
+   rect.w/h is the sprite size (x/y are 0) so callers size draws exactly
+   as they did with a standalone image. Repeat calls with the same path
+   return the same region. Sprites too big for a page get a texture of
+   their own. */
+aImage_t* AtlasImage( const char* path );
+
+/* Same as AtlasImage, but the PNG is decoded by the asset loader. The
+   region is reserved now and filled in when the batch is pumped - do not
+   draw it before then. */
+aImage_t* AtlasQueue( const char* path );
+
+/* Push every page that gained sprites since the last upload to the GPU.
+   Call once a batch of loaders has run, before the first draw. */
+void AtlasUpload( void );
+
+/* Source rect to pass to a_BlitRect for img - the region inside its
+   page, or NULL for a standalone image. */
+aRectf_t* AtlasSrc( aImage_t* img );
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef __TILE_DEFS_H__
+#define __TILE_DEFS_H__
+
+#include <Archimedes.h>
+
+#define TILE_DEFS_PATH    "resources/data/tiles.duf"
+#define TILE_SPRITE_NONE  -1
+
+/* What a world layer cell holds. How each type looks and whether it
+   blocks is data, in tiles.duf, keyed by the names in tile_defs.c. */
+typedef enum
+{
+  TILE_EMPTY = 0,         /* nothing on this layer */
+  TILE_FLOOR,
+  TILE_WALL,
+
+  TILE_DOOR_BLUE,         /* walls left/right, passage up/down */
+  TILE_DOOR_GREEN,
+  TILE_DOOR_RED,
+  TILE_DOOR_WHITE,
+  TILE_DOOR_BLUE_V,       /* walls above/below, passage left/right */
+  TILE_DOOR_GREEN_V,
+  TILE_DOOR_RED_V,
+  TILE_DOOR_WHITE_V,
+
+  TILE_RAT_HOLE,
+  TILE_HIDDEN_WALL,
+  TILE_CRACKED_WALL,      /* hidden wall once revealed */
+  TILE_SPIDER_WEB,
+  TILE_OLD_CRATE,
+  TILE_URN,
+  TILE_VOID_PORTAL,
+
+  TILE_EASEL,
+  TILE_CHAIR,
+
+  TILE_RUG_TL,
+  TILE_RUG_T,
+  TILE_RUG_TR,
+  TILE_RUG_BL,
+  TILE_RUG_B,
+  TILE_RUG_BR,
+
+  TILE_TYPE_COUNT
+} TileType_t;
+
+typedef struct
+{
+  int      sprite;        /* tileset index, TILE_SPRITE_NONE = nothing */
+  char     glyph[8];
+  aColor_t fg;
+  aColor_t bg;
+  uint8_t  solid;         /* blocks movement */
+  uint8_t  opaque;        /* blocks sight */
+} TileDef_t;
+
+extern TileDef_t g_tile_defs[TILE_TYPE_COUNT];
+
+#define TILE_DEF( t )  ( &g_tile_defs[(t)] )
+
+/* (Re)fill g_tile_defs from path. Types the file leaves out draw as a
+   magenta '?' and say so on stdout. */
+void TileDefsLoad( const char* path );
+
+#endif
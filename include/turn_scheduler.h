@@ -0,0 +1,52 @@
+#ifndef __TURN_SCHEDULER_H__
+#define __TURN_SCHEDULER_H__
+
+#include "enemies.h"
+#include "npc.h"
+
+/* Energy model: every player turn an actor gains its speed in energy,
+   and acts once for each TURN_ENERGY_COST it holds. Speed 200 acts
+   twice a turn, 50 every other turn. */
+#define TURN_ENERGY_COST   100
+#define TURN_SPEED_NORMAL  100
+
+#define TURN_QUEUE_MAX     ( MAX_ENEMIES + MAX_NPCS )
+
+/* How long each phase of an actor turn plays for, in seconds */
+typedef enum
+{
+  TURN_PHASE_DELAY,    /* pause after the player's move in a fight */
+  TURN_PHASE_MOVE,
+  TURN_PHASE_ATTACK,
+  TURN_PHASE_COUNT
+} TurnPhase_t;
+
+float TurnPhaseTime( TurnPhase_t phase );
+
+/* Actors ready to act, most energy first; equal energy goes in push
+   order. Actor ids are the caller's. */
+void TurnQueueClear( void );
+void TurnQueuePush( int actor, int energy );
+int  TurnQueuePop( int* energy );     /* -1 when empty */
+
+/* Per-turn world systems (pools, tiles, companions, slot collection...).
+   TURN_STAGE_WORLD runs before the enemies take their turn, and
+   TURN_STAGE_AFTER once it has been started. Within a stage, systems
+   run in registration order. */
+typedef enum
+{
+  TURN_STAGE_WORLD,
+  TURN_STAGE_AFTER,
+  TURN_STAGE_COUNT
+} TurnStage_t;
+
+#define TURN_SYSTEMS_MAX  16
+
+typedef void ( *TurnSystemFn_t )( void );
+
+void TurnSystemsClear( void );
+void TurnSystemRegister( TurnStage_t stage, const char* name,
+                         TurnSystemFn_t fn );
+void TurnSystemsRun( TurnStage_t stage );
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef __TURN_TIMELINE_H__
+#define __TURN_TIMELINE_H__
+
+#include "enemies.h"
+#include "npc.h"
+
+#define TURN_TIMELINE_MAX  ( MAX_ENEMIES + MAX_NPCS )
+
+/* One clock for every actor animating in the same phase of a turn, so a
+   phase costs the same time with one mover or a roomful. Positions are
+   written straight from the clock - no tween slots - and the float
+   pointers must stay valid until the phase ends. */
+void TurnTimelineBegin( float duration );
+
+/* Ease (x, y) to (tx, ty) over the phase */
+void TurnTimelineSlide( float* x, float* y, float tx, float ty );
+
+/* Jab dist pixels towards (dr, dc) and back over the phase */
+void TurnTimelineLunge( float* x, float* y, int dr, int dc, float dist );
+
+/* Advance the clock. Returns 1 while the phase is still playing. */
+int  TurnTimelineUpdate( float dt );
+int  TurnTimelineCount( void );
+
+#endif
@@ -9,4 +9,12 @@ void  VisibilityUpdate( int player_row, int player_col );
 float VisibilityGet( int r, int c );
 int   los_clear( int x0, int y0, int x1, int y1 );
 
+/* Sight is symmetric: a creature at (r,c) sees the player at (pr,pc)
+   exactly when the player's ray reaches (r,c). VisibilityUpdate keeps
+   the answer for every tile within VIS_RADIUS or the widest enemy sight
+   range (Manhattan), so a check from there is a bit lookup; anything
+   else casts the player's ray. Range is the caller's business. */
+void  VisibilitySetSightRange( int range );
+int   VisibilitySeesPlayer( int r, int c, int pr, int pc );
+
 #endif
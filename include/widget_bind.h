@@ -0,0 +1,72 @@
+#ifndef __WIDGET_BIND_H__
+#define __WIDGET_BIND_H__
+
+#include <Archimedes.h>
+
+/* Widget layouts (.auf files) - one per scene */
+typedef enum
+{
+  WB_LAYOUT_MAIN_MENU,
+  WB_LAYOUT_CLASS_SELECT,
+  WB_LAYOUT_SETTINGS,
+  WB_LAYOUT_LORE,
+  WB_LAYOUT_GAME,
+  WB_LAYOUT_COUNT
+} WidgetLayout_t;
+
+/* Named widgets - resolved to handles once per layout load */
+typedef enum
+{
+  /* main_menu.auf */
+  WB_MM_BUTTONS,
+  WB_MM_TITLE,
+  WB_MM_VERSION,
+
+  /* class_select.auf */
+  WB_CLASS_SELECT,
+  WB_CONSUMABLES_PANEL,
+  WB_DOORS_PANEL,
+  WB_TITLE_PANEL,
+  WB_INFO_PANEL,
+  WB_IMAGE_PANEL,
+  WB_GEAR_PANEL,
+
+  /* settings.auf */
+  WB_SETTINGS_TITLE,
+  WB_SETTINGS_PANEL,
+  WB_SETTINGS_BACK,
+  WB_SETTINGS_HINT,
+
+  /* lore.auf */
+  WB_LORE_TITLE,
+  WB_LORE_CATEGORIES,
+  WB_LORE_ENTRIES,
+  WB_LORE_BACK,
+  WB_LORE_HINT,
+
+  /* game_scene.auf */
+  WB_TOP_BAR,
+  WB_GAME_VIEWPORT,
+  WB_CONSOLE_PANEL,
+  WB_INV_PANEL,
+  WB_INV_TITLE,
+  WB_KEY_PANEL,
+  WB_KEY_TITLE,
+
+  WB_COUNT
+} WidgetBindId_t;
+
+/* Load a layout (a_WidgetsInit) and resolve all of its named widgets */
+void WidgetBindLoad( WidgetLayout_t layout );
+
+/* Re-read the current layout from disk (dev hot-reload, window resize) */
+void WidgetBindReload( void );
+
+/* Drop all handles and free the widget cache (scene exit) */
+void WidgetBindFree( void );
+
+/* Cached handles - NULL if the widget is not in the loaded layout */
+aContainerWidget_t* WidgetBindContainer( WidgetBindId_t id );
+aWidget_t*          WidgetBindWidget( WidgetBindId_t id );
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef __WORKER_POOL_H__
+#define __WORKER_POOL_H__
+
+#define WORKER_POOL_MAX  8      /* threads on a batch, the caller's included */
+
+/* One job of a batch. worker is 0 for the calling thread and
+   1..threads-1 for the pool's, so per-thread scratch can be indexed
+   by it. */
+typedef void ( *WorkerJobFn_t )( int job, int worker, void* user );
+
+/* Threads are started once, up to the CPU count. Emscripten builds run
+   without pthreads and get none - every batch runs on the caller. */
+void WorkerPoolInit( void );
+void WorkerPoolQuit( void );
+
+/* Threads a batch can use, the caller's included (1 = no pool) */
+int  WorkerPoolSize( void );
+
+/* Run jobs 0..num_jobs-1 on up to threads threads and wait for all of
+   them. Jobs go out in order but finish in any order, so each must
+   only write its own results. */
+void WorkerPoolRun( int num_jobs, WorkerJobFn_t fn, void* user, int threads );
+
+#endif
@@ -3,23 +3,20 @@
 
 #include <Archimedes.h>
 
-#define TILE_EMPTY ((uint32_t)-1)
+#include "tile_defs.h"
 
-typedef struct
-{
-  uint32_t tile;
-  char* glyph;
-  aColor_t glyph_fg;
-  aColor_t glyph_bg;
-  uint8_t solid;
-  Ground_t base;
-} Tile_t;
+/* One layer cell - a TileType_t. Look, solidity and opacity come from
+   g_tile_defs, so a cell is a byte rather than a copy of all of that. */
+typedef uint8_t Tile_t;
 
 typedef struct
 {
-  Tile_t* background;
-  Tile_t* midground;
-  Tile_t* foreground;
+  Tile_t*  background;
+  Tile_t*  midground;
+  Tile_t*  foreground;
+  uint32_t* blocks_move;    /* 1 bit per cell, see WORLD_BLOCKS_MOVE */
+  uint32_t* blocks_sight;
+  uint32_t  move_rev;       /* bumped whenever a blocks_move bit flips */
   int tile_count;
   int tile_w, tile_h;
   int width, height;
@@ -31,5 +28,19 @@ void WorldDraw( int x_off, int y_off,
                 World_t* world, aTileset_t* tile_set,
                 uint8_t draw_ascii );
 
+/* Any layer solid / opaque at idx. Packed 32 cells to a word so the
+   pathfinding and FOV loops stay in a few cache lines. */
+#define WORLD_GRID_WORDS( count )    ( ( (count) + 31 ) / 32 )
+#define WORLD_BIT( grid, idx )       ( ( (grid)[(idx) >> 5] >> ( (idx) & 31 ) ) & 1u )
+#define WORLD_BLOCKS_MOVE( w, idx )  WORLD_BIT( (w)->blocks_move, (idx) )
+#define WORLD_BLOCKS_SIGHT( w, idx ) WORLD_BIT( (w)->blocks_sight, (idx) )
+
+/* Layers are only written through these, which keep the grids in step */
+void WorldSetBackground( World_t* w, int idx, TileType_t t );
+void WorldSetMidground( World_t* w, int idx, TileType_t t );
+
+/* After g_tile_defs changes under a live world */
+void WorldRefreshGrids( World_t* w );
+
 #endif
 
@@ -3,6 +3,7 @@
 #include <string.h>
 #include <Archimedes.h>
 #include <Daedalus.h>
+#include <SDL2/SDL_ttf.h>
 
 #include "console.h"
 
@@ -11,121 +12,260 @@
 #define CON_SCALE    1.0f
 #define CON_LINE_H  16.0f
 #define CON_SB_W     8.0f
+#define CON_TEXT_X  16.0f                /* message, right of the "> " */
+
+#define CON_FONT_PATH  "resources/fonts/EnterCommand.ttf"
+#define CON_FONT_SIZE  16
+
+/* Shared by every console; NULL until the first bake, and stays NULL if
+   the font won't open - lines then draw as text the slow way */
+static TTF_Font* con_font        = NULL;
+static int       con_font_failed = 0;
+static aImage_t  con_prefix;
+
+static TTF_Font* con_Font( void )
+{
+  if ( !con_font && !con_font_failed )
+  {
+    con_font = TTF_OpenFont( CON_FONT_PATH, CON_FONT_SIZE );
+    if ( !con_font )
+    {
+      printf( "CONSOLE: could not open %s - %s\n", CON_FONT_PATH,
+              TTF_GetError() );
+      con_font_failed = 1;
+    }
+  }
+  return con_font;
+}
+
+static void con_Unbake( aImage_t* img )
+{
+  if ( img->texture ) SDL_DestroyTexture( img->texture );
+  img->texture = NULL;
+  img->rect    = (aRectf_t){ 0, 0, 0, 0 };
+}
+
+/* Render text into img's texture. Leaves it NULL on failure, which
+   ConsoleDraw takes as "draw this one as text". */
+static void con_Bake( aImage_t* img, const char* text, aColor_t color )
+{
+  con_Unbake( img );
+
+  TTF_Font* font = con_Font();
+  if ( !font || !app.renderer || text[0] == '\0' ) return;
+
+  SDL_Color fg = { color.r, color.g, color.b, color.a };
+  SDL_Surface* surf = TTF_RenderUTF8_Blended( font, text, fg );
+  if ( !surf ) return;
+
+  SDL_Texture* tex = SDL_CreateTextureFromSurface( app.renderer, surf );
+  if ( tex )
+  {
+    SDL_SetTextureBlendMode( tex, SDL_BLENDMODE_BLEND );
+    img->texture = tex;
+    img->rect    = (aRectf_t){ 0, 0, (float)surf->w, (float)surf->h };
+  }
+  SDL_FreeSurface( surf );
+}
+
+static void con_Blit( aImage_t* img, float x, float y, float max_w )
+{
+  float w = img->rect.w < max_w ? img->rect.w : max_w;
+  if ( w <= 0 ) return;
+
+  aRectf_t src = { 0, 0, w, img->rect.h };
+  aRectf_t dst = { x, y, w, img->rect.h };
+  a_BlitRect( img, &src, &dst, 1.0f );
+}
+
+/* Ring slot for the i-th line, 0 = oldest */
+static int con_Slot( Console_t* c, int i )
+{
+  return ( c->head + i ) % CONSOLE_MAX_LINES;
+}
 
 void ConsoleInit( Console_t* c )
 {
-  c->lines = d_ArrayInit( CONSOLE_MAX_LINES, sizeof( ConsoleLine_t ) );
+  /* Re-entry: the scene's console is static, so anything still baked
+     from the last game is freed here */
+  for ( int i = 0; i < CONSOLE_MAX_LINES; i++ )
+    con_Unbake( &c->lines[i].baked );
+
+  c->head          = 0;
+  c->count         = 0;
   c->scroll_offset = 0;
+  c->num_visible   = 0;
+  c->dirty         = 1;
 }
 
 void ConsoleDestroy( Console_t* c )
 {
-  for ( size_t i = 0; i < c->lines->count; i++ )
-  {
-    ConsoleLine_t* line = (ConsoleLine_t*)d_ArrayGet( c->lines, i );
-    d_StringDestroy( line->text );
-  }
-  d_ArrayDestroy( c->lines );
-  c->lines = NULL;
+  ConsoleClear( c );
 }
 
-void ConsolePush( Console_t* c, const char* msg, aColor_t color )
+/* Claim the slot for a new line, recycling the oldest one when full */
+static ConsoleLine_t* con_NextLine( Console_t* c )
 {
-  /* If at capacity, destroy the oldest line and remove it */
-  if ( c->lines->count >= CONSOLE_MAX_LINES )
+  int slot;
+
+  if ( c->count >= CONSOLE_MAX_LINES )
   {
-    ConsoleLine_t* oldest = (ConsoleLine_t*)d_ArrayGet( c->lines, 0 );
-    d_StringDestroy( oldest->text );
-    d_ArrayRemove( c->lines, 0 );
+    slot    = c->head;
+    c->head = ( c->head + 1 ) % CONSOLE_MAX_LINES;
 
     /* Adjust scroll so it doesn't point past removed line */
     if ( c->scroll_offset > 0 )
       c->scroll_offset--;
   }
-
-  ConsoleLine_t line;
-  line.text  = d_StringInit();
-  line.color = color;
-  d_StringAppend( line.text, msg, 0 );
-
-  d_ArrayAppend( c->lines, &line );
+  else
+  {
+    slot = con_Slot( c, c->count );
+    c->count++;
+  }
 
   /* If scrolled up, bump offset so the view stays pinned */
   if ( c->scroll_offset > 0 )
     c->scroll_offset++;
+
+  c->dirty = 1;
+  return &c->lines[slot];
+}
+
+void ConsolePush( Console_t* c, const char* msg, aColor_t color )
+{
+  ConsoleLine_t* line = con_NextLine( c );
+  snprintf( line->text, sizeof( line->text ), "%s", msg );
+  line->color = color;
+  con_Bake( &line->baked, line->text, line->color );
 }
 
 void ConsolePushF( Console_t* c, aColor_t color, const char* fmt, ... )
 {
-  dString_t* buf = d_StringInit();
+  ConsoleLine_t* line = con_NextLine( c );
   va_list args;
 
   va_start( args, fmt );
-  char tmp[512];
-  vsnprintf( tmp, sizeof( tmp ), fmt, args );
+  vsnprintf( line->text, sizeof( line->text ), fmt, args );
   va_end( args );
 
-  d_StringAppend( buf, tmp, 0 );
-  ConsolePush( c, d_StringPeek( buf ), color );
-  d_StringDestroy( buf );
+  line->color = color;
+  con_Bake( &line->baked, line->text, line->color );
 }
 
 void ConsoleScroll( Console_t* c, int delta )
 {
-  int max_offset = (int)c->lines->count - CONSOLE_VISIBLE;
+  int max_offset = c->count - CONSOLE_VISIBLE;
   if ( max_offset < 0 ) max_offset = 0;
 
+  int prev = c->scroll_offset;
   c->scroll_offset += delta;
 
   if ( c->scroll_offset < 0 ) c->scroll_offset = 0;
   if ( c->scroll_offset > max_offset ) c->scroll_offset = max_offset;
+
+  if ( c->scroll_offset != prev )
+    c->dirty = 1;
 }
 
-void ConsoleDraw( Console_t* c, aRectf_t rect )
+/* Rebuild which slots are on screen and where - only after a change */
+static void con_Layout( Console_t* c, aRectf_t rect )
 {
-  if ( c->lines->count == 0 )
-    return;
-
-  int total = (int)c->lines->count;
-  int has_scrollbar = ( total > CONSOLE_VISIBLE );
-
-  aTextStyle_t ts = a_default_text_style;
-  ts.bg    = (aColor_t){ 0, 0, 0, 0 };
-  ts.scale = CON_SCALE;
-  ts.align = TEXT_ALIGN_LEFT;
+  int total = c->count;
 
   /* How many lines can we actually show */
   int visible = CONSOLE_VISIBLE;
   if ( total < visible )
     visible = total;
 
-  /* Draw bottom-aligned: newest line at bottom of rect */
+  /* Bottom-aligned: newest line at bottom of rect */
   float base_y = rect.y + rect.h - CON_PAD_Y - CON_LINE_H;
-  float x      = rect.x + CON_PAD_X;
 
+  c->num_visible = 0;
   for ( int i = 0; i < visible; i++ )
   {
     /* Walk backwards from newest, offset by scroll */
     int idx = total - 1 - c->scroll_offset - i;
     if ( idx < 0 ) break;
 
-    ConsoleLine_t* line = (ConsoleLine_t*)d_ArrayGet( c->lines, (size_t)idx );
-    float y = base_y - ( i * CON_LINE_H );
+    c->visible[c->num_visible] = con_Slot( c, idx );
+    c->line_y[c->num_visible]  = base_y - ( i * CON_LINE_H );
+    c->num_visible++;
+  }
+
+  /* Scrollbar thumb - size proportional to visible/total, position from scroll */
+  if ( total > CONSOLE_VISIBLE )
+  {
+    int max_offset = total - CONSOLE_VISIBLE;
+    float track_y = rect.y + CON_PAD_Y;
+    float track_h = rect.h - CON_PAD_Y * 2;
+
+    c->thumb_h = ( (float)CONSOLE_VISIBLE / total ) * track_h;
+    if ( c->thumb_h < 12.0f ) c->thumb_h = 12.0f;
+
+    /* scroll_offset 0 = bottom, max_offset = top */
+    float scroll_pct = ( max_offset > 0 )
+                       ? (float)c->scroll_offset / max_offset
+                       : 0;
+    c->thumb_y = track_y + ( 1.0f - scroll_pct ) * ( track_h - c->thumb_h );
+  }
+
+  c->cached_rect = rect;
+  c->dirty = 0;
+}
+
+void ConsoleDraw( Console_t* c, aRectf_t rect )
+{
+  if ( c->count == 0 )
+    return;
+
+  if ( c->dirty
+       || rect.x != c->cached_rect.x || rect.y != c->cached_rect.y
+       || rect.w != c->cached_rect.w || rect.h != c->cached_rect.h )
+    con_Layout( c, rect );
+
+  aTextStyle_t ts = a_default_text_style;
+  ts.bg    = (aColor_t){ 0, 0, 0, 0 };
+  ts.scale = CON_SCALE;
+  ts.align = TEXT_ALIGN_LEFT;
+
+  float x      = rect.x + CON_PAD_X;
+  float text_w = rect.w - CON_PAD_X - CON_TEXT_X - CON_SB_W - 4;
+  aColor_t prefix_fg = { 0x57, 0x72, 0x77, 255 };
+
+  if ( !con_prefix.texture )
+    con_Bake( &con_prefix, "> ", prefix_fg );
+
+  for ( int i = 0; i < c->num_visible; i++ )
+  {
+    ConsoleLine_t* line = &c->lines[c->visible[i]];
+    float y = c->line_y[i];
+
+    /* Pushed before there was a renderer to bake with */
+    if ( !line->baked.texture && line->text[0] != '\0' )
+      con_Bake( &line->baked, line->text, line->color );
 
     /* Prefix */
-    ts.fg = (aColor_t){ 0x57, 0x72, 0x77, 255 };
-    a_DrawText( "> ", (int)x, (int)y, ts );
+    if ( con_prefix.texture )
+      con_Blit( &con_prefix, x, y, CON_TEXT_X );
+    else
+    {
+      ts.fg = prefix_fg;
+      a_DrawText( "> ", (int)x, (int)y, ts );
+    }
 
-    /* Message */
-    ts.fg = line->color;
-    a_DrawText( d_StringPeek( line->text ),
-                (int)( x + 16.0f ), (int)y, ts );
+    /* Message - clipped to the panel, so a resize needs no rebake */
+    if ( line->baked.texture )
+      con_Blit( &line->baked, x + CON_TEXT_X, y, text_w );
+    else
+    {
+      ts.fg = line->color;
+      a_DrawText( line->text, (int)( x + CON_TEXT_X ), (int)y, ts );
+    }
   }
 
   /* Scrollbar */
-  if ( has_scrollbar )
+  if ( c->count > CONSOLE_VISIBLE )
   {
-    int max_offset = total - CONSOLE_VISIBLE;
     float track_x = rect.x + rect.w - CON_SB_W - 2;
     float track_y = rect.y + CON_PAD_Y;
     float track_h = rect.h - CON_PAD_Y * 2;
@@ -134,30 +274,21 @@ void ConsoleDraw( Console_t* c, aRectf_t rect )
     a_DrawFilledRect( (aRectf_t){ track_x, track_y, CON_SB_W, track_h },
                       (aColor_t){ 0x10, 0x14, 0x1f, 200 } );
 
-    /* Thumb - size proportional to visible/total, position from scroll */
-    float thumb_h = ( (float)CONSOLE_VISIBLE / total ) * track_h;
-    if ( thumb_h < 12.0f ) thumb_h = 12.0f;
-
-    /* scroll_offset 0 = bottom, max_offset = top */
-    float scroll_pct = ( max_offset > 0 )
-                       ? (float)c->scroll_offset / max_offset
-                       : 0;
-    float thumb_y = track_y + ( 1.0f - scroll_pct ) * ( track_h - thumb_h );
-
-    a_DrawFilledRect( (aRectf_t){ track_x, thumb_y, CON_SB_W, thumb_h },
+    a_DrawFilledRect( (aRectf_t){ track_x, c->thumb_y, CON_SB_W, c->thumb_h },
                       (aColor_t){ 0x39, 0x4a, 0x50, 255 } );
-    a_DrawRect( (aRectf_t){ track_x, thumb_y, CON_SB_W, thumb_h },
+    a_DrawRect( (aRectf_t){ track_x, c->thumb_y, CON_SB_W, c->thumb_h },
                 (aColor_t){ 0x57, 0x72, 0x77, 255 } );
   }
 }
 
 void ConsoleClear( Console_t* c )
 {
-  for ( size_t i = 0; i < c->lines->count; i++ )
-  {
-    ConsoleLine_t* line = (ConsoleLine_t*)d_ArrayGet( c->lines, i );
-    d_StringDestroy( line->text );
-  }
-  d_ArrayClear( c->lines );
+  for ( int i = 0; i < CONSOLE_MAX_LINES; i++ )
+    con_Unbake( &c->lines[i].baked );
+
+  c->head          = 0;
+  c->count         = 0;
   c->scroll_offset = 0;
+  c->num_visible   = 0;
+  c->dirty         = 1;
 }
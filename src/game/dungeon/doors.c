@@ -4,71 +4,65 @@
 #include "defines.h"
 #include "doors.h"
 #include "player.h"
+#include "sound_bank.h"
 
 extern Player_t player;
 
 static Console_t* console;
 
-static aSoundEffect_t sfx_door_white;
-static aSoundEffect_t sfx_door_red;
-static aSoundEffect_t sfx_door_green;
-static aSoundEffect_t sfx_door_blue;
-static aSoundEffect_t sfx_door_fail;
+static aSoundEffect_t* sfx_door_white = NULL;
+static aSoundEffect_t* sfx_door_red   = NULL;
+static aSoundEffect_t* sfx_door_green = NULL;
+static aSoundEffect_t* sfx_door_blue  = NULL;
+static aSoundEffect_t* sfx_door_fail  = NULL;
 
-/* Map any door tile (horizontal or vertical) to its base type */
-static int door_base( uint32_t tile )
+/* Map any door tile (horizontal or vertical) to its door type, -1 if it
+   isn't one */
+static int door_base( Tile_t tile )
 {
-  if ( tile >= DOOR_BLUE_V && tile <= DOOR_WHITE_V )
-    return (int)tile - ( DOOR_BLUE_V - DOOR_BLUE );
-  return (int)tile;
+  if ( tile >= TILE_DOOR_BLUE_V && tile <= TILE_DOOR_WHITE_V )
+    return DOOR_BLUE + ( tile - TILE_DOOR_BLUE_V );
+  if ( tile >= TILE_DOOR_BLUE && tile <= TILE_DOOR_WHITE )
+    return DOOR_BLUE + ( tile - TILE_DOOR_BLUE );
+  return -1;
 }
 
-static aColor_t door_color( int type )
+void DoorsInit( Console_t* con )
 {
-  switch ( door_base( type ) )
-  {
-    case DOOR_BLUE:  return (aColor_t){ 0x4f, 0x8f, 0xba, 255 };
-    case DOOR_GREEN: return (aColor_t){ 0x75, 0xa7, 0x43, 255 };
-    case DOOR_RED:   return (aColor_t){ 0xa5, 0x30, 0x30, 255 };
-    case DOOR_WHITE: return (aColor_t){ 0xc7, 0xcf, 0xcc, 255 };
-    default:         return (aColor_t){ 0xc0, 0x94, 0x73, 255 };
-  }
+  console = con;
+  SoundBankAcquire( &sfx_door_white, "resources/soundeffects/door_white_open.wav" );
+  SoundBankAcquire( &sfx_door_red,   "resources/soundeffects/door_red_open.ogg" );
+  SoundBankAcquire( &sfx_door_green, "resources/soundeffects/door_green_open.ogg" );
+  SoundBankAcquire( &sfx_door_blue,  "resources/soundeffects/door_blue_open.ogg" );
+  SoundBankAcquire( &sfx_door_fail,  "resources/soundeffects/door_fail.ogg" );
 }
 
-void DoorsInit( Console_t* con )
+void DoorsReleaseSounds( void )
 {
-  console = con;
-  a_AudioLoadSound( "resources/soundeffects/door_white_open.wav", &sfx_door_white );
-  a_AudioLoadSound( "resources/soundeffects/door_red_open.ogg",   &sfx_door_red );
-  a_AudioLoadSound( "resources/soundeffects/door_green_open.ogg", &sfx_door_green );
-  a_AudioLoadSound( "resources/soundeffects/door_blue_open.ogg",  &sfx_door_blue );
-  a_AudioLoadSound( "resources/soundeffects/door_fail.ogg",       &sfx_door_fail );
+  SoundBankRelease( &sfx_door_white );
+  SoundBankRelease( &sfx_door_red );
+  SoundBankRelease( &sfx_door_green );
+  SoundBankRelease( &sfx_door_blue );
+  SoundBankRelease( &sfx_door_fail );
 }
 
 void DoorPlace( World_t* w, int x, int y, int type, int vertical )
 {
   int idx = y * w->width + x;
-  int tile = vertical ? type + ( DOOR_BLUE_V - DOOR_BLUE ) : type;
-
-  /* Floor underneath */
-  w->background[idx].tile     = 0;
-  w->background[idx].glyph    = ".";
-  w->background[idx].glyph_fg = (aColor_t){ 0x39, 0x4a, 0x50, 255 };
-
-  /* Door on midground */
-  w->midground[idx].tile     = (uint32_t)tile;
-  w->midground[idx].glyph    = "+";
-  w->midground[idx].glyph_fg = door_color( type );
-  w->midground[idx].solid    = 1;
+  TileType_t tile = ( vertical ? TILE_DOOR_BLUE_V : TILE_DOOR_BLUE )
+                  + ( type - DOOR_BLUE );
+
+  /* Floor underneath, door on midground */
+  WorldSetBackground( w, idx, TILE_FLOOR );
+  WorldSetMidground( w, idx, tile );
 }
 
-int DoorIsDoor( uint32_t tile )
+int DoorIsDoor( Tile_t tile )
 {
-  return ( tile >= DOOR_BLUE && tile <= DOOR_WHITE ) ||
-         ( tile >= DOOR_BLUE_V && tile <= DOOR_WHITE_V );
+  return door_base( tile ) >= 0;
 }
 
-int DoorCanOpen( uint32_t tile )
+int DoorCanOpen( Tile_t tile )
 {
   const char* cls = player.name;
   switch ( door_base( tile ) )
@@ -84,27 +78,26 @@ int DoorCanOpen( uint32_t tile )
 int DoorTryOpen( World_t* w, int x, int y )
 {
   int idx = y * w->width + x;
-  Tile_t* door = &w->midground[idx];
+  Tile_t   door  = w->midground[idx];
+  aColor_t color = TILE_DEF( door )->fg;
 
-  if ( DoorCanOpen( door->tile ) )
+  if ( DoorCanOpen( door ) )
   {
-    switch ( door_base( door->tile ) )
+    switch ( door_base( door ) )
     {
-      case DOOR_WHITE: a_AudioPlaySound( &sfx_door_white, NULL ); break;
-      case DOOR_RED:   a_AudioPlaySound( &sfx_door_red,   NULL ); break;
-      case DOOR_GREEN: a_AudioPlaySound( &sfx_door_green, NULL ); break;
-      case DOOR_BLUE:  a_AudioPlaySound( &sfx_door_blue,  NULL ); break;
+      case DOOR_WHITE: SoundBankPlay( sfx_door_white, NULL ); break;
+      case DOOR_RED:   SoundBankPlay( sfx_door_red,   NULL ); break;
+      case DOOR_GREEN: SoundBankPlay( sfx_door_green, NULL ); break;
+      case DOOR_BLUE:  SoundBankPlay( sfx_door_blue,  NULL ); break;
     }
-    switch ( door_base( door->tile ) )
+    switch ( door_base( door ) )
     {
-      case DOOR_RED:   ConsolePushF( console, door->glyph_fg, "You break down the door." ); break;
-      case DOOR_GREEN: ConsolePushF( console, door->glyph_fg, "You pick the lock." );       break;
-      case DOOR_BLUE:  ConsolePushF( console, door->glyph_fg, "You dispel the barrier." );  break;
-      default:         ConsolePushF( console, door->glyph_fg, "You open the door." );       break;
+      case DOOR_RED:   ConsolePushF( console, color, "You break down the door." ); break;
+      case DOOR_GREEN: ConsolePushF( console, color, "You pick the lock." );       break;
+      case DOOR_BLUE:  ConsolePushF( console, color, "You dispel the barrier." );  break;
+      default:         ConsolePushF( console, color, "You open the door." );       break;
     }
-    door->tile  = TILE_EMPTY;
-    door->solid = 0;
-    door->glyph = "";
+    WorldSetMidground( w, idx, TILE_EMPTY );
     return 1;
   }
 
@@ -113,45 +106,46 @@ int DoorTryOpen( World_t* w, int x, int y )
   if ( now - last_fail_tick < 1000 ) return 0;
   last_fail_tick = now;
 
-  a_AudioPlaySound( &sfx_door_fail, NULL );
-  ConsolePush( console, "The door is locked.", door->glyph_fg );
+  SoundBankPlay( sfx_door_fail, NULL );
+  ConsolePush( console, "The door is locked.", color );
   return 0;
 }
 
 void DoorDescribe( World_t* w, int x, int y )
 {
   int idx = y * w->width + x;
-  Tile_t* door = &w->midground[idx];
+  Tile_t   door  = w->midground[idx];
+  aColor_t color = TILE_DEF( door )->fg;
 
-  switch ( door_base( door->tile ) )
+  switch ( door_base( door ) )
   {
     case DOOR_WHITE:
-      ConsolePush( console, "An unlocked door.", door->glyph_fg );
-      ConsolePush( console, "  Anybody can open this.", door->glyph_fg );
+      ConsolePush( console, "An unlocked door.", color );
+      ConsolePush( console, "  Anybody can open this.", color );
       break;
     case DOOR_RED:
-      ConsolePush( console, "A locked door.", door->glyph_fg );
-      if ( DoorCanOpen( door->tile ) )
-        ConsolePush( console, "  You can bust it down.", door->glyph_fg );
+      ConsolePush( console, "A locked door.", color );
+      if ( DoorCanOpen( door ) )
+        ConsolePush( console, "  You can bust it down.", color );
       else
-        ConsolePush( console, "  Someone stronger could bust it down.", door->glyph_fg );
+        ConsolePush( console, "  Someone stronger could bust it down.", color );
       break;
     case DOOR_GREEN:
-      ConsolePush( console, "A locked door.", door->glyph_fg );
-      if ( DoorCanOpen( door->tile ) )
-        ConsolePush( console, "  You can pick this lock.", door->glyph_fg );
+      ConsolePush( console, "A locked door.", color );
+      if ( DoorCanOpen( door ) )
+        ConsolePush( console, "  You can pick this lock.", color );
       else
-        ConsolePush( console, "  Someone more agile could pick this lock.", door->glyph_fg );
+        ConsolePush( console, "  Someone more agile could pick this lock.", color );
       break;
     case DOOR_BLUE:
-      ConsolePush( console, "A locked door.", door->glyph_fg );
-      if ( DoorCanOpen( door->tile ) )
-        ConsolePush( console, "  You can dispel this barrier.", door->glyph_fg );
+      ConsolePush( console, "A locked door.", color );
+      if ( DoorCanOpen( door ) )
+        ConsolePush( console, "  You can dispel this barrier.", color );
       else
-        ConsolePush( console, "  Someone smarter could dispel this barrier.", door->glyph_fg );
+        ConsolePush( console, "  Someone smarter could dispel this barrier.", color );
       break;
     default:
-      ConsolePush( console, "A door.", door->glyph_fg );
+      ConsolePush( console, "A door.", color );
       break;
   }
 }
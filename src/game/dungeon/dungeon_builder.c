@@ -8,103 +8,94 @@
 #include "doors.h"
 #include "objects.h"
 #include "room_enumerator.h"
+#include "room_graph.h"
 #include "interactive_tile.h"
+#include "map_parse.h"
+#include "res_pack.h"
 
-int DungeonCharToRoomId( char c )
+/* Parse-time state for DungeonBuild - the world appears once the map's
+   size is known */
+typedef struct
 {
-  if ( c >= '0' && c <= '9' ) return c - '0';
-  switch ( c )
-  {
-    case '!': return 10;  case '@': return 11;  case '~': return 12;
-    case '$': return 13;  case '%': return 14;  case '^': return 15;
-    case '&': return 16;  case '*': return 17;  case '(': return 18;
-    case ')': return 19;  case '[': return 20;  case ']': return 21;
-    case '{': return 22;  case '}': return 23;  case '-': return 24;
-    case '_': return 25;  case '+': return 26;  case '=': return 27;
-    case '\\': return 28; case '|': return 29; case ';': return 30;
-    case ':': return 31;
-    default:
-      if ( c >= 'a' && c <= 'z' ) return 32 + ( c - 'a' );
-      return ROOM_NONE;
-  }
+  World_t* world;
+  int      tile_w, tile_h;
+} DungeonBuildCtx_t;
+
+static int build_size( int width, int height, void* user )
+{
+  DungeonBuildCtx_t* ctx = user;
+
+  ctx->world = WorldCreate( width, height, ctx->tile_w, ctx->tile_h );
+  if ( !ctx->world ) return 0;
+
+  RoomEnumeratorInit( width, height );
+  ITileInit();
+  return 1;
 }
 
-char DungeonRoomIdToChar( int id )
+static void build_wall( int x, int y, void* user )
 {
-  if ( id >= 0 && id <= 9 ) return '0' + id;
-  static const char lut[] = "!@~$%^&*()[]{}-_+=\\|;:";
-  if ( id >= 10 && id <= 31 ) return lut[id - 10];
-  if ( id >= 32 && id <= 57 ) return 'a' + ( id - 32 );
-  return '.';
+  World_t* w = ( (DungeonBuildCtx_t*)user )->world;
+  WorldSetBackground( w, y * w->width + x, TILE_WALL );
 }
 
-/* Load a .map file into dString rows. Caller must free with dungeon_free_map(). */
-static dString_t** dungeon_load_map( const char* path )
+/* Room chars and '.' keep the WorldCreate default (TILE_FLOOR) */
+static void build_floor( int x, int y, int room_id, void* user )
 {
-  FILE* fp = fopen( path, "r" );
-  if ( !fp )
-  {
-    fprintf( stderr, "dungeon_load_map: failed to open '%s'\n", path );
-    return NULL;
-  }
+  (void)user;
+  if ( room_id != ROOM_NONE ) RoomSetTile( x, y, room_id );
+}
 
-  dString_t** rows = malloc( sizeof( dString_t* ) * DUNGEON_H );
-  if ( !rows ) { fclose( fp ); return NULL; }
+static void build_door( int x, int y, char glyph, int vertical, void* user )
+{
+  int type = ( glyph == 'B' ) ? DOOR_BLUE  :
+             ( glyph == 'G' ) ? DOOR_GREEN :
+             ( glyph == 'R' ) ? DOOR_RED   : DOOR_WHITE;
+  DoorPlace( ( (DungeonBuildCtx_t*)user )->world, x, y, type, vertical );
+}
 
-  char buf[256];
-  int y = 0;
+static void build_itile( int x, int y, char glyph, void* user )
+{
+  World_t* w = ( (DungeonBuildCtx_t*)user )->world;
 
-  while ( y < DUNGEON_H && fgets( buf, sizeof( buf ), fp ) )
+  if ( glyph == 'H' )
   {
-    /* Strip trailing newline */
-    size_t len = strlen( buf );
-    while ( len > 0 && ( buf[len-1] == '\n' || buf[len-1] == '\r' ) )
-      buf[--len] = '\0';
-
-    /* Skip comment lines */
-    if ( len >= 2 && buf[0] == '/' && buf[1] == '/' )
-      continue;
-
-    rows[y] = d_StringInit();
-    d_StringAppend( rows[y], buf, 0 );
-
-    /* Pad short rows with walls */
-    if ( (int)len < DUNGEON_W )
-    {
-      fprintf( stderr, "dungeon_load_map: row %d too short (%zu < %d)\n",
-               y, len, DUNGEON_W );
-      char pad[DUNGEON_W + 1];
-      int needed = DUNGEON_W - (int)len;
-      memset( pad, '#', needed );
-      pad[needed] = '\0';
-      d_StringAppend( rows[y], pad, 0 );
-    }
-
-    y++;
+    ITilePlace( w, x, y, ITILE_RAT_HOLE );
+    return;
   }
 
-  fclose( fp );
+  /* Background wall so it looks normal, midground ITile for interaction */
+  WorldSetBackground( w, y * w->width + x, TILE_WALL );
+  ITilePlace( w, x, y, ITILE_HIDDEN_WALL );
+}
+
+static const MapParseFns_t build_fns = {
+  build_size, build_wall, build_floor, build_door, build_itile
+};
 
-  /* Fill any missing rows with walls */
-  while ( y < DUNGEON_H )
+/* Parse a .map from the pack or disk. The parser never writes to the
+   buffer, so a pack entry is used in place. */
+static int dungeon_parse_map( const char* path, const MapParseFns_t* fns, void* user )
+{
+  ResFile_t f;
+  if ( !ResOpen( path, &f ) )
   {
-    rows[y] = d_StringInit();
-    char wall_row[DUNGEON_W + 1];
-    memset( wall_row, '#', DUNGEON_W );
-    wall_row[DUNGEON_W] = '\0';
-    d_StringAppend( rows[y], wall_row, 0 );
-    y++;
+    fprintf( stderr, "dungeon_parse_map: failed to open '%s'\n", path );
+    return 0;
   }
 
-  return rows;
-}
+  MapParseError_t err;
+  int ok = MapParse( f.data, f.size, fns, user, &err );
+  ResClose( &f );
 
-static void dungeon_free_map( dString_t** rows )
-{
-  if ( !rows ) return;
-  for ( int y = 0; y < DUNGEON_H; y++ )
-    d_StringDestroy( rows[y] );
-  free( rows );
+  if ( !ok )
+  {
+    if ( err.column > 0 )
+      fprintf( stderr, "%s:%d:%d: %s\n", path, err.line, err.column, err.message );
+    else
+      fprintf( stderr, "%s:%d: %s\n", path, err.line, err.message );
+  }
+  return ok;
 }
 
 int DungeonSaveMap( const char* path, const char** rows, int width, int height )
@@ -127,97 +118,145 @@ int DungeonSaveMap( const char* path, const char** rows, int width, int height )
 
 int g_current_floor = 1;
 
-void DungeonBuild( World_t* world )
+const char* DungeonMapPath( void )
 {
-  const char* map_path = ( g_current_floor >= 3 )
+  return ( g_current_floor >= 3 )
     ? "resources/data/floors/floor_03/floor_03.map"
     : ( g_current_floor == 2 )
     ? "resources/data/floors/floor_02/floor_02.map"
     : "resources/data/floors/floor_01/floor_01.map";
-  dString_t** floor = dungeon_load_map( map_path );
-  if ( !floor )
-  {
-    fprintf( stderr, "DungeonBuild: could not load floor map!\n" );
-    return;
-  }
+}
 
-  RoomEnumeratorInit( DUNGEON_W, DUNGEON_H );
-  ITileInit();
+const char* DungeonRoomsPath( void )
+{
+  return ( g_current_floor >= 3 )
+    ? "resources/data/rooms_floor_03.duf"
+    : ( g_current_floor == 2 )
+    ? "resources/data/rooms_floor_02.duf"
+    : "resources/data/rooms_floor_01.duf";
+}
 
-  /* Parse the character map into tiles */
-  for ( int y = 0; y < DUNGEON_H; y++ )
+World_t* DungeonBuild( int tile_w, int tile_h )
+{
+  DungeonBuildCtx_t ctx = { NULL, tile_w, tile_h };
+  if ( !dungeon_parse_map( DungeonMapPath(), &build_fns, &ctx ) )
   {
-    const char* row = d_StringPeek( floor[y] );
-    for ( int x = 0; x < DUNGEON_W; x++ )
-    {
-      int  idx = y * DUNGEON_W + x;
-      char c   = row[x];
-
-      if ( c == '#' )
-      {
-        world->background[idx].tile     = 1;
-        world->background[idx].glyph    = "#";
-        world->background[idx].glyph_fg = (aColor_t){ 0x81, 0x97, 0x96, 255 };
-        world->background[idx].solid    = 1;
-      }
-      else if ( c == 'H' )
-      {
-        ITilePlace( world, x, y, ITILE_RAT_HOLE );
-      }
-      else if ( c == 'S' || c == '?' )
-      {
-        /* Background wall so it looks normal, midground ITile for interaction */
-        world->background[idx].tile     = 1;
-        world->background[idx].glyph    = "#";
-        world->background[idx].glyph_fg = (aColor_t){ 0x81, 0x97, 0x96, 255 };
-        world->background[idx].solid    = 1;
-        ITilePlace( world, x, y, ITILE_HIDDEN_WALL );
-      }
-      else if ( c == 'B' || c == 'G' || c == 'R' || c == 'W' )
-      {
-        int type = ( c == 'B' ) ? DOOR_BLUE  :
-                   ( c == 'G' ) ? DOOR_GREEN :
-                   ( c == 'R' ) ? DOOR_RED   : DOOR_WHITE;
-        /* Walls above & below = vertical door; walls left & right = horizontal */
-        const char* above = ( y > 0 )              ? d_StringPeek( floor[y-1] ) : NULL;
-        const char* below = ( y < DUNGEON_H - 1 )  ? d_StringPeek( floor[y+1] ) : NULL;
-        int vert = ( above && below && above[x] == '#' && below[x] == '#' );
-        DoorPlace( world, x, y, type, vert );
-      }
-      else
-      {
-        int room_id = DungeonCharToRoomId( c );
-        if ( room_id != ROOM_NONE )
-          RoomSetTile( x, y, room_id );
-        /* both room chars and '.' keep the WorldCreate default (floor, tile 0) */
-      }
-    }
+    fprintf( stderr, "DungeonBuild: could not load floor map!\n" );
+    if ( ctx.world ) WorldFree( ctx.world );
+    return NULL;
   }
 
-  dungeon_free_map( floor );
+  World_t* world = ctx.world;
 
-  RoomLoadData( ( g_current_floor >= 3 )
-    ? "resources/data/rooms_floor_03.duf"
-    : ( g_current_floor == 2 )
-    ? "resources/data/rooms_floor_02.duf"
-    : "resources/data/rooms_floor_01.duf" );
+  RoomLoadData( DungeonRoomsPath() );
 
   /* Objects - placed by coordinate, not by map char */
   if ( g_current_floor == 1 )
     ObjectPlace( world, 22, 4, OBJ_EASEL );
   if ( g_current_floor == 2 )
     ObjectPlace( world, 12, 5, OBJ_CHAIR );
+
+  RoomGraphInit( world );
+  return world;
+}
+
+/* ---- Dev hot reload ---- */
+
+typedef struct
+{
+  World_t* world;
+  int      patched;
+  int      skipped;
+} DungeonReloadCtx_t;
+
+static int reload_size( int width, int height, void* user )
+{
+  World_t* w = ( (DungeonReloadCtx_t*)user )->world;
+  if ( width == w->width && height == w->height ) return 1;
+
+  printf( "DUNGEON: map is now %dx%d (was %dx%d) - re-enter the floor\n",
+          width, height, w->width, w->height );
+  return 0;
+}
+
+static void reload_cell( DungeonReloadCtx_t* ctx, int x, int y, int wall, int room_id )
+{
+  World_t* w   = ctx->world;
+  int      idx = y * w->width + x;
+
+  if ( w->midground[idx] != TILE_EMPTY )
+  {
+    ctx->skipped++;
+    return;
+  }
+
+  TileType_t t = wall ? TILE_WALL : TILE_FLOOR;
+  if ( w->background[idx] != t || RoomAt( x, y ) != room_id )
+    ctx->patched++;
+
+  WorldSetBackground( w, idx, t );
+  RoomSetTile( x, y, room_id );
+}
+
+static void reload_wall( int x, int y, void* user )
+{
+  reload_cell( user, x, y, 1, ROOM_NONE );
+}
+
+static void reload_floor( int x, int y, int room_id, void* user )
+{
+  reload_cell( user, x, y, 0, room_id );
+}
+
+/* A door or tile that is already there keeps its state */
+static void reload_special( DungeonReloadCtx_t* ctx, int x, int y )
+{
+  if ( ctx->world->midground[y * ctx->world->width + x] == TILE_EMPTY )
+    ctx->skipped++;
+}
+
+static void reload_door( int x, int y, char glyph, int vertical, void* user )
+{
+  (void)glyph; (void)vertical;
+  reload_special( user, x, y );
+}
+
+static void reload_itile( int x, int y, char glyph, void* user )
+{
+  (void)glyph;
+  reload_special( user, x, y );
+}
+
+static const MapParseFns_t reload_fns = {
+  reload_size, reload_wall, reload_floor, reload_door, reload_itile
+};
+
+/* Re-read the floor map and patch walls, floors and room ids in place.
+   Doors and interactive tiles carry run state (opened, searched), so
+   cells that gain or lose one are left alone and counted; a resized map
+   needs the floor re-entered. */
+int DungeonReloadMap( World_t* world, const char* path )
+{
+  DungeonReloadCtx_t ctx = { world, 0, 0 };
+  if ( !dungeon_parse_map( path, &reload_fns, &ctx ) ) return 0;
+
+  RoomGraphInvalidate();    /* room ids may have moved without any wall */
+  printf( "DUNGEON: %s - %d cells patched", path, ctx.patched );
+  if ( ctx.skipped > 0 )
+    printf( ", %d door/tile changes need a floor restart", ctx.skipped );
+  printf( "\n" );
+  return 1;
 }
 
-void DungeonPlayerStart( float* wx, float* wy )
+void DungeonPlayerStart( World_t* world, float* wx, float* wy )
 {
   /* Find center of room 0 */
-  int min_x = DUNGEON_W, max_x = 0;
-  int min_y = DUNGEON_H, max_y = 0;
+  int min_x = world->width, max_x = 0;
+  int min_y = world->height, max_y = 0;
   int found = 0;
 
-  for ( int y = 0; y < DUNGEON_H; y++ )
-    for ( int x = 0; x < DUNGEON_W; x++ )
+  for ( int y = 0; y < world->height; y++ )
+    for ( int x = 0; x < world->width; x++ )
       if ( RoomAt( x, y ) == 0 )
       {
         if ( x < min_x ) min_x = x;
@@ -230,6 +269,6 @@ void DungeonPlayerStart( float* wx, float* wy )
   int cx = found ? ( min_x + max_x ) / 2 : 14;
   int cy = found ? ( min_y + max_y ) / 2 : 18;
 
-  *wx = cx * 16 + 8.0f;
-  *wy = cy * 16 + 8.0f;
+  *wx = cx * world->tile_w + world->tile_w / 2.0f;
+  *wy = cy * world->tile_h + world->tile_h / 2.0f;
 }
@@ -3,6 +3,7 @@
 #include "defines.h"
 #include "dungeon.h"
 #include "visibility.h"
+#include "sprite_atlas.h"
 
 #define EASEL_COL 22
 #define EASEL_ROW  4
@@ -20,11 +21,11 @@ static float chair_wy = 0;
 
 void DungeonHandlerInit( World_t* world )
 {
-  easel_image = a_ImageLoad( "resources/assets/objects/jonathon-easel.png" );
+  easel_image = AtlasQueue( "resources/assets/objects/jonathon-easel.png" );
   easel_wx = EASEL_COL * world->tile_w + world->tile_w / 2.0f;
   easel_wy = EASEL_ROW * world->tile_h + world->tile_h / 2.0f;
 
-  chair_image = a_ImageLoad( "resources/assets/objects/grishnak-chair.png" );
+  chair_image = AtlasQueue( "resources/assets/objects/grishnak-chair.png" );
   chair_wx = CHAIR_COL * world->tile_w + world->tile_w / 2.0f;
   chair_wy = CHAIR_ROW * world->tile_h + world->tile_h / 2.0f;
 }
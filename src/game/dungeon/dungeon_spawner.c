@@ -1,3 +1,4 @@
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <Archimedes.h>
@@ -11,6 +12,7 @@
 #include "maps.h"
 #include "movement.h"
 #include "shop.h"
+#include "room_index.h"
 
 extern Player_t player;
 
@@ -159,6 +161,7 @@ void DungeonDeferredSpawns( NPC_t* npcs, int num_npcs,
         EnemySpawn( enemies, num_enemies, cult_enemy,
                     npcs[i].row, npcs[i].col, tw, th );
         npcs[i].alive = 0;
+        RoomIndexNPC( &npcs[i] );
       }
     }
   }
@@ -184,6 +187,7 @@ void DungeonDeferredSpawns( NPC_t* npcs, int num_npcs,
         EnemySpawn( enemies, num_enemies, cult_enemy,
                     npcs[i].row, npcs[i].col, tw, th );
         npcs[i].alive = 0;
+        RoomIndexNPC( &npcs[i] );
       }
     }
   }
@@ -347,6 +351,46 @@ void DungeonSpawnFromDUF( const char* path,
   SpawnListDestroy( &list );
 }
 
+#ifdef STRESS_ENEMIES
+/* `make STRESS=n` - top the floor up to n live enemies on random open
+   tiles, clear of the player's start, so the enemy turn can be timed at
+   a density no real floor reaches. Raise MAX_ENEMIES to fit. */
+static void SpawnStressEnemies( NPC_t* npcs, int num_npcs,
+                                Enemy_t* enemies, int* num_enemies,
+                                GroundItem_t* items, int num_items,
+                                World_t* world )
+{
+  int pr, pc;
+  PlayerGetTile( &pr, &pc );
+
+  int alive = 0;
+  for ( int i = 0; i < *num_enemies; i++ )
+    if ( enemies[i].alive ) alive++;
+
+  int want = STRESS_ENEMIES < MAX_ENEMIES ? STRESS_ENEMIES : MAX_ENEMIES;
+  for ( int tries = want * 50; alive < want && tries > 0; tries-- )
+  {
+    int r = rand() % world->width;
+    int c = rand() % world->height;
+    if ( abs( r - pr ) + abs( c - pc ) < 4 ) continue;
+    if ( !TileWalkable( r, c ) || TileHasDoor( r, c ) ) continue;
+    if ( EnemyAt( enemies, *num_enemies, r, c )
+         || NPCAt( npcs, num_npcs, r, c )
+         || GroundItemAt( items, num_items, r, c ) )
+      continue;
+
+    static const char* kinds[] = { "rat", "skeleton", "slime" };
+    if ( !EnemySpawn( enemies, num_enemies,
+                      EnemyTypeByKey( kinds[rand() % 3] ), r, c,
+                      world->tile_w, world->tile_h ) )
+      break;   /* list full - EnemySpawn said so */
+    alive++;
+  }
+
+  printf( "SPAWNER: stress floor, %d enemies alive\n", alive );
+}
+#endif
+
 /* ====== Dispatcher ====== */
 
 void DungeonSpawn( NPC_t* npcs, int* num_npcs,
@@ -365,4 +409,9 @@ void DungeonSpawn( NPC_t* npcs, int* num_npcs,
   else
     SpawnFloor1( npcs, num_npcs, enemies, num_enemies,
                  items, num_items, world );
+
+#ifdef STRESS_ENEMIES
+  SpawnStressEnemies( npcs, *num_npcs, enemies, num_enemies,
+                      items, *num_items, world );
+#endif
 }
@@ -4,43 +4,41 @@
 #include "interactive_tile.h"
 #include "player.h"
 #include "enemies.h"
+#include "sound_bank.h"
 
 extern Player_t player;
 
 static ITile_t itiles[MAX_ITILES];
 static int     num_itiles = 0;
-static aSoundEffect_t sfx_web_hit;
+static aSoundEffect_t* sfx_web_hit = NULL;
 
 static const struct {
-  int         tile_id;
-  const char* glyph;
-  aColor_t    color;
+  TileType_t  tile;
   const char* description;
-  int         solid;
 } itile_types[] = {
   [ITILE_RAT_HOLE] = {
-    10, "O", { 0x09, 0x0a, 0x14, 255 },
-    "A dark hole gnawed through the wall. Something is scratching inside.", 1
+    TILE_RAT_HOLE,
+    "A dark hole gnawed through the wall. Something is scratching inside."
   },
   [ITILE_HIDDEN_WALL] = {
-    1, "#", { 0x81, 0x97, 0x96, 255 },
-    "You see a stone wall.", 1
+    TILE_HIDDEN_WALL,
+    "You see a stone wall."
   },
   [ITILE_SPIDER_WEB] = {
-    9, "~", { 0x9a, 0x8c, 0x7a, 255 },
-    "Thick spider silk stretches across the floor. Stepping in it would slow you down.", 0
+    TILE_SPIDER_WEB,
+    "Thick spider silk stretches across the floor. Stepping in it would slow you down."
   },
   [ITILE_OLD_CRATE] = {
-    18, "=", { 0xa0, 0x78, 0x46, 255 },
-    "An old wooden crate. Looks like it's been here a while.", 1
+    TILE_OLD_CRATE,
+    "An old wooden crate. Looks like it's been here a while."
   },
   [ITILE_URN] = {
-    19, "U", { 0x8a, 0x5c, 0x3e, 255 },
-    "A clay urn. The cult placed these with care.", 1
+    TILE_URN,
+    "A clay urn. The cult placed these with care."
   },
   [ITILE_VOID_PORTAL] = {
-    20, "V", { 0x80, 0x20, 0xa0, 255 },
-    "A shimmering tear in the air. Something writhes inside.", 1
+    TILE_VOID_PORTAL,
+    "A shimmering tear in the air. Something writhes inside."
   },
 };
 
@@ -48,7 +46,12 @@ void ITileInit( void )
 {
   memset( itiles, 0, sizeof( itiles ) );
   num_itiles = 0;
-  a_AudioLoadSound( "resources/soundeffects/web_hit.wav", &sfx_web_hit );
+  SoundBankAcquire( &sfx_web_hit, "resources/soundeffects/web_hit.wav" );
+}
+
+void ITileReleaseSounds( void )
+{
+  SoundBankRelease( &sfx_web_hit );
 }
 
 void ITilePlace( World_t* world, int x, int y, int type )
@@ -57,10 +60,7 @@ void ITilePlace( World_t* world, int x, int y, int type )
 
   int idx = y * world->width + x;
 
-  world->midground[idx].tile     = itile_types[type].tile_id;
-  world->midground[idx].glyph    = (char*)itile_types[type].glyph;
-  world->midground[idx].glyph_fg = itile_types[type].color;
-  world->midground[idx].solid    = itile_types[type].solid;
+  WorldSetMidground( world, idx, itile_types[type].tile );
 
   itiles[num_itiles].row         = x;
   itiles[num_itiles].col         = y;
@@ -87,10 +87,7 @@ void ITileBreak( World_t* world, int row, int col )
 
   int idx = t->col * world->width + t->row;
 
-  world->midground[idx].tile     = 0;
-  world->midground[idx].glyph    = ".";
-  world->midground[idx].glyph_fg = (aColor_t){ 0x39, 0x4a, 0x50, 255 };
-  world->midground[idx].solid    = 0;
+  WorldSetMidground( world, idx, TILE_FLOOR );
 
   t->active = 0;
 }
@@ -108,9 +105,7 @@ void ITileReveal( World_t* world, int row, int col )
   t->revealed = 1;
 
   int idx = t->col * world->width + t->row;
-  world->midground[idx].glyph    = "#";
-  world->midground[idx].glyph_fg = (aColor_t){ 0xc0, 0x94, 0x73, 255 };
-  world->background[idx].solid   = 0;
+  WorldSetMidground( world, idx, TILE_CRACKED_WALL );
 }
 
 int ITileIsRevealedHiddenWall( int row, int col )
@@ -132,15 +127,8 @@ void ITileOpenHiddenWall( World_t* world, int row, int col )
 
   int idx = t->col * world->width + t->row;
 
-  world->midground[idx].tile     = TILE_EMPTY;
-  world->midground[idx].glyph    = "";
-  world->midground[idx].glyph_fg = (aColor_t){ 0, 0, 0, 0 };
-  world->midground[idx].solid    = 0;
-
-  world->background[idx].tile     = 0;
-  world->background[idx].glyph    = ".";
-  world->background[idx].glyph_fg = (aColor_t){ 0x39, 0x4a, 0x50, 255 };
-  world->background[idx].solid    = 0;
+  WorldSetMidground( world, idx, TILE_EMPTY );
+  WorldSetBackground( world, idx, TILE_FLOOR );
 
   t->active = 0;
 }
@@ -151,7 +139,7 @@ int ITileWebCheck( World_t* world, int row, int col, int* out_gold )
   if ( !t || t->type != ITILE_SPIDER_WEB || t->cooldown > 0 ) return 0;
 
   player.root_turns = WEB_ROOT_TURNS;
-  a_AudioPlaySound( &sfx_web_hit, NULL );
+  SoundBankPlay( sfx_web_hit, NULL );
 
   *out_gold = 0;
   if ( t->gold > 0 )
@@ -204,7 +192,7 @@ int ITileCrateCheck( World_t* world, int row, int col, int* out_gold )
   ITile_t* t = ITileAt( row, col );
   if ( !t || t->type != ITILE_OLD_CRATE ) return 0;
 
-  a_AudioPlaySound( &sfx_web_hit, NULL );
+  SoundBankPlay( sfx_web_hit, NULL );
   *out_gold = t->gold;
   t->gold = 0;
   ITileBreak( world, row, col );
@@ -240,7 +228,7 @@ int ITileUrnCheck( World_t* world, int row, int col, int* out_gold )
   ITile_t* t = ITileAt( row, col );
   if ( !t || t->type != ITILE_URN ) return 0;
 
-  a_AudioPlaySound( &sfx_web_hit, NULL );
+  SoundBankPlay( sfx_web_hit, NULL );
   *out_gold = t->gold;
   t->gold = 0;
   ITileBreak( world, row, col );
@@ -277,7 +265,7 @@ int ITileVoidPortalCheck( World_t* world, int row, int col,
   ITile_t* t = ITileAt( row, col );
   if ( !t || t->type != ITILE_VOID_PORTAL ) return 0;
 
-  a_AudioPlaySound( &sfx_web_hit, NULL );
+  SoundBankPlay( sfx_web_hit, NULL );
   *out_gold   = t->gold;
   *out_horror = t->horror_type;
   t->gold = 0;
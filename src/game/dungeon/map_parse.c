@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include "map_parse.h"
+
+typedef struct
+{
+  const char* p;
+  const char* end;
+  int         line;     /* file line of the last line handed out */
+} MapCursor_t;
+
+typedef struct
+{
+  const char* s;
+  int         len;
+} MapRow_t;
+
+int MapCharToRoomId( char c )
+{
+  if ( c >= '0' && c <= '9' ) return c - '0';
+  switch ( c )
+  {
+    case '!': return 10;  case '@': return 11;  case '~': return 12;
+    case '$': return 13;  case '%': return 14;  case '^': return 15;
+    case '&': return 16;  case '*': return 17;  case '(': return 18;
+    case ')': return 19;  case '[': return 20;  case ']': return 21;
+    case '{': return 22;  case '}': return 23;  case '-': return 24;
+    case '_': return 25;  case '+': return 26;  case '=': return 27;
+    case '\\': return 28; case '|': return 29; case ';': return 30;
+    case ':': return 31;
+    default:
+      if ( c >= 'a' && c <= 'z' ) return 32 + ( c - 'a' );
+      return MAP_ROOM_NONE;
+  }
+}
+
+char MapRoomIdToChar( int id )
+{
+  if ( id >= 0 && id <= 9 ) return '0' + id;
+  static const char lut[] = "!@~$%^&*()[]{}-_+=\\|;:";
+  if ( id >= 10 && id <= 31 ) return lut[id - 10];
+  if ( id >= 32 && id <= 57 ) return 'a' + ( id - 32 );
+  return '.';
+}
+
+static int mp_IsDoor( char c )  { return c == 'B' || c == 'G' || c == 'R' || c == 'W'; }
+static int mp_IsITile( char c ) { return c == 'H' || c == 'S' || c == '?'; }
+
+static int mp_Valid( char c )
+{
+  return c == '#' || c == '.' || mp_IsDoor( c ) || mp_IsITile( c )
+      || MapCharToRoomId( c ) != MAP_ROOM_NONE;
+}
+
+static void mp_Error( MapParseError_t* err, int line, int column, const char* fmt, ... )
+{
+  if ( !err ) return;
+
+  err->line   = line;
+  err->column = column;
+
+  va_list args;
+  va_start( args, fmt );
+  vsnprintf( err->message, sizeof( err->message ), fmt, args );
+  va_end( args );
+}
+
+/* Next line without its newline, or 0 at the end. The buffer need not be
+   NUL-terminated, so everything is bounded by end. */
+static int mp_NextLine( MapCursor_t* c, MapRow_t* out )
+{
+  if ( c->p >= c->end ) return 0;
+
+  const char* s  = c->p;
+  const char* nl = memchr( s, '\n', (size_t)( c->end - s ) );
+  const char* e  = nl ? nl : c->end;
+
+  c->p = nl ? nl + 1 : c->end;
+  c->line++;
+
+  while ( e > s && e[-1] == '\r' ) e--;
+  out->s   = s;
+  out->len = (int)( e - s );
+  return 1;
+}
+
+static int mp_IsComment( const MapRow_t* r )
+{
+  return r->len >= 2 && r->s[0] == '/' && r->s[1] == '/';
+}
+
+/* Next map row, skipping comments. Past the end of the file rows are
+   empty, which reads as walls. */
+static void mp_NextRow( MapCursor_t* c, MapRow_t* out )
+{
+  while ( mp_NextLine( c, out ) )
+    if ( !mp_IsComment( out ) ) return;
+
+  out->s   = "";
+  out->len = 0;
+}
+
+static char mp_At( const MapRow_t* r, int x )
+{
+  return ( x < r->len ) ? r->s[x] : '#';
+}
+
+int MapParse( const char* data, size_t size,
+              const MapParseFns_t* fns, void* user, MapParseError_t* err )
+{
+  if ( err ) memset( err, 0, sizeof( MapParseError_t ) );
+
+  /* Pass 1 - size the map and reject anything we don't understand before
+     a single cell goes out */
+  MapCursor_t c = { data, data + size, 0 };
+  MapRow_t    r;
+  int hdr_w = 0, hdr_h = 0, hdr_line = 0;
+  int rows = 0, last_row = 0, max_len = 0;
+
+  while ( mp_NextLine( &c, &r ) )
+  {
+    if ( mp_IsComment( &r ) )
+    {
+      if ( hdr_line == 0 && rows == 0 )
+      {
+        char hdr[32];
+        int  n = r.len - 2 < (int)sizeof( hdr ) - 1 ? r.len - 2 : (int)sizeof( hdr ) - 1;
+        memcpy( hdr, r.s + 2, n );
+        hdr[n] = '\0';
+        if ( sscanf( hdr, "%d %d", &hdr_w, &hdr_h ) == 2 ) hdr_line = c.line;
+        else hdr_w = hdr_h = 0;
+      }
+      continue;
+    }
+
+    for ( int x = 0; x < r.len; x++ )
+    {
+      if ( mp_Valid( r.s[x] ) ) continue;
+      if ( (unsigned char)r.s[x] >= 0x20 && (unsigned char)r.s[x] < 0x7f )
+        mp_Error( err, c.line, x + 1, "unknown map character '%c'", r.s[x] );
+      else
+        mp_Error( err, c.line, x + 1, "unknown map character 0x%02x",
+                  (unsigned char)r.s[x] );
+      return 0;
+    }
+
+    rows++;
+    if ( r.len > 0 ) last_row = rows;     /* trailing blank lines aren't rows */
+    if ( r.len > max_len ) max_len = r.len;
+  }
+
+  int width  = max_len;
+  int height = last_row;
+  if ( hdr_w > 0 && hdr_h > 0 )
+  {
+    if ( hdr_w != max_len || hdr_h != last_row )
+      fprintf( stderr, "MapParse: line %d: header says %dx%d, rows are %dx%d\n",
+               hdr_line, hdr_w, hdr_h, max_len, last_row );
+    width  = hdr_w;
+    height = hdr_h;
+  }
+
+  if ( width <= 0 || height <= 0 )
+  {
+    mp_Error( err, c.line, 0, "map has no rows" );
+    return 0;
+  }
+
+  if ( fns->size && !fns->size( width, height, user ) )
+  {
+    mp_Error( err, hdr_line, 0, "%dx%d map rejected", width, height );
+    return 0;
+  }
+
+  /* Pass 2 - emit cells, keeping only the rows above and below in view
+     for door orientation */
+  MapCursor_t c2 = { data, data + size, 0 };
+  MapRow_t prev = { "", 0 }, cur, next;
+  mp_NextRow( &c2, &cur );
+  mp_NextRow( &c2, &next );
+
+  for ( int y = 0; y < height; y++ )
+  {
+    for ( int x = 0; x < width; x++ )
+    {
+      char ch = mp_At( &cur, x );
+
+      if ( ch == '#' )
+      {
+        if ( fns->wall ) fns->wall( x, y, user );
+      }
+      else if ( mp_IsDoor( ch ) )
+      {
+        /* Walls above & below = vertical door; walls left & right = horizontal */
+        int vert = ( y > 0 && y < height - 1
+                     && mp_At( &prev, x ) == '#' && mp_At( &next, x ) == '#' );
+        if ( fns->door ) fns->door( x, y, ch, vert, user );
+      }
+      else if ( mp_IsITile( ch ) )
+      {
+        if ( fns->itile ) fns->itile( x, y, ch, user );
+      }
+      else if ( fns->floor )
+      {
+        fns->floor( x, y, MapCharToRoomId( ch ), user );
+      }
+    }
+
+    prev = cur;
+    cur  = next;
+    mp_NextRow( &c2, &next );
+  }
+
+  return 1;
+}
+
+int MapParseFile( const char* path,
+                  const MapParseFns_t* fns, void* user, MapParseError_t* err )
+{
+  FILE* fp = fopen( path, "rb" );
+  if ( !fp )
+  {
+    mp_Error( err, 0, 0, "cannot open '%s'", path );
+    return 0;
+  }
+
+  fseek( fp, 0, SEEK_END );
+  long size = ftell( fp );
+  fseek( fp, 0, SEEK_SET );
+
+  char* buf = ( size > 0 ) ? malloc( size ) : NULL;
+  if ( !buf || fread( buf, 1, size, fp ) != (size_t)size )
+  {
+    free( buf );
+    fclose( fp );
+    mp_Error( err, 0, 0, "cannot read '%s'", path );
+    return 0;
+  }
+  fclose( fp );
+
+  int ok = MapParse( buf, (size_t)size, fns, user, err );
+  free( buf );
+  return ok;
+}
@@ -12,23 +12,13 @@ static Console_t* console;
 static ObjectEntry_t objects[MAX_OBJECTS];
 static int num_objects = 0;
 
-static aColor_t object_color( int type )
+static TileType_t object_tile( int type )
 {
   switch ( type )
   {
-    case OBJ_EASEL: return (aColor_t){ 0xc0, 0x94, 0x73, 255 };
-    case OBJ_CHAIR: return (aColor_t){ 0x8b, 0x6d, 0x4a, 255 };
-    default:        return (aColor_t){ 0x81, 0x97, 0x96, 255 };
-  }
-}
-
-static char* object_glyph( int type )
-{
-  switch ( type )
-  {
-    case OBJ_EASEL: return "E";
-    case OBJ_CHAIR: return "h";
-    default:        return "?";
+    case OBJ_EASEL: return TILE_EASEL;
+    case OBJ_CHAIR: return TILE_CHAIR;
+    default:        return TILE_WALL;
   }
 }
 
@@ -52,10 +42,7 @@ void ObjectPlace( World_t* w, int x, int y, int type )
   objects[num_objects++] = (ObjectEntry_t){ x, y, type };
 
   int idx = y * w->width + x;
-  w->background[idx].tile     = 0;  /* floor tile - object sits on floor */
-  w->background[idx].glyph    = object_glyph( type );
-  w->background[idx].glyph_fg = object_color( type );
-  w->background[idx].solid    = 1;
+  WorldSetBackground( w, idx, object_tile( type ) );  /* drawn on the floor sprite */
 }
 
 int ObjectIsObject( int x, int y )
@@ -68,7 +55,7 @@ void ObjectDescribe( int x, int y )
   ObjectEntry_t* obj = object_at( x, y );
   if ( !obj ) return;
 
-  aColor_t color = object_color( obj->type );
+  aColor_t color = TILE_DEF( object_tile( obj->type ) )->fg;
   switch ( obj->type )
   {
     case OBJ_EASEL:
@@ -1,37 +1,37 @@
 #include <Daedalus.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
 #include "room_enumerator.h"
 #include "dungeon.h"
+#include "res_pack.h"
 
-static int  room_map[DUNGEON_W * DUNGEON_H];
+static int* room_map = NULL;     /* map_width * map_height, sized per floor */
+static int  room_cap = 0;
 static char room_names[MAX_ROOMS][64];
 static int  map_width;
+static int  map_height;
 
-static int char_to_room_id( char c )
+void RoomEnumeratorInit( int width, int height )
 {
-  if ( c >= '0' && c <= '9' ) return c - '0';
-  switch ( c )
+  int total = width * height;
+  if ( total > room_cap )
   {
-    case '!': return 10;  case '@': return 11;  case '~': return 12;
-    case '$': return 13;  case '%': return 14;  case '^': return 15;
-    case '&': return 16;  case '*': return 17;  case '(': return 18;
-    case ')': return 19;  case '[': return 20;  case ']': return 21;
-    case '{': return 22;  case '}': return 23;  case '-': return 24;
-    case '_': return 25;  case '+': return 26;  case '=': return 27;
-    case '\\': return 28; case '|': return 29; case ';': return 30;
-    case ':': return 31;
-    default:
-      if ( c >= 'a' && c <= 'z' ) return 32 + ( c - 'a' );
-      return ROOM_NONE;
+    int* grown = realloc( room_map, sizeof( int ) * total );
+    if ( !grown )
+    {
+      fprintf( stderr, "RoomEnumeratorInit: out of memory for %dx%d\n",
+               width, height );
+      map_width = map_height = 0;
+      return;
+    }
+    room_map = grown;
+    room_cap = total;
   }
-}
 
-void RoomEnumeratorInit( int width, int height )
-{
-  map_width = width;
-  int total = width * height;
+  map_width  = width;
+  map_height = height;
   for ( int i = 0; i < total; i++ )
     room_map[i] = ROOM_NONE;
 
@@ -41,18 +41,20 @@ void RoomEnumeratorInit( int width, int height )
 
 void RoomSetTile( int x, int y, int room_id )
 {
+  if ( x < 0 || x >= map_width || y < 0 || y >= map_height ) return;
   room_map[y * map_width + x] = room_id;
 }
 
 int RoomAt( int x, int y )
 {
+  if ( x < 0 || x >= map_width || y < 0 || y >= map_height ) return ROOM_NONE;
   return room_map[y * map_width + x];
 }
 
 void RoomLoadData( const char* path )
 {
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( path, &root );
+  dDUFError_t* err = ResParseDUF( path, &root );
 
   if ( err != NULL )
   {
@@ -71,7 +73,7 @@ void RoomLoadData( const char* path )
 
     if ( !rid_node || !rid_node->value_string ) continue;
 
-    int rid = char_to_room_id( rid_node->value_string[0] );
+    int rid = MapCharToRoomId( rid_node->value_string[0] );
     if ( rid == ROOM_NONE || rid >= MAX_ROOMS ) continue;
 
     if ( name && name->value_string )
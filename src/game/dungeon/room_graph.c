@@ -0,0 +1,378 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "room_graph.h"
+#include "room_enumerator.h"
+
+#define RG_NO_ZONE    -1
+#define RG_ADJ_WORDS  ( ROOM_GRAPH_MAX_ZONES / 32 )
+
+typedef struct
+{
+  int ( *blocked )( int r, int c, void* ctx );
+  void*          ctx;
+  const uint8_t* on_route;
+} RoomRouteCtx_t;
+
+static World_t* rg_world = NULL;
+static int      rg_valid = 0;
+static int      rg_announce = 0;
+static uint32_t rg_rev;
+
+/* Per cell, sized with the largest floor */
+static int16_t* rg_zone  = NULL;    /* RG_NO_ZONE on blocked tiles */
+static int*     rg_stack = NULL;    /* flood fill scratch */
+static int      rg_cap   = 0;
+
+static int      rg_num_zones;
+static int      rg_overflow;        /* too many zones - plain A* everywhere */
+static uint32_t rg_adj[ROOM_GRAPH_MAX_ZONES][RG_ADJ_WORDS];
+static int16_t  rg_comp[ROOM_GRAPH_MAX_ZONES];
+static RoomGraphScratch_t rg_shared;  /* RoomGraphPath's, main thread */
+static int      rg_hops_from;       /* zone rg_hops was measured from */
+static int16_t  rg_hops[ROOM_GRAPH_MAX_ZONES];
+
+void RoomGraphInit( World_t* world )
+{
+  rg_world    = world;
+  rg_valid    = 0;
+  rg_announce = 1;
+}
+
+void RoomGraphInvalidate( void )
+{
+  rg_valid = 0;
+}
+
+static int rg_Reserve( int total )
+{
+  if ( total <= rg_cap ) return 1;
+
+  int16_t* z = realloc( rg_zone, total * sizeof( int16_t ) );
+  if ( z ) rg_zone = z;
+  int*     s = realloc( rg_stack, total * sizeof( int ) );
+  if ( s ) rg_stack = s;
+
+  if ( !z || !s ) return 0;
+  rg_cap = total;
+  return 1;
+}
+
+/* Flood one zone out from seed - same room id, nothing solid */
+static void rg_Fill( int seed, int zone )
+{
+  static const int dx[] = { -1, 1, 0, 0 };
+  static const int dy[] = { 0, 0, -1, 1 };
+
+  int w    = rg_world->width;
+  int h    = rg_world->height;
+  int room = RoomAt( seed % w, seed / w );
+  int top  = 0;
+
+  rg_zone[seed] = (int16_t)zone;
+  rg_stack[top++] = seed;
+
+  while ( top > 0 )
+  {
+    int i = rg_stack[--top];
+    int x = i % w;
+    int y = i / w;
+
+    for ( int d = 0; d < 4; d++ )
+    {
+      int nx = x + dx[d];
+      int ny = y + dy[d];
+      if ( nx < 0 || nx >= w || ny < 0 || ny >= h ) continue;
+
+      int n = ny * w + nx;
+      if ( rg_zone[n] != RG_NO_ZONE )             continue;
+      if ( WORLD_BLOCKS_MOVE( rg_world, n ) )    continue;
+      if ( RoomAt( nx, ny ) != room )            continue;
+
+      rg_zone[n] = (int16_t)zone;
+      rg_stack[top++] = n;
+    }
+  }
+}
+
+static void rg_Link( int a, int b )
+{
+  rg_adj[a][b >> 5] |= 1u << ( b & 31 );
+  rg_adj[b][a >> 5] |= 1u << ( a & 31 );
+}
+
+/* Visit every zone linked to z */
+#define RG_FOR_EACH_LINK( z, n )                                          \
+  for ( int n##_w = 0; n##_w < RG_ADJ_WORDS; n##_w++ )                    \
+    for ( uint32_t n##_b = rg_adj[(z)][n##_w], n = n##_w * 32;            \
+          n##_b; n##_b >>= 1, n++ )                                       \
+      if ( n##_b & 1u )
+
+static void rg_Components( void )
+{
+  int16_t queue[ROOM_GRAPH_MAX_ZONES];
+
+  for ( int z = 0; z < rg_num_zones; z++ ) rg_comp[z] = -1;
+
+  for ( int z = 0; z < rg_num_zones; z++ )
+  {
+    if ( rg_comp[z] >= 0 ) continue;
+
+    int head = 0, tail = 0;
+    rg_comp[z] = (int16_t)z;
+    queue[tail++] = (int16_t)z;
+    while ( head < tail )
+    {
+      int cur = queue[head++];
+      RG_FOR_EACH_LINK( cur, n )
+      {
+        if ( rg_comp[n] >= 0 ) continue;
+        rg_comp[n] = (int16_t)z;
+        queue[tail++] = (int16_t)n;
+      }
+    }
+  }
+}
+
+static void rg_Build( void )
+{
+  World_t* w = rg_world;
+
+  rg_valid     = 1;
+  rg_rev       = w->move_rev;
+  rg_num_zones = 0;
+  rg_overflow  = 0;
+  rg_hops_from = RG_NO_ZONE;
+
+  if ( !rg_Reserve( w->tile_count ) )
+  {
+    printf( "ROOMGRAPH: out of memory, pathing without it\n" );
+    rg_overflow = 1;
+    return;
+  }
+
+  for ( int i = 0; i < w->tile_count; i++ ) rg_zone[i] = RG_NO_ZONE;
+  memset( rg_adj, 0, sizeof( rg_adj ) );
+
+  for ( int i = 0; i < w->tile_count; i++ )
+  {
+    if ( rg_zone[i] != RG_NO_ZONE || WORLD_BLOCKS_MOVE( w, i ) ) continue;
+    if ( rg_num_zones >= ROOM_GRAPH_MAX_ZONES )
+    {
+      printf( "ROOMGRAPH: more than %d zones, pathing without it\n",
+              ROOM_GRAPH_MAX_ZONES );
+      rg_overflow = 1;
+      return;
+    }
+    rg_Fill( i, rg_num_zones++ );
+  }
+
+  /* Zones touch wherever two open tiles of different zones are adjacent -
+     an open door, a gap between a room and its corridor */
+  for ( int y = 0; y < w->height; y++ )
+  {
+    for ( int x = 0; x < w->width; x++ )
+    {
+      int a = rg_zone[y * w->width + x];
+      if ( a == RG_NO_ZONE ) continue;
+
+      int r = ( x + 1 < w->width )  ? rg_zone[y * w->width + x + 1]   : RG_NO_ZONE;
+      int d = ( y + 1 < w->height ) ? rg_zone[( y + 1 ) * w->width + x] : RG_NO_ZONE;
+      if ( r != RG_NO_ZONE && r != a ) rg_Link( a, r );
+      if ( d != RG_NO_ZONE && d != a ) rg_Link( a, d );
+    }
+  }
+
+  rg_Components();
+
+  if ( rg_announce )
+  {
+    printf( "ROOMGRAPH: %d zones\n", rg_num_zones );
+    rg_announce = 0;
+  }
+}
+
+static int rg_Ready( void )
+{
+  if ( !rg_world ) return 0;
+  if ( !rg_valid || rg_rev != rg_world->move_rev ) rg_Build();
+  return !rg_overflow;
+}
+
+static int rg_ZoneAt( int r, int c )
+{
+  if ( r < 0 || r >= rg_world->width || c < 0 || c >= rg_world->height )
+    return RG_NO_ZONE;
+  return rg_zone[c * rg_world->width + r];
+}
+
+/* Zones a goal can be reached from - its own, or if it is solid, those
+   of its open neighbours */
+static int rg_GoalZones( int r, int c, int out[4] )
+{
+  int z = rg_ZoneAt( r, c );
+  if ( z != RG_NO_ZONE )
+  {
+    out[0] = z;
+    return 1;
+  }
+
+  static const int dx[] = { -1, 1, 0, 0 };
+  static const int dy[] = { 0, 0, -1, 1 };
+  int n = 0;
+  for ( int d = 0; d < 4; d++ )
+  {
+    int nz = rg_ZoneAt( r + dx[d], c + dy[d] );
+    if ( nz != RG_NO_ZONE ) out[n++] = nz;
+  }
+  return n;
+}
+
+static int rg_SameComponent( int from, const int* goals, int num_goals )
+{
+  for ( int i = 0; i < num_goals; i++ )
+    if ( rg_comp[goals[i]] == rg_comp[from] ) return 1;
+  return 0;
+}
+
+/* Fewest-zones route from one zone to any goal zone, marked in
+   on_route. Breadth-first - the graph is a few dozen nodes. */
+static int rg_Route( int from, const int* goals, int num_goals,
+                     uint8_t* on_route )
+{
+  int16_t parent[ROOM_GRAPH_MAX_ZONES];
+  int16_t queue[ROOM_GRAPH_MAX_ZONES];
+  int     head = 0, tail = 0, found = RG_NO_ZONE;
+
+  for ( int z = 0; z < rg_num_zones; z++ ) parent[z] = -2;
+  memset( on_route, 0, ROOM_GRAPH_MAX_ZONES );
+
+  parent[from] = RG_NO_ZONE;
+  queue[tail++] = (int16_t)from;
+
+  while ( head < tail && found == RG_NO_ZONE )
+  {
+    int cur = queue[head++];
+    for ( int i = 0; i < num_goals; i++ )
+      if ( goals[i] == cur ) found = cur;
+    if ( found != RG_NO_ZONE ) break;
+
+    RG_FOR_EACH_LINK( cur, n )
+    {
+      if ( parent[n] != -2 ) continue;
+      parent[n] = (int16_t)cur;
+      queue[tail++] = (int16_t)n;
+    }
+  }
+
+  if ( found == RG_NO_ZONE ) return 0;
+  for ( int z = found; z != RG_NO_ZONE; z = parent[z] )
+    on_route[z] = 1;
+  return 1;
+}
+
+int RoomGraphReachable( int start_r, int start_c, int goal_r, int goal_c )
+{
+  if ( !rg_Ready() ) return 1;
+
+  int from = rg_ZoneAt( start_r, start_c );
+  if ( from == RG_NO_ZONE ) return 1;   /* standing in a wall - let A* judge */
+
+  int goals[4];
+  int num_goals = rg_GoalZones( goal_r, goal_c, goals );
+  return rg_SameComponent( from, goals, num_goals );
+}
+
+static void rg_MeasureHops( int from )
+{
+  int16_t queue[ROOM_GRAPH_MAX_ZONES];
+  int     head = 0, tail = 0;
+
+  for ( int z = 0; z < rg_num_zones; z++ ) rg_hops[z] = -1;
+  rg_hops[from] = 0;
+  queue[tail++] = (int16_t)from;
+
+  while ( head < tail )
+  {
+    int cur = queue[head++];
+    RG_FOR_EACH_LINK( cur, n )
+    {
+      if ( rg_hops[n] >= 0 ) continue;
+      rg_hops[n] = rg_hops[cur] + 1;
+      queue[tail++] = (int16_t)n;
+    }
+  }
+  rg_hops_from = from;
+}
+
+int RoomGraphHops( int from_r, int from_c, int r, int c )
+{
+  if ( !rg_Ready() ) return 0;
+
+  int from = rg_ZoneAt( from_r, from_c );
+  int to   = rg_ZoneAt( r, c );
+  if ( from == RG_NO_ZONE || to == RG_NO_ZONE ) return 0;
+
+  if ( from != rg_hops_from ) rg_MeasureHops( from );
+  return rg_hops[to];
+}
+
+/* Off-route zones are walls as far as the search is concerned */
+static int rg_RouteBlocked( int r, int c, void* ctx )
+{
+  RoomRouteCtx_t* p = ctx;
+  int z = rg_zone[c * rg_world->width + r];
+  if ( z != RG_NO_ZONE && !p->on_route[z] ) return 1;
+  return p->blocked( r, c, p->ctx );
+}
+
+void RoomGraphPrepare( void )
+{
+  rg_Ready();
+}
+
+void RoomGraphScratchFree( RoomGraphScratch_t* s )
+{
+  PathScratchFree( &s->path );
+}
+
+int RoomGraphPath( int start_r, int start_c, int goal_r, int goal_c,
+                   int (*blocked)( int r, int c, void* ctx ), void* ctx,
+                   PathLimits_t* limits, PathNode_t out[PATH_MAX_LEN] )
+{
+  return RoomGraphPathIn( &rg_shared, start_r, start_c, goal_r, goal_c,
+                          blocked, ctx, limits, out );
+}
+
+int RoomGraphPathIn( RoomGraphScratch_t* s,
+                     int start_r, int start_c, int goal_r, int goal_c,
+                     int (*blocked)( int r, int c, void* ctx ), void* ctx,
+                     PathLimits_t* limits, PathNode_t out[PATH_MAX_LEN] )
+{
+  if ( limits ) limits->partial = 0;
+  if ( !rg_world ) return 0;
+
+  int w = rg_world->width;
+  int h = rg_world->height;
+
+  int from = rg_Ready() ? rg_ZoneAt( start_r, start_c ) : RG_NO_ZONE;
+  if ( from == RG_NO_ZONE )
+    return PathfindAStarIn( &s->path, start_r, start_c, goal_r, goal_c,
+                            w, h, blocked, ctx, limits, out );
+
+  int goals[4];
+  int num_goals = rg_GoalZones( goal_r, goal_c, goals );
+  if ( !rg_SameComponent( from, goals, num_goals ) ) return 0;
+  if ( !rg_Route( from, goals, num_goals, s->on_route ) ) return 0;
+
+  RoomRouteCtx_t route = { blocked, ctx, s->on_route };
+  int len = PathfindAStarIn( &s->path, start_r, start_c, goal_r, goal_c,
+                             w, h, rg_RouteBlocked, &route, limits, out );
+  if ( len > 0 ) return len;
+
+  /* Somebody is standing in a doorway on the planned route - the long
+     way round may still be open */
+  return PathfindAStarIn( &s->path, start_r, start_c, goal_r, goal_c,
+                          w, h, blocked, ctx, limits, out );
+}
@@ -0,0 +1,194 @@
+#include <stdint.h>
+#include <stddef.h>
+
+#include "room_index.h"
+#include "room_enumerator.h"
+
+#define RI_UNFILED  -2      /* dead, or never seen */
+#define RI_END      -1
+
+/* One kind of entity: an intrusive doubly-linked list per room, kept
+   in arrays parallel to the entity list */
+typedef struct
+{
+  int16_t  head[MAX_ROOMS];
+  int16_t* room;
+  int16_t* next;
+  int16_t* prev;
+  int      cap;
+} RoomBucket_t;
+
+static int16_t ri_enemy_room[MAX_ENEMIES], ri_enemy_next[MAX_ENEMIES],
+               ri_enemy_prev[MAX_ENEMIES];
+static int16_t ri_npc_room[MAX_NPCS], ri_npc_next[MAX_NPCS],
+               ri_npc_prev[MAX_NPCS];
+static int16_t ri_item_room[MAX_GROUND_ITEMS], ri_item_next[MAX_GROUND_ITEMS],
+               ri_item_prev[MAX_GROUND_ITEMS];
+
+static RoomBucket_t ri_enemy = { { 0 }, ri_enemy_room, ri_enemy_next,
+                                 ri_enemy_prev, MAX_ENEMIES };
+static RoomBucket_t ri_npc   = { { 0 }, ri_npc_room, ri_npc_next,
+                                 ri_npc_prev, MAX_NPCS };
+static RoomBucket_t ri_item  = { { 0 }, ri_item_room, ri_item_next,
+                                 ri_item_prev, MAX_GROUND_ITEMS };
+
+static Enemy_t*      ri_enemies = NULL;
+static int*          ri_num_enemies = NULL;
+static NPC_t*        ri_npcs = NULL;
+static int*          ri_num_npcs = NULL;
+static GroundItem_t* ri_items = NULL;
+static int*          ri_num_items = NULL;
+
+static int     ri_ready = 0;
+static uint8_t ri_chasing[MAX_ENEMIES];
+static int     ri_num_chasing = 0;
+
+static void ri_Clear( RoomBucket_t* b )
+{
+  for ( int r = 0; r < MAX_ROOMS; r++ ) b->head[r] = RI_END;
+  for ( int i = 0; i < b->cap; i++ )
+  {
+    b->room[i] = RI_UNFILED;
+    b->next[i] = b->prev[i] = RI_END;
+  }
+}
+
+static void ri_Unlink( RoomBucket_t* b, int i )
+{
+  int room = b->room[i];
+  if ( room >= 0 && room < MAX_ROOMS )
+  {
+    if ( b->prev[i] != RI_END ) b->next[b->prev[i]] = b->next[i];
+    else                        b->head[room]      = b->next[i];
+    if ( b->next[i] != RI_END ) b->prev[b->next[i]] = b->prev[i];
+  }
+  b->next[i] = b->prev[i] = RI_END;
+}
+
+/* room is RI_UNFILED for the dead, ROOM_NONE for corridors */
+static void ri_File( RoomBucket_t* b, int i, int room )
+{
+  if ( b->room[i] == room ) return;
+
+  ri_Unlink( b, i );
+  b->room[i] = (int16_t)room;
+  if ( room < 0 || room >= MAX_ROOMS ) return;
+
+  b->next[i] = b->head[room];
+  if ( b->head[room] != RI_END ) b->prev[b->head[room]] = (int16_t)i;
+  b->head[room] = (int16_t)i;
+}
+
+static int ri_Slot( const void* base, const void* p, size_t size, int* count )
+{
+  if ( !base || !p || !count ) return -1;
+  const char* b = base;
+  const char* c = p;
+  if ( c < b ) return -1;
+
+  ptrdiff_t i = ( c - b ) / (ptrdiff_t)size;
+  return ( i < *count ) ? (int)i : -1;
+}
+
+void RoomIndexSetLists( Enemy_t* enemies, int* num_enemies,
+                        NPC_t* npcs, int* num_npcs,
+                        GroundItem_t* items, int* num_items )
+{
+  ri_enemies = enemies;  ri_num_enemies = num_enemies;
+  ri_npcs    = npcs;     ri_num_npcs    = num_npcs;
+  ri_items   = items;    ri_num_items   = num_items;
+  RoomIndexRebuild();
+}
+
+void RoomIndexRebuild( void )
+{
+  ri_Clear( &ri_enemy );
+  ri_Clear( &ri_npc );
+  ri_Clear( &ri_item );
+  ri_ready = 1;
+  for ( int i = 0; i < MAX_ENEMIES; i++ ) ri_chasing[i] = 0;
+  ri_num_chasing = 0;
+
+  for ( int i = 0; ri_num_enemies && i < *ri_num_enemies; i++ )
+    RoomIndexEnemy( &ri_enemies[i] );
+  for ( int i = 0; ri_num_npcs && i < *ri_num_npcs; i++ )
+    RoomIndexNPC( &ri_npcs[i] );
+  for ( int i = 0; ri_num_items && i < *ri_num_items; i++ )
+    RoomIndexItem( &ri_items[i] );
+}
+
+void RoomIndexEnemy( Enemy_t* e )
+{
+  int i = ri_Slot( ri_enemies, e, sizeof( Enemy_t ), ri_num_enemies );
+  if ( i < 0 ) return;
+
+  ri_File( &ri_enemy, i, e->alive ? RoomAt( e->row, e->col ) : RI_UNFILED );
+
+  int chasing = e->alive && e->chase_turns > 0;
+  if ( chasing != ri_chasing[i] )
+  {
+    ri_chasing[i] = (uint8_t)chasing;
+    ri_num_chasing += chasing ? 1 : -1;
+  }
+}
+
+void RoomIndexNPC( NPC_t* n )
+{
+  int i = ri_Slot( ri_npcs, n, sizeof( NPC_t ), ri_num_npcs );
+  if ( i < 0 ) return;
+  ri_File( &ri_npc, i, n->alive ? RoomAt( n->row, n->col ) : RI_UNFILED );
+}
+
+void RoomIndexItem( GroundItem_t* g )
+{
+  int i = ri_Slot( ri_items, g, sizeof( GroundItem_t ), ri_num_items );
+  if ( i < 0 ) return;
+  ri_File( &ri_item, i, g->alive ? RoomAt( g->row, g->col ) : RI_UNFILED );
+}
+
+static int ri_Head( RoomBucket_t* b, int room )
+{
+  if ( !ri_ready || room < 0 || room >= MAX_ROOMS ) return RI_END;
+  return b->head[room];
+}
+
+Enemy_t* RoomIndexEnemies( int room )
+{
+  int i = ri_Head( &ri_enemy, room );
+  return ( i != RI_END ) ? &ri_enemies[i] : NULL;
+}
+
+Enemy_t* RoomIndexNextEnemy( Enemy_t* e )
+{
+  int i = ri_enemy.next[e - ri_enemies];
+  return ( i != RI_END ) ? &ri_enemies[i] : NULL;
+}
+
+NPC_t* RoomIndexNPCs( int room )
+{
+  int i = ri_Head( &ri_npc, room );
+  return ( i != RI_END ) ? &ri_npcs[i] : NULL;
+}
+
+NPC_t* RoomIndexNextNPC( NPC_t* n )
+{
+  int i = ri_npc.next[n - ri_npcs];
+  return ( i != RI_END ) ? &ri_npcs[i] : NULL;
+}
+
+GroundItem_t* RoomIndexItems( int room )
+{
+  int i = ri_Head( &ri_item, room );
+  return ( i != RI_END ) ? &ri_items[i] : NULL;
+}
+
+GroundItem_t* RoomIndexNextItem( GroundItem_t* g )
+{
+  int i = ri_item.next[g - ri_items];
+  return ( i != RI_END ) ? &ri_items[i] : NULL;
+}
+
+int RoomIndexChasing( Enemy_t* list )
+{
+  return ( list && list == ri_enemies ) ? ri_num_chasing : -1;
+}
@@ -4,6 +4,7 @@
 #include <Daedalus.h>
 
 #include "spawn_data.h"
+#include "res_pack.h"
 
 static const char* type_strings[SPAWN_TYPE_COUNT] =
 {
@@ -29,7 +30,7 @@ static void SafeCopy( char* dst, const char* src, int n )
 int SpawnDUFLoad( const char* path, SpawnList_t* list )
 {
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( path, &root );
+  dDUFError_t* err = ResParseDUF( path, &root );
 
   if ( err != NULL )
   {
@@ -1,3 +1,4 @@
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <Archimedes.h>
@@ -9,23 +10,33 @@
 #include "combat.h"
 #include "combat_vfx.h"
 #include "world.h"
-#include "tween.h"
+#include "turn_timeline.h"
+#include "turn_scheduler.h"
 #include "placed_traps.h"
 #include "dev_mode.h"
+#include "room_graph.h"
+#include "room_index.h"
+#include "visibility.h"
+#include "worker_pool.h"
 
 static World_t* world = NULL;
 static NPC_t*   npc_list  = NULL;
 static int*     npc_count = NULL;
-static TweenManager_t tweens;
 
 /* Stored enemy list for mid-turn spawning (shaman totem) */
 static Enemy_t* stored_list  = NULL;
 static int*     stored_count = NULL;
 
-/* Turn state machine */
+/* Turn state machine - every actor's move plays at once, then every
+   attack, on the shared turn timeline */
 #define TURN_IDLE     0
-#define TURN_MOVING   1   /* one enemy moving at a time */
-#define TURN_ATTACK   2   /* one enemy lunging at a time */
+#define TURN_MOVING   1
+#define TURN_ATTACK   2
+
+#define TURN_LUNGE_DIST  3.0f
+
+/* Queue ids past the enemies are NPCs */
+#define TURN_ACTOR_NPC   MAX_ENEMIES
 
 static int turn_state = TURN_IDLE;
 
@@ -33,15 +44,30 @@ static int turn_state = TURN_IDLE;
 static Enemy_t* turn_list  = NULL;
 static int      turn_count = 0;
 static int      turn_pr, turn_pc;
-static int      was_adjacent[MAX_ENEMIES]; /* adjacent before moving */
-static int      did_move[MAX_ENEMIES];     /* moved this turn */
-static int      move_idx;                  /* current enemy being processed */
+static int      strikes[MAX_ENEMIES];      /* actions begun next to the player */
 static int (*turn_walkable)(int,int);
+static int      turn_serial;               /* enemy turns started, for sleepers */
+
+/* STRESS builds always check the threaded plans against serial ones */
+#if defined( STRESS_ENEMIES ) && !defined( ENEMY_DECIDE_CHECK )
+#define ENEMY_DECIDE_CHECK
+#endif
+
+/* Decide phase - chasers' first moves, planned up front from where
+   everyone stands when the turn starts */
+static int16_t            decide_slots[MAX_ENEMIES];
+static int                decide_count;
+static PathNode_t         decide_from[MAX_ENEMIES];  /* by slot */
+static Enemy_t            decide_plan[MAX_ENEMIES];  /* by slot */
+static uint8_t            decide_ready[MAX_ENEMIES]; /* plan not applied yet */
+static RoomGraphScratch_t decide_scratch[WORKER_POOL_MAX];
+#ifdef ENEMY_DECIDE_CHECK
+static Enemy_t            decide_check[MAX_ENEMIES];
+#endif
 
 void EnemiesSetWorld( World_t* w )
 {
   world = w;
-  InitTweenManager( &tweens );
   turn_state = TURN_IDLE;
 }
 
@@ -57,10 +83,11 @@ void EnemiesSetList( Enemy_t* list, int* count )
   stored_count = count;
 }
 
-int EnemyShamanSpawnTotem( int row, int col, int (*walkable)(int,int),
+int EnemyShamanSpawnTotem( Enemy_t* shaman, int (*walkable)(int,int),
                            Enemy_t* all, int count )
 {
   if ( !stored_list || !stored_count || !world ) return -1;
+  int row = shaman->row, col = shaman->col;
 
   int ti = EnemyTypeByKey( "war_totem" );
   if ( ti < 0 ) return -1;
@@ -76,8 +103,8 @@ int EnemyShamanSpawnTotem( int row, int col, int (*walkable)(int,int),
     if ( EnemyAt( all, count, nr, nc ) ) continue;
     if ( EnemyBlockedByNPC( nr, nc ) ) continue;
 
-    Enemy_t* totem = EnemySpawn( stored_list, stored_count, ti,
-                                  nr, nc, world->tile_w, world->tile_h );
+    Enemy_t* totem = EnemySpawnChild( stored_list, stored_count, shaman, ti,
+                                       nr, nc, world->tile_w, world->tile_h );
     if ( totem )
     {
       CombatVFXSpawnText( totem->world_x, totem->world_y,
@@ -88,7 +115,8 @@ int EnemyShamanSpawnTotem( int row, int col, int (*walkable)(int,int),
   return -1;
 }
 
-int EnemyHorrorSpawnBaby( int row, int col, int (*walkable)(int,int),
+int EnemyHorrorSpawnBaby( Enemy_t* horror, int row, int col,
+                          int (*walkable)(int,int),
                           Enemy_t* all, int count )
 {
   if ( !stored_list || !stored_count || !world ) return -1;
@@ -106,8 +134,8 @@ int EnemyHorrorSpawnBaby( int row, int col, int (*walkable)(int,int),
     if ( EnemyAt( all, count, nr, nc ) ) continue;
     if ( EnemyBlockedByNPC( nr, nc ) ) continue;
 
-    Enemy_t* baby = EnemySpawn( stored_list, stored_count, ti,
-                                 nr, nc, world->tile_w, world->tile_h );
+    Enemy_t* baby = EnemySpawnChild( stored_list, stored_count, horror, ti,
+                                      nr, nc, world->tile_w, world->tile_h );
     if ( baby )
     {
       CombatVFXSpawnText( baby->world_x, baby->world_y,
@@ -132,6 +160,7 @@ void EnemyBossGretaSpawn( int npc_type_idx )
       row = npc_list[i].row;
       col = npc_list[i].col;
       npc_list[i].alive = 0;
+      RoomIndexNPC( &npc_list[i] );
       break;
     }
   }
@@ -169,10 +198,10 @@ void EnemyBossGretaSpawn( int npc_type_idx )
   }
 }
 
-void EnemyOnGretaDeath( int row, int col )
+void EnemySpawnDeathNPC( const char* npc_key, int row, int col )
 {
   if ( !npc_list || !npc_count || !world ) return;
-  int li = NPCTypeByKey( "greta_ledger" );
+  int li = NPCTypeByKey( npc_key );
   if ( li < 0 ) return;
   NPCSpawn( npc_list, npc_count, li, row, col + 1,
             world->tile_w, world->tile_h );
@@ -188,28 +217,143 @@ int EnemyGridW( void ) { return world ? world->width  : 0; }
 int EnemyGridH( void ) { return world ? world->height : 0; }
 int EnemyTileW( void ) { return world ? world->tile_w : 16; }
 int EnemyTileH( void ) { return world ? world->tile_h : 16; }
+uint32_t EnemyMoveRev( void ) { return world ? world->move_rev : 0; }
 
-/* --- Lunge callback data --- */
+/* --- Decide phase: chasers plan on the worker pool --- */
 
-typedef struct
+/* The AIs EnemyBasicAIPlan decides for */
+static int is_chaser( Enemy_t* e )
 {
-  float* target;
-  float  home;
-} LungeBack_t;
+  const char* ai = g_enemy_types[e->type_idx].ai;
+  return strcmp( ai, "basic" ) == 0 || strcmp( ai, "baby_horror" ) == 0;
+}
 
-static LungeBack_t lunge_data[MAX_ENEMIES * 2];
-static int lunge_count = 0;
+/* Stream for this turn - one lowbias32 hash, so neighbouring turns and
+   slots get unrelated streams */
+static uint32_t turn_seed( int slot )
+{
+  uint32_t x = (uint32_t)turn_serial * 0x9e3779b9u
+             ^ (uint32_t)slot * 0x85ebca6bu;
+  x ^= x >> 16;
+  x *= 0x7feb352du;
+  x ^= x >> 15;
+  x *= 0x846ca68bu;
+  x ^= x >> 16;
+  return x ? x : 1;
+}
 
-static void lunge_back_cb( void* data )
+/* One job: plan on a copy, so the list stays the snapshot every other
+   job reads */
+static void decide_job( int job, int worker, void* user )
 {
-  LungeBack_t* lb = (LungeBack_t*)data;
-  TweenFloat( &tweens, lb->target, lb->home, 0.06f, TWEEN_EASE_OUT_CUBIC );
+  Enemy_t* out = user;
+  int      i   = decide_slots[job];
+
+  out[i] = turn_list[i];
+  EnemyBasicAIPlan( &out[i], turn_pr, turn_pc, turn_walkable,
+                    turn_list, turn_count, &decide_scratch[worker] );
 }
 
-/* --- Sequential movement: advance to next enemy --- */
+#ifdef ENEMY_DECIDE_CHECK
+static int decide_same( const Enemy_t* a, const Enemy_t* b )
+{
+  if ( a->row != b->row || a->col != b->col )                 return 0;
+  if ( a->last_seen_row != b->last_seen_row )                 return 0;
+  if ( a->last_seen_col != b->last_seen_col )                 return 0;
+  if ( a->chase_turns != b->chase_turns )                     return 0;
+  if ( a->path.len != b->path.len || a->path.step != b->path.step
+       || a->path.move_rev != b->path.move_rev )              return 0;
+  return memcmp( a->path.node, b->path.node,
+                 (size_t)a->path.len * sizeof( PathNode_t ) ) == 0;
+}
+#endif
+
+static void decide( void )
+{
+  memset( decide_ready, 0, sizeof( decide_ready ) );
+  if ( decide_count == 0 ) return;
+
+  /* Workers only read the graph, so it has to be current first */
+  RoomGraphPrepare();
+
+#ifdef ENEMY_DECIDE_SERIAL
+  int threads = 1;
+#else
+  int threads = WorkerPoolSize();
+#endif
+
+#ifdef STRESS_ENEMIES
+  /* Same plans at every thread count - the last run is the one kept */
+  printf( "ENEMIES: turn %d, %d planned", turn_serial, decide_count );
+  for ( int t = 1; ; t = ( t * 2 < threads ) ? t * 2 : threads )
+  {
+    uint64_t start = SDL_GetPerformanceCounter();
+    WorkerPoolRun( decide_count, decide_job, decide_plan, t );
+    double ms = (double)( SDL_GetPerformanceCounter() - start )
+              * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    printf( ", %d thread(s) %.2f ms", t, ms );
+    if ( t >= threads ) break;
+  }
+  printf( "\n" );
+#else
+  WorkerPoolRun( decide_count, decide_job, decide_plan, threads );
+#endif
 
-static void start_next_move( void );
-static void start_next_attack( void );
+#ifdef ENEMY_DECIDE_CHECK
+  if ( threads > 1 )
+  {
+    WorkerPoolRun( decide_count, decide_job, decide_check, 1 );
+    for ( int k = 0; k < decide_count; k++ )
+    {
+      int i = decide_slots[k];
+      if ( decide_same( &decide_plan[i], &decide_check[i] ) ) continue;
+      printf( "ENEMIES: turn %d, slot %d planned (%d,%d) on %d threads "
+              "but (%d,%d) on one\n", turn_serial, i,
+              decide_plan[i].row, decide_plan[i].col, threads,
+              decide_check[i].row, decide_check[i].col );
+      SDL_assert( !"threaded enemy plan differs from serial" );
+    }
+  }
+#endif
+
+  for ( int k = 0; k < decide_count; k++ )
+    decide_ready[decide_slots[k]] = 1;
+}
+
+/* A chaser's move: its plan if nothing got in the way since, otherwise
+   decided again against where everyone is now. Plans are applied in
+   queue order, so which of two chasers gets a contested tile is the
+   same every run and on any thread count. */
+static void chase_move( int i )
+{
+  Enemy_t* e = &turn_list[i];
+
+  if ( decide_ready[i] )
+  {
+    Enemy_t* p = &decide_plan[i];
+    decide_ready[i] = 0;
+
+    int stayed = ( p->row == e->row && p->col == e->col );
+    if ( e->row == decide_from[i].row && e->col == decide_from[i].col
+         && ( stayed
+              || ( !EnemyMobileAt( turn_list, turn_count, p->row, p->col )
+                   && !EnemyBlockedByNPC( p->row, p->col ) ) ) )
+    {
+      e->row           = p->row;
+      e->col           = p->col;
+      e->last_seen_row = p->last_seen_row;
+      e->last_seen_col = p->last_seen_col;
+      e->chase_turns   = p->chase_turns;
+      e->path          = p->path;
+      return;
+    }
+  }
+
+  EnemyBasicAITick( e, turn_pr, turn_pc, turn_walkable,
+                    turn_list, turn_count );
+}
+
+/* --- Move phase: actors decide in energy order, moves play together --- */
 
 static void tick_and_move( int i )
 {
@@ -242,9 +386,8 @@ static void tick_and_move( int i )
     return;
   }
 
-  if ( strcmp( t->ai, "basic" ) == 0 )
-    EnemyBasicAITick( &turn_list[i], turn_pr, turn_pc,
-                  turn_walkable, turn_list, turn_count );
+  if ( is_chaser( &turn_list[i] ) )
+    chase_move( i );
   else if ( strcmp( t->ai, "ranged_telegraph" ) == 0 )
     EnemySkeletonTick( &turn_list[i], turn_pr, turn_pc,
                        turn_walkable, turn_list, turn_count );
@@ -254,9 +397,6 @@ static void tick_and_move( int i )
   else if ( strcmp( t->ai, "horror" ) == 0 )
     EnemyHorrorTick( &turn_list[i], turn_pr, turn_pc,
                      turn_walkable, turn_list, turn_count );
-  else if ( strcmp( t->ai, "baby_horror" ) == 0 )
-    EnemyBasicAITick( &turn_list[i], turn_pr, turn_pc,
-                      turn_walkable, turn_list, turn_count );
 
   /* Skeleton just fired - spawn arrow projectile */
   if ( old_ai == 1 && turn_list[i].ai_state == 3 )
@@ -273,7 +413,7 @@ static void tick_and_move( int i )
       if ( nr < 0 || nr >= world->width || nc < 0 || nc >= world->height )
         break;
       int idx = nc * world->width + nr;
-      if ( world->background[idx].solid || world->midground[idx].solid )
+      if ( WORLD_BLOCKS_MOVE( world, idx ) )
         break;
       cr = nr;
       cc = nc;
@@ -312,93 +452,31 @@ static void tick_and_move( int i )
 
     float tx = turn_list[i].row * world->tile_w + world->tile_w / 2.0f;
     float ty = turn_list[i].col * world->tile_h + world->tile_h / 2.0f;
-    TweenFloat( &tweens, &turn_list[i].world_x, tx, 0.15f, TWEEN_EASE_OUT_CUBIC );
-    TweenFloat( &tweens, &turn_list[i].world_y, ty, 0.15f, TWEEN_EASE_OUT_CUBIC );
-    did_move[i] = 1;
+    TurnTimelineSlide( &turn_list[i].world_x, &turn_list[i].world_y, tx, ty );
   }
 }
 
-static void start_next_move( void )
-{
-  /* Find next alive enemy to move */
-  while ( move_idx < turn_count )
-  {
-    if ( turn_list[move_idx].alive )
-    {
-      tick_and_move( move_idx );
-      if ( did_move[move_idx] )
-      {
-        /* Tween started - wait for it to finish */
-        turn_state = TURN_MOVING;
-        move_idx++;
-        return;
-      }
-    }
-    move_idx++;
-  }
+/* --- Attack phase: NPC allies strike first, then every adjacent enemy --- */
 
-  /* All enemies processed - begin attack phase */
-  move_idx = 0;
-  start_next_attack();
-}
+static int can_melee( int i )
+{
+  Enemy_t* e = &turn_list[i];
+  if ( !e->alive || e->stun_turns > 0 ) return 0;
 
-/* --- Sequential attacks: one lunge at a time --- */
+  EnemyType_t* at = &g_enemy_types[e->type_idx];
+  if ( at->immobile )  return 0;
+  if ( at->range > 0 ) return 0; /* ranged - no melee */
 
-static void do_attack( int i )
-{
-  int dr = turn_pr - turn_list[i].row;
-  int dc = turn_pc - turn_list[i].col;
-
-  float lunge_dist = 3.0f;
-  lunge_count = 0;
-
-  LungeBack_t* lbx = &lunge_data[lunge_count++];
-  lbx->target = &turn_list[i].world_x;
-  lbx->home   = turn_list[i].world_x;
-  TweenFloatWithCallback( &tweens, &turn_list[i].world_x,
-                          turn_list[i].world_x + dr * lunge_dist,
-                          0.06f, TWEEN_EASE_OUT_QUAD,
-                          lunge_back_cb, lbx );
-
-  LungeBack_t* lby = &lunge_data[lunge_count++];
-  lby->target = &turn_list[i].world_y;
-  lby->home   = turn_list[i].world_y;
-  TweenFloatWithCallback( &tweens, &turn_list[i].world_y,
-                          turn_list[i].world_y + dc * lunge_dist,
-                          0.06f, TWEEN_EASE_OUT_QUAD,
-                          lunge_back_cb, lby );
-
-  CombatEnemyHit( &turn_list[i] );
+  return abs( turn_pr - e->row ) + abs( turn_pc - e->col ) == 1;
 }
 
-static void start_next_attack( void )
+static void end_turn( void )
 {
-  while ( move_idx < turn_count )
-  {
-    if ( turn_list[move_idx].alive && was_adjacent[move_idx]
-         && turn_list[move_idx].stun_turns <= 0 )
-    {
-      EnemyType_t* at = &g_enemy_types[turn_list[move_idx].type_idx];
-      if ( strcmp( at->ai, "static" ) == 0
-           || strcmp( at->ai, "stone_healer" ) == 0
-           || strcmp( at->ai, "stone_ranged" ) == 0 ) { move_idx++; continue; }
-      if ( at->range > 0 ) { move_idx++; continue; } /* ranged - no melee */
-      int dr = abs( turn_pr - turn_list[move_idx].row );
-      int dc = abs( turn_pc - turn_list[move_idx].col );
-      if ( dr + dc == 1 )
-      {
-        do_attack( move_idx );
-        turn_state = TURN_ATTACK;
-        move_idx++;
-        return;
-      }
-    }
-    move_idx++;
-  }
-
-  /* No more attackers - decrement stun/root at end of turn */
+  /* Decrement stun/root at end of turn (sleepers catch up when they
+     wake) */
   for ( int i = 0; i < turn_count; i++ )
   {
+    if ( turn_list[i].dormant ) continue;
     if ( turn_list[i].alive && turn_list[i].stun_turns > 0 )
       turn_list[i].stun_turns--;
     if ( turn_list[i].alive && turn_list[i].root_turns > 0 )
@@ -407,8 +485,97 @@ static void start_next_attack( void )
   turn_state = TURN_IDLE;
 }
 
+static void start_attacks( void )
+{
+  TurnTimelineBegin( TurnPhaseTime( TURN_PHASE_ATTACK ) );
+
+  if ( npc_list && npc_count )
+    NPCsCombatAttack( npc_list, *npc_count, TURN_LUNGE_DIST );
+
+  /* One lunge however many blows - fast enemies land them all at once */
+  for ( int i = 0; i < turn_count; i++ )
+  {
+    if ( strikes[i] == 0 || !can_melee( i ) ) continue;
+
+    TurnTimelineLunge( &turn_list[i].world_x, &turn_list[i].world_y,
+                       turn_pr - turn_list[i].row,
+                       turn_pc - turn_list[i].col, TURN_LUNGE_DIST );
+    for ( int s = 0; s < strikes[i]; s++ )
+      CombatEnemyHit( &turn_list[i] );
+  }
+
+  if ( TurnTimelineCount() > 0 ) turn_state = TURN_ATTACK;
+  else                           end_turn();
+}
+
+/* --- AI level of detail --- */
+
+/* Up to n turns of a damage-over-time effect in one hit. Leaves the
+   killing to the caller unless kill is set. */
+static void apply_dot( Enemy_t* e, int* ticks, int dmg, int n, int kill,
+                       aColor_t color, const char* kill_text )
+{
+  if ( *ticks <= 0 ) return;
+  if ( n > *ticks ) n = *ticks;
+
+  e->hp  -= dmg * n;
+  *ticks -= n;
+  CombatVFXSpawnNumber( e->world_x, e->world_y, dmg * n, color );
+  if ( kill && e->hp <= 0 )
+  {
+    CombatVFXSpawnText( e->world_x, e->world_y, kill_text, color );
+    CombatHandleEnemyDeath( e );
+  }
+}
+
+/* Everything a sleeper would have gone through before enemy turn
+   `turn`, which it will take itself */
+static void wake( Enemy_t* e, int turn, int kill )
+{
+  int missed = turn - e->dormant_since;
+  e->dormant = 0;
+  e->energy  = 0;
+  if ( missed <= 0 ) return;
+
+  apply_dot( e, &e->poison_ticks, e->poison_dmg, missed, kill,
+             (aColor_t){ 0x50, 0xc8, 0x50, 255 }, "Poisoned!" );
+  if ( e->alive )
+    apply_dot( e, &e->burn_ticks, e->burn_dmg, missed, kill,
+               (aColor_t){ 0xff, 0x64, 0x1e, 255 }, "Burned!" );
+
+  e->stun_turns = ( e->stun_turns > missed ) ? e->stun_turns - missed : 0;
+  e->root_turns = ( e->root_turns > missed ) ? e->root_turns - missed : 0;
+}
+
+/* Cheapest tests first - only enemies with nothing to chase and nobody
+   near get as far as the room graph */
+static int wants_turn( Enemy_t* e )
+{
+  if ( e->chase_turns > 0 ) return 1;
+
+  /* Humming stones act on the whole floor, not just around the player */
+  if ( strncmp( g_enemy_types[e->type_idx].ai, "stone_", 6 ) == 0 ) return 1;
+
+  /* +1 - anything the player can step next to before the next enemy
+     turn is already awake */
+  int dist = abs( turn_pr - e->row ) + abs( turn_pc - e->col );
+  if ( dist <= g_enemy_types[e->type_idx].sight_range + 1 ) return 1;
+
+  if ( VisibilityGet( e->row, e->col ) > 0.01f ) return 1;
+
+  int hops = RoomGraphHops( turn_pr, turn_pc, e->row, e->col );
+  if ( hops >= 0 && hops <= ENEMY_WAKE_HOPS ) return 1;
+
+  return e->dormant && turn_serial - e->dormant_since >= ENEMY_WAKE_PERIOD;
+}
+
 /* --- Public API --- */
 
+void EnemyWake( Enemy_t* e )
+{
+  if ( e->dormant ) wake( e, turn_serial + 1, 0 );
+}
+
 void EnemiesStartTurn( Enemy_t* list, int count,
                        int player_row, int player_col,
                        int (*walkable)(int,int) )
@@ -419,52 +586,43 @@ void EnemiesStartTurn( Enemy_t* list, int count,
   turn_pc      = player_col;
   turn_walkable = walkable;
 
-  /* Record which enemies are already adjacent before they move */
-  for ( int i = 0; i < count; i++ )
-  {
-    int dr = abs( player_row - list[i].row );
-    int dc = abs( player_col - list[i].col );
-    was_adjacent[i] = list[i].alive && ( dr + dc == 1 );
-    did_move[i] = 0;
-  }
+  turn_serial++;
+  TurnQueueClear();
+
+  memset( strikes, 0, sizeof( strikes ) );
+  decide_count = 0;
 
-  /* Process status effects before AI runs */
-  for ( int i = 0; i < count; i++ )
+  /* Process status effects before AI runs. Walks the live slots only -
+     a long fight leaves most of the list dead. */
+  int num_live;
+  const int16_t* live = EnemiesLive( list, count, &num_live );
+  for ( int k = 0; k < num_live; k++ )
   {
-    if ( !list[i].alive ) continue;
+    int i = live[k];
+    if ( i >= count || !list[i].alive ) continue;
 
-    /* Poison DOT */
-    if ( list[i].poison_ticks > 0 )
+    if ( !wants_turn( &list[i] ) )
     {
-      list[i].hp -= list[i].poison_dmg;
-      list[i].poison_ticks--;
-      CombatVFXSpawnNumber( list[i].world_x, list[i].world_y,
-                            list[i].poison_dmg,
-                            (aColor_t){ 0x50, 0xc8, 0x50, 255 } );
-      if ( list[i].hp <= 0 )
+      if ( !list[i].dormant )
       {
-        CombatVFXSpawnText( list[i].world_x, list[i].world_y,
-                            "Poisoned!", (aColor_t){ 0x50, 0xc8, 0x50, 255 } );
-        CombatHandleEnemyDeath( &list[i] );
+        list[i].dormant       = 1;
+        list[i].dormant_since = turn_serial;
       }
+      continue;
     }
 
-    /* Burn DOT */
-    if ( list[i].alive && list[i].burn_ticks > 0 )
+    if ( list[i].dormant )
     {
-      list[i].hp -= list[i].burn_dmg;
-      list[i].burn_ticks--;
-      CombatVFXSpawnNumber( list[i].world_x, list[i].world_y,
-                            list[i].burn_dmg,
-                            (aColor_t){ 0xff, 0x64, 0x1e, 255 } );
-      if ( list[i].hp <= 0 )
-      {
-        CombatVFXSpawnText( list[i].world_x, list[i].world_y,
-                            "Burned!", (aColor_t){ 0xff, 0x64, 0x1e, 255 } );
-        CombatHandleEnemyDeath( &list[i] );
-      }
+      wake( &list[i], turn_serial, 1 );
+      if ( !list[i].alive ) continue;
     }
 
+    apply_dot( &list[i], &list[i].poison_ticks, list[i].poison_dmg, 1, 1,
+               (aColor_t){ 0x50, 0xc8, 0x50, 255 }, "Poisoned!" );
+    if ( list[i].alive )
+      apply_dot( &list[i], &list[i].burn_ticks, list[i].burn_dmg, 1, 1,
+                 (aColor_t){ 0xff, 0x64, 0x1e, 255 }, "Burned!" );
+
     /* Stun/freeze - show VFX (decrement happens at end of turn) */
     if ( list[i].alive && list[i].stun_turns > 0 )
     {
@@ -476,26 +634,87 @@ void EnemiesStartTurn( Enemy_t* list, int count,
       CombatVFXSpawnText( list[i].world_x, list[i].world_y,
                           "Trapped!", (aColor_t){ 0xde, 0x9e, 0x41, 255 } );
     }
+
+    if ( !list[i].alive ) continue;
+    list[i].rng     = turn_seed( i );
+    list[i].energy += g_enemy_types[list[i].type_idx].speed;
+    if ( list[i].energy < TURN_ENERGY_COST ) continue;
+    TurnQueuePush( i, list[i].energy );
+
+    /* Stunned and rooted enemies don't move - see tick_and_move */
+    if ( is_chaser( &list[i] ) && !DevModeNoclip()
+         && list[i].stun_turns <= 0 && list[i].root_turns <= 0 )
+    {
+      decide_slots[decide_count++] = (int16_t)i;
+      decide_from[i] = (PathNode_t){ list[i].row, list[i].col };
+    }
+  }
+
+  /* Allies queue behind enemies of the same energy, so at normal speed
+     they see where the enemies ended up */
+  if ( npc_list && npc_count )
+  {
+    NPCsCombatBegin( npc_list, *npc_count, player_row, player_col, walkable );
+    for ( int i = 0; i < *npc_count; i++ )
+      if ( npc_list[i].alive )
+        TurnQueuePush( TURN_ACTOR_NPC + i, TURN_SPEED_NORMAL );
   }
 
-  /* Start sequential movement from enemy 0 */
-  move_idx = 0;
-  start_next_move();
+  /* Decide everything up front; the animation is just playback */
+#ifdef STRESS_ENEMIES
+  uint64_t stress_start = SDL_GetPerformanceCounter();
+  int      stress_acts  = 0;
+#endif
+  TurnTimelineBegin( TurnPhaseTime( TURN_PHASE_MOVE ) );
+  EnemyOccupancyBuild( list, count );
+  decide();
+  int actor;
+  while ( ( actor = TurnQueuePop( NULL ) ) >= 0 )
+  {
+    if ( actor >= TURN_ACTOR_NPC )
+    {
+      NPCCombatAct( npc_list, actor - TURN_ACTOR_NPC );
+      continue;
+    }
+
+    Enemy_t* e = &list[actor];
+    if ( !e->alive ) continue;
+    e->energy -= TURN_ENERGY_COST;
+
+    int adjacent = abs( player_row - e->row ) + abs( player_col - e->col ) == 1;
+    EnemyOccupancyTrack( e );
+    tick_and_move( actor );
+    RoomIndexEnemy( e );
+    if ( adjacent && can_melee( actor ) ) strikes[actor]++;
+#ifdef STRESS_ENEMIES
+    stress_acts++;
+#endif
+
+    if ( e->alive && e->energy >= TURN_ENERGY_COST )
+      TurnQueuePush( actor, e->energy );
+  }
+  EnemyOccupancyRelease();
+  if ( npc_list && npc_count ) NPCsCombatEnd();
+
+#ifdef STRESS_ENEMIES
+  double stress_ms = (double)( SDL_GetPerformanceCounter() - stress_start )
+                   * 1000.0 / (double)SDL_GetPerformanceFrequency();
+  printf( "ENEMIES: turn %d, %d live, %d acted, decided in %.2f ms\n",
+          turn_serial, num_live, stress_acts, stress_ms );
+#endif
+
+  if ( TurnTimelineCount() > 0 ) turn_state = TURN_MOVING;
+  else                           start_attacks();
 }
 
 void EnemiesUpdate( float dt )
 {
   if ( turn_state == TURN_IDLE ) return;
 
-  UpdateTweens( &tweens, dt );
+  if ( TurnTimelineUpdate( dt ) ) return;
 
-  if ( GetActiveTweenCount( &tweens ) == 0 )
-  {
-    if ( turn_state == TURN_MOVING )
-      start_next_move();
-    else if ( turn_state == TURN_ATTACK )
-      start_next_attack();
-  }
+  if ( turn_state == TURN_MOVING ) start_attacks();
+  else                             end_turn();
 }
 
 int EnemiesTurning( void )
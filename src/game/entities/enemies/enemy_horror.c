@@ -2,7 +2,6 @@
 #include <string.h>
 
 #include "enemies.h"
-#include "pathfinding.h"
 #include "visibility.h"
 #include "combat_vfx.h"
 #include "console.h"
@@ -57,16 +56,14 @@ static void move_toward( Enemy_t* e, int target_row, int target_col,
                          int (*walkable)(int,int), Enemy_t* all, int count )
 {
   HorrorPathCtx_t ctx = { walkable, player_row, player_col, all, count };
-  PathNode_t path[PATH_MAX_LEN];
-  int len = PathfindAStar( e->row, e->col, target_row, target_col,
-                           EnemyGridW(), EnemyGridH(),
-                           horror_blocked, &ctx, path );
-  if ( len >= 2
-       && !EnemyMobileAt( all, count, path[1].row, path[1].col )
-       && !EnemyBlockedByNPC( path[1].row, path[1].col ) )
+  int nr, nc;
+  if ( EnemyPathStep( e, target_row, target_col, horror_blocked, &ctx, NULL,
+                      &nr, &nc )
+       && !EnemyMobileAt( all, count, nr, nc )
+       && !EnemyBlockedByNPC( nr, nc ) )
   {
-    e->row = path[1].row;
-    e->col = path[1].col;
+    e->row = nr;
+    e->col = nc;
   }
 }
 
@@ -83,7 +80,7 @@ void EnemyHorrorTick( Enemy_t* e, int player_row, int player_col,
   int dc = player_col - e->col;
   int dist = abs( dr ) + abs( dc );
   int can_see = ( dist <= sight
-                  && los_clear( e->row, e->col, player_row, player_col ) );
+                  && VisibilitySeesPlayer( e->row, e->col, player_row, player_col ) );
 
   /* Update chase memory */
   if ( can_see )
@@ -106,7 +103,8 @@ void EnemyHorrorTick( Enemy_t* e, int player_row, int player_col,
   /* Spawn a baby horror if under cap and off cooldown */
   if ( count_babies( all, count ) < MAX_BABIES && e->ai_state == 0 )
   {
-    int ti = EnemyHorrorSpawnBaby( player_row, player_col, walkable, all, count );
+    int ti = EnemyHorrorSpawnBaby( e, player_row, player_col,
+                                   walkable, all, count );
     if ( ti >= 0 )
     {
       e->ai_state = SPAWN_COOLDOWN;
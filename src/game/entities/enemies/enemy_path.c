@@ -0,0 +1,100 @@
+#include <stdlib.h>
+
+#include "enemies.h"
+#include "room_graph.h"
+
+static int ep_At( const PathNode_t* n, int r, int c )
+{
+  return n->row == r && n->col == c;
+}
+
+/* Bring the cached path up to date with where the enemy and its goal
+   are now. Returns 0 if it has to be thrown away. */
+static int ep_Patch( Enemy_t* e, int goal_r, int goal_c )
+{
+  EnemyPath_t* p = &e->path;
+
+  if ( p->len == 0 || p->move_rev != EnemyMoveRev() ) return 0;
+
+  /* Moved one step along it, or held still last turn */
+  if ( p->step + 1 < p->len && ep_At( &p->node[p->step + 1], e->row, e->col ) )
+    p->step++;
+  else if ( !ep_At( &p->node[p->step], e->row, e->col ) )
+    return 0;
+
+  PathNode_t* end = &p->node[p->len - 1];
+  if ( ep_At( end, goal_r, goal_c ) ) return 1;
+
+  /* Goal stepped back onto the path - cut it there */
+  for ( int k = p->step + 1; k < p->len - 1; k++ )
+  {
+    if ( ep_At( &p->node[k], goal_r, goal_c ) )
+    {
+      p->len = k + 1;
+      return 1;
+    }
+  }
+
+  /* Goal stepped off the end - follow it, unless that makes a detour */
+  if ( abs( end->row - goal_r ) + abs( end->col - goal_c ) != 1 ) return 0;
+  if ( p->len >= ENEMY_PATH_CACHE )                               return 0;
+
+  int remaining = p->len - p->step;
+  int direct    = abs( e->row - goal_r ) + abs( e->col - goal_c );
+  if ( remaining > direct + ENEMY_PATH_DETOUR ) return 0;
+
+  p->node[p->len++] = (PathNode_t){ goal_r, goal_c };
+  return 1;
+}
+
+int EnemyPathStep( Enemy_t* e, int goal_r, int goal_c,
+                   int (*blocked)( int r, int c, void* ctx ), void* ctx,
+                   RoomGraphScratch_t* scratch,
+                   int* out_r, int* out_c )
+{
+  EnemyPath_t* p = &e->path;
+
+  /* Reuse only re-checks the next step - the rest is checked as we get
+     there, and walls can't have moved without move_rev changing */
+  if ( ep_Patch( e, goal_r, goal_c ) && p->step + 1 < p->len )
+  {
+    PathNode_t* next = &p->node[p->step + 1];
+    int is_goal = ( next->row == goal_r && next->col == goal_c );
+    if ( is_goal || !blocked( next->row, next->col, ctx ) )
+    {
+      *out_r = next->row;
+      *out_c = next->col;
+      return 1;
+    }
+  }
+
+  /* Replan, bounded by how far this enemy could care about */
+  PathLimits_t limits = {
+    ENEMY_PATH_BUDGET,
+    g_enemy_types[e->type_idx].sight_range + ENEMY_PATH_SLACK,
+    0
+  };
+  PathNode_t path[PATH_MAX_LEN];
+  int len = scratch
+    ? RoomGraphPathIn( scratch, e->row, e->col, goal_r, goal_c,
+                       blocked, ctx, &limits, path )
+    : RoomGraphPath( e->row, e->col, goal_r, goal_c,
+                     blocked, ctx, &limits, path );
+
+  p->len = 0;
+  if ( len < 2 ) return 0;
+
+  /* Only whole paths are worth keeping; a partial one is replanned next
+     turn from wherever it got us */
+  if ( !limits.partial && len <= ENEMY_PATH_CACHE )
+  {
+    for ( int i = 0; i < len; i++ ) p->node[i] = path[i];
+    p->len      = len;
+    p->step     = 0;
+    p->move_rev = EnemyMoveRev();
+  }
+
+  *out_r = path[1].row;
+  *out_c = path[1].col;
+  return 1;
+}
@@ -1,7 +1,6 @@
 #include <stdlib.h>
 
 #include "enemies.h"
-#include "pathfinding.h"
 #include "visibility.h"
 
 #define DEFAULT_CHASE_TURNS  5
@@ -36,6 +35,14 @@ static int rat_blocked( int r, int c, void* ctx )
 void EnemyBasicAITick( Enemy_t* e, int player_row, int player_col,
                    int (*walkable)(int,int),
                    Enemy_t* all, int count )
+{
+  EnemyBasicAIPlan( e, player_row, player_col, walkable, all, count, NULL );
+}
+
+void EnemyBasicAIPlan( Enemy_t* e, int player_row, int player_col,
+                       int (*walkable)(int,int),
+                       Enemy_t* all, int count,
+                       RoomGraphScratch_t* scratch )
 {
   if ( !e->alive ) return;
 
@@ -46,7 +53,7 @@ void EnemyBasicAITick( Enemy_t* e, int player_row, int player_col,
   int dist = abs( dr ) + abs( dc );
 
   int can_see = ( dist <= sight
-                  && los_clear( e->row, e->col, player_row, player_col ) );
+                  && VisibilitySeesPlayer( e->row, e->col, player_row, player_col ) );
 
   /* Determine target tile */
   int target_row, target_col;
@@ -103,15 +110,13 @@ void EnemyBasicAITick( Enemy_t* e, int player_row, int player_col,
 
   /* A* pathfinding toward best adjacent tile */
   RatPathCtx_t ctx = { walkable, player_row, player_col, all, count };
-  PathNode_t path[PATH_MAX_LEN];
-  int len = PathfindAStar( e->row, e->col, best_r, best_c,
-                           EnemyGridW(), EnemyGridH(),
-                           rat_blocked, &ctx, path );
-  if ( len >= 2
-       && !EnemyMobileAt( all, count, path[1].row, path[1].col )
-       && !EnemyBlockedByNPC( path[1].row, path[1].col ) )
+  int nr, nc;
+  if ( EnemyPathStep( e, best_r, best_c, rat_blocked, &ctx, scratch,
+                      &nr, &nc )
+       && !EnemyMobileAt( all, count, nr, nc )
+       && !EnemyBlockedByNPC( nr, nc ) )
   {
-    e->row = path[1].row;
-    e->col = path[1].col;
+    e->row = nr;
+    e->col = nc;
   }
 }
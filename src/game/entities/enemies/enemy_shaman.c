@@ -2,7 +2,6 @@
 #include <string.h>
 
 #include "enemies.h"
-#include "pathfinding.h"
 #include "visibility.h"
 #include "combat_vfx.h"
 #include "spell_vfx.h"
@@ -78,16 +77,14 @@ static void move_toward( Enemy_t* e, int target_row, int target_col,
                          int (*walkable)(int,int), Enemy_t* all, int count )
 {
   ShamanPathCtx_t ctx = { walkable, player_row, player_col, all, count };
-  PathNode_t path[PATH_MAX_LEN];
-  int len = PathfindAStar( e->row, e->col, target_row, target_col,
-                           EnemyGridW(), EnemyGridH(),
-                           shaman_blocked, &ctx, path );
-  if ( len >= 2
-       && !EnemyMobileAt( all, count, path[1].row, path[1].col )
-       && !EnemyBlockedByNPC( path[1].row, path[1].col ) )
+  int nr, nc;
+  if ( EnemyPathStep( e, target_row, target_col, shaman_blocked, &ctx, NULL,
+                      &nr, &nc )
+       && !EnemyMobileAt( all, count, nr, nc )
+       && !EnemyBlockedByNPC( nr, nc ) )
   {
-    e->row = path[1].row;
-    e->col = path[1].col;
+    e->row = nr;
+    e->col = nc;
   }
 }
 
@@ -120,7 +117,7 @@ static void move_away( Enemy_t* e, int target_row, int target_col,
   /* If can't flee further, try lateral move */
   if ( best_r == e->row && best_c == e->col )
   {
-    int start = rand() % 4;
+    int start = EnemyRandom( e ) % 4;
     for ( int j = 0; j < 4; j++ )
     {
       int i  = ( start + j ) % 4;
@@ -197,7 +194,7 @@ void EnemyShamanTick( Enemy_t* e, int player_row, int player_col,
   int dc = player_col - e->col;
   int dist = abs( dr ) + abs( dc );
   int can_see = ( dist <= sight
-                  && los_clear( e->row, e->col, player_row, player_col ) );
+                  && VisibilitySeesPlayer( e->row, e->col, player_row, player_col ) );
 
   /* Update chase memory */
   if ( can_see )
@@ -223,7 +220,7 @@ void EnemyShamanTick( Enemy_t* e, int player_row, int player_col,
     /* Place totem if none alive and off cooldown */
     if ( !totem_alive( all, count ) && e->ai_state == 0 )
     {
-      int ti = EnemyShamanSpawnTotem( e->row, e->col, walkable, all, count );
+      int ti = EnemyShamanSpawnTotem( e, walkable, all, count );
       if ( ti >= 0 )
       {
         e->ai_state = TOTEM_COOLDOWN;
@@ -1,7 +1,6 @@
 #include <stdlib.h>
 
 #include "enemies.h"
-#include "pathfinding.h"
 #include "combat.h"
 #include "visibility.h"
 
@@ -93,16 +92,14 @@ static void move_toward( Enemy_t* e, int target_r, int target_c,
                          Enemy_t* all, int count )
 {
   SkelPathCtx_t ctx = { walkable, target_r, target_c, all, count };
-  PathNode_t path[PATH_MAX_LEN];
-  int len = PathfindAStar( e->row, e->col, target_r, target_c,
-                           EnemyGridW(), EnemyGridH(),
-                           skel_blocked, &ctx, path );
-  if ( len >= 2
-       && !EnemyAt( all, count, path[1].row, path[1].col )
-       && !EnemyBlockedByNPC( path[1].row, path[1].col ) )
+  int nr, nc;
+  if ( EnemyPathStep( e, target_r, target_c, skel_blocked, &ctx, NULL,
+                      &nr, &nc )
+       && !EnemyAt( all, count, nr, nc )
+       && !EnemyBlockedByNPC( nr, nc ) )
   {
-    e->row = path[1].row;
-    e->col = path[1].col;
+    e->row = nr;
+    e->col = nc;
   }
 }
 
@@ -164,7 +161,8 @@ static void move_strafe( Enemy_t* e, int target_r, int target_c,
     if ( EnemyBlockedByNPC( nr, nc ) )   continue;
     int nd = abs( target_r - nr ) + abs( target_c - nc );
     int diff = abs( nd - cur_dist );
-    if ( diff < best_diff || ( diff == best_diff && ( rand() & 1 ) ) )
+    if ( diff < best_diff
+         || ( diff == best_diff && ( EnemyRandom( e ) & 1 ) ) )
     {
       best_diff = diff;
       best_r = nr;
@@ -223,7 +221,7 @@ void EnemySkeletonTick( Enemy_t* e, int player_row, int player_col,
   int dist = abs( dr ) + abs( dc );
 
   int can_see = ( dist <= t->sight_range
-                  && los_clear( e->row, e->col, player_row, player_col ) );
+                  && VisibilitySeesPlayer( e->row, e->col, player_row, player_col ) );
 
   /* Update chase memory */
   if ( can_see )
@@ -260,7 +258,7 @@ void EnemySkeletonTick( Enemy_t* e, int player_row, int player_col,
         if ( dist <= t->range )
         {
           /* Check each neighbor for a clear shot */
-          int start = rand() % 4;
+          int start = EnemyRandom( e ) % 4;
           for ( int i = 0; i < 4; i++ )
           {
             int d = ( start + i ) % 4;
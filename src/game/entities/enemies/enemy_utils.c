@@ -1,13 +1,21 @@
 #include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unistd.h>
-#include <dirent.h>
-#include <sys/stat.h>
+#include <ctype.h>
 #include <Archimedes.h>
 #include <Daedalus.h>
 
+#include "data_cache.h"
 #include "enemies.h"
+#include "sprite_atlas.h"
+#include "res_pack.h"
+#include "room_index.h"
+#include "dialogue.h"
+#include "visibility.h"
+#include "turn_scheduler.h"
+#include "slot_pool.h"
 
 EnemyType_t g_enemy_types[MAX_ENEMY_TYPES];
 int         g_num_enemy_types = 0;
@@ -25,124 +33,272 @@ static aColor_t ParseDUFColor( dDUFValue_t* color_node )
   return c;
 }
 
-static void EnemiesLoadFile( const char* path )
+static void enemies_parse_entry( dDUFValue_t* entry, EnemyType_t* t )
+{
+  memset( t, 0, sizeof( EnemyType_t ) );
+
+  if ( entry->key )
+    strncpy( t->key, entry->key, MAX_NAME_LENGTH - 1 );
+
+  dDUFValue_t* name     = d_DUFGetObjectItem( entry, "name" );
+  dDUFValue_t* glyph    = d_DUFGetObjectItem( entry, "glyph" );
+  dDUFValue_t* hp       = d_DUFGetObjectItem( entry, "hp" );
+  dDUFValue_t* dmg      = d_DUFGetObjectItem( entry, "damage" );
+  dDUFValue_t* def      = d_DUFGetObjectItem( entry, "defense" );
+  dDUFValue_t* ai       = d_DUFGetObjectItem( entry, "ai" );
+  dDUFValue_t* desc     = d_DUFGetObjectItem( entry, "description" );
+  dDUFValue_t* range     = d_DUFGetObjectItem( entry, "range" );
+  dDUFValue_t* drop_item = d_DUFGetObjectItem( entry, "drop_item" );
+  dDUFValue_t* gold_drop = d_DUFGetObjectItem( entry, "gold_drop" );
+  dDUFValue_t* color     = d_DUFGetObjectItem( entry, "color" );
+  dDUFValue_t* img_path  = d_DUFGetObjectItem( entry, "image_path" );
+
+  if ( name )      strncpy( t->name, name->value_string, MAX_NAME_LENGTH - 1 );
+  if ( glyph )     strncpy( t->glyph, glyph->value_string, 7 );
+  if ( hp )        t->hp      = (int)hp->value_int;
+  if ( dmg )       t->damage  = (int)dmg->value_int;
+  if ( def )       t->defense = (int)def->value_int;
+  if ( ai )        strncpy( t->ai, ai->value_string, MAX_NAME_LENGTH - 1 );
+  if ( desc )      strncpy( t->description, desc->value_string, 255 );
+  if ( range )     t->range = (int)range->value_int;
+
+  dDUFValue_t* sight = d_DUFGetObjectItem( entry, "sight_range" );
+  t->sight_range = sight ? (int)sight->value_int : 6;
+
+  dDUFValue_t* speed = d_DUFGetObjectItem( entry, "speed" );
+  t->speed = speed ? (int)speed->value_int : TURN_SPEED_NORMAL;
+  if ( drop_item )
+    strncpy( t->drop_item, drop_item->value_string, MAX_NAME_LENGTH - 1 );
+  if ( gold_drop ) t->gold_drop = (int)gold_drop->value_int;
+
+  dDUFValue_t* death_flag_v    = d_DUFGetObjectItem( entry, "death_flag" );
+  if ( death_flag_v ) strncpy( t->death_flag, death_flag_v->value_string, MAX_NAME_LENGTH - 1 );
+
+  dDUFValue_t* on_death_v      = d_DUFGetObjectItem( entry, "on_death" );
+  dDUFValue_t* pool_duration_v = d_DUFGetObjectItem( entry, "pool_duration" );
+  dDUFValue_t* pool_damage_v   = d_DUFGetObjectItem( entry, "pool_damage" );
+  if ( on_death_v )      strncpy( t->on_death, on_death_v->value_string, MAX_NAME_LENGTH - 1 );
+  if ( pool_duration_v ) t->pool_duration = (int)pool_duration_v->value_int;
+  if ( pool_damage_v )   t->pool_damage   = (int)pool_damage_v->value_int;
+
+  dDUFValue_t* death_npc_v  = d_DUFGetObjectItem( entry, "death_npc" );
+  dDUFValue_t* owns_v       = d_DUFGetObjectItem( entry, "owns" );
+  dDUFValue_t* link_verb_v  = d_DUFGetObjectItem( entry, "dies_with_owner" );
+  dDUFValue_t* link_color_v = d_DUFGetObjectItem( entry, "dies_with_owner_color" );
+  if ( death_npc_v ) strncpy( t->death_npc, death_npc_v->value_string, MAX_NAME_LENGTH - 1 );
+  if ( owns_v && owns_v->type == D_DUF_ARRAY )
+  {
+    int n = 0;
+    for ( dDUFValue_t* ch = owns_v->child; ch && n < MAX_ENEMY_OWNS; ch = ch->next )
+      strncpy( t->owns[n++], ch->value_string, MAX_NAME_LENGTH - 1 );
+  }
+  strncpy( t->link_verb, link_verb_v ? link_verb_v->value_string : "dies",
+           MAX_NAME_LENGTH - 1 );
+
+  t->color      = ParseDUFColor( color );
+  t->link_color = link_color_v ? ParseDUFColor( link_color_v ) : t->color;
+
+  if ( img_path )
+    snprintf( t->image_path, sizeof( t->image_path ), "%s", img_path->value_string );
+}
+
+static dDUFValue_t* enemies_parse_file( const char* path )
 {
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( path, &root );
+  dDUFError_t* err = ResParseDUF( path, &root );
 
   if ( err != NULL )
   {
-    printf( "DUF parse error at %d:%d - %s\n",
-            err->line, err->column, d_StringPeek( err->message ) );
+    printf( "DUF parse error in %s at %d:%d - %s\n",
+            path, err->line, err->column, d_StringPeek( err->message ) );
     d_DUFErrorFree( err );
-    return;
+    return NULL;
   }
+  return root;
+}
+
+static void EnemiesLoadFile( const char* path )
+{
+  dDUFValue_t* root = enemies_parse_file( path );
+  if ( !root ) return;
 
   for ( dDUFValue_t* entry = root->child;
         entry != NULL && g_num_enemy_types < MAX_ENEMY_TYPES;
         entry = entry->next )
-  {
-    EnemyType_t* t = &g_enemy_types[g_num_enemy_types];
-    memset( t, 0, sizeof( EnemyType_t ) );
-
-    if ( entry->key )
-      strncpy( t->key, entry->key, MAX_NAME_LENGTH - 1 );
-
-    dDUFValue_t* name     = d_DUFGetObjectItem( entry, "name" );
-    dDUFValue_t* glyph    = d_DUFGetObjectItem( entry, "glyph" );
-    dDUFValue_t* hp       = d_DUFGetObjectItem( entry, "hp" );
-    dDUFValue_t* dmg      = d_DUFGetObjectItem( entry, "damage" );
-    dDUFValue_t* def      = d_DUFGetObjectItem( entry, "defense" );
-    dDUFValue_t* ai       = d_DUFGetObjectItem( entry, "ai" );
-    dDUFValue_t* desc     = d_DUFGetObjectItem( entry, "description" );
-    dDUFValue_t* range     = d_DUFGetObjectItem( entry, "range" );
-    dDUFValue_t* drop_item = d_DUFGetObjectItem( entry, "drop_item" );
-    dDUFValue_t* gold_drop = d_DUFGetObjectItem( entry, "gold_drop" );
-    dDUFValue_t* color     = d_DUFGetObjectItem( entry, "color" );
-    dDUFValue_t* img_path  = d_DUFGetObjectItem( entry, "image_path" );
-
-    if ( name )      strncpy( t->name, name->value_string, MAX_NAME_LENGTH - 1 );
-    if ( glyph )     strncpy( t->glyph, glyph->value_string, 7 );
-    if ( hp )        t->hp      = (int)hp->value_int;
-    if ( dmg )       t->damage  = (int)dmg->value_int;
-    if ( def )       t->defense = (int)def->value_int;
-    if ( ai )        strncpy( t->ai, ai->value_string, MAX_NAME_LENGTH - 1 );
-    if ( desc )      strncpy( t->description, desc->value_string, 255 );
-    if ( range )     t->range = (int)range->value_int;
-
-    dDUFValue_t* sight = d_DUFGetObjectItem( entry, "sight_range" );
-    t->sight_range = sight ? (int)sight->value_int : 6;
-    if ( drop_item )
-      strncpy( t->drop_item, drop_item->value_string, MAX_NAME_LENGTH - 1 );
-    if ( gold_drop ) t->gold_drop = (int)gold_drop->value_int;
-
-    dDUFValue_t* death_flag_v    = d_DUFGetObjectItem( entry, "death_flag" );
-    if ( death_flag_v ) strncpy( t->death_flag, death_flag_v->value_string, MAX_NAME_LENGTH - 1 );
-
-    dDUFValue_t* on_death_v      = d_DUFGetObjectItem( entry, "on_death" );
-    dDUFValue_t* pool_duration_v = d_DUFGetObjectItem( entry, "pool_duration" );
-    dDUFValue_t* pool_damage_v   = d_DUFGetObjectItem( entry, "pool_damage" );
-    if ( on_death_v )      strncpy( t->on_death, on_death_v->value_string, MAX_NAME_LENGTH - 1 );
-    if ( pool_duration_v ) t->pool_duration = (int)pool_duration_v->value_int;
-    if ( pool_damage_v )   t->pool_damage   = (int)pool_damage_v->value_int;
-
-    t->color = ParseDUFColor( color );
-
-    if ( img_path && strlen( img_path->value_string ) > 0 )
-    {
-      if ( access( img_path->value_string, F_OK ) != 0 )
-      {
-        fprintf( stderr, "FATAL: missing image '%s' for enemy '%s'\n",
-                 img_path->value_string, t->name );
-        exit( 1 );
-      }
-      t->image = a_ImageLoad( img_path->value_string );
-    }
+    enemies_parse_entry( entry, &g_enemy_types[g_num_enemy_types++] );
 
-    g_num_enemy_types++;
+  d_DUFFree( root );
+}
+
+/* Enemy DUFs found under resources/data/enemies - also the cache's sources */
+static char        g_enemy_files[DATA_CACHE_MAX_SOURCES][DATA_CACHE_PATH_LEN];
+static const char* g_enemy_sources[DATA_CACHE_MAX_SOURCES];
+static int         g_num_enemy_files = 0;
+
+static void enemies_add_file( const char* path, void* user )
+{
+  (void)user;
+
+  if ( g_num_enemy_files >= DATA_CACHE_MAX_SOURCES )
+  {
+    printf( "ENEMIES: too many enemy files, skipping %s\n", path );
+    return;
   }
+  snprintf( g_enemy_files[g_num_enemy_files], DATA_CACHE_PATH_LEN, "%s", path );
+  g_enemy_sources[g_num_enemy_files] = g_enemy_files[g_num_enemy_files];
+  g_num_enemy_files++;
+}
 
-  d_DUFFree( root );
+static int enemies_cmp_path( const void* a, const void* b )
+{
+  return strcmp( (const char*)a, (const char*)b );
 }
 
-static void enemies_scan_dir( const char* dirpath )
+/* Everything that needs the whole type table: owner links by index,
+   death effects, interned flags, and the widest sight range for the
+   visibility pass */
+static void enemies_link_types( void )
 {
-  DIR* dir = opendir( dirpath );
-  if ( !dir ) return;
+  int range = 0;
 
-  struct dirent* ent;
-  while ( ( ent = readdir( dir ) ) != NULL )
+  for ( int i = 0; i < g_num_enemy_types; i++ )
+    g_enemy_types[i].owned_by_mask = 0;
+
+  for ( int i = 0; i < g_num_enemy_types; i++ )
   {
-    const char* name = ent->d_name;
-    if ( name[0] == '.' ) continue;
+    EnemyType_t* t = &g_enemy_types[i];
 
-    char path[512];
-    snprintf( path, sizeof( path ), "%s/%s", dirpath, name );
+    if ( t->sight_range > range ) range = t->sight_range;
 
-    struct stat st;
-    if ( stat( path, &st ) == 0 && S_ISDIR( st.st_mode ) )
+    t->death_effect = ENEMY_DEATH_NONE;
+    if ( strcmp( t->on_death, "poison_pool" ) == 0 )
+      t->death_effect = ENEMY_DEATH_POISON_POOL;
+    else if ( t->on_death[0] != '\0' )
+      printf( "ENEMIES: '%s' has unknown on_death '%s'\n", t->key, t->on_death );
+
+    t->owns_mask = 0;
+    for ( int o = 0; o < MAX_ENEMY_OWNS && t->owns[o][0] != '\0'; o++ )
     {
-      enemies_scan_dir( path );
-      continue;
+      int child = EnemyTypeByKey( t->owns[o] );
+      if ( child < 0 )
+      {
+        printf( "ENEMIES: '%s' owns unknown type '%s'\n", t->key, t->owns[o] );
+        continue;
+      }
+      t->owns_mask |= 1u << child;
+      g_enemy_types[child].owned_by_mask |= 1u << i;
     }
 
-    int len = (int)strlen( name );
-    if ( len < 5 || strcmp( name + len - 4, ".duf" ) != 0 ) continue;
+    snprintf( t->link_text, sizeof( t->link_text ), "%c%s!",
+              toupper( (unsigned char)t->link_verb[0] ), t->link_verb + 1 );
+
+    char kill_flag[MAX_NAME_LENGTH + 8];
+    snprintf( kill_flag, sizeof( kill_flag ), "%s_kills", t->key );
+    t->kill_flag     = FlagIntern( kill_flag );
+    t->death_flag_id = t->death_flag[0] ? FlagIntern( t->death_flag ) : -1;
 
-    EnemiesLoadFile( path );
+    t->immobile = strcmp( t->ai, "static" ) == 0
+                  || strcmp( t->ai, "stone_healer" ) == 0
+                  || strcmp( t->ai, "stone_ranged" ) == 0;
   }
 
-  closedir( dir );
+  VisibilitySetSightRange( range );
 }
 
+/* What a cached EnemyType_t depends on beyond its size - see
+   DataCacheLayout */
+static const size_t enemies_type_layout[] = {
+  MAX_NAME_LENGTH, MAX_ENEMY_TYPES, MAX_ENEMY_OWNS,
+  offsetof( EnemyType_t, hp ),           offsetof( EnemyType_t, ai ),
+  offsetof( EnemyType_t, range ),        offsetof( EnemyType_t, speed ),
+  offsetof( EnemyType_t, drop_item ),    offsetof( EnemyType_t, gold_drop ),
+  offsetof( EnemyType_t, pool_duration ), offsetof( EnemyType_t, owns ),
+  offsetof( EnemyType_t, link_color ),   offsetof( EnemyType_t, image_path ),
+  offsetof( EnemyType_t, image ),        offsetof( EnemyType_t, death_effect ),
+  offsetof( EnemyType_t, owns_mask ),    offsetof( EnemyType_t, link_text ),
+  offsetof( EnemyType_t, kill_flag ),    offsetof( EnemyType_t, immobile ),
+  ENEMY_DEATH_POISON_POOL,
+};
+
 void EnemiesLoadTypes( void )
 {
   memset( g_enemy_types, 0, sizeof( g_enemy_types ) );
   g_num_enemy_types = 0;
-  enemies_scan_dir( "resources/data/enemies" );
+  g_num_enemy_files = 0;
+  ResListDir( "resources/data/enemies", ".duf", enemies_add_file, NULL );
+
+  /* Loose-file listing order isn't stable - sort so type indices and the cache agree */
+  qsort( g_enemy_files, g_num_enemy_files, DATA_CACHE_PATH_LEN, enemies_cmp_path );
+
+  DataCacheTable_t table = { g_enemy_types, sizeof( EnemyType_t ),
+                             MAX_ENEMY_TYPES, &g_num_enemy_types,
+                             DataCacheLayout( enemies_type_layout,
+                               (int)( sizeof( enemies_type_layout )
+                                      / sizeof( enemies_type_layout[0] ) ) ) };
+  if ( !DataCacheLoad( "enemies", g_enemy_sources, g_num_enemy_files, &table, 1 ) )
+  {
+    for ( int i = 0; i < g_num_enemy_files; i++ )
+      EnemiesLoadFile( g_enemy_files[i] );
+    DataCacheSave( "enemies", g_enemy_sources, g_num_enemy_files, &table, 1 );
+  }
+
+  for ( int i = 0; i < g_num_enemy_types; i++ )
+  {
+    EnemyType_t* t = &g_enemy_types[i];
+    t->image = NULL;
+    if ( t->image_path[0] == '\0' ) continue;
+    if ( !ResExists( t->image_path ) )
+    {
+      fprintf( stderr, "FATAL: missing image '%s' for enemy '%s'\n",
+               t->image_path, t->name );
+      exit( 1 );
+    }
+    t->image = AtlasQueue( t->image_path );
+  }
+
+  enemies_link_types();
   printf( "Loaded %d enemy types.\n", g_num_enemy_types );
 }
 
+/* Patch types in place by key, so live enemies keep their type_idx. Keys
+   dropped from the file keep their old stats until the next run. */
+void EnemiesReloadFile( const char* path )
+{
+  dDUFValue_t* root = enemies_parse_file( path );
+  if ( !root ) return;
+
+  int patched = 0, added = 0;
+  for ( dDUFValue_t* entry = root->child; entry != NULL; entry = entry->next )
+  {
+    EnemyType_t fresh;
+    enemies_parse_entry( entry, &fresh );
+
+    int idx = EnemyTypeByKey( fresh.key );
+    if ( idx < 0 )
+    {
+      if ( g_num_enemy_types >= MAX_ENEMY_TYPES ) continue;
+      idx = g_num_enemy_types++;
+      added++;
+    }
+    else
+      patched++;
+
+    EnemyType_t* t = &g_enemy_types[idx];
+    if ( strcmp( fresh.image_path, t->image_path ) == 0 )
+      fresh.image = t->image;
+    else if ( fresh.image_path[0] != '\0' && ResExists( fresh.image_path ) )
+      fresh.image = AtlasQueue( fresh.image_path );
+    else if ( fresh.image_path[0] != '\0' )
+      printf( "ENEMIES: missing image '%s' for '%s'\n", fresh.image_path, fresh.key );
+
+    *t = fresh;
+  }
+
+  d_DUFFree( root );
+  enemies_link_types();
+  printf( "ENEMIES: %s - %d patched, %d new\n", path, patched, added );
+}
+
 int EnemyTypeByKey( const char* key )
 {
   for ( int i = 0; i < g_num_enemy_types; i++ )
@@ -153,20 +309,173 @@ int EnemyTypeByKey( const char* key )
   return -1;
 }
 
+/* Slot reuse for the list EnemiesInit was given */
+static int16_t    pool_free[MAX_ENEMIES], pool_live[MAX_ENEMIES];
+static uint16_t   pool_gen[MAX_ENEMIES];
+static SlotPool_t enemy_pool = { pool_free, 0, pool_live, 0, pool_gen,
+                                 MAX_ENEMIES };
+static Enemy_t*   pool_list = NULL;
+
+/* Turn occupancy grid - see EnemyOccupancyBuild */
+static int16_t* occ_grid  = NULL;
+static int      occ_size  = 0;
+static int      occ_w, occ_h;
+static Enemy_t* occ_list  = NULL;
+static Enemy_t* occ_actor = NULL;
+static int      occ_actor_row, occ_actor_col;
+
+static void enemies_occ_file( ptrdiff_t i, int row, int col );
+
+/* Slot a link points at, or -1 once that slot went to someone else */
+static int enemies_slot( SlotHandle_t h )
+{
+  return SlotPoolResolve( &enemy_pool, h );
+}
+
+static void enemies_adopt( Enemy_t* list, int owner, int child )
+{
+  list[child].owner        = SlotPoolHandle( &enemy_pool, owner );
+  list[child].next_sibling = list[owner].first_child;
+  list[owner].first_child  = SlotPoolHandle( &enemy_pool, child );
+}
+
+/* A slot being reused leaves its old owner's brood. Its own brood needs
+   nothing - their owner handle went stale with the new generation.
+   Every other link in a brood is current, since each slot is taken out
+   here before it is handed on, so the walk can go by slot. */
+static void enemies_unlink( Enemy_t* list, int idx )
+{
+  if ( list != pool_list ) return;
+
+  int owner = enemies_slot( list[idx].owner );
+  if ( owner < 0 ) return;
+
+  SlotHandle_t* link = &list[owner].first_child;
+  while ( *link != SLOT_HANDLE_NONE && SLOT_HANDLE_SLOT( *link ) != idx )
+    link = &list[SLOT_HANDLE_SLOT( *link )].next_sibling;
+  if ( *link != SLOT_HANDLE_NONE ) *link = list[idx].next_sibling;
+}
+
+/* spawner < 0 - placed with the floor, so the nearest owner takes it */
+static void enemies_link_owner( Enemy_t* list, int count, int idx,
+                                int spawner )
+{
+  Enemy_t*     e = &list[idx];
+  EnemyType_t* t = &g_enemy_types[e->type_idx];
+  if ( list != pool_list ) return;
+
+  if ( spawner >= 0 )
+  {
+    if ( list[spawner].alive
+         && ( t->owned_by_mask & ( 1u << list[spawner].type_idx ) ) )
+      enemies_adopt( list, spawner, idx );
+  }
+  else if ( t->owned_by_mask )
+  {
+    int best = -1, best_dist = 0;
+    for ( int i = 0; i < count; i++ )
+    {
+      if ( i == idx || !list[i].alive ) continue;
+      if ( !( t->owned_by_mask & ( 1u << list[i].type_idx ) ) ) continue;
+      int d = abs( list[i].row - e->row ) + abs( list[i].col - e->col );
+      if ( best < 0 || d < best_dist ) { best = i; best_dist = d; }
+    }
+    if ( best >= 0 ) enemies_adopt( list, best, idx );
+  }
+
+  if ( t->owns_mask )
+  {
+    for ( int i = 0; i < count; i++ )
+    {
+      if ( i == idx || !list[i].alive ) continue;
+      if ( enemies_slot( list[i].owner ) >= 0 ) continue;
+      if ( t->owns_mask & ( 1u << list[i].type_idx ) )
+        enemies_adopt( list, idx, i );
+    }
+  }
+}
+
 void EnemiesInit( Enemy_t* list, int* count )
 {
   memset( list, 0, sizeof( Enemy_t ) * MAX_ENEMIES );
+  for ( int i = 0; i < MAX_ENEMIES; i++ )
+    list[i].owner = list[i].first_child = list[i].next_sibling
+                  = SLOT_HANDLE_NONE;
   *count = 0;
+
+  pool_list = list;
+  SlotPoolReset( &enemy_pool );
 }
 
-Enemy_t* EnemySpawn( Enemy_t* list, int* count,
-                     int type_idx, int row, int col,
-                     int tile_w, int tile_h )
+void EnemiesCollect( Enemy_t* list, int* count )
 {
-  if ( *count >= MAX_ENEMIES || type_idx < 0 || type_idx >= g_num_enemy_types )
+  if ( list != pool_list ) return;
+  SlotPoolCollect( &enemy_pool, list, sizeof( Enemy_t ),
+                   offsetof( Enemy_t, alive ), count );
+}
+
+const int16_t* EnemiesLive( Enemy_t* list, int count, int* n )
+{
+  static int16_t all[MAX_ENEMIES];
+  if ( list == pool_list )
+  {
+    *n = enemy_pool.num_live;
+    return enemy_pool.live;
+  }
+
+  /* A list nobody pooled - every slot counts */
+  for ( int i = 0; i < count; i++ ) all[i] = (int16_t)i;
+  *n = count;
+  return all;
+}
+
+SlotHandle_t EnemyHandle( Enemy_t* list, Enemy_t* e )
+{
+  if ( list != pool_list || !e ) return SLOT_HANDLE_NONE;
+  return SlotPoolHandle( &enemy_pool, (int)( e - list ) );
+}
+
+Enemy_t* EnemyFromHandle( Enemy_t* list, SlotHandle_t h )
+{
+  if ( list != pool_list ) return NULL;
+  int slot = SlotPoolResolve( &enemy_pool, h );
+  return ( slot >= 0 && list[slot].alive ) ? &list[slot] : NULL;
+}
+
+Enemy_t* EnemyFirstChild( Enemy_t* list, Enemy_t* e )
+{
+  if ( list != pool_list || !e ) return NULL;
+  int slot = enemies_slot( e->first_child );
+  return slot >= 0 ? &list[slot] : NULL;
+}
+
+Enemy_t* EnemyNextSibling( Enemy_t* list, Enemy_t* e )
+{
+  if ( list != pool_list || !e ) return NULL;
+  int slot = enemies_slot( e->next_sibling );
+  return slot >= 0 ? &list[slot] : NULL;
+}
+
+static Enemy_t* enemies_spawn( Enemy_t* list, int* count, int spawner,
+                               int type_idx, int row, int col,
+                               int tile_w, int tile_h )
+{
+  if ( type_idx < 0 || type_idx >= g_num_enemy_types ) return NULL;
+
+  int slot;
+  if ( list == pool_list )         slot = SlotPoolAlloc( &enemy_pool, count );
+  else if ( *count < MAX_ENEMIES ) slot = ( *count )++;
+  else                             slot = -1;
+  if ( slot < 0 )
+  {
+    printf( "ENEMIES: all %d slots taken, no '%s'\n", MAX_ENEMIES,
+            g_enemy_types[type_idx].key );
     return NULL;
+  }
 
-  Enemy_t* e = &list[*count];
+  enemies_unlink( list, slot );
+  Enemy_t* e = &list[slot];
+  memset( e, 0, sizeof( Enemy_t ) );
   e->type_idx = type_idx;
   e->row      = row;
   e->col      = col;
@@ -181,12 +490,127 @@ Enemy_t* EnemySpawn( Enemy_t* list, int* count,
   e->ai_state        = 0;
   e->ai_dir_row      = 0;
   e->ai_dir_col      = 0;
-  ( *count )++;
+  e->path.len        = 0;
+  e->dormant         = 0;
+  e->energy          = 0;
+  e->owner           = SLOT_HANDLE_NONE;
+  e->first_child     = SLOT_HANDLE_NONE;
+  e->next_sibling    = SLOT_HANDLE_NONE;
+  enemies_link_owner( list, *count, slot, spawner );
+  RoomIndexEnemy( e );
+  if ( list == occ_list ) enemies_occ_file( e - list, e->row, e->col );
   return e;
 }
 
+Enemy_t* EnemySpawn( Enemy_t* list, int* count,
+                     int type_idx, int row, int col,
+                     int tile_w, int tile_h )
+{
+  return enemies_spawn( list, count, -1, type_idx, row, col,
+                        tile_w, tile_h );
+}
+
+Enemy_t* EnemySpawnChild( Enemy_t* list, int* count, Enemy_t* spawner,
+                          int type_idx, int row, int col,
+                          int tile_w, int tile_h )
+{
+  int si = ( spawner && spawner >= list && spawner < list + *count )
+         ? (int)( spawner - list ) : -1;
+  if ( si < 0 ) return NULL;
+  return enemies_spawn( list, count, si, type_idx, row, col,
+                        tile_w, tile_h );
+}
+
+/* ---- Turn occupancy grid ---- */
+
+static int enemies_occ_index( int row, int col )
+{
+  if ( row < 0 || row >= occ_w || col < 0 || col >= occ_h ) return -1;
+  return col * occ_w + row;
+}
+
+/* A tile keeps its lowest live index, like the scan would find */
+static void enemies_occ_file( ptrdiff_t i, int row, int col )
+{
+  if ( !occ_list || i < 0 || i >= MAX_ENEMIES || !occ_list[i].alive ) return;
+  int idx = enemies_occ_index( row, col );
+  if ( idx < 0 ) return;
+
+  int j = occ_grid[idx];
+  if ( j >= 0 && j < i && occ_list[j].alive
+       && occ_list[j].row == row && occ_list[j].col == col ) return;
+  occ_grid[idx] = (int16_t)i;
+}
+
+static void enemies_occ_refile( void )
+{
+  if ( !occ_actor ) return;
+  int idx = enemies_occ_index( occ_actor_row, occ_actor_col );
+  if ( idx >= 0 && occ_grid[idx] == occ_actor - occ_list ) occ_grid[idx] = -1;
+  enemies_occ_file( occ_actor - occ_list, occ_actor->row, occ_actor->col );
+  occ_actor = NULL;
+}
+
+void EnemyOccupancyBuild( Enemy_t* list, int count )
+{
+  occ_list  = NULL;
+  occ_actor = NULL;
+
+  int w = EnemyGridW(), h = EnemyGridH();
+  if ( w <= 0 || h <= 0 ) return;
+  if ( w * h > occ_size )
+  {
+    int16_t* grown = realloc( occ_grid, (size_t)w * h * sizeof( int16_t ) );
+    if ( !grown ) return;
+    occ_grid = grown;
+    occ_size = w * h;
+  }
+  occ_w = w;
+  occ_h = h;
+  for ( int i = 0; i < w * h; i++ ) occ_grid[i] = -1;
+
+  occ_list = list;
+  for ( int i = 0; i < count; i++ )
+    enemies_occ_file( i, list[i].row, list[i].col );
+}
+
+void EnemyOccupancyTrack( Enemy_t* e )
+{
+  if ( !occ_list ) return;
+  enemies_occ_refile();
+  occ_actor     = e;
+  occ_actor_row = e->row;
+  occ_actor_col = e->col;
+}
+
+void EnemyOccupancyRelease( void )
+{
+  occ_list  = NULL;
+  occ_actor = NULL;
+}
+
+/* Same answer as the scan: the lowest live index on the tile */
+static Enemy_t* enemies_occ_at( Enemy_t* list, int count, int row, int col )
+{
+  Enemy_t* hit = NULL;
+  int idx = enemies_occ_index( row, col );
+  int i   = ( idx >= 0 ) ? occ_grid[idx] : -1;
+  if ( i >= 0 && i < count && &list[i] != occ_actor && list[i].alive
+       && list[i].row == row && list[i].col == col )
+    hit = &list[i];
+
+  if ( occ_actor && occ_actor - list < count && occ_actor->alive
+       && occ_actor->row == row && occ_actor->col == col
+       && ( !hit || occ_actor < hit ) )
+    hit = occ_actor;
+  return hit;
+}
+
 Enemy_t* EnemyAt( Enemy_t* list, int count, int row, int col )
 {
+  if ( occ_list && list == occ_list )
+    return enemies_occ_at( list, count, row, col );
+
   for ( int i = 0; i < count; i++ )
   {
     if ( list[i].alive && list[i].row == row && list[i].col == col )
@@ -197,12 +621,16 @@ Enemy_t* EnemyAt( Enemy_t* list, int count, int row, int col )
 
 Enemy_t* EnemyMobileAt( Enemy_t* list, int count, int row, int col )
 {
+  if ( occ_list && list == occ_list )
+  {
+    Enemy_t* e = enemies_occ_at( list, count, row, col );
+    return ( e && !g_enemy_types[e->type_idx].immobile ) ? e : NULL;
+  }
+
   for ( int i = 0; i < count; i++ )
   {
     if ( list[i].alive && list[i].row == row && list[i].col == col
-         && strcmp( g_enemy_types[list[i].type_idx].ai, "static" ) != 0
-         && strcmp( g_enemy_types[list[i].type_idx].ai, "stone_healer" ) != 0
-         && strcmp( g_enemy_types[list[i].type_idx].ai, "stone_ranged" ) != 0 )
+         && !g_enemy_types[list[i].type_idx].immobile )
       return &list[i];
   }
   return NULL;
@@ -210,7 +638,21 @@ Enemy_t* EnemyMobileAt( Enemy_t* list, int count, int row, int col )
 
 int EnemiesInCombat( Enemy_t* list, int count )
 {
+  int chasing = RoomIndexChasing( list );
+  if ( chasing >= 0 ) return chasing > 0;
+
   for ( int i = 0; i < count; i++ )
     if ( list[i].alive && list[i].chase_turns > 0 ) return 1;
   return 0;
 }
+
+uint32_t EnemyRandom( Enemy_t* e )
+{
+  /* xorshift32 - spawned mid-turn means not seeded yet */
+  uint32_t x = e->rng ? e->rng : 0x9e3779b9u;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  e->rng = x;
+  return x;
+}
@@ -89,7 +89,7 @@ void EnemiesDrawTelegraph( aRectf_t vp_rect, GameCamera_t* cam,
       if ( cr < 0 || cr >= world->width || cc < 0 || cc >= world->height )
         break;
       int idx = cc * world->width + cr;
-      if ( world->background[idx].solid || world->midground[idx].solid )
+      if ( WORLD_BLOCKS_MOVE( world, idx ) )
         break;
       end_r = cr;
       end_c = cc;
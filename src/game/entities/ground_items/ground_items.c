@@ -1,3 +1,4 @@
+#include <stdio.h>
 #include <string.h>
 #include <Archimedes.h>
 
@@ -8,71 +9,91 @@
 #include "game_viewport.h"
 #include "world.h"
 #include "visibility.h"
+#include "room_index.h"
+#include "slot_pool.h"
+
+/* Slot reuse for the list GroundItemsInit was given */
+static int16_t       gi_free[MAX_GROUND_ITEMS], gi_live[MAX_GROUND_ITEMS];
+static uint16_t      gi_gen[MAX_GROUND_ITEMS];
+static SlotPool_t    gi_pool = { gi_free, 0, gi_live, 0, gi_gen,
+                                 MAX_GROUND_ITEMS };
+static GroundItem_t* gi_list = NULL;
 
 void GroundItemsInit( GroundItem_t* list, int* count )
 {
   memset( list, 0, sizeof( GroundItem_t ) * MAX_GROUND_ITEMS );
   *count = 0;
+
+  gi_list = list;
+  SlotPoolReset( &gi_pool );
 }
 
-GroundItem_t* GroundItemSpawn( GroundItem_t* list, int* count,
-                               int consumable_idx, int row, int col,
+void GroundItemsCollect( GroundItem_t* list, int* count )
+{
+  if ( list != gi_list ) return;
+  SlotPoolCollect( &gi_pool, list, sizeof( GroundItem_t ),
+                   offsetof( GroundItem_t, alive ), count );
+}
+
+/* A cleared slot, already on the ground at (row, col) */
+static GroundItem_t* gi_Place( GroundItem_t* list, int* count,
+                               int item_type, int item_idx, int row, int col,
                                int tile_w, int tile_h )
 {
-  if ( *count >= MAX_GROUND_ITEMS || consumable_idx < 0
-       || consumable_idx >= g_num_consumables )
+  int slot;
+  if ( list == gi_list )                slot = SlotPoolAlloc( &gi_pool, count );
+  else if ( *count < MAX_GROUND_ITEMS ) slot = ( *count )++;
+  else                                  slot = -1;
+  if ( slot < 0 )
+  {
+    printf( "GROUND ITEMS: all %d slots taken\n", MAX_GROUND_ITEMS );
     return NULL;
+  }
 
-  GroundItem_t* g = &list[*count];
-  g->item_type = GROUND_CONSUMABLE;
-  g->item_idx  = consumable_idx;
+  GroundItem_t* g = &list[slot];
+  memset( g, 0, sizeof( GroundItem_t ) );
+  g->item_type = item_type;
+  g->item_idx  = item_idx;
   g->row     = row;
   g->col     = col;
   g->world_x = row * tile_w + tile_w / 2.0f;
   g->world_y = col * tile_h + tile_h / 2.0f;
   g->alive   = 1;
-  ( *count )++;
+  RoomIndexItem( g );
   return g;
 }
 
+GroundItem_t* GroundItemSpawn( GroundItem_t* list, int* count,
+                               int consumable_idx, int row, int col,
+                               int tile_w, int tile_h )
+{
+  if ( consumable_idx < 0 || consumable_idx >= g_num_consumables )
+    return NULL;
+
+  return gi_Place( list, count, GROUND_CONSUMABLE, consumable_idx,
+                   row, col, tile_w, tile_h );
+}
+
 GroundItem_t* GroundItemSpawnMap( GroundItem_t* list, int* count,
                                   int map_idx, int row, int col,
                                   int tile_w, int tile_h )
 {
-  if ( *count >= MAX_GROUND_ITEMS || map_idx < 0
-       || map_idx >= g_num_maps )
+  if ( map_idx < 0 || map_idx >= g_num_maps )
     return NULL;
 
-  GroundItem_t* g = &list[*count];
-  g->item_type = GROUND_MAP;
-  g->item_idx  = map_idx;
-  g->row     = row;
-  g->col     = col;
-  g->world_x = row * tile_w + tile_w / 2.0f;
-  g->world_y = col * tile_h + tile_h / 2.0f;
-  g->alive   = 1;
-  ( *count )++;
-  return g;
+  return gi_Place( list, count, GROUND_MAP, map_idx,
+                   row, col, tile_w, tile_h );
 }
 
 GroundItem_t* GroundItemSpawnEquipment( GroundItem_t* list, int* count,
                                         int equip_idx, int row, int col,
                                         int tile_w, int tile_h )
 {
-  if ( *count >= MAX_GROUND_ITEMS || equip_idx < 0
-       || equip_idx >= g_num_equipment )
+  if ( equip_idx < 0 || equip_idx >= g_num_equipment )
     return NULL;
 
-  GroundItem_t* g = &list[*count];
-  g->item_type = GROUND_EQUIPMENT;
-  g->item_idx  = equip_idx;
-  g->row     = row;
-  g->col     = col;
-  g->world_x = row * tile_w + tile_w / 2.0f;
-  g->world_y = col * tile_h + tile_h / 2.0f;
-  g->alive   = 1;
-  ( *count )++;
-  return g;
+  return gi_Place( list, count, GROUND_EQUIPMENT, equip_idx,
+                   row, col, tile_w, tile_h );
 }
 
 GroundItem_t* GroundItemAt( GroundItem_t* list, int count, int row, int col )
@@ -1,8 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <dirent.h>
-#include <sys/stat.h>
 #include <Archimedes.h>
 #include <Daedalus.h>
 
@@ -14,6 +12,8 @@
 #include "npc_relocate.h"
 #include "enemies.h"
 #include "victory.h"
+#include "sprite_atlas.h"
+#include "res_pack.h"
 
 extern Player_t player;
 
@@ -28,6 +28,7 @@ typedef struct { dString_t* name; int value; } Flag_t;
 
 static Flag_t g_flags[MAX_FLAGS];
 static int    g_num_flags = 0;
+static int    g_flags_version = 0;   /* bumped on every flag change */
 
 static int flag_find( const char* name )
 {
@@ -36,44 +37,71 @@ static int flag_find( const char* name )
   return -1;
 }
 
+/* Names keep their slot for the life of the program, so ids from
+   FlagIntern stay good across new games and clears */
 void FlagsInit( void )
 {
   for ( int i = 0; i < g_num_flags; i++ )
-    d_StringDestroy( g_flags[i].name );
-  memset( g_flags, 0, sizeof( g_flags ) );
-  g_num_flags = 0;
+    g_flags[i].value = 0;
+  g_flags_version++;
 }
 
-int FlagGet( const char* name )
+int FlagsVersion( void )
 {
-  int i = flag_find( name );
-  return ( i >= 0 ) ? g_flags[i].value : 0;
+  return g_flags_version;
 }
 
-void FlagSet( const char* name, int value )
+int FlagIntern( const char* name )
 {
   int i = flag_find( name );
-  if ( i >= 0 ) { g_flags[i].value = value; return; }
-  if ( g_num_flags >= MAX_FLAGS ) return;
+  if ( i >= 0 ) return i;
+
+  if ( g_num_flags >= MAX_FLAGS )
+  {
+    printf( "FLAGS: table full, dropping '%s'\n", name );
+    return -1;
+  }
   g_flags[g_num_flags].name = d_StringInit();
   d_StringSet( g_flags[g_num_flags].name, name );
-  g_flags[g_num_flags].value = value;
-  g_num_flags++;
+  g_flags[g_num_flags].value = 0;
+  return g_num_flags++;
+}
+
+int FlagGetId( int id )
+{
+  return ( id >= 0 && id < g_num_flags ) ? g_flags[id].value : 0;
+}
+
+void FlagSetId( int id, int value )
+{
+  if ( id < 0 || id >= g_num_flags ) return;
+  if ( g_flags[id].value != value ) g_flags_version++;
+  g_flags[id].value = value;
+}
+
+void FlagIncrId( int id )
+{
+  FlagSetId( id, FlagGetId( id ) + 1 );
+}
+
+int FlagGet( const char* name )
+{
+  return FlagGetId( flag_find( name ) );
+}
+
+void FlagSet( const char* name, int value )
+{
+  FlagSetId( FlagIntern( name ), value );
 }
 
 void FlagIncr( const char* name )
 {
-  FlagSet( name, FlagGet( name ) + 1 );
+  FlagIncrId( FlagIntern( name ) );
 }
 
 void FlagClear( const char* name )
 {
-  int i = flag_find( name );
-  if ( i < 0 ) return;
-  d_StringDestroy( g_flags[i].name );
-  g_flags[i] = g_flags[g_num_flags - 1];
-  memset( &g_flags[g_num_flags - 1], 0, sizeof( Flag_t ) );
-  g_num_flags--;
+  FlagSetId( flag_find( name ), 0 );
 }
 
 /* ---- Init / destroy helpers ---- */
@@ -213,22 +241,19 @@ static void copy_dstr( dString_t* dst, dDUFValue_t* node )
 
 /* ---- Load one NPC dialogue file ---- */
 
-static void DialogueLoadFile( const char* path, const char* stem )
+static int dialogue_parse_file( const char* path, const char* stem, NPCType_t* npc )
 {
-  if ( g_num_npc_types >= MAX_NPC_TYPES ) return;
-
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( path, &root );
+  dDUFError_t* err = ResParseDUF( path, &root );
 
   if ( err != NULL )
   {
     printf( "DUF parse error in %s at %d:%d - %s\n",
             path, err->line, err->column, d_StringPeek( err->message ) );
     d_DUFErrorFree( err );
-    return;
+    return 0;
   }
 
-  NPCType_t* npc = &g_npc_types[g_num_npc_types];
   NPCTypeInit( npc );
   d_StringSet( npc->key, stem );
   d_StringSet( npc->combat_bark, "Can't talk right now!" );
@@ -267,9 +292,8 @@ static void DialogueLoadFile( const char* path, const char* stem )
       dDUFValue_t* img_path = d_DUFGetObjectItem( entry, "image_path" );
       if ( img_path && img_path->value_string && strlen( img_path->value_string ) > 0 )
       {
-        struct stat img_st;
-        if ( stat( img_path->value_string, &img_st ) == 0 )
-          npc->image = a_ImageLoad( img_path->value_string );
+        if ( ResExists( img_path->value_string ) )
+          npc->image = AtlasQueue( img_path->value_string );
         else
           printf( "NPC '%s': image not found: %s\n", stem, img_path->value_string );
       }
@@ -399,52 +423,44 @@ static void DialogueLoadFile( const char* path, const char* stem )
   }
 
   d_DUFFree( root );
-  g_num_npc_types++;
+  return 1;
 }
 
-/* ---- Scan a directory for .duf files, recurse into subdirs ---- */
-
-static void dialogue_scan_dir( const char* dirpath )
+static void DialogueLoadFile( const char* path, const char* stem )
 {
-  DIR* dir = opendir( dirpath );
-  if ( !dir ) return;
-
-  struct dirent* ent;
-  while ( ( ent = readdir( dir ) ) != NULL )
-  {
-    const char* name = ent->d_name;
-    if ( name[0] == '.' ) continue;
+  if ( g_num_npc_types >= MAX_NPC_TYPES ) return;
 
-    char path[512];
-    snprintf( path, sizeof( path ), "%s/%s", dirpath, name );
+  if ( dialogue_parse_file( path, stem, &g_npc_types[g_num_npc_types] ) )
+    g_num_npc_types++;
+}
 
-    /* Recurse into subdirectories */
-    struct stat st;
-    if ( stat( path, &st ) == 0 && S_ISDIR( st.st_mode ) )
-    {
-      dialogue_scan_dir( path );
-      continue;
-    }
+/* ---- One .duf under resources/data/npcs (pack or loose, recursive) ---- */
 
-    int len = (int)strlen( name );
-    if ( len < 5 || strcmp( name + len - 4, ".duf" ) != 0 ) continue;
+/* Extract stem (filename without .duf) - the NPC's key */
+static void dialogue_stem( const char* path, char stem[MAX_NAME_LENGTH] )
+{
+  const char* name = strrchr( path, '/' );
+  name = name ? name + 1 : path;
 
-    /* Extract stem (filename without .duf) */
-    char stem[MAX_NAME_LENGTH] = { 0 };
-    int slen = len - 4;
-    if ( slen >= MAX_NAME_LENGTH ) slen = MAX_NAME_LENGTH - 1;
-    strncpy( stem, name, slen );
+  memset( stem, 0, MAX_NAME_LENGTH );
+  int slen = (int)strlen( name ) - 4;
+  if ( slen >= MAX_NAME_LENGTH ) slen = MAX_NAME_LENGTH - 1;
+  if ( slen > 0 ) strncpy( stem, name, slen );
+}
 
-    DialogueLoadFile( path, stem );
-  }
+static void dialogue_load_listed( const char* path, void* user )
+{
+  (void)user;
 
-  closedir( dir );
+  char stem[MAX_NAME_LENGTH];
+  dialogue_stem( path, stem );
+  DialogueLoadFile( path, stem );
 }
 
 void DialogueLoadAll( void )
 {
   DialogueDestroyAll();
-  dialogue_scan_dir( "resources/data/npcs" );
+  ResListDir( "resources/data/npcs", ".duf", dialogue_load_listed, NULL );
   printf( "Loaded %d NPC dialogue files.\n", g_num_npc_types );
 }
 
@@ -903,3 +919,38 @@ const char* DialogueGetNPCGlyph( void )
   if ( dlg_npc_type < 0 ) return "";
   return d_StringPeek( g_npc_types[dlg_npc_type].glyph );
 }
+
+/* ---- Hot reload ---- */
+
+/* Parsed into a scratch slot first so a broken edit leaves the live NPC
+   alone; on success it replaces the type at the same index, so placed
+   NPCs keep their type_idx. */
+static NPCType_t dlg_reload_scratch;
+
+void DialogueReloadFile( const char* path )
+{
+  char stem[MAX_NAME_LENGTH];
+  dialogue_stem( path, stem );
+
+  if ( !dialogue_parse_file( path, stem, &dlg_reload_scratch ) ) return;
+
+  int idx = NPCTypeByKey( stem );
+  if ( idx < 0 )
+  {
+    if ( g_num_npc_types >= MAX_NPC_TYPES )
+    {
+      NPCTypeDestroy( &dlg_reload_scratch );
+      return;
+    }
+    idx = g_num_npc_types++;
+  }
+  else
+  {
+    /* Node indices may have moved under an open conversation */
+    if ( dlg_active && dlg_npc_type == idx ) DialogueEnd();
+    NPCTypeDestroy( &g_npc_types[idx] );
+  }
+
+  g_npc_types[idx] = dlg_reload_scratch;
+  printf( "DIALOGUE: %s - %d nodes\n", stem, g_npc_types[idx].num_entries );
+}
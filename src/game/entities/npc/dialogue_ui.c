@@ -5,6 +5,8 @@
 #include "defines.h"
 #include "dialogue.h"
 #include "draw_utils.h"
+#include "sprite_atlas.h"
+#include "sound_bank.h"
 
 #define DLG_BG    (aColor_t){ 0x09, 0x0a, 0x14, 230 }
 #define DLG_FG    (aColor_t){ 0xc7, 0xcf, 0xcc, 255 }
@@ -79,7 +81,7 @@ int DialogueUILogic( void )
         if ( i != dlg_cursor )
         {
           dlg_cursor = i;
-          if ( sfx_move ) a_AudioPlaySound( sfx_move, NULL );
+          if ( sfx_move ) SoundBankPlay( sfx_move, NULL );
         }
         break;
       }
@@ -101,7 +103,7 @@ int DialogueUILogic( void )
       {
         app.mouse.pressed = 0;
         dlg_cursor = i;
-        if ( sfx_click ) a_AudioPlaySound( sfx_click, NULL );
+        if ( sfx_click ) SoundBankPlay( sfx_click, NULL );
         DialogueSelectOption( i );
         dlg_cursor = 0;
         return 1;
@@ -116,7 +118,7 @@ int DialogueUILogic( void )
     dlg_cursor += ( app.mouse.wheel < 0 ) ? 1 : -1;
     if ( dlg_cursor < 0 ) dlg_cursor = count - 1;
     if ( dlg_cursor >= count ) dlg_cursor = 0;
-    if ( sfx_move ) a_AudioPlaySound( sfx_move, NULL );
+    if ( sfx_move ) SoundBankPlay( sfx_move, NULL );
     app.mouse.wheel = 0;
   }
 
@@ -127,7 +129,7 @@ int DialogueUILogic( void )
     app.keyboard[SDL_SCANCODE_UP] = 0;
     dlg_cursor--;
     if ( dlg_cursor < 0 ) dlg_cursor = count - 1;
-    if ( sfx_move ) a_AudioPlaySound( sfx_move, NULL );
+    if ( sfx_move ) SoundBankPlay( sfx_move, NULL );
   }
   if ( app.keyboard[SDL_SCANCODE_S] == 1 || app.keyboard[SDL_SCANCODE_DOWN] == 1 )
   {
@@ -135,7 +137,7 @@ int DialogueUILogic( void )
     app.keyboard[SDL_SCANCODE_DOWN] = 0;
     dlg_cursor++;
     if ( dlg_cursor >= count ) dlg_cursor = 0;
-    if ( sfx_move ) a_AudioPlaySound( sfx_move, NULL );
+    if ( sfx_move ) SoundBankPlay( sfx_move, NULL );
   }
 
   /* Number keys 1-4 */
@@ -145,7 +147,7 @@ int DialogueUILogic( void )
     {
       app.keyboard[SDL_SCANCODE_1 + k] = 0;
       dlg_cursor = k;
-      if ( sfx_click ) a_AudioPlaySound( sfx_click, NULL );
+      if ( sfx_click ) SoundBankPlay( sfx_click, NULL );
       DialogueSelectOption( k );
       dlg_cursor = 0;
       return 1;
@@ -157,7 +159,7 @@ int DialogueUILogic( void )
   {
     app.keyboard[SDL_SCANCODE_RETURN] = 0;
     app.keyboard[SDL_SCANCODE_SPACE] = 0;
-    if ( sfx_click ) a_AudioPlaySound( sfx_click, NULL );
+    if ( sfx_click ) SoundBankPlay( sfx_click, NULL );
     DialogueSelectOption( dlg_cursor );
     dlg_cursor = 0;
     return 1;
@@ -233,7 +235,7 @@ void DialogueUIDraw( aRectf_t panel_rect )
   if ( img && settings.gfx_mode == GFX_IMAGE )
   {
     float scale = PORTRAIT_SZ / img->rect.w;
-    a_BlitRect( img, NULL, &(aRectf_t){ px, py, img->rect.w, img->rect.h }, scale );
+    a_BlitRect( img, AtlasSrc( img ), &(aRectf_t){ px, py, img->rect.w, img->rect.h }, scale );
   }
   else
   {
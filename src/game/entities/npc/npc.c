@@ -1,6 +1,8 @@
+#include <stdio.h>
 #include <string.h>
 #include <Archimedes.h>
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "defines.h"
@@ -15,73 +17,87 @@
 #include "combat_vfx.h"
 #include "visibility.h"
 #include "room_enumerator.h"
-#include "tween.h"
+#include "room_graph.h"
+#include "turn_timeline.h"
+#include "room_index.h"
+#include "slot_pool.h"
 
 extern Player_t player;
 
-/* ---- NPC combat animation state machine ---- */
-
-#define NPC_TURN_IDLE  0
-#define NPC_TURN_ANIM  1
-
-static TweenManager_t npc_tweens;
-static int npc_turn_state = NPC_TURN_IDLE;
+/* ---- NPC combat intents ---- */
 
 #define NPC_ACT_NONE   0
 #define NPC_ACT_MOVE   1
 #define NPC_ACT_ATTACK 2
 
+#define NPC_PATH_BUDGET  256   /* A* expansions - paths never leave the room */
+
 typedef struct
 {
-  int action;
-  int enemy_idx;        /* target enemy (attack) */
-  int dest_r, dest_c;   /* destination tile (move) */
+  int      action;
+  Enemy_t* target;      /* attack */
 } NPCAction_t;
 
 static NPCAction_t npc_actions[MAX_NPCS];
-static int npc_action_count = 0;
-static int npc_action_idx   = 0;
 
-/* Saved pointers for async processing */
-static NPC_t*   t_npcs       = NULL;
-static int      t_npc_count  = 0;
-static Enemy_t* t_enemies    = NULL;
-static int      t_num_enemies = 0;
+/* Tiles taken this turn - NPCs and the player where they stand, and
+   where combat NPCs have already said they are going. Enemies move
+   between NPC actions, so they are looked up live. */
+static uint8_t* np_occ      = NULL;
+static int      np_occ_size = 0;
+static int      np_marked[MAX_NPCS * 2 + 1];
+static int      np_num_marked = 0;
+static int      np_ready = 0;
 
-/* Lunge callback data */
 typedef struct
 {
-  float* target;
-  float  home;
-} NPCLunge_t;
-
-static NPCLunge_t npc_lunge_data[MAX_NPCS * 2];
-static int npc_lunge_count = 0;
-
-static void npc_lunge_back( void* data )
-{
-  NPCLunge_t* lb = (NPCLunge_t*)data;
-  TweenFloat( &npc_tweens, lb->target, lb->home, 0.06f, TWEEN_EASE_OUT_CUBIC );
-}
+  int home;
+  int (*walkable)(int,int);
+} NPCPathCtx_t;
 
-static void start_next_npc_action( void );
+static int (*np_walkable)(int,int) = NULL;
 
-static int tweens_inited = 0;
+/* Slot reuse for the list NPCsInit was given */
+static int16_t    np_free[MAX_NPCS], np_live[MAX_NPCS];
+static uint16_t   np_gen[MAX_NPCS];
+static SlotPool_t np_pool = { np_free, 0, np_live, 0, np_gen, MAX_NPCS };
+static NPC_t*     np_list = NULL;
 
 void NPCsInit( NPC_t* list, int* count )
 {
   memset( list, 0, sizeof( NPC_t ) * MAX_NPCS );
   *count = 0;
+
+  np_list = list;
+  SlotPoolReset( &np_pool );
+}
+
+void NPCsCollect( NPC_t* list, int* count )
+{
+  if ( list != np_list ) return;
+  SlotPoolCollect( &np_pool, list, sizeof( NPC_t ),
+                   offsetof( NPC_t, alive ), count );
 }
 
 NPC_t* NPCSpawn( NPC_t* list, int* count,
                   int type_idx, int row, int col,
                   int tile_w, int tile_h )
 {
-  if ( *count >= MAX_NPCS || type_idx < 0 || type_idx >= g_num_npc_types )
+  if ( type_idx < 0 || type_idx >= g_num_npc_types ) return NULL;
+
+  int slot;
+  if ( list == np_list )        slot = SlotPoolAlloc( &np_pool, count );
+  else if ( *count < MAX_NPCS ) slot = ( *count )++;
+  else                          slot = -1;
+  if ( slot < 0 )
+  {
+    printf( "NPC: all %d slots taken, no '%s'\n", MAX_NPCS,
+            d_StringPeek( g_npc_types[type_idx].key ) );
     return NULL;
+  }
 
-  NPC_t* n = &list[*count];
+  NPC_t* n = &list[slot];
+  memset( n, 0, sizeof( NPC_t ) );
   n->type_idx = type_idx;
   n->row      = row;
   n->col      = col;
@@ -89,7 +105,7 @@ NPC_t* NPCSpawn( NPC_t* list, int* count,
   n->world_y   = col * tile_h + tile_h / 2.0f;
   n->alive     = 1;
   n->home_room = RoomAt( row, col );
-  ( *count )++;
+  RoomIndexNPC( n );
   return n;
 }
 
@@ -150,186 +166,171 @@ void NPCsDrawAll( aRectf_t vp_rect, GameCamera_t* cam,
   }
 }
 
-/* ---- Animated combat turn ---- */
+/* ---- Combat turn ---- */
 
-static void start_next_npc_action( void )
+static int np_Reserve( void )
 {
-  while ( npc_action_idx < npc_action_count )
+  int size = EnemyGridW() * EnemyGridH();
+  if ( size <= 0 ) return 0;
+  if ( size > np_occ_size )
   {
-    int i = npc_action_idx;
-    npc_action_idx++;
-    NPCAction_t* act = &npc_actions[i];
-
-    if ( act->action == NPC_ACT_ATTACK )
-    {
-      NPC_t* n = &t_npcs[i];
-      if ( !n->alive ) continue;
-      NPCType_t* nt = &g_npc_types[n->type_idx];
-      Enemy_t* target = &t_enemies[act->enemy_idx];
-
-      /* Deal damage */
-      target->hp -= nt->damage;
-      target->turns_since_hit = 0;
-      CombatVFXSpawnNumber( target->world_x, target->world_y,
-                            nt->damage, (aColor_t){ 0xcf, 0x57, 0x3c, 255 } );
-
-      /* Combat bark */
-      if ( d_StringGetLength( nt->combat_bark ) > 0 )
-        CombatVFXSpawnText( n->world_x, n->world_y,
-                            d_StringPeek( nt->combat_bark ), nt->color );
-
-      if ( target->hp <= 0 )
-        CombatHandleEnemyDeath( target );
-
-      /* Lunge toward target */
-      int dr = target->row - n->row;
-      int dc = target->col - n->col;
-      float lunge_dist = 3.0f;
-      npc_lunge_count = 0;
-
-      NPCLunge_t* lbx = &npc_lunge_data[npc_lunge_count++];
-      lbx->target = &n->world_x;
-      lbx->home   = n->world_x;
-      TweenFloatWithCallback( &npc_tweens, &n->world_x,
-                              n->world_x + dr * lunge_dist,
-                              0.06f, TWEEN_EASE_OUT_QUAD,
-                              npc_lunge_back, lbx );
-
-      NPCLunge_t* lby = &npc_lunge_data[npc_lunge_count++];
-      lby->target = &n->world_y;
-      lby->home   = n->world_y;
-      TweenFloatWithCallback( &npc_tweens, &n->world_y,
-                              n->world_y + dc * lunge_dist,
-                              0.06f, TWEEN_EASE_OUT_QUAD,
-                              npc_lunge_back, lby );
-
-      npc_turn_state = NPC_TURN_ANIM;
-      return;
-    }
-
-    if ( act->action == NPC_ACT_MOVE )
-    {
-      NPC_t* n = &t_npcs[i];
-      if ( !n->alive ) continue;
-
-      n->row = act->dest_r;
-      n->col = act->dest_c;
-      float tx = act->dest_r * 16 + 8.0f;
-      float ty = act->dest_c * 16 + 8.0f;
-      TweenFloat( &npc_tweens, &n->world_x, tx, 0.15f, TWEEN_EASE_OUT_CUBIC );
-      TweenFloat( &npc_tweens, &n->world_y, ty, 0.15f, TWEEN_EASE_OUT_CUBIC );
-
-      npc_turn_state = NPC_TURN_ANIM;
-      return;
-    }
+    uint8_t* grown = realloc( np_occ, size );
+    if ( !grown ) return 0;
+    np_occ      = grown;
+    np_occ_size = size;
+    memset( np_occ, 0, size );
   }
-
-  /* All actions processed */
-  npc_turn_state = NPC_TURN_IDLE;
+  return 1;
 }
 
-void NPCsCombatTick( NPC_t* list, int count,
-                     Enemy_t* enemies, int num_enemies )
+static int np_Index( int r, int c )
 {
-  static const int dx[] = { 1, -1, 0, 0 };
-  static const int dy[] = { 0, 0, 1, -1 };
-
-  if ( !tweens_inited )
-  {
-    InitTweenManager( &npc_tweens );
-    tweens_inited = 1;
-  }
+  if ( r < 0 || r >= EnemyGridW() || c < 0 || c >= EnemyGridH() ) return -1;
+  return c * EnemyGridW() + r;
+}
 
-  t_npcs        = list;
-  t_npc_count   = count;
-  t_enemies     = enemies;
-  t_num_enemies = num_enemies;
-  npc_action_count = count;
-  npc_action_idx   = 0;
+static void np_Mark( int r, int c )
+{
+  int i = np_Index( r, c );
+  if ( i < 0 || np_occ[i] ) return;
+  if ( np_num_marked >= (int)( sizeof( np_marked ) / sizeof( np_marked[0] ) ) )
+    return;
+  np_occ[i] = 1;
+  np_marked[np_num_marked++] = i;
+}
 
-  /* Pre-compute all actions */
-  for ( int i = 0; i < count; i++ )
-  {
-    npc_actions[i].action = NPC_ACT_NONE;
+static void np_Unmark( int r, int c )
+{
+  int i = np_Index( r, c );
+  if ( i >= 0 ) np_occ[i] = 0;
+}
 
-    if ( !list[i].alive ) continue;
-    NPCType_t* nt = &g_npc_types[list[i].type_idx];
-    if ( !nt->combat ) continue;
+static void np_ClearMarks( void )
+{
+  for ( int i = 0; i < np_num_marked; i++ ) np_occ[np_marked[i]] = 0;
+  np_num_marked = 0;
+}
 
-    int nr = list[i].row;
-    int nc = list[i].col;
-    int home = list[i].home_room;
+static int np_Blocked( int r, int c, void* ctx )
+{
+  NPCPathCtx_t* p = ctx;
+  if ( !p->walkable( r, c ) )   return 1;
+  if ( RoomAt( r, c ) != p->home ) return 1;
+  int i = np_Index( r, c );
+  if ( i < 0 || np_occ[i] ) return 1;
+
+  for ( Enemy_t* e = RoomIndexEnemies( p->home ); e; e = RoomIndexNextEnemy( e ) )
+    if ( e->row == r && e->col == c ) return 1;
+  return 0;
+}
 
-    /* Find closest enemy in the same room */
-    int best_idx  = -1;
-    int best_dist = 9999;
-    for ( int e = 0; e < num_enemies; e++ )
-    {
-      if ( !enemies[e].alive ) continue;
-      if ( RoomAt( enemies[e].row, enemies[e].col ) != home ) continue;
-      int d = abs( enemies[e].row - nr ) + abs( enemies[e].col - nc );
-      if ( d < best_dist )
-      {
-        best_dist = d;
-        best_idx  = e;
-      }
-    }
+void NPCsCombatBegin( NPC_t* list, int count, int player_row, int player_col,
+                      int (*walkable)(int,int) )
+{
+  for ( int i = 0; i < MAX_NPCS; i++ ) npc_actions[i].action = NPC_ACT_NONE;
+  np_ready = np_Reserve();
+  if ( !np_ready ) return;
+  np_walkable = walkable;
 
-    if ( best_idx < 0 ) continue;
+  np_Mark( player_row, player_col );
+  for ( int i = 0; i < count; i++ )
+    if ( list[i].alive ) np_Mark( list[i].row, list[i].col );
+}
 
-    /* Adjacent - attack */
-    if ( best_dist <= 1 )
+void NPCCombatAct( NPC_t* list, int i )
+{
+  if ( !np_ready || i < 0 || i >= MAX_NPCS ) return;
+
+  NPC_t* n = &list[i];
+  if ( !n->alive ) return;
+  NPCType_t* nt = &g_npc_types[n->type_idx];
+  if ( !nt->combat ) return;
+
+  /* Closest enemy in the same room */
+  Enemy_t* target    = NULL;
+  int      best_dist = 9999;
+  for ( Enemy_t* e = RoomIndexEnemies( n->home_room ); e;
+        e = RoomIndexNextEnemy( e ) )
+  {
+    int d = abs( e->row - n->row ) + abs( e->col - n->col );
+    if ( d < best_dist )
     {
-      npc_actions[i].action    = NPC_ACT_ATTACK;
-      npc_actions[i].enemy_idx = best_idx;
-      continue;
+      best_dist = d;
+      target    = e;
     }
+  }
 
-    /* Move toward target, stay in room */
-    Enemy_t* target = &enemies[best_idx];
-    int cur_dist = best_dist;
-    int move_r = nr, move_c = nc;
-    for ( int d = 0; d < 4; d++ )
-    {
-      int tr = nr + dx[d];
-      int tc = nc + dy[d];
-      if ( RoomAt( tr, tc ) != home ) continue;
-      if ( EnemyAt( enemies, num_enemies, tr, tc ) ) continue;
-      if ( NPCAt( list, count, tr, tc ) ) continue;
-      if ( tr == (int)( player.world_x / 16 ) &&
-           tc == (int)( player.world_y / 16 ) ) continue;
-      int nd = abs( target->row - tr ) + abs( target->col - tc );
-      if ( nd < cur_dist )
-      {
-        cur_dist = nd;
-        move_r = tr;
-        move_c = tc;
-      }
-    }
+  if ( !target ) return;
 
-    if ( move_r != nr || move_c != nc )
-    {
-      npc_actions[i].action = NPC_ACT_MOVE;
-      npc_actions[i].dest_r = move_r;
-      npc_actions[i].dest_c = move_c;
-    }
+  /* Adjacent - attack */
+  if ( best_dist <= 1 )
+  {
+    npc_actions[i].action = NPC_ACT_ATTACK;
+    npc_actions[i].target = target;
+    return;
   }
 
-  /* Kick off first action */
-  start_next_npc_action();
+  /* Step along a path that stays in the room and off every tile
+     somebody stands on or has claimed */
+  NPCPathCtx_t ctx    = { n->home_room, np_walkable };
+  PathLimits_t limits = { NPC_PATH_BUDGET, 0, 0 };
+  PathNode_t   path[PATH_MAX_LEN];
+  int len = RoomGraphPath( n->row, n->col, target->row, target->col,
+                           np_Blocked, &ctx, &limits, path );
+  if ( len < 2 ) return;
+
+  PathNode_t* next = &path[1];
+  if ( next->row == target->row && next->col == target->col ) return;
+
+  np_Unmark( n->row, n->col );
+  np_Mark( next->row, next->col );
+
+  n->row = next->row;
+  n->col = next->col;
+  RoomIndexNPC( n );
+  npc_actions[i].action = NPC_ACT_MOVE;
+
+  float tw = EnemyTileW(), th = EnemyTileH();
+  TurnTimelineSlide( &n->world_x, &n->world_y,
+                     n->row * tw + tw / 2.0f, n->col * th + th / 2.0f );
 }
 
-void NPCsUpdate( float dt )
+void NPCsCombatEnd( void )
 {
-  if ( npc_turn_state == NPC_TURN_IDLE ) return;
-  UpdateTweens( &npc_tweens, dt );
-  if ( GetActiveTweenCount( &npc_tweens ) == 0 )
-    start_next_npc_action();
+  if ( np_ready ) np_ClearMarks();
+  np_ready = 0;
 }
 
-int NPCsTurning( void )
+void NPCsCombatAttack( NPC_t* list, int count, float lunge_dist )
 {
-  return npc_turn_state != NPC_TURN_IDLE;
+  for ( int i = 0; i < count && i < MAX_NPCS; i++ )
+  {
+    if ( npc_actions[i].action != NPC_ACT_ATTACK ) continue;
+    npc_actions[i].action = NPC_ACT_NONE;
+
+    NPC_t*   n      = &list[i];
+    Enemy_t* target = npc_actions[i].target;
+    if ( !n->alive || !target->alive ) continue;
+    NPCType_t* nt = &g_npc_types[n->type_idx];
+
+    /* Deal damage */
+    target->hp -= nt->damage;
+    target->turns_since_hit = 0;
+    CombatVFXSpawnNumber( target->world_x, target->world_y,
+                          nt->damage, (aColor_t){ 0xcf, 0x57, 0x3c, 255 } );
+
+    /* Combat bark */
+    if ( d_StringGetLength( nt->combat_bark ) > 0 )
+      CombatVFXSpawnText( n->world_x, n->world_y,
+                          d_StringPeek( nt->combat_bark ), nt->color );
+
+    if ( target->hp <= 0 )
+      CombatHandleEnemyDeath( target );
+
+    TurnTimelineLunge( &n->world_x, &n->world_y,
+                       target->row - n->row, target->col - n->col,
+                       lunge_dist );
+  }
 }
 
 void NPCsIdleTick( NPC_t* list, int count, Console_t* con )
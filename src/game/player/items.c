@@ -1,21 +1,25 @@
 #include <stdio.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unistd.h>
 #include <Archimedes.h>
 #include <Daedalus.h>
 
+#include "data_cache.h"
 #include "items.h"
 #include "maps.h"
+#include "game_events.h"
 #include "player.h"
+#include "sprite_atlas.h"
+#include "res_pack.h"
+#include "sound_bank.h"
 
 ClassInfo_t      g_classes[3];
 const char*      g_class_keys[3] = { "mercenary", "rogue", "mage" };
 ConsumableInfo_t g_consumables[MAX_CONSUMABLES];
 int              g_num_consumables = 0;
 
-static aSoundEffect_t sfx_heal;
-static int sfx_heal_loaded = 0;
+static aSoundEffect_t* sfx_heal = NULL;
 OpenableInfo_t   g_openables[MAX_DOORS];
 int              g_num_openables = 0;
 EquipmentInfo_t  g_equipment[MAX_EQUIPMENT];
@@ -34,10 +38,22 @@ static aColor_t ParseDUFColor( dDUFValue_t* color_node )
   return c;
 }
 
+/* Images are loaded after the tables are filled, from DUF or from cache */
+static aImage_t* LoadItemImage( const char* path, const char* what, const char* name )
+{
+  if ( path[0] == '\0' ) return NULL;
+  if ( !ResExists( path ) )
+  {
+    fprintf( stderr, "FATAL: missing image '%s' for %s '%s'\n", path, what, name );
+    exit( 1 );
+  }
+  return AtlasQueue( path );
+}
+
 static void LoadCharacterData( void )
 {
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( "resources/data/characters.duf", &root );
+  dDUFError_t* err = ResParseDUF( "resources/data/characters.duf", &root );
 
   if ( err != NULL )
   {
@@ -71,26 +87,87 @@ static void LoadCharacterData( void )
     if ( glyph ) strncpy( g_classes[i].glyph, glyph->value_string, 7 );
     g_classes[i].color = ParseDUFColor( color );
 
-    if ( img_path && strlen( img_path->value_string ) > 0 )
-    {
-      if ( access( img_path->value_string, F_OK ) != 0 )
-      {
-        fprintf( stderr, "FATAL: missing image '%s' for class '%s'\n",
-                 img_path->value_string, g_classes[i].name );
-        exit( 1 );
-      }
-      g_classes[i].image = a_ImageLoad( img_path->value_string );
-    }
+    if ( img_path )
+      snprintf( g_classes[i].image_path, sizeof( g_classes[i].image_path ), "%s", img_path->value_string );
   }
 
   d_DUFFree( root );
 }
 
-static void ParseConsumableEntry( dDUFValue_t* entry )
+static const char* g_cons_type_names[CONS_TYPE_COUNT] = {
+  [CONS_TYPE_NONE]   = "",
+  [CONS_TYPE_FOOD]   = "food",
+  [CONS_TYPE_GADGET] = "gadget",
+  [CONS_TYPE_SCROLL] = "scroll",
+  [CONS_TYPE_POTION] = "potion",
+  [CONS_TYPE_QUEST]  = "quest",
+  [CONS_TYPE_PICKUP] = "pickup",
+};
+
+static const char* g_cons_effect_names[CONS_EFFECT_COUNT] = {
+  [CONS_EFFECT_NONE]         = "none",
+  [CONS_EFFECT_HEAL]         = "heal",
+  [CONS_EFFECT_EMPOWER]      = "empower",
+  [CONS_EFFECT_LIFESTEAL]    = "lifesteal",
+  [CONS_EFFECT_LURE]         = "lure",
+  [CONS_EFFECT_EAT_SANDWICH] = "eat_sandwich",
+  [CONS_EFFECT_SHOOT]        = "shoot",
+  [CONS_EFFECT_PIERCE]       = "pierce",
+  [CONS_EFFECT_STEW_THROW]   = "stew_throw",
+  [CONS_EFFECT_POISON]       = "poison",
+  [CONS_EFFECT_TRAP_ROOT]    = "trap_root",
+  [CONS_EFFECT_SMOKE]        = "smoke",
+  [CONS_EFFECT_MAGIC_BOLT]   = "magic_bolt",
+  [CONS_EFFECT_FREEZE]       = "freeze",
+  [CONS_EFFECT_AOE]          = "aoe",
+  [CONS_EFFECT_SWAP]         = "swap",
+  [CONS_EFFECT_REACH]        = "reach",
+  [CONS_EFFECT_CLEAVE]       = "cleave",
+  [CONS_EFFECT_FIRE_CONE]    = "fire_cone",
+};
+
+static const char* g_cons_special_keys[CONS_SPECIAL_COUNT] = {
+  [CONS_SPECIAL_NONE]          = "",
+  [CONS_SPECIAL_CAVE_MUSHROOM] = "cave_mushroom",
+  [CONS_SPECIAL_BAG]           = "bag",
+  [CONS_SPECIAL_SACK]          = "sack",
+  [CONS_SPECIAL_MAX_HEALTH]    = "max_health",
+  [CONS_SPECIAL_HEARTHSTONE]   = "hearthstone",
+};
+
+/* Index of str in names[], or -1 */
+static int LookupName( const char* str, const char** names, int count )
+{
+  for ( int i = 0; i < count; i++ )
+    if ( names[i][0] != '\0' && strcmp( str, names[i] ) == 0 ) return i;
+  return -1;
+}
+
+static void ResolveConsumable( ConsumableInfo_t* c )
 {
-  if ( g_num_consumables >= MAX_CONSUMABLES ) return;
+  int id;
+
+  c->type_id = CONS_TYPE_NONE;
+  if ( ( id = LookupName( c->type, g_cons_type_names, CONS_TYPE_COUNT ) ) >= 0 )
+    c->type_id = (ConsumableType_t)id;
+  else
+    printf( "ITEMS: unknown consumable type '%s' on '%s'\n", c->type, c->key );
+
+  c->effect_id = CONS_EFFECT_NONE;
+  if ( c->effect[0] != '\0'
+       && ( id = LookupName( c->effect, g_cons_effect_names, CONS_EFFECT_COUNT ) ) >= 0 )
+    c->effect_id = (ConsumableEffect_t)id;
+  else if ( c->effect[0] != '\0' )
+    printf( "ITEMS: unknown consumable effect '%s' on '%s', treated as none\n",
+            c->effect, c->key );
 
-  ConsumableInfo_t* c = &g_consumables[g_num_consumables];
+  c->special_id = CONS_SPECIAL_NONE;
+  if ( ( id = LookupName( c->key, g_cons_special_keys, CONS_SPECIAL_COUNT ) ) >= 0 )
+    c->special_id = (ConsumableSpecial_t)id;
+}
+
+static void ParseConsumableEntry( dDUFValue_t* entry, ConsumableInfo_t* c )
+{
   memset( c, 0, sizeof( ConsumableInfo_t ) );
 
   if ( entry->key )
@@ -112,6 +189,7 @@ static void ParseConsumableEntry( dDUFValue_t* entry )
   if ( desc )   strncpy( c->description, desc->value_string, 255 );
   if ( bdmg )   c->bonus_damage = (int)bdmg->value_int;
   c->color = ParseDUFColor( color );
+  ResolveConsumable( c );
 
   dDUFValue_t* v;
   if ( ( v = d_DUFGetObjectItem( entry, "range" ) ) )        c->range        = (int)v->value_int;
@@ -132,24 +210,14 @@ static void ParseConsumableEntry( dDUFValue_t* entry )
   if ( gives )       strncpy( c->gives, gives->value_string, MAX_NAME_LENGTH - 1 );
   if ( use_message ) strncpy( c->use_message, use_message->value_string, 255 );
 
-  if ( img_path && strlen( img_path->value_string ) > 0 )
-  {
-    if ( access( img_path->value_string, F_OK ) != 0 )
-    {
-      fprintf( stderr, "FATAL: missing image '%s' for consumable '%s'\n",
-               img_path->value_string, c->name );
-      exit( 1 );
-    }
-    c->image = a_ImageLoad( img_path->value_string );
-  }
-
-  g_num_consumables++;
+  if ( img_path )
+    snprintf( c->image_path, sizeof( c->image_path ), "%s", img_path->value_string );
 }
 
 static void LoadConsumableDUF( const char* path )
 {
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( path, &root );
+  dDUFError_t* err = ResParseDUF( path, &root );
 
   if ( err != NULL )
   {
@@ -159,8 +227,10 @@ static void LoadConsumableDUF( const char* path )
     return;
   }
 
-  for ( dDUFValue_t* entry = root->child; entry != NULL; entry = entry->next )
-    ParseConsumableEntry( entry );
+  for ( dDUFValue_t* entry = root->child;
+        entry != NULL && g_num_consumables < MAX_CONSUMABLES;
+        entry = entry->next )
+    ParseConsumableEntry( entry, &g_consumables[g_num_consumables++] );
 
   d_DUFFree( root );
 }
@@ -174,7 +244,7 @@ static void LoadConsumableData( void )
 static void LoadOpenableData( void )
 {
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( "resources/data/openables.duf", &root );
+  dDUFError_t* err = ResParseDUF( "resources/data/openables.duf", &root );
 
   if ( err != NULL )
   {
@@ -205,16 +275,8 @@ static void LoadOpenableData( void )
     if ( desc )  strncpy( o->description, desc->value_string, 255 );
     o->color = ParseDUFColor( color );
 
-    if ( img_path && strlen( img_path->value_string ) > 0 )
-    {
-      if ( access( img_path->value_string, F_OK ) != 0 )
-      {
-        fprintf( stderr, "FATAL: missing image '%s' for openable '%s'\n",
-                 img_path->value_string, o->name );
-        exit( 1 );
-      }
-      o->image = a_ImageLoad( img_path->value_string );
-    }
+    if ( img_path )
+      snprintf( o->image_path, sizeof( o->image_path ), "%s", img_path->value_string );
 
     g_num_openables++;
   }
@@ -222,10 +284,38 @@ static void LoadOpenableData( void )
   d_DUFFree( root );
 }
 
+static const char* g_equip_effect_names[EQUIP_EFFECT_COUNT] = {
+  [EQUIP_EFFECT_NONE]         = "none",
+  [EQUIP_EFFECT_FIRST_STRIKE] = "first_strike",
+  [EQUIP_EFFECT_SCROLL_ECHO]  = "scroll_echo",
+  [EQUIP_EFFECT_BERSERK]      = "berserk",
+  [EQUIP_EFFECT_POISON]       = "poison",
+  [EQUIP_EFFECT_AMPLIFY]      = "amplify",
+  [EQUIP_EFFECT_DODGE]        = "dodge",
+  [EQUIP_EFFECT_ARMOR_BREAK]  = "armor_break",
+  [EQUIP_EFFECT_MANA_SHIELD]  = "mana_shield",
+  [EQUIP_EFFECT_COMPANION]    = "companion",
+  [EQUIP_EFFECT_GOLD_BONUS]   = "gold_bonus",
+  [EQUIP_EFFECT_THORNS]       = "thorns",
+};
+
+static EquipEffect_t ResolveEquipEffect( const EquipmentInfo_t* e, const char* path )
+{
+  if ( e->effect[0] == '\0' ) return EQUIP_EFFECT_NONE;
+
+  for ( int i = 0; i < EQUIP_EFFECT_COUNT; i++ )
+    if ( strcmp( e->effect, g_equip_effect_names[i] ) == 0 )
+      return (EquipEffect_t)i;
+
+  printf( "ITEMS: unknown effect '%s' on '%s' in %s, treated as none\n",
+          e->effect, e->key, path );
+  return EQUIP_EFFECT_NONE;
+}
+
 static void LoadEquipmentDUF( const char* path )
 {
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( path, &root );
+  dDUFError_t* err = ResParseDUF( path, &root );
 
   if ( err != NULL )
   {
@@ -266,18 +356,11 @@ static void LoadEquipmentDUF( const char* path )
     if ( dmg )    e->damage = (int)dmg->value_int;
     if ( def )    e->defense = (int)def->value_int;
     if ( effval ) e->effect_value = (int)effval->value_int;
+    e->effect_id = ResolveEquipEffect( e, path );
     e->color = ParseDUFColor( color );
 
-    if ( img_path && strlen( img_path->value_string ) > 0 )
-    {
-      if ( access( img_path->value_string, F_OK ) != 0 )
-      {
-        fprintf( stderr, "FATAL: missing image '%s' for equipment '%s'\n",
-                 img_path->value_string, e->name );
-        exit( 1 );
-      }
-      e->image = a_ImageLoad( img_path->value_string );
-    }
+    if ( img_path )
+      snprintf( e->image_path, sizeof( e->image_path ), "%s", img_path->value_string );
 
     g_num_equipment++;
   }
@@ -296,6 +379,67 @@ static void LoadEquipmentData( void )
   LoadEquipmentDUF( "resources/data/equipment_drops.duf" );
 }
 
+static const char* g_item_sources[] = {
+  "resources/data/characters.duf",
+  "resources/data/consumables.duf",
+  "resources/data/openables.duf",
+  "resources/data/equipment_starters.duf",
+  "resources/data/equipment_shop.duf",
+  "resources/data/equipment_drops.duf",
+};
+#define NUM_ITEM_SOURCES ( (int)( sizeof( g_item_sources ) / sizeof( g_item_sources[0] ) ) )
+
+static void ItemsLoadImages( void )
+{
+  for ( int i = 0; i < 3; i++ )
+    g_classes[i].image = LoadItemImage( g_classes[i].image_path, "class", g_classes[i].name );
+  for ( int i = 0; i < g_num_consumables; i++ )
+    g_consumables[i].image = LoadItemImage( g_consumables[i].image_path, "consumable",
+                                            g_consumables[i].name );
+  for ( int i = 0; i < g_num_openables; i++ )
+    g_openables[i].image = LoadItemImage( g_openables[i].image_path, "openable",
+                                          g_openables[i].name );
+  for ( int i = 0; i < g_num_equipment; i++ )
+    g_equipment[i].image = LoadItemImage( g_equipment[i].image_path, "equipment",
+                                          g_equipment[i].name );
+}
+
+/* What the cached item tables depend on beyond their sizes - see
+   DataCacheLayout */
+#define ITEMS_LAYOUT( facts ) \
+  DataCacheLayout( facts, (int)( sizeof( facts ) / sizeof( facts[0] ) ) )
+
+static const size_t items_class_layout[] = {
+  MAX_NAME_LENGTH,
+  offsetof( ClassInfo_t, hp ),          offsetof( ClassInfo_t, consumable_type ),
+  offsetof( ClassInfo_t, glyph ),       offsetof( ClassInfo_t, color ),
+  offsetof( ClassInfo_t, image_path ),  offsetof( ClassInfo_t, image ),
+};
+
+static const size_t items_consumable_layout[] = {
+  offsetof( ConsumableInfo_t, glyph ),       offsetof( ConsumableInfo_t, color ),
+  offsetof( ConsumableInfo_t, effect ),      offsetof( ConsumableInfo_t, type_id ),
+  offsetof( ConsumableInfo_t, special_id ),  offsetof( ConsumableInfo_t, use ),
+  offsetof( ConsumableInfo_t, range ),       offsetof( ConsumableInfo_t, aoe_radius ),
+  offsetof( ConsumableInfo_t, description ), offsetof( ConsumableInfo_t, use_message ),
+  offsetof( ConsumableInfo_t, image_path ),  offsetof( ConsumableInfo_t, image ),
+  CONS_TYPE_COUNT, CONS_EFFECT_COUNT, CONS_SPECIAL_COUNT,
+};
+
+static const size_t items_openable_layout[] = {
+  offsetof( OpenableInfo_t, glyph ),       offsetof( OpenableInfo_t, color ),
+  offsetof( OpenableInfo_t, required_type ),
+  offsetof( OpenableInfo_t, image_path ),  offsetof( OpenableInfo_t, image ),
+};
+
+static const size_t items_equipment_layout[] = {
+  offsetof( EquipmentInfo_t, glyph ),       offsetof( EquipmentInfo_t, color ),
+  offsetof( EquipmentInfo_t, damage ),      offsetof( EquipmentInfo_t, effect_id ),
+  offsetof( EquipmentInfo_t, class_name ),  offsetof( EquipmentInfo_t, description ),
+  offsetof( EquipmentInfo_t, image_path ),  offsetof( EquipmentInfo_t, image ),
+  EQUIP_EFFECT_COUNT,
+};
+
 void ItemsLoadAll( void )
 {
   memset( g_classes, 0, sizeof( g_classes ) );
@@ -306,13 +450,82 @@ void ItemsLoadAll( void )
   g_num_openables = 0;
   g_num_equipment = 0;
 
-  LoadCharacterData();
-  LoadConsumableData();
-  LoadOpenableData();
-  LoadEquipmentData();
+  int num_classes  = 3;
+  int num_starters = 1;
+  DataCacheTable_t tables[] = {
+    { g_classes,       sizeof( ClassInfo_t ),      3,               &num_classes,
+      ITEMS_LAYOUT( items_class_layout ) },
+    { g_consumables,   sizeof( ConsumableInfo_t ), MAX_CONSUMABLES, &g_num_consumables,
+      ITEMS_LAYOUT( items_consumable_layout ) },
+    { g_openables,     sizeof( OpenableInfo_t ),   MAX_DOORS,       &g_num_openables,
+      ITEMS_LAYOUT( items_openable_layout ) },
+    { g_equipment,     sizeof( EquipmentInfo_t ),  MAX_EQUIPMENT,   &g_num_equipment,
+      ITEMS_LAYOUT( items_equipment_layout ) },
+    { &g_num_starters, sizeof( int ),              1,               &num_starters, 0 },
+  };
+  int num_tables = (int)( sizeof( tables ) / sizeof( tables[0] ) );
+
+  if ( !DataCacheLoad( "items", g_item_sources, NUM_ITEM_SOURCES, tables, num_tables ) )
+  {
+    LoadCharacterData();
+    LoadConsumableData();
+    LoadOpenableData();
+    LoadEquipmentData();
+    DataCacheSave( "items", g_item_sources, NUM_ITEM_SOURCES, tables, num_tables );
+  }
+
+  /* Pointers in the tables are never valid after a cache load */
+  ItemsLoadImages();
+  GameEventsBindConsumables();
   MapsLoadAll();
 }
 
+/* Patch consumables in place by key - inventory slots, ground items and
+   shop stock hold indices, so those must not move. Other item files are
+   cached together and still need a restart. */
+void ItemsReloadFile( const char* path )
+{
+  if ( strcmp( path, "resources/data/consumables.duf" ) != 0 )
+  {
+    printf( "ITEMS: %s changed - restart to pick it up\n", path );
+    return;
+  }
+
+  dDUFValue_t* root = NULL;
+  dDUFError_t* err = ResParseDUF( path, &root );
+  if ( err != NULL )
+  {
+    printf( "DUF parse error in %s at %d:%d - %s\n",
+            path, err->line, err->column, d_StringPeek( err->message ) );
+    d_DUFErrorFree( err );
+    return;
+  }
+
+  for ( dDUFValue_t* entry = root->child; entry != NULL; entry = entry->next )
+  {
+    ConsumableInfo_t fresh;
+    ParseConsumableEntry( entry, &fresh );
+
+    int idx = ConsumableByKey( fresh.key );
+    if ( idx < 0 )
+    {
+      if ( g_num_consumables >= MAX_CONSUMABLES ) continue;
+      idx = g_num_consumables++;
+    }
+
+    ConsumableInfo_t* c = &g_consumables[idx];
+    if ( strcmp( fresh.image_path, c->image_path ) == 0 )
+      fresh.image = c->image;
+    else if ( fresh.image_path[0] != '\0' && ResExists( fresh.image_path ) )
+      fresh.image = AtlasQueue( fresh.image_path );
+
+    *c = fresh;
+  }
+
+  d_DUFFree( root );
+  GameEventsBindConsumables();
+}
+
 int ItemsBuildFiltered( int class_idx, FilteredItem_t* out, int max_out, int include_universal )
 {
   int count = 0;
@@ -326,8 +539,8 @@ int ItemsBuildFiltered( int class_idx, FilteredItem_t* out, int max_out, int inc
   {
     int match = strncmp( g_consumables[i].type, ctype, strlen( g_consumables[i].type ) ) == 0;
     if ( !match && include_universal )
-      match = strcmp( g_consumables[i].type, "potion" ) == 0 ||
-              strcmp( g_consumables[i].type, "quest" ) == 0;
+      match = g_consumables[i].type_id == CONS_TYPE_POTION ||
+              g_consumables[i].type_id == CONS_TYPE_QUEST;
     if ( match )
     {
       out[count].type = FILTERED_CONSUMABLE;
@@ -353,75 +566,55 @@ int ItemsBuildFiltered( int class_idx, FilteredItem_t* out, int max_out, int inc
 
 extern Player_t player;
 
-void PlayerInitStats( void )
-{
-  const char* k1 = "damage";
-  const char* k2 = "defense";
-  const void* keys[]   = { &k1, &k2 };
-  int zero = 0;
-  const void* values[] = { &zero, &zero };
-
-  player.stats = d_InitStaticTable(
-    sizeof( const char* ), sizeof( int ),
-    d_HashString, d_CompareString,
-    4, keys, values, 2
-  );
-}
+static int g_player_version = 0;   /* bumped on any HUD-visible change */
 
-void PlayerRecalcStats( void )
+int PlayerVersion( void )
 {
-  int total_dmg = player.class_damage;
-  int total_def = player.class_defense;
-
-  for ( int i = 0; i < EQUIP_SLOTS; i++ )
-  {
-    if ( player.equipment[i] < 0 ) continue;
-    total_dmg += g_equipment[ player.equipment[i] ].damage;
-    total_def += g_equipment[ player.equipment[i] ].defense;
-  }
-
-  const char* k_dmg = "damage";
-  const char* k_def = "defense";
-  d_StaticTableSet( player.stats, &k_dmg, &total_dmg );
-  d_StaticTableSet( player.stats, &k_def, &total_def );
+  return g_player_version;
 }
 
-int PlayerStat( const char* key )
+void PlayerTouch( void )
 {
-  int* v = (int*)d_StaticTableGet( player.stats, &key );
-  return v ? *v : 0;
+  g_player_version++;
 }
 
-int PlayerEquipEffect( const char* name )
+void PlayerRecalcStats( void )
 {
-  int total = 0;
+  PlayerDerived_t* d = &player.derived;
+  int count[EQUIP_EFFECT_COUNT] = { 0 };
+
+  memset( d, 0, sizeof( PlayerDerived_t ) );
+  d->damage  = player.class_damage;
+  d->defense = player.class_defense;
+  for ( int i = 0; i < EQUIP_EFFECT_COUNT; i++ )
+    d->effect_item[i] = -1;
+
   for ( int i = 0; i < EQUIP_SLOTS; i++ )
   {
     if ( player.equipment[i] < 0 ) continue;
-    EquipmentInfo_t* eq = &g_equipment[player.equipment[i]];
-    if ( strcmp( eq->effect, name ) == 0 )
-      total += eq->effect_value;
+    EquipmentInfo_t* eq = &g_equipment[ player.equipment[i] ];
+    d->damage  += eq->damage;
+    d->defense += eq->defense;
+
+    int id = eq->effect_id;
+    if ( id == EQUIP_EFFECT_NONE ) continue;
+
+    d->effect[id] += eq->effect_value;
+    if ( count[id] == 0 || eq->effect_value < d->effect_min[id] )
+      d->effect_min[id] = eq->effect_value;
+    if ( d->effect_item[id] < 0 )
+      d->effect_item[id] = player.equipment[i];
+    count[id]++;
   }
-  return total;
-}
 
-int PlayerEquipEffectMin( const char* name )
-{
-  int best = 0;
-  int count = 0;
-  for ( int i = 0; i < EQUIP_SLOTS; i++ )
+  /* Stacked duplicates of a "min" effect (scroll_echo) halve the threshold */
+  for ( int i = 0; i < EQUIP_EFFECT_COUNT; i++ )
   {
-    if ( player.equipment[i] < 0 ) continue;
-    EquipmentInfo_t* eq = &g_equipment[player.equipment[i]];
-    if ( strcmp( eq->effect, name ) == 0 )
-    {
-      if ( count == 0 || eq->effect_value < best )
-        best = eq->effect_value;
-      count++;
-    }
+    if ( count[i] >= 2 ) d->effect_min[i] /= 2;
+    if ( d->effect_min[i] < 0 ) d->effect_min[i] = 0;
   }
-  if ( count >= 2 ) best /= 2;
-  return best > 0 ? best : 0;
+
+  g_player_version++;
 }
 
 int EquipSlotForKind( const char* kind )
@@ -439,14 +632,14 @@ int EquipSlotForKind( const char* kind )
 
 int EquipSlotForTrinket( int equip_idx )
 {
-  const char* new_eff = g_equipment[equip_idx].effect;
+  EquipEffect_t new_eff = g_equipment[equip_idx].effect_id;
 
   /* Block if the other trinket slot already has the same effect */
   if ( player.equipment[EQUIP_TRINKET1] >= 0
-       && strcmp( g_equipment[player.equipment[EQUIP_TRINKET1]].effect, new_eff ) == 0 )
+       && g_equipment[player.equipment[EQUIP_TRINKET1]].effect_id == new_eff )
     return EQUIP_TRINKET1;  /* swap into same slot */
   if ( player.equipment[EQUIP_TRINKET2] >= 0
-       && strcmp( g_equipment[player.equipment[EQUIP_TRINKET2]].effect, new_eff ) == 0 )
+       && g_equipment[player.equipment[EQUIP_TRINKET2]].effect_id == new_eff )
     return EQUIP_TRINKET2;  /* swap into same slot */
 
   /* First empty slot, or default to slot 2 */
@@ -495,6 +688,13 @@ int ConsumableByKey( const char* key )
   return -1;
 }
 
+int ConsumableTargeted( const ConsumableInfo_t* c )
+{
+  return c->type_id == CONS_TYPE_GADGET
+      || c->type_id == CONS_TYPE_SCROLL
+      || ( c->type_id == CONS_TYPE_FOOD && c->range > 0 );
+}
+
 int EquipmentByKey( const char* key )
 {
   for ( int i = 0; i < g_num_equipment; i++ )
@@ -556,6 +756,7 @@ void PlayerFullReset( int class_index )
   player.last_room_id = -1;
   for ( int i = 0; i < EQUIP_SLOTS; i++ )
     player.equipment[i] = -1;
+  PlayerRecalcStats();
 }
 
 void PlayerTakeDamage( int amount )
@@ -563,37 +764,43 @@ void PlayerTakeDamage( int amount )
   player.hp -= amount;
   player.turns_since_hit = 0;
   if ( player.hp <= 0 ) player.hp = 0;
+  g_player_version++;
+}
+
+void ItemsReleaseSounds( void )
+{
+  SoundBankRelease( &sfx_heal );
 }
 
 void PlayerHeal( int amount )
 {
-  if ( !sfx_heal_loaded )
-  {
-    a_AudioLoadSound( "resources/soundeffects/heal.wav", &sfx_heal );
-    sfx_heal_loaded = 1;
-  }
+  if ( !sfx_heal )
+    SoundBankAcquire( &sfx_heal, "resources/soundeffects/heal.wav" );
   player.hp += amount;
   if ( player.hp > player.max_hp ) player.hp = player.max_hp;
-  a_AudioPlaySound( &sfx_heal, NULL );
+  g_player_version++;
+  SoundBankPlay( sfx_heal, NULL );
 }
 
 void PlayerAddGold( int amount )
 {
   player.gold += amount;
+  g_player_version++;
 }
 
 int PlayerSpendGold( int amount )
 {
   if ( player.gold < amount ) return 0;
   player.gold -= amount;
+  g_player_version++;
   return 1;
 }
 
-void PlayerApplyBuff( int bonus_dmg, const char* effect, int heal )
+void PlayerApplyBuff( int bonus_dmg, ConsumableEffect_t effect, int heal )
 {
   player.buff.active = 1;
   player.buff.bonus_damage = bonus_dmg;
-  strncpy( player.buff.effect, effect, MAX_NAME_LENGTH - 1 );
+  player.buff.effect = effect;
   player.buff.heal = heal;
 }
 
@@ -611,11 +818,13 @@ void PlayerSetWorldPos( float x, float y )
 void PlayerResetFirstStrike( void )
 {
   player.first_strike_active = 1;
+  g_player_version++;
 }
 
 void PlayerConsumeFirstStrike( void )
 {
   player.first_strike_active = 0;
+  g_player_version++;
 }
 
 void PlayerTickTurnsSinceHit( void )
@@ -630,6 +839,7 @@ void PlayerSetRoom( int room_id )
   {
     player.fs_visited |= ( 1u << room_id );
     player.first_strike_active = 1;
+    g_player_version++;
   }
 }
 
@@ -637,4 +847,5 @@ void PlayerEquip( int slot, int index )
 {
   if ( slot >= 0 && slot < EQUIP_SLOTS )
     player.equipment[slot] = index;
+  PlayerRecalcStats();
 }
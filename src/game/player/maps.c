@@ -1,11 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unistd.h>
 #include <Archimedes.h>
 #include <Daedalus.h>
 
 #include "maps.h"
+#include "sprite_atlas.h"
+#include "res_pack.h"
 
 MapInfo_t g_maps[MAX_MAPS];
 int       g_num_maps = 0;
@@ -29,7 +30,7 @@ void MapsLoadAll( void )
   memset( g_maps, 0, sizeof( g_maps ) );
 
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( "resources/data/items_maps.duf", &root );
+  dDUFError_t* err = ResParseDUF( "resources/data/items_maps.duf", &root );
 
   if ( err != NULL )
   {
@@ -65,13 +66,13 @@ void MapsLoadAll( void )
 
     if ( img_path && strlen( img_path->value_string ) > 0 )
     {
-      if ( access( img_path->value_string, F_OK ) != 0 )
+      if ( !ResExists( img_path->value_string ) )
       {
         fprintf( stderr, "FATAL: missing image '%s' for map '%s'\n",
                  img_path->value_string, m->name );
         exit( 1 );
       }
-      m->image = a_ImageLoad( img_path->value_string );
+      m->image = AtlasQueue( img_path->value_string );
     }
 
     g_num_maps++;
@@ -8,6 +8,7 @@
 #include "movement.h"
 #include "doors.h"
 #include "dev_mode.h"
+#include "sound_bank.h"
 
 extern Player_t player;
 
@@ -25,7 +26,7 @@ static float bounce_oy = 0;
 /* Viewport shake */
 static float shake_ox = 0;
 static float shake_oy = 0;
-static aSoundEffect_t sfx_wall;
+static aSoundEffect_t* sfx_wall = NULL;
 static aTimer_t* wall_bump_timer = NULL;
 #define WALL_BUMP_COOLDOWN_MS 300
 
@@ -58,7 +59,12 @@ void MovementInit( World_t* w )
   if ( !wall_bump_timer ) wall_bump_timer = a_TimerCreate();
   rapid_active = 0;
 
-  a_AudioLoadSound( "resources/soundeffects/wall_impact.wav", &sfx_wall );
+  SoundBankAcquire( &sfx_wall, "resources/soundeffects/wall_impact.wav" );
+}
+
+void MovementReleaseSounds( void )
+{
+  SoundBankRelease( &sfx_wall );
 }
 
 void MovementUpdate( float dt )
@@ -98,16 +104,14 @@ int TileWalkable( int r, int c )
 {
   if ( r < 0 || r >= world->width || c < 0 || c >= world->height ) return 0;
   int idx = c * world->width + r;
-  if ( world->background[idx].solid ) return 0;
-  if ( world->midground[idx].solid ) return 0;
-  return 1;
+  return !WORLD_BLOCKS_MOVE( world, idx );
 }
 
 int TileHasDoor( int r, int c )
 {
   if ( r < 0 || r >= world->width || c < 0 || c >= world->height ) return 0;
   int idx = c * world->width + r;
-  return DoorIsDoor( world->midground[idx].tile );
+  return DoorIsDoor( world->midground[idx] );
 }
 
 void PlayerStartMove( int r, int c )
@@ -178,7 +182,7 @@ void PlayerWallBump( int dr, int dc )
   if ( !a_TimerStarted( wall_bump_timer )
        || a_TimerGetTicks( wall_bump_timer ) > WALL_BUMP_COOLDOWN_MS )
   {
-    a_AudioPlaySound( &sfx_wall, NULL );
+    SoundBankPlay( sfx_wall, NULL );
     a_TimerStart( wall_bump_timer );
   }
   PlayerShake( dr, dc );
@@ -17,11 +17,13 @@
 #include "visibility.h"
 #include "game_turns.h"
 #include "dev_mode.h"
+#include "sound_bank.h"
+#include "room_index.h"
 
 extern Player_t player;
 
 static Console_t* console = NULL;
-static aSoundEffect_t sfx_hit;
+static aSoundEffect_t* sfx_hit = NULL;
 
 /* Enemy list for buff effects (cleave, reach) */
 static Enemy_t* combat_enemies     = NULL;
@@ -94,13 +96,18 @@ void CombatSetGroundItems( GroundItem_t* list, int* count )
 void CombatInit( Console_t* con )
 {
   console = con;
-  a_AudioLoadSound( "resources/soundeffects/hit_impact.wav", &sfx_hit );
+  SoundBankAcquire( &sfx_hit, "resources/soundeffects/hit_impact.wav" );
   InitTweenManager( &hit_tweens );
   hit_shake_x = 0;
   hit_shake_y = 0;
   hit_flash_alpha = 0;
 }
 
+void CombatReleaseSounds( void )
+{
+  SoundBankRelease( &sfx_hit );
+}
+
 void CombatUpdate( float dt )
 {
   UpdateTweens( &hit_tweens, dt );
@@ -115,17 +122,16 @@ void CombatHandleEnemyDeath( Enemy_t* e )
   EnemyType_t* t = &g_enemy_types[e->type_idx];
 
   e->alive = 0;
+  RoomIndexEnemy( e );
   ConsolePushF( console, (aColor_t){ 0x75, 0xa7, 0x43, 255 },
                 "You defeated the %s!", t->name );
 
-  char kill_flag[MAX_NAME_LENGTH + 8];
-  snprintf( kill_flag, sizeof( kill_flag ), "%s_kills", t->key );
-  FlagIncr( kill_flag );
+  FlagIncrId( t->kill_flag );
 
   /* Gold drop */
   if ( t->gold_drop > 0 )
   {
-    int gold_bonus = PlayerEquipEffect( "gold_bonus" );
+    int gold_bonus = player.derived.effect[EQUIP_EFFECT_GOLD_BONUS];
     int total = t->gold_drop + gold_bonus;
     PlayerAddGold( total );
     ConsolePushF( console, (aColor_t){ 0xda, 0xaf, 0x20, 255 },
@@ -171,8 +177,7 @@ void CombatHandleEnemyDeath( Enemy_t* e )
   }
 
   /* On-death hazard: spawn poison pool */
-  if ( t->on_death[0] != '\0'
-       && strcmp( t->on_death, "poison_pool" ) == 0 )
+  if ( t->death_effect == ENEMY_DEATH_POISON_POOL )
   {
     PoisonPoolSpawn( e->row, e->col, t->pool_duration, t->pool_damage,
                      t->color );
@@ -182,64 +187,27 @@ void CombatHandleEnemyDeath( Enemy_t* e )
   }
 
   /* Death flag: set a game flag when this enemy type dies */
-  if ( t->death_flag[0] != '\0' )
-    FlagSet( t->death_flag, 1 );
+  if ( t->death_flag_id >= 0 )
+    FlagSetId( t->death_flag_id, 1 );
 
-  /* Greta death: spawn her ledger NPC */
-  if ( strcmp( t->key, "greta" ) == 0 )
-    EnemyOnGretaDeath( e->row, e->col );
-
-  /* Linked death: shaman dies → totem crumbles */
-  if ( strcmp( t->ai, "shaman" ) == 0
-       && combat_enemies && combat_enemy_count )
-  {
-    for ( int i = 0; i < *combat_enemy_count; i++ )
-    {
-      if ( !combat_enemies[i].alive ) continue;
-      if ( strcmp( g_enemy_types[combat_enemies[i].type_idx].ai, "static" ) != 0 )
-        continue;
-      combat_enemies[i].alive = 0;
-      CombatVFXSpawnText( combat_enemies[i].world_x, combat_enemies[i].world_y,
-                          "Crumbles!", (aColor_t){ 160, 120, 60, 255 } );
-      ConsolePushF( console, (aColor_t){ 160, 120, 60, 255 },
-                    "The War Totem crumbles!" );
-    }
-  }
+  /* Someone left standing over the body (Greta's ledger) */
+  if ( t->death_npc[0] != '\0' )
+    EnemySpawnDeathNPC( t->death_npc, e->row, e->col );
 
-  /* Linked death: gatekeeper dies → humming stones shatter */
-  if ( strcmp( t->key, "gatekeeper" ) == 0
-       && combat_enemies && combat_enemy_count )
+  /* Linked death: whatever this enemy owns goes with it (a shaman's
+     totems, the gatekeeper's stones, a horror's brood) */
+  if ( combat_enemies && combat_enemy_count )
   {
-    for ( int i = 0; i < *combat_enemy_count; i++ )
+    for ( Enemy_t* ch = EnemyFirstChild( combat_enemies, e ); ch;
+          ch = EnemyNextSibling( combat_enemies, ch ) )
     {
-      if ( !combat_enemies[i].alive ) continue;
-      const char* ai = g_enemy_types[combat_enemies[i].type_idx].ai;
-      if ( strcmp( ai, "static" ) != 0
-           && strcmp( ai, "stone_healer" ) != 0
-           && strcmp( ai, "stone_ranged" ) != 0 )
-        continue;
-      combat_enemies[i].alive = 0;
-      CombatVFXSpawnText( combat_enemies[i].world_x, combat_enemies[i].world_y,
-                          "Shatters!", (aColor_t){ 140, 120, 180, 255 } );
-      ConsolePushF( console, (aColor_t){ 140, 120, 180, 255 },
-                    "The Humming Stone shatters!" );
-    }
-  }
+      EnemyType_t* ct = &g_enemy_types[ch->type_idx];
+      if ( !ch->alive ) continue;
 
-  /* Linked death: horror dies → baby horrors dissolve */
-  if ( strcmp( t->ai, "horror" ) == 0
-       && combat_enemies && combat_enemy_count )
-  {
-    for ( int i = 0; i < *combat_enemy_count; i++ )
-    {
-      if ( !combat_enemies[i].alive ) continue;
-      if ( strcmp( g_enemy_types[combat_enemies[i].type_idx].ai, "baby_horror" ) != 0 )
-        continue;
-      combat_enemies[i].alive = 0;
-      CombatVFXSpawnText( combat_enemies[i].world_x, combat_enemies[i].world_y,
-                          "Dissolves!", (aColor_t){ 140, 40, 80, 255 } );
-      ConsolePushF( console, (aColor_t){ 140, 40, 80, 255 },
-                    "The Baby Horror dissolves!" );
+      ch->alive = 0;
+      RoomIndexEnemy( ch );
+      CombatVFXSpawnText( ch->world_x, ch->world_y, ct->link_text, ct->link_color );
+      ConsolePushF( console, ct->link_color, "The %s %s!", ct->name, ct->link_verb );
     }
   }
 }
@@ -316,7 +284,7 @@ static void resolve_buff( Enemy_t* primary )
   if ( !player.buff.active ) return;
 
   /* Lifesteal: heal player */
-  if ( strcmp( player.buff.effect, "lifesteal" ) == 0 )
+  if ( player.buff.effect == CONS_EFFECT_LIFESTEAL )
   {
     int heal = player.buff.heal;
     if ( heal > 0 )
@@ -336,14 +304,14 @@ static void resolve_buff( Enemy_t* primary )
 int CombatAttack( Enemy_t* e )
 {
   EnemyType_t* t = &g_enemy_types[e->type_idx];
-  int pdmg = PlayerStat( "damage" );
+  int pdmg = player.derived.damage;
 
   /* Add food buff bonus damage */
   if ( player.buff.active )
     pdmg += player.buff.bonus_damage;
 
   /* Passive: first_strike - bonus damage on first attack per room */
-  int fs = PlayerEquipEffect( "first_strike" );
+  int fs = player.derived.effect[EQUIP_EFFECT_FIRST_STRIKE];
   if ( fs > 0 && player.first_strike_active )
   {
     pdmg += fs;
@@ -353,7 +321,7 @@ int CombatAttack( Enemy_t* e )
   }
 
   /* Passive: berserk - +1 damage per threshold% HP missing */
-  int berserk = PlayerEquipEffect( "berserk" );
+  int berserk = player.derived.effect[EQUIP_EFFECT_BERSERK];
   if ( berserk > 0 && player.max_hp > 0 )
   {
     int threshold  = ( berserk >= 2 ) ? 20 : 40;
@@ -370,7 +338,7 @@ int CombatAttack( Enemy_t* e )
   }
 
   /* Empower buff - double total damage */
-  if ( player.buff.active && strcmp( player.buff.effect, "empower" ) == 0 )
+  if ( player.buff.active && player.buff.effect == CONS_EFFECT_EMPOWER )
   {
     pdmg *= 2;
     ConsolePushF( console, (aColor_t){ 60, 85, 110, 255 },
@@ -379,11 +347,12 @@ int CombatAttack( Enemy_t* e )
   }
 
   /* Passive: armor_break - every Nth attack ignores enemy defense */
-  int armor_break = PlayerEquipEffect( "armor_break" );
+  int armor_break = player.derived.effect[EQUIP_EFFECT_ARMOR_BREAK];
   int broke_armor = 0;
   if ( armor_break > 0 )
   {
     player.attack_counter++;
+    PlayerTouch();
     if ( player.attack_counter % armor_break == 0 )
     {
       broke_armor = 1;
@@ -394,7 +363,7 @@ int CombatAttack( Enemy_t* e )
 
   if ( pdmg < 1 ) pdmg = 1;
 
-  a_AudioPlaySound( &sfx_hit, NULL );
+  SoundBankPlay( sfx_hit, NULL );
   ConsolePushF( console, (aColor_t){ 0xe8, 0xc1, 0x70, 255 },
                 "You hit %s for %d damage.", t->name, pdmg );
 
@@ -403,7 +372,7 @@ int CombatAttack( Enemy_t* e )
     : deal_damage( e, pdmg, (aColor_t){ 0xeb, 0xed, 0xe9, 255 } );
 
   /* Passive: poison - apply DOT on melee hit */
-  int psn = PlayerEquipEffect( "poison" );
+  int psn = player.derived.effect[EQUIP_EFFECT_POISON];
   if ( psn > 0 && e->alive )
   {
     e->poison_ticks = 3;
@@ -424,14 +393,15 @@ void CombatEnemyHit( Enemy_t* e )
 {
   if ( DevModeNoclip() ) return;
   EnemyType_t* t = &g_enemy_types[e->type_idx];
-  int edmg = t->damage + totem_buff_at( e, 1 ) - PlayerStat( "defense" );
+  int edmg = t->damage + totem_buff_at( e, 1 ) - player.derived.defense;
   if ( edmg < 1 ) edmg = 1;
 
   /* Passive: dodge - every Nth incoming hit is dodged */
-  int dodge = PlayerEquipEffect( "dodge" );
+  int dodge = player.derived.effect[EQUIP_EFFECT_DODGE];
   if ( dodge > 0 )
   {
     player.dodge_counter++;
+    PlayerTouch();
     if ( player.dodge_counter % dodge == 0 )
     {
       CombatVFXSpawnText( player.world_x, player.world_y,
@@ -447,7 +417,7 @@ void CombatEnemyHit( Enemy_t* e )
   /* Passive: mana_shield - lethal hit consumes a scroll instead */
   if ( player.hp <= 0 )
   {
-    int ms = PlayerEquipEffect( "mana_shield" );
+    int ms = player.derived.effect[EQUIP_EFFECT_MANA_SHIELD];
     if ( ms > 0 )
     {
       /* Find a random scroll in inventory */
@@ -456,7 +426,7 @@ void CombatEnemyHit( Enemy_t* e )
       for ( int i = 0; i < player.max_inventory; i++ )
       {
         if ( player.inventory[i].type == INV_CONSUMABLE
-             && strcmp( g_consumables[player.inventory[i].index].type, "scroll" ) == 0 )
+             && g_consumables[player.inventory[i].index].type_id == CONS_TYPE_SCROLL )
           scroll_slots[num_scrolls++] = i;
       }
       if ( num_scrolls > 0 )
@@ -464,6 +434,7 @@ void CombatEnemyHit( Enemy_t* e )
         int pick = scroll_slots[rand() % num_scrolls];
         const char* sname = g_consumables[player.inventory[pick].index].name;
         player.hp += edmg; /* undo lethal: restore HP to pre-hit value */
+        PlayerTouch();
         InventoryRemove( pick );
         CombatVFXSpawnText( player.world_x, player.world_y,
                             "Shielded!", (aColor_t){ 0x64, 0x64, 0xc8, 255 } );
@@ -491,7 +462,7 @@ void CombatEnemyHit( Enemy_t* e )
   /* Passive: thorns - reflect damage back (not if dead) */
   if ( player.hp > 0 )
   {
-    int thorns = PlayerEquipEffect( "thorns" );
+    int thorns = player.derived.effect[EQUIP_EFFECT_THORNS];
     if ( thorns > 0 && e->alive )
     {
       ConsolePushF( console, (aColor_t){ 0xde, 0x9e, 0x41, 255 },
@@ -504,11 +475,12 @@ void CombatEnemyHit( Enemy_t* e )
 /* Companion trinket: Bloop nips a random alive enemy every N turns */
 void CombatCompanionTick( void )
 {
-  int interval = PlayerEquipEffect( "companion" );
+  int interval = player.derived.effect[EQUIP_EFFECT_COMPANION];
   if ( interval <= 0 ) return;
   if ( !combat_enemies || !combat_enemy_count ) return;
 
   player.companion_counter++;
+  PlayerTouch();
   if ( player.companion_counter < interval ) return;
   player.companion_counter = 0;
 
@@ -1,3 +1,4 @@
+#include <stdio.h>
 #include <string.h>
 #include <Archimedes.h>
 
@@ -18,7 +19,9 @@
 #include "spell_vfx.h"
 #include "interactive_tile.h"
 #include "room_enumerator.h"
+#include "room_index.h"
 #include "game_turns.h"
+#include "sound_bank.h"
 
 extern Player_t player;
 
@@ -29,20 +32,29 @@ static World_t*  ge_world       = NULL;
 static Enemy_t*  ge_enemies     = NULL;
 static int*      ge_enemy_count = NULL;
 
-static aSoundEffect_t sfx_spark;
-static aSoundEffect_t sfx_frost;
-static aSoundEffect_t sfx_fireball;
-static aSoundEffect_t sfx_arrow;
-static aSoundEffect_t sfx_merc_swing;
+static aSoundEffect_t* sfx_spark      = NULL;
+static aSoundEffect_t* sfx_frost      = NULL;
+static aSoundEffect_t* sfx_fireball   = NULL;
+static aSoundEffect_t* sfx_arrow      = NULL;
+static aSoundEffect_t* sfx_merc_swing = NULL;
 
 void GameEventsInit( Console_t* c )
 {
   con = c;
-  a_AudioLoadSound( "resources/soundeffects/spark.wav",    &sfx_spark );
-  a_AudioLoadSound( "resources/soundeffects/frost.wav",    &sfx_frost );
-  a_AudioLoadSound( "resources/soundeffects/fireball.wav", &sfx_fireball );
-  a_AudioLoadSound( "resources/soundeffects/arrow_shoot.wav", &sfx_arrow );
-  a_AudioLoadSound( "resources/soundeffects/merc_swing.wav",  &sfx_merc_swing );
+  SoundBankAcquire( &sfx_spark,      "resources/soundeffects/spark.wav" );
+  SoundBankAcquire( &sfx_frost,      "resources/soundeffects/frost.wav" );
+  SoundBankAcquire( &sfx_fireball,   "resources/soundeffects/fireball.wav" );
+  SoundBankAcquire( &sfx_arrow,      "resources/soundeffects/arrow_shoot.wav" );
+  SoundBankAcquire( &sfx_merc_swing, "resources/soundeffects/merc_swing.wav" );
+}
+
+void GameEventsReleaseSounds( void )
+{
+  SoundBankRelease( &sfx_spark );
+  SoundBankRelease( &sfx_frost );
+  SoundBankRelease( &sfx_fireball );
+  SoundBankRelease( &sfx_arrow );
+  SoundBankRelease( &sfx_merc_swing );
 }
 
 void GameEventsSetWorld( World_t* world, Enemy_t* enemies, int* enemy_count )
@@ -66,7 +78,7 @@ static void evt_LookEquipment( int index )
     ConsolePushF( con, (aColor_t){ 0xeb, 0xed, 0xe9, 255 }, "  DMG: +%d", e->damage );
   if ( e->defense > 0 )
     ConsolePushF( con, (aColor_t){ 0xeb, 0xed, 0xe9, 255 }, "  DEF: +%d", e->defense );
-  if ( strcmp( e->effect, "none" ) != 0 )
+  if ( e->effect_id != EQUIP_EFFECT_NONE )
     ConsolePushF( con, (aColor_t){ 0xde, 0x9e, 0x41, 255 }, "  %s (%d)", e->effect, e->effect_value );
   ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 }, "  %s", e->description );
 }
@@ -78,7 +90,7 @@ static void evt_LookConsumable( int index )
   ConsolePushF( con, c->color, "You looked at %s", c->name );
   if ( c->bonus_damage > 0 )
     ConsolePushF( con, (aColor_t){ 0xeb, 0xed, 0xe9, 255 }, "  DMG: +%d", c->bonus_damage );
-  if ( strcmp( c->effect, "none" ) != 0 && strlen( c->effect ) > 0 )
+  if ( c->effect_id != CONS_EFFECT_NONE )
     ConsolePushF( con, (aColor_t){ 0xde, 0x9e, 0x41, 255 }, "  %s", c->effect );
   ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 }, "  %s", c->description );
 }
@@ -121,139 +133,163 @@ static void evt_UseConsumable( int index )
   ConsolePushF( con, c->color, "You use %s", c->name );
 }
 
-int GameEventUseConsumable( int consumable_index )
+/* ---- Instant-use consumable handlers ---- */
+
+/* Empower - buff next attack to deal double damage */
+static int use_Empower( ConsumableInfo_t* c )
 {
-  if ( consumable_index < 0 || consumable_index >= g_num_consumables )
-    return 0;
+  PlayerApplyBuff( 0, CONS_EFFECT_EMPOWER, 0 );
+  ConsolePushF( con, c->color,
+                "You drink %s. Next attack deals double damage!",
+                c->name );
+  consumable_used = 1;
+  return 1;
+}
 
-  ConsumableInfo_t* c = &g_consumables[consumable_index];
+/* Standard heal potion */
+static int use_Potion( ConsumableInfo_t* c )
+{
+  int healed = c->heal;
+  if ( player.hp + healed > player.max_hp )
+    healed = player.max_hp - player.hp;
 
-  /* One consumable per turn (quest items bypass) */
-  if ( consumable_used && strcmp( c->type, "quest" ) != 0 )
+  if ( healed <= 0 )
   {
-    ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
-                  "You can only use one consumable per turn." );
+    ConsolePushF( con, c->color, "You are already at full health." );
     return 0;
   }
 
-  /* Potions - instant use, no attack required */
-  if ( strcmp( c->type, "potion" ) == 0 )
-  {
-    /* Empower - buff next attack to deal double damage */
-    if ( strcmp( c->effect, "empower" ) == 0 )
-    {
-      PlayerApplyBuff( 0, "empower", 0 );
-      ConsolePushF( con, c->color,
-                    "You drink %s. Next attack deals double damage!",
-                    c->name );
-      consumable_used = 1;
-      return 1;
-    }
+  PlayerHeal( healed );
+  CombatVFXSpawnNumber( player.world_x, player.world_y, healed,
+                        (aColor_t){ 0x75, 0xa7, 0x43, 255 } );
+  ConsolePushF( con, (aColor_t){ 0x75, 0xa7, 0x43, 255 },
+                "You drink %s. Restored %d HP.", c->name, healed );
 
-    /* Standard heal potion */
-    int healed = c->heal;
-    if ( player.hp + healed > player.max_hp )
-      healed = player.max_hp - player.hp;
+  consumable_used = 1;
+  return 1;
+}
 
-    if ( healed <= 0 )
-    {
-      ConsolePushF( con, c->color, "You are already at full health." );
-      return 0;
-    }
+/* Food - buff next attack */
+static int use_Food( ConsumableInfo_t* c )
+{
+  PlayerApplyBuff( c->bonus_damage, c->effect_id, c->heal );
 
-    PlayerHeal( healed );
-    CombatVFXSpawnNumber( player.world_x, player.world_y, healed,
-                          (aColor_t){ 0x75, 0xa7, 0x43, 255 } );
-    ConsolePushF( con, (aColor_t){ 0x75, 0xa7, 0x43, 255 },
-                  "You drink %s. Restored %d HP.", c->name, healed );
+  if ( c->effect_id != CONS_EFFECT_NONE )
+    ConsolePushF( con, c->color, "You eat %s. Next attack: %s (+%d dmg).",
+                  c->name, c->effect, c->bonus_damage );
+  else
+    ConsolePushF( con, c->color, "You eat %s. Next attack: +%d dmg.",
+                  c->name, c->bonus_damage );
 
-    consumable_used = 1;
-    return 1;
-  }
+  consumable_used = 1;
+  return 1;
+}
 
-  /* Food - buff next attack */
-  if ( strcmp( c->type, "food" ) == 0 )
+/* Lure - requires specific location */
+static int use_Lure( ConsumableInfo_t* c )
+{
+  (void)c;
+  int pr, pc;
+  PlayerGetTile( &pr, &pc );
+  if ( RoomAt( pr, pc ) != ROOM_RAT_HOLE )
   {
-    PlayerApplyBuff( c->bonus_damage, c->effect, c->heal );
-
-    if ( strcmp( c->effect, "none" ) != 0 && strlen( c->effect ) > 0 )
-      ConsolePushF( con, c->color, "You eat %s. Next attack: %s (+%d dmg).",
-                    c->name, c->effect, c->bonus_damage );
-    else
-      ConsolePushF( con, c->color, "You eat %s. Next attack: +%d dmg.",
-                    c->name, c->bonus_damage );
-
-    consumable_used = 1;
-    return 1;
+    ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
+                  "The smell wafts away. Nothing to lure here." );
+    return 0;
   }
 
-  /* Quest items - generic handler with optional heal/message/give */
-  if ( strcmp( c->type, "quest" ) == 0 )
+  ITileBreak( ge_world, 5, 2 );
+
+  int rat_king_idx = EnemyTypeByKey( "rat_king" );
+  int rat_idx      = EnemyTypeByKey( "rat" );
+  if ( rat_king_idx >= 0 )
+    EnemySpawn( ge_enemies, ge_enemy_count, rat_king_idx, 5, 2,
+                ge_world->tile_w, ge_world->tile_h );
+  if ( rat_idx >= 0 )
   {
-    /* Lure - requires specific location, handled in Phase 4 */
-    if ( strcmp( c->effect, "lure" ) == 0 )
+    /* Candidate spots inside Room 24 - skip the player's tile */
+    static const int rat_pos[][2] = { {2,1}, {4,1}, {1,2}, {3,2} };
+    int spawned = 0;
+    for ( int i = 0; i < 4 && spawned < 2; i++ )
     {
-      int pr, pc;
-      PlayerGetTile( &pr, &pc );
-      if ( RoomAt( pr, pc ) != ROOM_RAT_HOLE )
-      {
-        ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
-                      "The smell wafts away. Nothing to lure here." );
-        return 0;
-      }
+      if ( rat_pos[i][0] == pr && rat_pos[i][1] == pc ) continue;
+      EnemySpawn( ge_enemies, ge_enemy_count, rat_idx,
+                  rat_pos[i][0], rat_pos[i][1],
+                  ge_world->tile_w, ge_world->tile_h );
+      spawned++;
+    }
+  }
 
-      ITileBreak( ge_world, 5, 2 );
+  ConsolePushF( con, (aColor_t){ 0xde, 0x9e, 0x41, 255 },
+                "You hold out the stinky cheese..." );
+  ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
+                "The wall EXPLODES! The Rat King emerges!" );
 
-      int rat_king_idx = EnemyTypeByKey( "rat_king" );
-      int rat_idx      = EnemyTypeByKey( "rat" );
-      if ( rat_king_idx >= 0 )
-        EnemySpawn( ge_enemies, ge_enemy_count, rat_king_idx, 5, 2,
-                    ge_world->tile_w, ge_world->tile_h );
-      if ( rat_idx >= 0 )
-      {
-        /* Candidate spots inside Room 24 - skip the player's tile */
-        static const int rat_pos[][2] = { {2,1}, {4,1}, {1,2}, {3,2} };
-        int spawned = 0;
-        for ( int i = 0; i < 4 && spawned < 2; i++ )
-        {
-          if ( rat_pos[i][0] == pr && rat_pos[i][1] == pc ) continue;
-          EnemySpawn( ge_enemies, ge_enemy_count, rat_idx,
-                      rat_pos[i][0], rat_pos[i][1],
-                      ge_world->tile_w, ge_world->tile_h );
-          spawned++;
-        }
-      }
+  return 1;
+}
 
-      ConsolePushF( con, (aColor_t){ 0xde, 0x9e, 0x41, 255 },
-                    "You hold out the stinky cheese..." );
-      ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
-                    "The wall EXPLODES! The Rat King emerges!" );
+/* Generic quest item: heal + message + give item */
+static int use_Quest( ConsumableInfo_t* c )
+{
+  if ( c->heal > 0 )
+  {
+    PlayerHeal( c->heal );
+    CombatVFXSpawnNumber( player.world_x, player.world_y, c->heal,
+                          (aColor_t){ 0x75, 0xa7, 0x43, 255 } );
+  }
+  if ( c->use_message[0] )
+    ConsolePushF( con, c->color, "%s", c->use_message );
+  if ( c->gives[0] )
+  {
+    int gi = ConsumableByKey( c->gives );
+    if ( gi >= 0 )
+      InventoryAdd( INV_CONSUMABLE, gi );
+  }
+  return 1;
+}
 
-      return 1;
-    }
+/* Sandwich - set flag, then the generic quest handler */
+static int use_Sandwich( ConsumableInfo_t* c )
+{
+  FlagSet( "sandwich_eaten", 1 );
+  return use_Quest( c );
+}
 
-    /* Sandwich - set flag, then fall through to generic handler */
-    if ( strcmp( c->effect, "eat_sandwich" ) == 0 )
-      FlagSet( "sandwich_eaten", 1 );
+static ConsumableUseFn_t use_handler_for( const ConsumableInfo_t* c )
+{
+  switch ( c->type_id )
+  {
+    case CONS_TYPE_POTION:
+      return ( c->effect_id == CONS_EFFECT_EMPOWER ) ? use_Empower : use_Potion;
+    case CONS_TYPE_FOOD:
+      return use_Food;
+    case CONS_TYPE_QUEST:
+      if ( c->effect_id == CONS_EFFECT_LURE )         return use_Lure;
+      if ( c->effect_id == CONS_EFFECT_EAT_SANDWICH ) return use_Sandwich;
+      return use_Quest;
+    default:
+      return NULL;
+  }
+}
 
-    /* Generic quest item: heal + message + give item */
-    if ( c->heal > 0 )
-    {
-      PlayerHeal( c->heal );
-      CombatVFXSpawnNumber( player.world_x, player.world_y, c->heal,
-                            (aColor_t){ 0x75, 0xa7, 0x43, 255 } );
-    }
-    if ( c->use_message[0] )
-      ConsolePushF( con, c->color, "%s", c->use_message );
-    if ( c->gives[0] )
-    {
-      int gi = ConsumableByKey( c->gives );
-      if ( gi >= 0 )
-        InventoryAdd( INV_CONSUMABLE, gi );
-    }
-    return 1;
+int GameEventUseConsumable( int consumable_index )
+{
+  if ( consumable_index < 0 || consumable_index >= g_num_consumables )
+    return 0;
+
+  ConsumableInfo_t* c = &g_consumables[consumable_index];
+
+  /* One consumable per turn (quest items bypass) */
+  if ( consumable_used && c->type_id != CONS_TYPE_QUEST )
+  {
+    ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
+                  "You can only use one consumable per turn." );
+    return 0;
   }
 
+  if ( c->use )
+    return c->use( c );
+
   ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
                 "%s can't use %s yet.", player.name, c->name );
   return 0;
@@ -324,10 +360,11 @@ static int apply_totem_def( Enemy_t* e, int damage )
 
 static void consume_scroll( int inv_slot )
 {
-  int echo = PlayerEquipEffectMin( "scroll_echo" );
+  int echo = player.derived.effect_min[EQUIP_EFFECT_SCROLL_ECHO];
   if ( echo > 0 )
   {
     player.scroll_echo_counter++;
+    PlayerTouch();
     if ( player.scroll_echo_counter >= echo )
     {
       player.scroll_echo_counter = 0;
@@ -339,57 +376,94 @@ static void consume_scroll( int inv_slot )
   InventoryRemove( inv_slot );
 }
 
-int GameEventResolveTarget( int consumable_idx, int inv_slot,
-                            int target_row, int target_col,
-                            Enemy_t* enemies, int num_enemies )
+/* ---- SHOOT: cardinal line projectile ---- */
+static int tgt_Shoot( ConsumableInfo_t* c, ConsumableTarget_t* tg )
 {
-  if ( consumable_idx < 0 || consumable_idx >= g_num_consumables )
-    return 0;
-
-  ConsumableInfo_t* c = &g_consumables[consumable_idx];
-
-  /* One consumable per turn */
-  if ( consumable_used )
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      pr          = tg->player_row;
+  int      pc          = tg->player_col;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  SoundBankPlay( sfx_arrow, NULL );
+  int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
+  int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
+
+  Enemy_t* hit = NULL;
+  int cr = pr, cc = pc;
+  for ( int step = 0; step < c->range; step++ )
   {
-    ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
-                  "You can only use one consumable per turn." );
-    return 0;
+    cr += dr;
+    cc += dc;
+    if ( !TileWalkable( cr, cc ) ) break;
+    hit = EnemyAt( enemies, num_enemies, cr, cc );
+    if ( hit ) break;
   }
 
-  int pr, pc;
-  PlayerGetTile( &pr, &pc );
-  int dmg = PlayerStat( "damage" ) + c->bonus_damage;
-  dmg += PlayerEquipEffect( "amplify" );
-  if ( dmg < 1 ) dmg = 1;
-
-  aColor_t hit_color = c->color;
+  /* Spawn arrow VFX from player toward end of line */
+  float tw = 16.0f, th = 16.0f;
+  float sx = pr * tw + tw / 2.0f;
+  float sy = pc * th + th / 2.0f;
+  float ex = cr * tw + tw / 2.0f;
+  float ey = cc * th + th / 2.0f;
+  EnemyProjectileSpawn( sx, sy, ex, ey, dr, dc );
 
-  /* ---- SHOOT: cardinal line projectile ---- */
-  if ( strcmp( c->effect, "shoot" ) == 0 )
+  if ( hit )
+  {
+    EnemyType_t* t = &g_enemy_types[hit->type_idx];
+    int fd = apply_totem_def( hit, dmg );
+    hit->hp -= fd;
+    hit->turns_since_hit = 0;
+    CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
+    ConsolePushF( con, hit_color, "You shoot %s for %d damage!",
+                  t->name, fd );
+    if ( hit->hp <= 0 )
+      CombatHandleEnemyDeath( hit );
+  }
+  else
   {
-    a_AudioPlaySound( &sfx_arrow, NULL );
-    int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
-    int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
+    ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
+                  "The arrow flies into the darkness..." );
+  }
 
-    Enemy_t* hit = NULL;
-    int cr = pr, cc = pc;
-    for ( int step = 0; step < c->range; step++ )
-    {
-      cr += dr;
-      cc += dc;
-      if ( !TileWalkable( cr, cc ) ) break;
-      hit = EnemyAt( enemies, num_enemies, cr, cc );
-      if ( hit ) break;
-    }
+  consume_scroll( inv_slot );
+  consumable_used = 1;
+  return 2;  /* free action */
+}
 
-    /* Spawn arrow VFX from player toward end of line */
-    float tw = 16.0f, th = 16.0f;
-    float sx = pr * tw + tw / 2.0f;
-    float sy = pc * th + th / 2.0f;
-    float ex = cr * tw + tw / 2.0f;
-    float ey = cc * th + th / 2.0f;
-    EnemyProjectileSpawn( sx, sy, ex, ey, dr, dc );
+/* ---- PIERCE: cardinal line projectile that hits ALL enemies ---- */
+static int tgt_Pierce( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      pr          = tg->player_row;
+  int      pc          = tg->player_col;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  SoundBankPlay( sfx_arrow, NULL );
+  int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
+  int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
+
+  int cr = pr, cc = pc;
+  int end_r = pr, end_c = pc;
+  int hits = 0;
+
+  for ( int step = 0; step < c->range; step++ )
+  {
+    cr += dr;
+    cc += dc;
+    if ( !TileWalkable( cr, cc ) ) break;
+    end_r = cr; end_c = cc;
 
+    Enemy_t* hit = EnemyAt( enemies, num_enemies, cr, cc );
     if ( hit )
     {
       EnemyType_t* t = &g_enemy_types[hit->type_idx];
@@ -397,439 +471,584 @@ int GameEventResolveTarget( int consumable_idx, int inv_slot,
       hit->hp -= fd;
       hit->turns_since_hit = 0;
       CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
-      ConsolePushF( con, hit_color, "You shoot %s for %d damage!",
-                    t->name, fd );
+      ConsolePushF( con, hit_color, "%s pierces %s for %d damage!",
+                    player.name, t->name, fd );
       if ( hit->hp <= 0 )
         CombatHandleEnemyDeath( hit );
+      hits++;
     }
-    else
+  }
+
+  /* Spawn arrow VFX from player to end of line */
+  float tw = 16.0f, th = 16.0f;
+  float sx = pr * tw + tw / 2.0f;
+  float sy = pc * th + th / 2.0f;
+  float ex = end_r * tw + tw / 2.0f;
+  float ey = end_c * th + th / 2.0f;
+  EnemyProjectileSpawn( sx, sy, ex, ey, dr, dc );
+
+  if ( hits == 0 )
+    ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
+                  "The arrow flies into the darkness..." );
+
+  consume_scroll( inv_slot );
+  consumable_used = 1;
+  return 2;
+}
+
+/* ---- STEW_THROW: heal + cardinal line projectile ---- */
+static int tgt_StewThrow( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      pr          = tg->player_row;
+  int      pc          = tg->player_col;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  SoundBankPlay( sfx_merc_swing, NULL );
+  /* Heal first */
+  if ( c->heal > 0 )
+  {
+    int healed = c->heal;
+    if ( player.hp + healed > player.max_hp )
+      healed = player.max_hp - player.hp;
+
+    if ( healed > 0 )
     {
-      ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
-                    "The arrow flies into the darkness..." );
+      PlayerHeal( healed );
+      CombatVFXSpawnNumber( player.world_x, player.world_y, healed,
+                            (aColor_t){ 0x75, 0xa7, 0x43, 255 } );
+      ConsolePushF( con, (aColor_t){ 0x75, 0xa7, 0x43, 255 },
+                    "You eat %s. Restored %d HP.", c->name, healed );
     }
+  }
+
+  /* Throw the bowl */
+  int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
+  int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
 
-    consume_scroll( inv_slot );
-    consumable_used = 1;
-    return 2;  /* free action */
+  Enemy_t* hit = NULL;
+  int cr = pr, cc = pc;
+  for ( int step = 0; step < c->range; step++ )
+  {
+    cr += dr;
+    cc += dc;
+    if ( !TileWalkable( cr, cc ) ) break;
+    hit = EnemyAt( enemies, num_enemies, cr, cc );
+    if ( hit ) break;
   }
 
-  /* ---- PIERCE: cardinal line projectile that hits ALL enemies ---- */
-  if ( strcmp( c->effect, "pierce" ) == 0 )
+  float tw = 16.0f, th = 16.0f;
+  EnemyProjectileSpawn( pr * tw + tw / 2.0f, pc * th + th / 2.0f,
+                        cr * tw + tw / 2.0f, cc * th + th / 2.0f,
+                        dr, dc );
+
+  if ( hit )
   {
-    a_AudioPlaySound( &sfx_arrow, NULL );
-    int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
-    int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
+    EnemyType_t* t = &g_enemy_types[hit->type_idx];
+    int fd = apply_totem_def( hit, dmg );
+    hit->hp -= fd;
+    hit->turns_since_hit = 0;
+    CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
+    ConsolePushF( con, hit_color, "You hurl the bowl at %s for %d damage!",
+                  t->name, fd );
+    if ( hit->hp <= 0 )
+      CombatHandleEnemyDeath( hit );
+  }
+  else
+  {
+    ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
+                  "The bowl sails into the darkness..." );
+  }
 
-    int cr = pr, cc = pc;
-    int end_r = pr, end_c = pc;
-    int hits = 0;
+  InventoryRemove( inv_slot );
+  consumable_used = 1;
+  return 2;  /* food = free action */
+}
 
-    for ( int step = 0; step < c->range; step++ )
-    {
-      cr += dr;
-      cc += dc;
-      if ( !TileWalkable( cr, cc ) ) break;
-      end_r = cr; end_c = cc;
+/* ---- POISON: cardinal line + DOT ---- */
+static int tgt_Poison( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      pr          = tg->player_row;
+  int      pc          = tg->player_col;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  SoundBankPlay( sfx_arrow, NULL );
+  int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
+  int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
+
+  Enemy_t* hit = NULL;
+  int cr = pr, cc = pc;
+  for ( int step = 0; step < c->range; step++ )
+  {
+    cr += dr;
+    cc += dc;
+    if ( !TileWalkable( cr, cc ) ) break;
+    hit = EnemyAt( enemies, num_enemies, cr, cc );
+    if ( hit ) break;
+  }
 
-      Enemy_t* hit = EnemyAt( enemies, num_enemies, cr, cc );
-      if ( hit )
-      {
-        EnemyType_t* t = &g_enemy_types[hit->type_idx];
-        int fd = apply_totem_def( hit, dmg );
-        hit->hp -= fd;
-        hit->turns_since_hit = 0;
-        CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
-        ConsolePushF( con, hit_color, "%s pierces %s for %d damage!",
-                      player.name, t->name, fd );
-        if ( hit->hp <= 0 )
-          CombatHandleEnemyDeath( hit );
-        hits++;
-      }
-    }
+  float tw = 16.0f, th = 16.0f;
+  EnemyProjectileSpawn( pr * tw + tw / 2.0f, pc * th + th / 2.0f,
+                        cr * tw + tw / 2.0f, cc * th + th / 2.0f,
+                        dr, dc );
 
-    /* Spawn arrow VFX from player to end of line */
-    float tw = 16.0f, th = 16.0f;
-    float sx = pr * tw + tw / 2.0f;
-    float sy = pc * th + th / 2.0f;
-    float ex = end_r * tw + tw / 2.0f;
-    float ey = end_c * th + th / 2.0f;
-    EnemyProjectileSpawn( sx, sy, ex, ey, dr, dc );
+  if ( hit )
+  {
+    EnemyType_t* t = &g_enemy_types[hit->type_idx];
+    EnemyWake( hit );
+    int fd = apply_totem_def( hit, dmg );
+    hit->hp -= fd;
+    hit->turns_since_hit = 0;
+    CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
 
-    if ( hits == 0 )
-      ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
-                    "The arrow flies into the darkness..." );
+    /* Apply poison */
+    hit->poison_ticks = c->ticks;
+    hit->poison_dmg   = c->tick_damage;
 
-    consume_scroll( inv_slot );
-    consumable_used = 1;
-    return 2;
-  }
+    ConsolePushF( con, hit_color,
+                  "%s poisons %s! %d dmg + %d poison for %d turns.",
+                  player.name, t->name, fd,
+                  c->tick_damage, c->ticks );
 
-  /* ---- STEW_THROW: heal + cardinal line projectile ---- */
-  if ( strcmp( c->effect, "stew_throw" ) == 0 )
+    if ( hit->hp <= 0 )
+      CombatHandleEnemyDeath( hit );
+  }
+  else
   {
-    a_AudioPlaySound( &sfx_merc_swing, NULL );
-    /* Heal first */
-    if ( c->heal > 0 )
-    {
-      int healed = c->heal;
-      if ( player.hp + healed > player.max_hp )
-        healed = player.max_hp - player.hp;
+    ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
+                  "The arrow flies past..." );
+  }
 
-      if ( healed > 0 )
-      {
-        PlayerHeal( healed );
-        CombatVFXSpawnNumber( player.world_x, player.world_y, healed,
-                              (aColor_t){ 0x75, 0xa7, 0x43, 255 } );
-        ConsolePushF( con, (aColor_t){ 0x75, 0xa7, 0x43, 255 },
-                      "You eat %s. Restored %d HP.", c->name, healed );
-      }
-    }
+  consume_scroll( inv_slot );
+  consumable_used = 1;
+  return 2;  /* free action */
+}
 
-    /* Throw the bowl */
-    int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
-    int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
+/* ---- TRAP_ROOT: place trap on tile ---- */
+static int tgt_TrapRoot( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      consumable_idx = tg->consumable_idx;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  if ( EnemyAt( enemies, num_enemies, target_row, target_col ) )
+  {
+    ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
+                  "Can't place a trap under an enemy." );
+    return 0;
+  }
 
-    Enemy_t* hit = NULL;
-    int cr = pr, cc = pc;
-    for ( int step = 0; step < c->range; step++ )
-    {
-      cr += dr;
-      cc += dc;
-      if ( !TileWalkable( cr, cc ) ) break;
-      hit = EnemyAt( enemies, num_enemies, cr, cc );
-      if ( hit ) break;
-    }
+  PlacedTrapSpawn( target_row, target_col, dmg, 2, consumable_idx, c->image );
+  ConsolePushF( con, hit_color, "You set a %s.", c->name );
 
-    float tw = 16.0f, th = 16.0f;
-    EnemyProjectileSpawn( pr * tw + tw / 2.0f, pc * th + th / 2.0f,
-                          cr * tw + tw / 2.0f, cc * th + th / 2.0f,
-                          dr, dc );
+  consume_scroll( inv_slot );
+  consumable_used = 1;
+  return 2;  /* free action - don't end the turn */
+}
 
-    if ( hit )
-    {
-      EnemyType_t* t = &g_enemy_types[hit->type_idx];
-      int fd = apply_totem_def( hit, dmg );
-      hit->hp -= fd;
-      hit->turns_since_hit = 0;
-      CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
-      ConsolePushF( con, hit_color, "You hurl the bowl at %s for %d damage!",
-                    t->name, fd );
-      if ( hit->hp <= 0 )
-        CombatHandleEnemyDeath( hit );
-    }
-    else
+/* ---- SMOKE: damage + stun enemies in radius ---- */
+static int tgt_Smoke( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  int stunned = 0;
+  for ( int i = 0; i < num_enemies; i++ )
+  {
+    if ( !enemies[i].alive ) continue;
+    int edr = abs( enemies[i].row - target_row );
+    int edc = abs( enemies[i].col - target_col );
+    if ( edr + edc <= c->radius )
     {
-      ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
-                    "The bowl sails into the darkness..." );
+      int fd = apply_totem_def( &enemies[i], dmg );
+      EnemyWake( &enemies[i] );
+      enemies[i].hp -= fd;
+      enemies[i].stun_turns = c->duration;
+      enemies[i].turns_since_hit = 0;
+      CombatVFXSpawnNumber( enemies[i].world_x, enemies[i].world_y, fd, hit_color );
+      CombatVFXSpawnText( enemies[i].world_x, enemies[i].world_y,
+                          "Stunned!", (aColor_t){ 0x78, 0x78, 0x78, 255 } );
+      if ( enemies[i].hp <= 0 )
+        CombatHandleEnemyDeath( &enemies[i] );
+      stunned++;
     }
-
-    InventoryRemove( inv_slot );
-    consumable_used = 1;
-    return 2;  /* food = free action */
   }
 
-  /* ---- POISON: cardinal line + DOT ---- */
-  if ( strcmp( c->effect, "poison" ) == 0 )
-  {
-    a_AudioPlaySound( &sfx_arrow, NULL );
-    int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
-    int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
+  if ( stunned > 0 )
+    ConsolePushF( con, hit_color,
+                  "You throw a smoke bomb! %d enemies hit and stunned for %d turns.",
+                  stunned, c->duration );
+  else
+    ConsolePushF( con, hit_color,
+                  "You throw a smoke bomb! The smoke dissipates harmlessly." );
 
-    Enemy_t* hit = NULL;
-    int cr = pr, cc = pc;
-    for ( int step = 0; step < c->range; step++ )
-    {
-      cr += dr;
-      cc += dc;
-      if ( !TileWalkable( cr, cc ) ) break;
-      hit = EnemyAt( enemies, num_enemies, cr, cc );
-      if ( hit ) break;
-    }
+  consume_scroll( inv_slot );
+  consumable_used = 1;
+  return 2;  /* free action */
+}
 
-    float tw = 16.0f, th = 16.0f;
-    EnemyProjectileSpawn( pr * tw + tw / 2.0f, pc * th + th / 2.0f,
-                          cr * tw + tw / 2.0f, cc * th + th / 2.0f,
-                          dr, dc );
+/* ---- MAGIC_BOLT: direct damage, no LOS needed ---- */
+static int tgt_MagicBolt( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  Enemy_t* hit = EnemyAt( enemies, num_enemies, target_row, target_col );
+  if ( !hit )
+  {
+    ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
+                  "No target there." );
+    return 0;
+  }
 
-    if ( hit )
-    {
-      EnemyType_t* t = &g_enemy_types[hit->type_idx];
-      int fd = apply_totem_def( hit, dmg );
-      hit->hp -= fd;
-      hit->turns_since_hit = 0;
-      CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
+  EnemyType_t* t = &g_enemy_types[hit->type_idx];
+  SoundBankPlay( sfx_spark, NULL );
+  SpellVFXSpark( player.world_x, player.world_y,
+                 hit->world_x, hit->world_y );
+  { int fd = apply_totem_def( hit, dmg );
+    hit->hp -= fd;
+    hit->turns_since_hit = 0;
+    CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
+    ConsolePushF( con, hit_color,
+                  "%s zaps %s with a spark for %d damage!",
+                  player.name, t->name, fd );
+  }
 
-      /* Apply poison */
-      hit->poison_ticks = c->ticks;
-      hit->poison_dmg   = c->tick_damage;
+  if ( hit->hp <= 0 )
+    CombatHandleEnemyDeath( hit );
 
-      ConsolePushF( con, hit_color,
-                    "%s poisons %s! %d dmg + %d poison for %d turns.",
-                    player.name, t->name, fd,
-                    c->tick_damage, c->ticks );
+  consume_scroll( inv_slot );
+  consumable_used = 1;
+  return 2;  /* free action */
+}
 
-      if ( hit->hp <= 0 )
-        CombatHandleEnemyDeath( hit );
-    }
-    else
-    {
-      ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
-                    "The arrow flies past..." );
-    }
+/* ---- FREEZE: damage + stun ---- */
+static int tgt_Freeze( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  Enemy_t* hit = EnemyAt( enemies, num_enemies, target_row, target_col );
+  if ( !hit )
+  {
+    ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
+                  "No target there." );
+    return 0;
+  }
 
-    consume_scroll( inv_slot );
-    consumable_used = 1;
-    return 2;  /* free action */
+  EnemyType_t* t = &g_enemy_types[hit->type_idx];
+  SoundBankPlay( sfx_frost, NULL );
+  SpellVFXFrost( player.world_x, player.world_y,
+                 hit->world_x, hit->world_y );
+  { int fd = apply_totem_def( hit, dmg );
+    hit->hp -= fd;
+    hit->turns_since_hit = 0;
+    EnemyWake( hit );
+    hit->stun_turns = c->duration;
+    CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
+    CombatVFXSpawnText( hit->world_x, hit->world_y - 8,
+                        "Frozen!", (aColor_t){ 0x64, 0xb4, 0xff, 255 } );
+    ConsolePushF( con, hit_color,
+                  "%s freezes %s for %d damage! Frozen for %d turns.",
+                  player.name, t->name, fd, c->duration );
   }
 
-  /* ---- TRAP_ROOT: place trap on tile ---- */
-  if ( strcmp( c->effect, "trap_root" ) == 0 )
+  if ( hit->hp <= 0 )
+    CombatHandleEnemyDeath( hit );
+
+  consume_scroll( inv_slot );
+  consumable_used = 1;
+  return 2;  /* free action */
+}
+
+/* ---- AOE: damage target + all enemies in aoe_radius ---- */
+static int tgt_Aoe( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  SoundBankPlay( sfx_fireball, NULL );
+  SpellVFXFireball( player.world_x, player.world_y,
+                    target_row, target_col, c->aoe_radius );
+  int hits = 0;
+  for ( int i = 0; i < num_enemies; i++ )
   {
-    if ( EnemyAt( enemies, num_enemies, target_row, target_col ) )
+    if ( !enemies[i].alive ) continue;
+    int dr = abs( enemies[i].row - target_row );
+    int dc = abs( enemies[i].col - target_col );
+    int dist = ( dr > dc ) ? dr : dc;
+    if ( dist <= c->aoe_radius )
     {
-      ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
-                    "Can't place a trap under an enemy." );
-      return 0;
+      int fd = apply_totem_def( &enemies[i], dmg );
+      enemies[i].hp -= fd;
+      enemies[i].turns_since_hit = 0;
+      CombatVFXSpawnNumber( enemies[i].world_x, enemies[i].world_y,
+                            fd, hit_color );
+      hits++;
+
+      if ( enemies[i].hp <= 0 )
+        CombatHandleEnemyDeath( &enemies[i] );
     }
+  }
+
+  if ( hits > 0 )
+    ConsolePushF( con, hit_color,
+                  "You hurl a fireball! %d enemies hit for %d damage!",
+                  hits, dmg );
+  else
+    ConsolePushF( con, hit_color,
+                  "You hurl a fireball! It explodes harmlessly." );
 
-    PlacedTrapSpawn( target_row, target_col, dmg, 2, consumable_idx, c->image );
-    ConsolePushF( con, hit_color, "You set a %s.", c->name );
+  consume_scroll( inv_slot );
+  consumable_used = 1;
+  return 2;  /* free action */
+}
 
-    consume_scroll( inv_slot );
-    consumable_used = 1;
-    return 2;  /* free action - don't end the turn */
+/* ---- SWAP: swap positions with target enemy ---- */
+static int tgt_Swap( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      pr          = tg->player_row;
+  int      pc          = tg->player_col;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  Enemy_t* hit = EnemyAt( enemies, num_enemies, target_row, target_col );
+  if ( !hit )
+  {
+    ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
+                  "No target there." );
+    return 0;
   }
 
-  /* ---- SMOKE: damage + stun enemies in radius ---- */
-  if ( strcmp( c->effect, "smoke" ) == 0 )
+  EnemyType_t* t = &g_enemy_types[hit->type_idx];
+
+  /* VFX before swap so we capture original positions */
+  SpellVFXSwap( player.world_x, player.world_y,
+                hit->world_x, hit->world_y );
+
+  /* Swap grid positions */
+  int old_er = hit->row;
+  int old_ec = hit->col;
+  hit->row = pr;
+  hit->col = pc;
+  RoomIndexEnemy( hit );
+
+  /* Swap world positions */
+  float tmp_wx = player.world_x;
+  float tmp_wy = player.world_y;
+  PlayerSetWorldPos( hit->world_x, hit->world_y );
+  hit->world_x = tmp_wx;
+  hit->world_y = tmp_wy;
+
+  /* Deal bonus damage to swapped enemy */
+  int swap_dmg = dmg + 2;
+  int fd = apply_totem_def( hit, swap_dmg );
+  hit->hp -= fd;
+  hit->turns_since_hit = 0;
+  CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
+  ConsolePushF( con, hit_color,
+                "%s teleports into %s for %d damage!",
+                player.name, t->name, fd );
+  if ( hit->hp <= 0 )
+    CombatHandleEnemyDeath( hit );
+
+  /* Cleave around new player position (enemy's old tile) */
+  static const int swap_dirs[8][2] = {
+    {1,0}, {-1,0}, {0,1}, {0,-1}, {1,1}, {1,-1}, {-1,1}, {-1,-1}
+  };
+  for ( int d = 0; d < 8; d++ )
   {
-    int stunned = 0;
-    for ( int i = 0; i < num_enemies; i++ )
+    int ar = old_er + swap_dirs[d][0];
+    int ac = old_ec + swap_dirs[d][1];
+    Enemy_t* adj = EnemyAt( enemies, num_enemies, ar, ac );
+    if ( adj && adj != hit )
     {
-      if ( !enemies[i].alive ) continue;
-      int edr = abs( enemies[i].row - target_row );
-      int edc = abs( enemies[i].col - target_col );
-      if ( edr + edc <= c->radius )
-      {
-        int fd = apply_totem_def( &enemies[i], dmg );
-        enemies[i].hp -= fd;
-        enemies[i].stun_turns = c->duration;
-        enemies[i].turns_since_hit = 0;
-        CombatVFXSpawnNumber( enemies[i].world_x, enemies[i].world_y, fd, hit_color );
-        CombatVFXSpawnText( enemies[i].world_x, enemies[i].world_y,
-                            "Stunned!", (aColor_t){ 0x78, 0x78, 0x78, 255 } );
-        if ( enemies[i].hp <= 0 )
-          CombatHandleEnemyDeath( &enemies[i] );
-        stunned++;
-      }
+      EnemyType_t* at = &g_enemy_types[adj->type_idx];
+      int ad = apply_totem_def( adj, swap_dmg );
+      adj->hp -= ad;
+      adj->turns_since_hit = 0;
+      CombatVFXSpawnNumber( adj->world_x, adj->world_y, ad, hit_color );
+      ConsolePushF( con, hit_color, "%s crashes into %s for %d damage!",
+                    player.name, at->name, ad );
+      if ( adj->hp <= 0 )
+        CombatHandleEnemyDeath( adj );
     }
+  }
 
-    if ( stunned > 0 )
-      ConsolePushF( con, hit_color,
-                    "You throw a smoke bomb! %d enemies hit and stunned for %d turns.",
-                    stunned, c->duration );
-    else
-      ConsolePushF( con, hit_color,
-                    "You throw a smoke bomb! The smoke dissipates harmlessly." );
+  SpellVFXSweep( old_er, old_ec, hit_color );
 
-    consume_scroll( inv_slot );
-    consumable_used = 1;
-    return 2;  /* free action */
-  }
+  consume_scroll( inv_slot );
+  consumable_used = 1;
+  return 2;  /* free action */
+}
 
-  /* ---- MAGIC_BOLT: direct damage, no LOS needed ---- */
-  if ( strcmp( c->effect, "magic_bolt" ) == 0 )
+/* ---- REACH: 2-tile cardinal thrust, hits both tiles ---- */
+static int tgt_Reach( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      pr          = tg->player_row;
+  int      pc          = tg->player_col;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  SoundBankPlay( sfx_merc_swing, NULL );
+  int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
+  int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
+
+  int hits = 0;
+  int cr = pr, cc = pc;
+  for ( int step = 0; step < 2; step++ )
   {
-    Enemy_t* hit = EnemyAt( enemies, num_enemies, target_row, target_col );
-    if ( !hit )
-    {
-      ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
-                    "No target there." );
-      return 0;
-    }
+    cr += dr;
+    cc += dc;
+    if ( !TileWalkable( cr, cc ) ) break;
 
-    EnemyType_t* t = &g_enemy_types[hit->type_idx];
-    a_AudioPlaySound( &sfx_spark, NULL );
-    SpellVFXSpark( player.world_x, player.world_y,
-                   hit->world_x, hit->world_y );
-    { int fd = apply_totem_def( hit, dmg );
+    Enemy_t* hit = EnemyAt( enemies, num_enemies, cr, cc );
+    if ( hit )
+    {
+      EnemyType_t* t = &g_enemy_types[hit->type_idx];
+      int fd = apply_totem_def( hit, dmg );
       hit->hp -= fd;
       hit->turns_since_hit = 0;
       CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
-      ConsolePushF( con, hit_color,
-                    "%s zaps %s with a spark for %d damage!",
+      ConsolePushF( con, hit_color, "%s thrusts through %s for %d damage!",
                     player.name, t->name, fd );
+      if ( hit->hp <= 0 )
+        CombatHandleEnemyDeath( hit );
+      hits++;
     }
+  }
 
-    if ( hit->hp <= 0 )
-      CombatHandleEnemyDeath( hit );
+  SpellVFXThrust( pr, pc, dr, dc, 2, hit_color );
 
-    consume_scroll( inv_slot );
-    consumable_used = 1;
-    return 2;  /* free action */
-  }
+  if ( hits == 0 )
+    ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
+                  "%s thrusts at the air.", player.name );
 
-  /* ---- FREEZE: damage + stun ---- */
-  if ( strcmp( c->effect, "freeze" ) == 0 )
+  InventoryRemove( inv_slot );
+  consumable_used = 1;
+  return 2;  /* food = free action */
+}
+
+/* ---- CLEAVE: hit all adjacent enemies ---- */
+static int tgt_Cleave( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      pr          = tg->player_row;
+  int      pc          = tg->player_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  SoundBankPlay( sfx_merc_swing, NULL );
+  int hits = 0;
+  static const int dirs[8][2] = {
+    {1,0}, {-1,0}, {0,1}, {0,-1}, {1,1}, {1,-1}, {-1,1}, {-1,-1}
+  };
+  for ( int d = 0; d < 8; d++ )
   {
-    Enemy_t* hit = EnemyAt( enemies, num_enemies, target_row, target_col );
-    if ( !hit )
+    int ar = pr + dirs[d][0];
+    int ac = pc + dirs[d][1];
+    Enemy_t* hit = EnemyAt( enemies, num_enemies, ar, ac );
+    if ( hit )
     {
-      ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
-                    "No target there." );
-      return 0;
-    }
-
-    EnemyType_t* t = &g_enemy_types[hit->type_idx];
-    a_AudioPlaySound( &sfx_frost, NULL );
-    SpellVFXFrost( player.world_x, player.world_y,
-                   hit->world_x, hit->world_y );
-    { int fd = apply_totem_def( hit, dmg );
+      EnemyType_t* t = &g_enemy_types[hit->type_idx];
+      int fd = apply_totem_def( hit, dmg );
       hit->hp -= fd;
       hit->turns_since_hit = 0;
-      hit->stun_turns = c->duration;
       CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
-      CombatVFXSpawnText( hit->world_x, hit->world_y - 8,
-                          "Frozen!", (aColor_t){ 0x64, 0xb4, 0xff, 255 } );
-      ConsolePushF( con, hit_color,
-                    "%s freezes %s for %d damage! Frozen for %d turns.",
-                    player.name, t->name, fd, c->duration );
-    }
-
-    if ( hit->hp <= 0 )
-      CombatHandleEnemyDeath( hit );
-
-    consume_scroll( inv_slot );
-    consumable_used = 1;
-    return 2;  /* free action */
-  }
-
-  /* ---- AOE: damage target + all enemies in aoe_radius ---- */
-  if ( strcmp( c->effect, "aoe" ) == 0 )
-  {
-    a_AudioPlaySound( &sfx_fireball, NULL );
-    SpellVFXFireball( player.world_x, player.world_y,
-                      target_row, target_col, c->aoe_radius );
-    int hits = 0;
-    for ( int i = 0; i < num_enemies; i++ )
-    {
-      if ( !enemies[i].alive ) continue;
-      int dr = abs( enemies[i].row - target_row );
-      int dc = abs( enemies[i].col - target_col );
-      int dist = ( dr > dc ) ? dr : dc;
-      if ( dist <= c->aoe_radius )
-      {
-        int fd = apply_totem_def( &enemies[i], dmg );
-        enemies[i].hp -= fd;
-        enemies[i].turns_since_hit = 0;
-        CombatVFXSpawnNumber( enemies[i].world_x, enemies[i].world_y,
-                              fd, hit_color );
-        hits++;
-
-        if ( enemies[i].hp <= 0 )
-          CombatHandleEnemyDeath( &enemies[i] );
-      }
+      ConsolePushF( con, hit_color, "%s cleaves %s for %d damage!",
+                    player.name, t->name, fd );
+      if ( hit->hp <= 0 )
+        CombatHandleEnemyDeath( hit );
+      hits++;
     }
-
-    if ( hits > 0 )
-      ConsolePushF( con, hit_color,
-                    "You hurl a fireball! %d enemies hit for %d damage!",
-                    hits, dmg );
-    else
-      ConsolePushF( con, hit_color,
-                    "You hurl a fireball! It explodes harmlessly." );
-
-    consume_scroll( inv_slot );
-    consumable_used = 1;
-    return 2;  /* free action */
   }
 
-  /* ---- SWAP: swap positions with target enemy ---- */
-  if ( strcmp( c->effect, "swap" ) == 0 )
-  {
-    Enemy_t* hit = EnemyAt( enemies, num_enemies, target_row, target_col );
-    if ( !hit )
-    {
-      ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
-                    "No target there." );
-      return 0;
-    }
-
-    EnemyType_t* t = &g_enemy_types[hit->type_idx];
-
-    /* VFX before swap so we capture original positions */
-    SpellVFXSwap( player.world_x, player.world_y,
-                  hit->world_x, hit->world_y );
-
-    /* Swap grid positions */
-    int old_er = hit->row;
-    int old_ec = hit->col;
-    hit->row = pr;
-    hit->col = pc;
-
-    /* Swap world positions */
-    float tmp_wx = player.world_x;
-    float tmp_wy = player.world_y;
-    PlayerSetWorldPos( hit->world_x, hit->world_y );
-    hit->world_x = tmp_wx;
-    hit->world_y = tmp_wy;
-
-    /* Deal bonus damage to swapped enemy */
-    int swap_dmg = dmg + 2;
-    int fd = apply_totem_def( hit, swap_dmg );
-    hit->hp -= fd;
-    hit->turns_since_hit = 0;
-    CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
-    ConsolePushF( con, hit_color,
-                  "%s teleports into %s for %d damage!",
-                  player.name, t->name, fd );
-    if ( hit->hp <= 0 )
-      CombatHandleEnemyDeath( hit );
-
-    /* Cleave around new player position (enemy's old tile) */
-    static const int swap_dirs[8][2] = {
-      {1,0}, {-1,0}, {0,1}, {0,-1}, {1,1}, {1,-1}, {-1,1}, {-1,-1}
-    };
-    for ( int d = 0; d < 8; d++ )
-    {
-      int ar = old_er + swap_dirs[d][0];
-      int ac = old_ec + swap_dirs[d][1];
-      Enemy_t* adj = EnemyAt( enemies, num_enemies, ar, ac );
-      if ( adj && adj != hit )
-      {
-        EnemyType_t* at = &g_enemy_types[adj->type_idx];
-        int ad = apply_totem_def( adj, swap_dmg );
-        adj->hp -= ad;
-        adj->turns_since_hit = 0;
-        CombatVFXSpawnNumber( adj->world_x, adj->world_y, ad, hit_color );
-        ConsolePushF( con, hit_color, "%s crashes into %s for %d damage!",
-                      player.name, at->name, ad );
-        if ( adj->hp <= 0 )
-          CombatHandleEnemyDeath( adj );
-      }
-    }
+  SpellVFXSweep( pr, pc, hit_color );
 
-    SpellVFXSweep( old_er, old_ec, hit_color );
+  if ( hits == 0 )
+    ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
+                  "%s cleaves the air.", player.name );
 
-    consume_scroll( inv_slot );
-    consumable_used = 1;
-    return 2;  /* free action */
-  }
+  InventoryRemove( inv_slot );
+  consumable_used = 1;
+  return 2;  /* food = free action */
+}
 
-  /* ---- REACH: 2-tile cardinal thrust, hits both tiles ---- */
-  if ( strcmp( c->effect, "reach" ) == 0 )
+/* ---- FIRE_CONE: expanding cone + burn DOT ---- */
+static int tgt_FireCone( ConsumableInfo_t* c, ConsumableTarget_t* tg )
+{
+  Enemy_t* enemies     = tg->enemies;
+  int      num_enemies = tg->num_enemies;
+  int      pr          = tg->player_row;
+  int      pc          = tg->player_col;
+  int      target_row  = tg->target_row;
+  int      target_col  = tg->target_col;
+  int      inv_slot    = tg->inv_slot;
+  int      dmg         = tg->damage;
+  aColor_t hit_color   = c->color;
+
+  int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
+  int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
+  int perp_r = -dc;
+  int perp_c =  dr;
+
+  int hits = 0;
+  for ( int step = 1; step <= c->range; step++ )
   {
-    a_AudioPlaySound( &sfx_merc_swing, NULL );
-    int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
-    int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
-
-    int hits = 0;
-    int cr = pr, cc = pc;
-    for ( int step = 0; step < 2; step++ )
+    int spread = step - 1;
+    for ( int s = -spread; s <= spread; s++ )
     {
-      cr += dr;
-      cc += dc;
-      if ( !TileWalkable( cr, cc ) ) break;
+      int cr = pr + step * dr + s * perp_r;
+      int cc = pc + step * dc + s * perp_c;
+      if ( !TileWalkable( cr, cc ) ) continue;
 
       Enemy_t* hit = EnemyAt( enemies, num_enemies, cr, cc );
       if ( hit )
@@ -839,121 +1058,103 @@ int GameEventResolveTarget( int consumable_idx, int inv_slot,
         hit->hp -= fd;
         hit->turns_since_hit = 0;
         CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
-        ConsolePushF( con, hit_color, "%s thrusts through %s for %d damage!",
-                      player.name, t->name, fd );
-        if ( hit->hp <= 0 )
-          CombatHandleEnemyDeath( hit );
-        hits++;
-      }
-    }
+        ConsolePushF( con, hit_color, "You scorch %s for %d damage!",
+                      t->name, fd );
 
-    SpellVFXThrust( pr, pc, dr, dc, 2, hit_color );
-
-    if ( hits == 0 )
-      ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
-                    "%s thrusts at the air.", player.name );
-
-    InventoryRemove( inv_slot );
-    consumable_used = 1;
-    return 2;  /* food = free action */
-  }
+        /* Apply burn DOT */
+        if ( c->ticks > 0 )
+        {
+          EnemyWake( hit );
+          hit->burn_ticks = c->ticks;
+          hit->burn_dmg   = c->tick_damage;
+        }
 
-  /* ---- CLEAVE: hit all adjacent enemies ---- */
-  if ( strcmp( c->effect, "cleave" ) == 0 )
-  {
-    a_AudioPlaySound( &sfx_merc_swing, NULL );
-    int hits = 0;
-    static const int dirs[8][2] = {
-      {1,0}, {-1,0}, {0,1}, {0,-1}, {1,1}, {1,-1}, {-1,1}, {-1,-1}
-    };
-    for ( int d = 0; d < 8; d++ )
-    {
-      int ar = pr + dirs[d][0];
-      int ac = pc + dirs[d][1];
-      Enemy_t* hit = EnemyAt( enemies, num_enemies, ar, ac );
-      if ( hit )
-      {
-        EnemyType_t* t = &g_enemy_types[hit->type_idx];
-        int fd = apply_totem_def( hit, dmg );
-        hit->hp -= fd;
-        hit->turns_since_hit = 0;
-        CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
-        ConsolePushF( con, hit_color, "%s cleaves %s for %d damage!",
-                      player.name, t->name, fd );
         if ( hit->hp <= 0 )
           CombatHandleEnemyDeath( hit );
         hits++;
       }
     }
+  }
 
-    SpellVFXSweep( pr, pc, hit_color );
+  if ( hits > 0 )
+    ConsolePushF( con, hit_color,
+                  "You breathe fire! %d enemies scorched!",
+                  hits );
+  else
+    ConsolePushF( con, hit_color,
+                  "You breathe fire! The flames lick at empty air." );
 
-    if ( hits == 0 )
-      ConsolePushF( con, (aColor_t){ 0x81, 0x97, 0x96, 255 },
-                    "%s cleaves the air.", player.name );
+  InventoryRemove( inv_slot );
+  consumable_used = 1;
+  return 2;  /* free action */
+}
+
+int GameEventResolveTarget( int consumable_idx, int inv_slot,
+                            int target_row, int target_col,
+                            Enemy_t* enemies, int num_enemies )
+{
+  if ( consumable_idx < 0 || consumable_idx >= g_num_consumables )
+    return 0;
+
+  ConsumableInfo_t* c = &g_consumables[consumable_idx];
 
-    InventoryRemove( inv_slot );
-    consumable_used = 1;
-    return 2;  /* food = free action */
+  /* One consumable per turn */
+  if ( consumable_used )
+  {
+    ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
+                  "You can only use one consumable per turn." );
+    return 0;
   }
 
-  /* ---- FIRE_CONE: expanding cone + burn DOT ---- */
-  if ( strcmp( c->effect, "fire_cone" ) == 0 )
+  if ( !c->target )
   {
-    int dr = ( target_row > pr ) ? 1 : ( target_row < pr ) ? -1 : 0;
-    int dc = ( target_col > pc ) ? 1 : ( target_col < pc ) ? -1 : 0;
-    int perp_r = -dc;
-    int perp_c =  dr;
+    ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
+                  "Unknown effect: %s", c->effect );
+    return 0;
+  }
 
-    int hits = 0;
-    for ( int step = 1; step <= c->range; step++ )
-    {
-      int spread = step - 1;
-      for ( int s = -spread; s <= spread; s++ )
-      {
-        int cr = pr + step * dr + s * perp_r;
-        int cc = pc + step * dc + s * perp_c;
-        if ( !TileWalkable( cr, cc ) ) continue;
+  ConsumableTarget_t tg;
+  tg.consumable_idx = consumable_idx;
+  tg.inv_slot       = inv_slot;
+  tg.target_row     = target_row;
+  tg.target_col     = target_col;
+  tg.enemies        = enemies;
+  tg.num_enemies    = num_enemies;
+  PlayerGetTile( &tg.player_row, &tg.player_col );
 
-        Enemy_t* hit = EnemyAt( enemies, num_enemies, cr, cc );
-        if ( hit )
-        {
-          EnemyType_t* t = &g_enemy_types[hit->type_idx];
-          int fd = apply_totem_def( hit, dmg );
-          hit->hp -= fd;
-          hit->turns_since_hit = 0;
-          CombatVFXSpawnNumber( hit->world_x, hit->world_y, fd, hit_color );
-          ConsolePushF( con, hit_color, "You scorch %s for %d damage!",
-                        t->name, fd );
-
-          /* Apply burn DOT */
-          if ( c->ticks > 0 )
-          {
-            hit->burn_ticks = c->ticks;
-            hit->burn_dmg   = c->tick_damage;
-          }
-
-          if ( hit->hp <= 0 )
-            CombatHandleEnemyDeath( hit );
-          hits++;
-        }
-      }
-    }
+  tg.damage = player.derived.damage + c->bonus_damage;
+  tg.damage += player.derived.effect[EQUIP_EFFECT_AMPLIFY];
+  if ( tg.damage < 1 ) tg.damage = 1;
 
-    if ( hits > 0 )
-      ConsolePushF( con, hit_color,
-                    "You breathe fire! %d enemies scorched!",
-                    hits );
-    else
-      ConsolePushF( con, hit_color,
-                    "You breathe fire! The flames lick at empty air." );
+  return c->target( c, &tg );
+}
 
-    InventoryRemove( inv_slot );
-    consumable_used = 1;
-    return 2;  /* free action */
-  }
+static const ConsumableTargetFn_t g_target_handlers[CONS_EFFECT_COUNT] = {
+  [CONS_EFFECT_SHOOT]      = tgt_Shoot,
+  [CONS_EFFECT_PIERCE]     = tgt_Pierce,
+  [CONS_EFFECT_STEW_THROW] = tgt_StewThrow,
+  [CONS_EFFECT_POISON]     = tgt_Poison,
+  [CONS_EFFECT_TRAP_ROOT]  = tgt_TrapRoot,
+  [CONS_EFFECT_SMOKE]      = tgt_Smoke,
+  [CONS_EFFECT_MAGIC_BOLT] = tgt_MagicBolt,
+  [CONS_EFFECT_FREEZE]     = tgt_Freeze,
+  [CONS_EFFECT_AOE]        = tgt_Aoe,
+  [CONS_EFFECT_SWAP]       = tgt_Swap,
+  [CONS_EFFECT_REACH]      = tgt_Reach,
+  [CONS_EFFECT_CLEAVE]     = tgt_Cleave,
+  [CONS_EFFECT_FIRE_CONE]  = tgt_FireCone,
+};
+
+void GameEventsBindConsumables( void )
+{
+  for ( int i = 0; i < g_num_consumables; i++ )
+  {
+    ConsumableInfo_t* c = &g_consumables[i];
+    c->use    = use_handler_for( c );
+    c->target = g_target_handlers[c->effect_id];
 
-  ConsolePushF( con, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
-                "Unknown effect: %s", c->effect );
-  return 0;
+    if ( ConsumableTargeted( c ) && !c->target )
+      printf( "GAME_EVENTS: '%s' needs a target but effect '%s' has no handler\n",
+              c->key, c->effect );
+  }
 }
@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <string.h>
+#include <Archimedes.h>
+
+#include "hot_reload.h"
+#include "asset_loader.h"
+#include "sprite_atlas.h"
+#include "res_pack.h"
+
+/* inotify is Linux-only, and shipped builds have no business watching
+   their own data, so everything else compiles to stubs */
+#if defined( HOT_RELOAD ) && defined( __linux__ ) && !defined( __EMSCRIPTEN__ )
+
+#include <unistd.h>
+#include <sys/inotify.h>
+
+#define HR_MAX_PENDING  16
+
+typedef struct
+{
+  char          dir[HOT_RELOAD_PATH_LEN];
+  char          match[HOT_RELOAD_PATH_LEN];  /* file name, or ext if recursive */
+  int           recursive;
+  HotReloadFn_t fn;
+} HotReloadWatch_t;
+
+typedef struct
+{
+  int  wd;
+  char dir[HOT_RELOAD_PATH_LEN];
+} HotReloadDir_t;
+
+static int              g_fd = -1;
+static Console_t*       g_console = NULL;
+static HotReloadWatch_t g_watches[HOT_RELOAD_MAX_WATCHES];
+static int              g_num_watches = 0;
+static HotReloadDir_t   g_dirs[HOT_RELOAD_MAX_DIRS];
+static int              g_num_dirs = 0;
+
+static void hr_DropDirs( void )
+{
+  for ( int i = 0; i < g_num_dirs; i++ )
+    inotify_rm_watch( g_fd, g_dirs[i].wd );
+  g_num_dirs    = 0;
+  g_num_watches = 0;
+}
+
+void HotReloadBegin( Console_t* console )
+{
+  g_console = console;
+
+  if ( g_fd < 0 )
+  {
+    g_fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+    if ( g_fd < 0 )
+    {
+      perror( "HOTRELOAD: inotify_init1" );
+      return;
+    }
+    if ( ResPackMounted() )
+      printf( "HOTRELOAD: %s is mounted - edits to loose files won't be seen\n",
+              RES_PACK_PATH );
+  }
+
+  hr_DropDirs();
+}
+
+void HotReloadQuit( void )
+{
+  if ( g_fd < 0 ) return;
+  hr_DropDirs();
+  close( g_fd );
+  g_fd = -1;
+}
+
+/* Editors save by rename as often as by rewrite, so watch both */
+static void hr_AddDir( const char* dir )
+{
+  for ( int i = 0; i < g_num_dirs; i++ )
+    if ( strcmp( g_dirs[i].dir, dir ) == 0 ) return;
+
+  if ( g_num_dirs >= HOT_RELOAD_MAX_DIRS )
+  {
+    printf( "HOTRELOAD: too many directories, not watching %s\n", dir );
+    return;
+  }
+
+  int wd = inotify_add_watch( g_fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO );
+  if ( wd < 0 )
+  {
+    printf( "HOTRELOAD: cannot watch %s\n", dir );
+    return;
+  }
+
+  g_dirs[g_num_dirs].wd = wd;
+  snprintf( g_dirs[g_num_dirs].dir, HOT_RELOAD_PATH_LEN, "%s", dir );
+  g_num_dirs++;
+}
+
+static HotReloadWatch_t* hr_NewWatch( HotReloadFn_t fn )
+{
+  if ( g_fd < 0 ) return NULL;
+  if ( g_num_watches >= HOT_RELOAD_MAX_WATCHES )
+  {
+    printf( "HOTRELOAD: watch table full\n" );
+    return NULL;
+  }
+
+  HotReloadWatch_t* w = &g_watches[g_num_watches++];
+  memset( w, 0, sizeof( HotReloadWatch_t ) );
+  w->fn = fn;
+  return w;
+}
+
+void HotReloadWatchFile( const char* path, HotReloadFn_t fn )
+{
+  HotReloadWatch_t* w = hr_NewWatch( fn );
+  if ( !w ) return;
+
+  const char* slash = strrchr( path, '/' );
+  int dlen = slash ? (int)( slash - path ) : 1;
+  snprintf( w->dir, sizeof( w->dir ), "%.*s", dlen, slash ? path : "." );
+  snprintf( w->match, sizeof( w->match ), "%s", slash ? slash + 1 : path );
+
+  hr_AddDir( w->dir );
+}
+
+/* inotify isn't recursive - watch every directory a matching file is in */
+static void hr_AddFileDir( const char* path, void* user )
+{
+  (void)user;
+
+  const char* slash = strrchr( path, '/' );
+  if ( !slash ) return;
+
+  char dir[HOT_RELOAD_PATH_LEN];
+  snprintf( dir, sizeof( dir ), "%.*s", (int)( slash - path ), path );
+  hr_AddDir( dir );
+}
+
+void HotReloadWatchDir( const char* dir, const char* ext, HotReloadFn_t fn )
+{
+  HotReloadWatch_t* w = hr_NewWatch( fn );
+  if ( !w ) return;
+
+  snprintf( w->dir, sizeof( w->dir ), "%s", dir );
+  snprintf( w->match, sizeof( w->match ), "%s", ext );
+  w->recursive = 1;
+
+  hr_AddDir( dir );
+  ResListDir( dir, ext, hr_AddFileDir, NULL );
+}
+
+static int hr_Matches( const HotReloadWatch_t* w, const char* path )
+{
+  size_t dlen = strlen( w->dir );
+  if ( strncmp( path, w->dir, dlen ) != 0 || path[dlen] != '/' ) return 0;
+
+  if ( !w->recursive ) return strcmp( path + dlen + 1, w->match ) == 0;
+
+  size_t len = strlen( path ), elen = strlen( w->match );
+  return len > elen && strcmp( path + len - elen, w->match ) == 0;
+}
+
+static const char* hr_DirOf( int wd )
+{
+  for ( int i = 0; i < g_num_dirs; i++ )
+    if ( g_dirs[i].wd == wd ) return g_dirs[i].dir;
+  return NULL;
+}
+
+/* One save can arrive as several events - collect the frame's changes
+   and reload each file once */
+static int hr_Collect( char pending[][HOT_RELOAD_PATH_LEN] )
+{
+  union { struct inotify_event ev; char raw[4096]; } u;  /* aligned for events */
+  char* buf = u.raw;
+  int   count = 0;
+  ssize_t n;
+
+  while ( ( n = read( g_fd, buf, sizeof( u.raw ) ) ) > 0 )
+  {
+    for ( char* p = buf; p < buf + n;
+          p += sizeof( struct inotify_event ) + ( (struct inotify_event*)p )->len )
+    {
+      struct inotify_event* ev = (struct inotify_event*)p;
+      const char* dir = hr_DirOf( ev->wd );
+      if ( !dir || ev->len == 0 ) continue;
+
+      char path[HOT_RELOAD_PATH_LEN];
+      if ( snprintf( path, sizeof( path ), "%s/%s", dir, ev->name )
+           >= (int)sizeof( path ) )
+        continue;
+
+      int dup = 0;
+      for ( int i = 0; i < count && !dup; i++ )
+        dup = strcmp( pending[i], path ) == 0;
+      if ( dup || count >= HR_MAX_PENDING ) continue;
+
+      memcpy( pending[count++], path, sizeof( path ) );
+    }
+  }
+  return count;
+}
+
+int HotReloadPoll( void )
+{
+  if ( g_fd < 0 || g_num_watches == 0 ) return 0;
+
+  char pending[HR_MAX_PENDING][HOT_RELOAD_PATH_LEN];
+  int  count = hr_Collect( pending );
+  int  reloaded = 0;
+
+  for ( int i = 0; i < count; i++ )
+  {
+    uint64_t start = SDL_GetPerformanceCounter();
+    int hits = 0;
+
+    for ( int w = 0; w < g_num_watches; w++ )
+    {
+      if ( !hr_Matches( &g_watches[w], pending[i] ) ) continue;
+      g_watches[w].fn( pending[i] );
+      hits++;
+    }
+    if ( hits == 0 ) continue;
+
+    /* Handlers may queue new sprites - get them on the GPU before the
+       next draw rather than waiting for a loading screen */
+    AssetLoaderFinish();
+    AtlasUpload();
+
+    double ms = (double)( SDL_GetPerformanceCounter() - start ) * 1000.0
+              / (double)SDL_GetPerformanceFrequency();
+    printf( "HOTRELOAD: %s in %.2f ms\n", pending[i], ms );
+    if ( g_console )
+      ConsolePushF( g_console, (aColor_t){ 0x75, 0xa7, 0x43, 255 },
+                    "Reloaded %s (%.1f ms)", pending[i], ms );
+    reloaded++;
+  }
+
+  return reloaded;
+}
+
+#else
+
+void HotReloadBegin( Console_t* console )  { (void)console; }
+void HotReloadQuit( void )                 {}
+void HotReloadWatchFile( const char* path, HotReloadFn_t fn ) { (void)path; (void)fn; }
+void HotReloadWatchDir( const char* dir, const char* ext, HotReloadFn_t fn )
+{
+  (void)dir; (void)ext; (void)fn;
+}
+int  HotReloadPoll( void )                 { return 0; }
+
+#endif
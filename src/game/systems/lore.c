@@ -5,6 +5,7 @@
 
 #include "lore.h"
 #include "persist.h"
+#include "res_pack.h"
 
 static LoreEntry_t g_lore[MAX_LORE_ENTRIES];
 static int         g_num_lore = 0;
@@ -14,7 +15,7 @@ static int         g_num_lore = 0;
 static void lore_load_file( const char* path, int floor )
 {
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( path, &root );
+  dDUFError_t* err = ResParseDUF( path, &root );
   if ( err )
   {
     printf( "LORE: parse error in %s - %s\n", path,
@@ -3,6 +3,7 @@
 #include "npc_relocate.h"
 #include "dialogue.h"
 #include "room_enumerator.h"
+#include "room_index.h"
 
 /* ---- Phase enum ---- */
 enum {
@@ -58,6 +59,7 @@ void NPCRelocate( int npc_type_idx, int new_row, int new_col, int fade )
         rl_npcs[i].col     = new_col;
         rl_npcs[i].world_x = new_row * 16 + 8.0f;
         rl_npcs[i].world_y = new_col * 16 + 8.0f;
+        RoomIndexNPC( &rl_npcs[i] );
         break;
       }
     }
@@ -87,6 +89,7 @@ int NPCRelocateUpdate( float dt )
         rl_npcs[i].col     = rl_dest_col;
         rl_npcs[i].world_x = rl_dest_row * 16 + 8.0f;
         rl_npcs[i].world_y = rl_dest_col * 16 + 8.0f;
+        RoomIndexNPC( &rl_npcs[i] );
         break;
       }
     }
@@ -129,6 +132,7 @@ int NPCRelocateUpdate( float dt )
               rl_npcs[i].world_x = rl_dest_row * 16 + 8.0f;
               rl_npcs[i].world_y = rl_dest_col * 16 + 8.0f;
               rl_npcs[i].home_room = RoomAt( rl_dest_row, rl_dest_col );
+              RoomIndexNPC( &rl_npcs[i] );
               found = 1;
               break;
             }
@@ -1,17 +1,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <limits.h>
 
 #include "pathfinding.h"
 
-#define GRID_MAX  10000   /* max supported grid cells (100x100) */
-
 /* ---- Binary min-heap on f-score ---- */
 
-typedef struct { int idx; int f; } HeapNode_t;
+typedef struct PathHeapNode_t { int idx; int f; } HeapNode_t;
 
-static HeapNode_t heap[GRID_MAX];
-static int        heap_size;
+/* The plain calls' scratch - main thread only */
+static PathScratch_t shared;
 
 static void heap_swap( HeapNode_t* a, HeapNode_t* b )
 {
@@ -20,10 +19,11 @@ static void heap_swap( HeapNode_t* a, HeapNode_t* b )
   *b = tmp;
 }
 
-static void heap_push( int idx, int f )
+static void heap_push( PathScratch_t* s, int idx, int f )
 {
-  if ( heap_size >= GRID_MAX ) return;
-  int i = heap_size++;
+  if ( s->heap_size >= s->grid_cap ) return;
+  HeapNode_t* heap = s->heap;
+  int i = s->heap_size++;
   heap[i].idx = idx;
   heap[i].f   = f;
   while ( i > 0 )
@@ -35,37 +35,142 @@ static void heap_push( int idx, int f )
   }
 }
 
-static int heap_pop( int* out_idx )
+static int heap_pop( PathScratch_t* s, int* out_idx )
 {
-  if ( heap_size == 0 ) return 0;
+  if ( s->heap_size == 0 ) return 0;
+  HeapNode_t* heap = s->heap;
   *out_idx = heap[0].idx;
-  heap[0] = heap[--heap_size];
+  heap[0] = heap[--s->heap_size];
+  int size = s->heap_size;
   int i = 0;
   for ( ;; )
   {
-    int l = 2 * i + 1, r = 2 * i + 2, s = i;
-    if ( l < heap_size && heap[l].f < heap[s].f ) s = l;
-    if ( r < heap_size && heap[r].f < heap[s].f ) s = r;
-    if ( s == i ) break;
-    heap_swap( &heap[i], &heap[s] );
-    i = s;
+    int l = 2 * i + 1, r = 2 * i + 2, m = i;
+    if ( l < size && heap[l].f < heap[m].f ) m = l;
+    if ( r < size && heap[r].f < heap[m].f ) m = r;
+    if ( m == i ) break;
+    heap_swap( &heap[i], &heap[m] );
+    i = m;
   }
   return 1;
 }
 
 /* ---- A* ---- */
 
-static int     g_score[GRID_MAX];
-static int     came_from[GRID_MAX];
-static uint8_t closed[GRID_MAX];
+/* Nothing is cleared between searches. A cell's g_score and came_from
+   only count when seen[] holds the current search's stamp, and it is
+   closed when shut[] does - so a bounded search costs what it touches,
+   not the whole map. */
+static int grid_reserve( PathScratch_t* s, int total )
+{
+  if ( total <= s->grid_cap ) return 1;
+
+  HeapNode_t* h  = realloc( s->heap,      total * sizeof( HeapNode_t ) );
+  if ( h ) s->heap = h;
+  int*        gs = realloc( s->g_score,   total * sizeof( int ) );
+  if ( gs ) s->g_score = gs;
+  int*        cf = realloc( s->came_from, total * sizeof( int ) );
+  if ( cf ) s->came_from = cf;
+  uint32_t*   sn = realloc( s->seen,      total * sizeof( uint32_t ) );
+  if ( sn ) s->seen = sn;
+  uint32_t*   sh = realloc( s->shut,      total * sizeof( uint32_t ) );
+  if ( sh ) s->shut = sh;
+
+  if ( !h || !gs || !cf || !sn || !sh ) return 0;
+  s->grid_cap = total;
+
+  /* Fresh cells hold garbage - start the stamps over */
+  memset( s->seen, 0, total * sizeof( uint32_t ) );
+  memset( s->shut, 0, total * sizeof( uint32_t ) );
+  s->stamp = 0;
+  return 1;
+}
+
+/* Next search's stamp; on wraparound old stamps could match again */
+static void grid_begin( PathScratch_t* s )
+{
+  if ( ++s->stamp == 0 )
+  {
+    memset( s->seen, 0, s->grid_cap * sizeof( uint32_t ) );
+    memset( s->shut, 0, s->grid_cap * sizeof( uint32_t ) );
+    s->stamp = 1;
+  }
+}
+
+static int grid_g( PathScratch_t* s, int idx )
+{
+  return s->seen[idx] == s->stamp ? s->g_score[idx] : INT_MAX;
+}
+
+void PathScratchFree( PathScratch_t* s )
+{
+  free( s->heap );
+  free( s->g_score );
+  free( s->came_from );
+  free( s->seen );
+  free( s->shut );
+  memset( s, 0, sizeof( PathScratch_t ) );
+}
+
+/* Walk came_from back from end to si and write the first PATH_MAX_LEN
+   steps into out[] */
+static int path_build( const int* came_from, int si, int end, int grid_w,
+                       PathNode_t out[PATH_MAX_LEN] )
+{
+  int total = 1;
+  for ( int idx = end; idx != si; idx = came_from[idx] )
+  {
+    if ( idx < 0 ) return 0;
+    total++;
+  }
+
+  /* Long paths keep the near end - that's the part anybody walks */
+  int len = ( total < PATH_MAX_LEN ) ? total : PATH_MAX_LEN;
+  int idx = end;
+  for ( int skip = total - len; skip > 0; skip-- )
+    idx = came_from[idx];
+
+  for ( int i = len - 1; i >= 0; i-- )
+  {
+    out[i].row = idx % grid_w;
+    out[i].col = idx / grid_w;
+    idx = came_from[idx];
+  }
+  return len;
+}
 
 int PathfindAStar( int start_r, int start_c, int goal_r, int goal_c,
                    int grid_w, int grid_h,
                    int (*blocked)( int r, int c, void* ctx ), void* ctx,
                    PathNode_t out[PATH_MAX_LEN] )
 {
+  return PathfindAStarBounded( start_r, start_c, goal_r, goal_c,
+                               grid_w, grid_h, blocked, ctx, NULL, out );
+}
+
+int PathfindAStarBounded( int start_r, int start_c, int goal_r, int goal_c,
+                          int grid_w, int grid_h,
+                          int (*blocked)( int r, int c, void* ctx ), void* ctx,
+                          PathLimits_t* limits,
+                          PathNode_t out[PATH_MAX_LEN] )
+{
+  return PathfindAStarIn( &shared, start_r, start_c, goal_r, goal_c,
+                          grid_w, grid_h, blocked, ctx, limits, out );
+}
+
+int PathfindAStarIn( PathScratch_t* s,
+                     int start_r, int start_c, int goal_r, int goal_c,
+                     int grid_w, int grid_h,
+                     int (*blocked)( int r, int c, void* ctx ), void* ctx,
+                     PathLimits_t* limits,
+                     PathNode_t out[PATH_MAX_LEN] )
+{
+  int max_nodes  = limits ? limits->max_nodes  : 0;
+  int max_radius = limits ? limits->max_radius : 0;
+  if ( limits ) limits->partial = 0;
+
   int total = grid_w * grid_h;
-  if ( total <= 0 || total > GRID_MAX ) return 0;
+  if ( total <= 0 || !grid_reserve( s, total ) ) return 0;
 
   int si = start_c * grid_w + start_r;
   int gi = goal_c  * grid_w + goal_r;
@@ -77,30 +182,50 @@ int PathfindAStar( int start_r, int start_c, int goal_r, int goal_c,
     return 1;
   }
 
-  /* Init arrays (only the portion we use) */
-  memset( g_score,   0x7f, total * sizeof( int ) );
-  memset( came_from,   -1, total * sizeof( int ) );
-  memset( closed,       0, total * sizeof( uint8_t ) );
-  heap_size = 0;
+  grid_begin( s );
+  s->heap_size = 0;
 
-  g_score[si] = 0;
-  heap_push( si, abs( goal_r - start_r ) + abs( goal_c - start_c ) );
+  int*      g_score   = s->g_score;
+  int*      came_from = s->came_from;
+  uint32_t* seen      = s->seen;
+  uint32_t* shut      = s->shut;
+  uint32_t  stamp     = s->stamp;
+
+  seen[si]      = stamp;
+  g_score[si]   = 0;
+  came_from[si] = -1;
+  heap_push( s, si, abs( goal_r - start_r ) + abs( goal_c - start_c ) );
 
   static const int dr[] = { 1, -1, 0, 0 };
   static const int dc[] = { 0, 0, 1, -1 };
 
-  while ( heap_size > 0 )
+  /* Closest tile to the goal so far, for when a cap cuts us off */
+  int best   = si;
+  int best_h = abs( goal_r - start_r ) + abs( goal_c - start_c );
+  int capped = 0;
+  int expanded = 0;
+
+  while ( s->heap_size > 0 )
   {
     int ci;
-    heap_pop( &ci );
+    heap_pop( s, &ci );
     if ( ci == gi ) break;
-    if ( closed[ci] ) continue;
-    closed[ci] = 1;
+    if ( shut[ci] == stamp ) continue;
+    shut[ci] = stamp;
+
+    if ( max_nodes > 0 && ++expanded > max_nodes )
+    {
+      capped = 1;
+      break;
+    }
 
     int cr = ci % grid_w;
     int cc = ci / grid_w;
     int cg = g_score[ci];
 
+    int ch = abs( goal_r - cr ) + abs( goal_c - cc );
+    if ( ch < best_h ) { best = ci; best_h = ch; }
+
     for ( int d = 0; d < 4; d++ )
     {
       int nr = cr + dr[d];
@@ -108,44 +233,35 @@ int PathfindAStar( int start_r, int start_c, int goal_r, int goal_c,
       if ( nr < 0 || nr >= grid_w || nc < 0 || nc >= grid_h ) continue;
 
       int ni = nc * grid_w + nr;
-      if ( closed[ni] ) continue;
+      if ( shut[ni] == stamp ) continue;
+
+      if ( max_radius > 0
+           && abs( nr - start_r ) + abs( nc - start_c ) > max_radius )
+      {
+        capped = 1;
+        continue;
+      }
 
       /* Goal tile exempt from blocker - caller handles it */
       if ( ni != gi && blocked( nr, nc, ctx ) ) continue;
 
       int ng = cg + 1;
-      if ( ng < g_score[ni] )
+      if ( ng < grid_g( s, ni ) )
       {
+        seen[ni]      = stamp;
         g_score[ni]   = ng;
         came_from[ni] = ci;
-        heap_push( ni, ng + abs( goal_r - nr ) + abs( goal_c - nc ) );
+        heap_push( s, ni, ng + abs( goal_r - nr ) + abs( goal_c - nc ) );
       }
     }
   }
 
-  /* No path found */
-  if ( came_from[gi] < 0 ) return 0;
+  if ( seen[gi] == stamp )
+    return path_build( came_from, si, gi, grid_w, out );
 
-  /* Reconstruct path backwards into temp buffer */
-  PathNode_t rev[PATH_MAX_LEN];
-  int len = 0;
-  int idx = gi;
-  while ( idx >= 0 && len < PATH_MAX_LEN )
-  {
-    rev[len].row = idx % grid_w;
-    rev[len].col = idx / grid_w;
-    len++;
-    if ( idx == si ) break;
-    idx = came_from[idx];
-  }
-
-  /* Sanity: path must end at start */
-  if ( len == 0 || rev[len - 1].row != start_r || rev[len - 1].col != start_c )
-    return 0;
-
-  /* Reverse into out[] */
-  for ( int i = 0; i < len; i++ )
-    out[i] = rev[len - 1 - i];
-
-  return len;
+  /* No path found - unless a cap got in the way, then head for the
+     closest tile we did reach */
+  if ( !capped || best == si ) return 0;
+  if ( limits ) limits->partial = 1;
+  return path_build( came_from, si, best, grid_w, out );
 }
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <string.h>
+#include <Archimedes.h>
+
+#include "asset_loader.h"
+#include "sound_bank.h"
+
+/* sfx must stay the first member - callers hold &entry->sfx */
+typedef struct
+{
+  aSoundEffect_t sfx;
+  char           path[SOUND_BANK_PATH_LEN];
+  int            refs;
+  int            loaded;
+} SoundBankEntry_t;
+
+static SoundBankEntry_t g_bank[SOUND_BANK_MAX];
+static int              g_num_bank = 0;
+
+static SoundBankEntry_t* sb_Entry( aSoundEffect_t* sfx )
+{
+  const char* p  = (const char*)sfx;
+  const char* lo = (const char*)g_bank;
+  const char* hi = (const char*)( g_bank + g_num_bank );
+  return ( p >= lo && p < hi ) ? (SoundBankEntry_t*)sfx : NULL;
+}
+
+static SoundBankEntry_t* sb_Find( const char* path )
+{
+  SoundBankEntry_t* free_slot = NULL;
+
+  for ( int i = 0; i < g_num_bank; i++ )
+  {
+    if ( strcmp( g_bank[i].path, path ) == 0 ) return &g_bank[i];
+    if ( !free_slot && g_bank[i].refs == 0 && !g_bank[i].loaded )
+      free_slot = &g_bank[i];
+  }
+
+  /* Reuse an entry nobody holds before growing */
+  if ( !free_slot )
+  {
+    if ( g_num_bank >= SOUND_BANK_MAX ) return NULL;
+    free_slot = &g_bank[g_num_bank++];
+  }
+
+  memset( free_slot, 0, sizeof( SoundBankEntry_t ) );
+  snprintf( free_slot->path, sizeof( free_slot->path ), "%s", path );
+  return free_slot;
+}
+
+static void sb_Load( SoundBankEntry_t* e )
+{
+  if ( e->loaded ) return;
+  e->loaded = 1;
+  a_AudioLoadSound( e->path, &e->sfx );
+}
+
+void SoundBankAcquire( aSoundEffect_t** slot, const char* path )
+{
+  SoundBankEntry_t* e = sb_Find( path );
+  if ( !e )
+  {
+    printf( "SOUND: bank full, %s will not play\n", path );
+    SoundBankRelease( slot );
+    return;
+  }
+
+  e->refs++;
+  SoundBankRelease( slot );
+  *slot = &e->sfx;
+}
+
+void SoundBankRelease( aSoundEffect_t** slot )
+{
+  SoundBankEntry_t* e = sb_Entry( *slot );
+  *slot = NULL;
+  if ( !e || e->refs <= 0 ) return;
+
+  if ( --e->refs == 0 && e->loaded )
+  {
+    a_AudioFreeSound( &e->sfx );
+    memset( &e->sfx, 0, sizeof( aSoundEffect_t ) );
+    e->loaded = 0;
+  }
+}
+
+void SoundBankPlay( aSoundEffect_t* sfx, aAudioOptions_t* opts )
+{
+  SoundBankEntry_t* e = sb_Entry( sfx );
+  if ( !e ) return;
+
+  sb_Load( e );
+  a_AudioPlaySound( &e->sfx, opts );
+}
+
+static void sb_LoadCall( void* user )
+{
+  sb_Load( (SoundBankEntry_t*)user );
+}
+
+void SoundBankPrefetch( aSoundEffect_t* sfx )
+{
+  SoundBankEntry_t* e = sb_Entry( sfx );
+  if ( e && !e->loaded ) AssetQueueCall( sb_LoadCall, e );
+}
@@ -1,12 +1,22 @@
+#include <stdio.h>
 #include <stdlib.h>
 #include <Archimedes.h>
 #include <Daedalus.h>
 
+#include "sound_bank.h"
 #include "sound_manager.h"
 #include "tween.h"
 
+#define MUSIC_MENU_PATH  "resources/music/Soliloquy.ogg"
+#define MUSIC_GAME_PATH  "resources/music/Desolate.ogg"
+#define AMBIENCE_PATH    "resources/ambience/Forgoten_tombs.ogg"
+
+/* Mix_Music streams from disk, so a track is only opened the first time
+   it plays and never decoded whole */
 static aMusic_t music_menu;
 static aMusic_t music_game;
+static int music_menu_open = 0;
+static int music_game_open = 0;
 static int game_music_active = 0;
 static int menu_music_active = 0;
 
@@ -15,10 +25,10 @@ static int g_sfx_pct   = 100;
 
 /* Footsteps - pick a random one each move */
 #define FOOTSTEP_COUNT 10
-static aSoundEffect_t footsteps[FOOTSTEP_COUNT];
+static aSoundEffect_t* footsteps[FOOTSTEP_COUNT];
 
 /* Dungeon ambience - loops on AUDIO_CHANNEL_WEATHER with random volume drift */
-static aSoundEffect_t ambience_dungeon;
+static aSoundEffect_t* ambience_dungeon = NULL;
 static TweenManager_t amb_tweens;
 static float amb_volume;
 
@@ -69,18 +79,40 @@ static void amb_fade_out( void* user_data )
                           amb_start_cycle, NULL );
 }
 
-void SoundManagerInit( void )
+static aMusic_t* sm_Music( aMusic_t* m, int* open, const char* path )
 {
-  a_AudioLoadMusic( "resources/music/Soliloquy.ogg", &music_menu );
-  a_AudioLoadMusic( "resources/music/Desolate.ogg", &music_game );
-  a_AudioLoadSound( "resources/ambience/Forgoten_tombs.ogg", &ambience_dungeon );
+  if ( !*open )
+  {
+    a_AudioLoadMusic( path, m );
+    *open = 1;
+  }
+  return m;
+}
+
+/* The ambience is a long OGG decoded to a chunk - do it behind the
+   game scene's loading bar instead of on the first dungeon frame.
+   Footsteps load on first play. */
+void SoundManagerPrefetchGame( void )
+{
+  SoundBankAcquire( &ambience_dungeon, AMBIENCE_PATH );
 
   char path[64];
   for ( int i = 0; i < FOOTSTEP_COUNT; i++ )
   {
     snprintf( path, sizeof( path ), "resources/soundeffects/Footstep_Dirt_%02d.wav", i );
-    a_AudioLoadSound( path, &footsteps[i] );
+    SoundBankAcquire( &footsteps[i], path );
   }
+
+  SoundBankPrefetch( ambience_dungeon );
+}
+
+void SoundManagerReleaseGame( void )
+{
+  a_AudioHaltChannel( AUDIO_CHANNEL_WEATHER );
+  StopAllTweens( &amb_tweens );
+  SoundBankRelease( &ambience_dungeon );
+  for ( int i = 0; i < FOOTSTEP_COUNT; i++ )
+    SoundBankRelease( &footsteps[i] );
 }
 
 void SoundManagerUpdate( float dt )
@@ -94,7 +126,8 @@ void SoundManagerCrossfadeToGame( void )
   if ( game_music_active ) return;
   d_LogInfo( "[sound] crossfade to game music" );
   a_AudioSetMusicVolume( 80 * g_music_pct / 100 );
-  a_AudioPlayMusic( &music_game, -1, MUSIC_FADE_MS );
+  a_AudioPlayMusic( sm_Music( &music_game, &music_game_open, MUSIC_GAME_PATH ),
+                      -1, MUSIC_FADE_MS );
   game_music_active = 1;
   menu_music_active = 0;
 }
@@ -105,7 +138,8 @@ void SoundManagerPlayMenu( void )
   {
     a_AudioStopMusic( MUSIC_FADE_MS );
     a_AudioSetMusicVolume( AUDIO_MAX_VOLUME * g_music_pct / 100 );
-    a_AudioPlayMusic( &music_menu, -1, MUSIC_FADE_MS );
+    a_AudioPlayMusic( sm_Music( &music_menu, &music_menu_open, MUSIC_MENU_PATH ),
+                      -1, MUSIC_FADE_MS );
     menu_music_active = 1;
   }
   game_music_active = 0;
@@ -122,7 +156,8 @@ void SoundManagerPlayGame( void )
   {
     a_AudioStopMusic( MUSIC_FADE_MS );
     a_AudioSetMusicVolume( 80 * g_music_pct / 100 );
-    a_AudioPlayMusic( &music_game, -1, MUSIC_FADE_MS );
+    a_AudioPlayMusic( sm_Music( &music_game, &music_game_open, MUSIC_GAME_PATH ),
+                      -1, MUSIC_FADE_MS );
     game_music_active = 1;
   }
 
@@ -131,7 +166,7 @@ void SoundManagerPlayGame( void )
   aAudioOptions_t opts = a_AudioDefaultOptions();
   opts.channel = AUDIO_CHANNEL_WEATHER;
   opts.loops   = -1;
-  a_AudioPlaySound( &ambience_dungeon, &opts );
+  SoundBankPlay( ambience_dungeon, &opts );
   a_AudioSetChannelVolume( AUDIO_CHANNEL_WEATHER, 0 );
 
   /* Kick off the random volume drift */
@@ -152,7 +187,7 @@ void SoundManagerPlayFootstep( void )
   a_TimerStart( footstep_timer );
   aAudioOptions_t opts = a_AudioDefaultOptions();
   opts.volume = (int)( AUDIO_MAX_VOLUME * 0.7f ) * g_sfx_pct / 100;
-  a_AudioPlaySound( &footsteps[ rand() % FOOTSTEP_COUNT ], &opts );
+  SoundBankPlay( footsteps[ rand() % FOOTSTEP_COUNT ], &opts );
 }
 
 void SoundManagerStop( void )
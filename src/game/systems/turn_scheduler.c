@@ -0,0 +1,119 @@
+#include <stdio.h>
+
+#include "turn_scheduler.h"
+
+static float ts_phase_time[TURN_PHASE_COUNT] = {
+  [TURN_PHASE_DELAY]  = 0.2f,
+  [TURN_PHASE_MOVE]   = 0.15f,
+  [TURN_PHASE_ATTACK] = 0.12f,
+};
+
+typedef struct
+{
+  int actor;
+  int energy;
+  int seq;
+} TurnEntry_t;
+
+/* Binary max-heap on (energy, -seq) */
+static TurnEntry_t ts_heap[TURN_QUEUE_MAX];
+static int         ts_size = 0;
+static int         ts_seq  = 0;
+
+typedef struct
+{
+  const char*    name;
+  TurnSystemFn_t fn;
+} TurnSystem_t;
+
+static TurnSystem_t ts_systems[TURN_STAGE_COUNT][TURN_SYSTEMS_MAX];
+static int          ts_num_systems[TURN_STAGE_COUNT];
+
+float TurnPhaseTime( TurnPhase_t phase )
+{
+  if ( phase < 0 || phase >= TURN_PHASE_COUNT ) return 0.0f;
+  return ts_phase_time[phase];
+}
+
+static int ts_Before( const TurnEntry_t* a, const TurnEntry_t* b )
+{
+  if ( a->energy != b->energy ) return a->energy > b->energy;
+  return a->seq < b->seq;
+}
+
+static void ts_Swap( int a, int b )
+{
+  TurnEntry_t t = ts_heap[a];
+  ts_heap[a] = ts_heap[b];
+  ts_heap[b] = t;
+}
+
+void TurnQueueClear( void )
+{
+  ts_size = 0;
+  ts_seq  = 0;
+}
+
+void TurnQueuePush( int actor, int energy )
+{
+  if ( ts_size >= TURN_QUEUE_MAX )
+  {
+    printf( "SCHEDULER: more than %d actors queued\n", TURN_QUEUE_MAX );
+    return;
+  }
+
+  int i = ts_size++;
+  ts_heap[i] = (TurnEntry_t){ actor, energy, ts_seq++ };
+  while ( i > 0 && ts_Before( &ts_heap[i], &ts_heap[( i - 1 ) / 2] ) )
+  {
+    ts_Swap( i, ( i - 1 ) / 2 );
+    i = ( i - 1 ) / 2;
+  }
+}
+
+int TurnQueuePop( int* energy )
+{
+  if ( ts_size == 0 ) return -1;
+
+  TurnEntry_t top = ts_heap[0];
+  ts_heap[0] = ts_heap[--ts_size];
+
+  int i = 0;
+  for ( ;; )
+  {
+    int l = i * 2 + 1, r = l + 1, best = i;
+    if ( l < ts_size && ts_Before( &ts_heap[l], &ts_heap[best] ) ) best = l;
+    if ( r < ts_size && ts_Before( &ts_heap[r], &ts_heap[best] ) ) best = r;
+    if ( best == i ) break;
+    ts_Swap( i, best );
+    i = best;
+  }
+
+  if ( energy ) *energy = top.energy;
+  return top.actor;
+}
+
+void TurnSystemsClear( void )
+{
+  for ( int s = 0; s < TURN_STAGE_COUNT; s++ )
+    ts_num_systems[s] = 0;
+}
+
+void TurnSystemRegister( TurnStage_t stage, const char* name,
+                         TurnSystemFn_t fn )
+{
+  if ( stage < 0 || stage >= TURN_STAGE_COUNT || !fn ) return;
+  if ( ts_num_systems[stage] >= TURN_SYSTEMS_MAX )
+  {
+    printf( "SCHEDULER: no room for system '%s'\n", name );
+    return;
+  }
+  ts_systems[stage][ts_num_systems[stage]++] = (TurnSystem_t){ name, fn };
+}
+
+void TurnSystemsRun( TurnStage_t stage )
+{
+  if ( stage < 0 || stage >= TURN_STAGE_COUNT ) return;
+  for ( int i = 0; i < ts_num_systems[stage]; i++ )
+    ts_systems[stage][i].fn();
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+
+#include "turn_timeline.h"
+
+typedef struct
+{
+  float* x;
+  float* y;
+  float  x0, y0;
+  float  x1, y1;
+  int    lunge;
+} TurnMotion_t;
+
+static TurnMotion_t tl_motions[TURN_TIMELINE_MAX];
+static int          tl_count    = 0;
+static float        tl_elapsed  = 0.0f;
+static float        tl_duration = 0.0f;
+
+static float tl_EaseOutCubic( float t )
+{
+  float u = 1.0f - t;
+  return 1.0f - u * u * u;
+}
+
+static float tl_EaseOutQuad( float t )
+{
+  return t * ( 2.0f - t );
+}
+
+static TurnMotion_t* tl_Add( float* x, float* y )
+{
+  /* One motion per actor - a second one replaces the first */
+  for ( int i = 0; i < tl_count; i++ )
+    if ( tl_motions[i].x == x ) return &tl_motions[i];
+
+  if ( tl_count >= TURN_TIMELINE_MAX )
+  {
+    printf( "TIMELINE: more than %d actors in one phase\n", TURN_TIMELINE_MAX );
+    return NULL;
+  }
+
+  TurnMotion_t* m = &tl_motions[tl_count++];
+  m->x = x;
+  m->y = y;
+  return m;
+}
+
+void TurnTimelineBegin( float duration )
+{
+  tl_count    = 0;
+  tl_elapsed  = 0.0f;
+  tl_duration = duration;
+}
+
+void TurnTimelineSlide( float* x, float* y, float tx, float ty )
+{
+  TurnMotion_t* m = tl_Add( x, y );
+  if ( !m ) return;
+
+  m->x0    = *x;  m->y0 = *y;
+  m->x1    = tx;  m->y1 = ty;
+  m->lunge = 0;
+}
+
+void TurnTimelineLunge( float* x, float* y, int dr, int dc, float dist )
+{
+  TurnMotion_t* m = tl_Add( x, y );
+  if ( !m ) return;
+
+  m->x0    = *x;  m->y0 = *y;
+  m->x1    = *x + dr * dist;
+  m->y1    = *y + dc * dist;
+  m->lunge = 1;
+}
+
+int TurnTimelineUpdate( float dt )
+{
+  if ( tl_count == 0 || tl_duration <= 0.0f ) return 0;
+
+  tl_elapsed += dt;
+  float t = tl_elapsed / tl_duration;
+  if ( t > 1.0f ) t = 1.0f;
+
+  for ( int i = 0; i < tl_count; i++ )
+  {
+    TurnMotion_t* m = &tl_motions[i];
+
+    /* Lunges go out in the first half and come home in the second */
+    float k;
+    if ( !m->lunge )         k = tl_EaseOutCubic( t );
+    else if ( t < 0.5f )     k = tl_EaseOutQuad( t * 2.0f );
+    else                     k = 1.0f - tl_EaseOutCubic( t * 2.0f - 1.0f );
+
+    *m->x = m->x0 + ( m->x1 - m->x0 ) * k;
+    *m->y = m->y0 + ( m->y1 - m->y0 ) * k;
+  }
+
+  if ( t < 1.0f ) return 1;
+
+  tl_count = 0;
+  return 0;
+}
+
+int TurnTimelineCount( void )
+{
+  return tl_count;
+}
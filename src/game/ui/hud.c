@@ -7,6 +7,7 @@
 #include "items.h"
 #include "transitions.h"
 #include "draw_utils.h"
+#include "widget_bind.h"
 
 extern Player_t player;
 
@@ -33,16 +34,19 @@ static int g_passive_hover = -1;
 
 static void PassivesClear( void ) { g_num_passives = 0; g_passive_hover = -1; }
 
-static int FindEquipByEffect( const char* effect )
-{
-  for ( int i = 0; i < EQUIP_SLOTS; i++ )
-  {
-    if ( player.equipment[i] < 0 ) continue;
-    if ( strcmp( g_equipment[player.equipment[i]].effect, effect ) == 0 )
-      return player.equipment[i];
-  }
-  return -1;
-}
+/* Effects with their own top-bar segment - the rest share the generic one */
+static const int g_own_segment[EQUIP_EFFECT_COUNT] = {
+  [EQUIP_EFFECT_NONE]         = 1,
+  [EQUIP_EFFECT_FIRST_STRIKE] = 1,
+  [EQUIP_EFFECT_SCROLL_ECHO]  = 1,
+  [EQUIP_EFFECT_BERSERK]      = 1,
+  [EQUIP_EFFECT_POISON]       = 1,
+  [EQUIP_EFFECT_AMPLIFY]      = 1,
+  [EQUIP_EFFECT_DODGE]        = 1,
+  [EQUIP_EFFECT_ARMOR_BREAK]  = 1,
+  [EQUIP_EFFECT_MANA_SHIELD]  = 1,
+  [EQUIP_EFFECT_COMPANION]    = 1,
+};
 
 static void PassiveAdd( float x, float y, float w, float h, int equip_idx )
 {
@@ -76,129 +80,109 @@ static int PassivesFindHover( void )
 #define HUD_MODAL_LINE_LG  24.0f
 #define HUD_MODAL_H       130.0f
 
-int HUDDrawTopBar( int in_combat )
+/* Retained top bar - text segments are rebuilt only when the player state
+   version or the combat indicator changes. */
+#define TB_MAX_SEGS 24
+typedef struct
 {
-  aContainerWidget_t* tb = a_GetContainerFromWidget( "top_bar" );
-  aRectf_t r = tb->rect;
-  r.y += TransitionGetTopBarOY();
-  float tb_alpha = TransitionGetUIAlpha();
-
-  /* Background + border */
-  aColor_t tb_bg = PANEL_BG;
-  tb_bg.a = (int)( tb_bg.a * tb_alpha );
-  aColor_t tb_fg = PANEL_FG;
-  tb_fg.a = (int)( tb_fg.a * tb_alpha );
-  a_DrawFilledRect( r, tb_bg );
-  a_DrawRect( r, tb_fg );
-
-  aTextStyle_t ts = a_default_text_style;
-  ts.bg = (aColor_t){ 0, 0, 0, 0 };
+  char     text[48];
+  aColor_t color;
+  float    scale;
+  float    x, w;             /* x relative to the bar's left edge */
+  float    dy;               /* y offset below the bar's text line */
+  int      equip_idx;        /* passive tooltip target, -1 = none */
+} TopBarSeg_t;
+
+static TopBarSeg_t g_segs[TB_MAX_SEGS];
+static int         g_num_segs       = 0;
+static int         g_built_player   = -1;
+static int         g_built_combat   = -1;
+
+static float SegAdd( float x, float dy, float scale, aColor_t color,
+                     int equip_idx, const char* text )
+{
+  if ( g_num_segs >= TB_MAX_SEGS ) return x;
+  TopBarSeg_t* sg = &g_segs[g_num_segs++];
+  snprintf( sg->text, sizeof( sg->text ), "%s", text );
+  sg->color     = color;
+  sg->scale     = scale;
+  sg->x         = x;
+  sg->w         = strlen( sg->text ) * 8.0f * scale;
+  sg->dy        = dy;
+  sg->equip_idx = equip_idx;
+  return x + sg->w;
+}
 
-  float tx = r.x + TB_PAD_X;
-  float ty = r.y + TB_PAD_Y;
+static void TopBarRebuild( int in_combat )
+{
+  g_num_segs = 0;
+  char buf[48];
 
   /* Player name - left side, larger */
-  ts.fg = (aColor_t){ 0xeb, 0xed, 0xe9, 255 };
-  ts.scale = TB_NAME_SCALE;
-  ts.align = TEXT_ALIGN_LEFT;
-  a_DrawText( player.name, (int)tx, (int)ty, ts );
-
-  /* Measure name width to place stats right after it */
-  float name_w = strlen( player.name ) * 8.0f * TB_NAME_SCALE;
-  float sx = tx + name_w + TB_SECTION_GAP;
-
-  /* Stats - flexed right of name, smaller */
-  ts.scale = TB_STAT_SCALE;
-  ts.align = TEXT_ALIGN_LEFT;
-  char buf[48];
+  float sx = SegAdd( TB_PAD_X, 0, TB_NAME_SCALE,
+                     (aColor_t){ 0xeb, 0xed, 0xe9, 255 }, -1, player.name );
+  sx += TB_SECTION_GAP;
 
   /* HP - label near-white, numbers colored by percentage */
-  ts.fg = (aColor_t){ 0xeb, 0xed, 0xe9, 255 };
-  a_DrawText( "HP: ", (int)sx, (int)( ty + 4 ), ts );
-  float hp_label_w = 4 * 8.0f * TB_STAT_SCALE;
+  sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0xeb, 0xed, 0xe9, 255 }, -1, "HP: " );
 
+  aColor_t hp_fg;
   float hp_pct = ( player.max_hp > 0 ) ? (float)player.hp / player.max_hp : 0;
-  if ( hp_pct > 0.5f )       ts.fg = (aColor_t){ 0x75, 0xa7, 0x43, 255 };
-  else if ( hp_pct > 0.25f ) ts.fg = (aColor_t){ 0xde, 0x9e, 0x41, 255 };
-  else                        ts.fg = (aColor_t){ 0xa5, 0x30, 0x30, 255 };
+  if ( hp_pct > 0.5f )       hp_fg = (aColor_t){ 0x75, 0xa7, 0x43, 255 };
+  else if ( hp_pct > 0.25f ) hp_fg = (aColor_t){ 0xde, 0x9e, 0x41, 255 };
+  else                        hp_fg = (aColor_t){ 0xa5, 0x30, 0x30, 255 };
 
   snprintf( buf, sizeof( buf ), "%d/%d", player.hp, player.max_hp );
-  a_DrawText( buf, (int)( sx + hp_label_w ), (int)( ty + 4 ), ts );
-  sx += hp_label_w + strlen( buf ) * 8.0f * TB_STAT_SCALE + TB_STAT_GAP;
+  sx = SegAdd( sx, 4, TB_STAT_SCALE, hp_fg, -1, buf ) + TB_STAT_GAP;
 
   /* DMG */
-  snprintf( buf, sizeof( buf ), "DMG: %d", PlayerStat( "damage" ) );
-  ts.fg = (aColor_t){ 0xeb, 0xed, 0xe9, 255 };
-  a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-  sx += strlen( buf ) * 8.0f * TB_STAT_SCALE + TB_STAT_GAP;
+  snprintf( buf, sizeof( buf ), "DMG: %d", player.derived.damage );
+  sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0xeb, 0xed, 0xe9, 255 }, -1, buf ) + TB_STAT_GAP;
 
   /* DEF */
-  snprintf( buf, sizeof( buf ), "DEF: %d", PlayerStat( "defense" ) );
-  ts.fg = (aColor_t){ 0xeb, 0xed, 0xe9, 255 };
-  a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-  sx += strlen( buf ) * 8.0f * TB_STAT_SCALE + TB_STAT_GAP;
+  snprintf( buf, sizeof( buf ), "DEF: %d", player.derived.defense );
+  sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0xeb, 0xed, 0xe9, 255 }, -1, buf ) + TB_STAT_GAP;
 
   /* Gold */
   snprintf( buf, sizeof( buf ), "G: %d", player.gold );
-  ts.fg = (aColor_t){ 0xda, 0xaf, 0x20, 255 };
-  a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-  sx += strlen( buf ) * 8.0f * TB_STAT_SCALE + TB_STAT_GAP;
+  sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0xda, 0xaf, 0x20, 255 }, -1, buf ) + TB_STAT_GAP;
 
   /* Equipment effects - gold (skip conditional ones) */
-  PassivesClear();
-  ts.fg = (aColor_t){ 0xde, 0x9e, 0x41, 255 };
   for ( int i = 0; i < EQUIP_SLOTS; i++ )
   {
     if ( player.equipment[i] < 0 ) continue;
     EquipmentInfo_t* e = &g_equipment[ player.equipment[i] ];
-    if ( strcmp( e->effect, "none" ) == 0 ) continue;
-    if ( strcmp( e->effect, "first_strike" ) == 0 ) continue;
-    if ( strcmp( e->effect, "scroll_echo" ) == 0 ) continue;
-    if ( strcmp( e->effect, "berserk" ) == 0 ) continue;
-    if ( strcmp( e->effect, "poison" ) == 0 ) continue;
-    if ( strcmp( e->effect, "amplify" ) == 0 ) continue;
-    if ( strcmp( e->effect, "dodge" ) == 0 ) continue;
-    if ( strcmp( e->effect, "armor_break" ) == 0 ) continue;
-    if ( strcmp( e->effect, "mana_shield" ) == 0 ) continue;
-    if ( strcmp( e->effect, "companion" ) == 0 ) continue;
+    if ( g_own_segment[e->effect_id] ) continue;
     snprintf( buf, sizeof( buf ), "%s(%d)", e->effect, e->effect_value );
-    float tw = strlen( buf ) * 8.0f * TB_STAT_SCALE;
-    PassiveAdd( sx, ty + 4, tw, r.y + r.h - ( ty + 4 ), player.equipment[i] );
-    a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-    sx += tw + TB_STAT_GAP;
+    sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0xde, 0x9e, 0x41, 255 },
+                 player.equipment[i], buf ) + TB_STAT_GAP;
   }
 
   /* first_strike - green, only when ready */
   {
-    int fs = PlayerEquipEffect( "first_strike" );
+    int fs = player.derived.effect[EQUIP_EFFECT_FIRST_STRIKE];
     if ( fs > 0 && player.first_strike_active )
     {
-      ts.fg = (aColor_t){ 0x75, 0xa7, 0x43, 255 };
       snprintf( buf, sizeof( buf ), "FIRST STRIKE(%d)", fs );
-      float pw = strlen( buf ) * 8.0f * TB_STAT_SCALE;
-      PassiveAdd( sx, ty + 4, pw, r.y + r.h - ( ty + 4 ), FindEquipByEffect( "first_strike" ) );
-      a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-      sx += pw + TB_STAT_GAP;
+      sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0x75, 0xa7, 0x43, 255 },
+                   player.derived.effect_item[EQUIP_EFFECT_FIRST_STRIKE], buf ) + TB_STAT_GAP;
     }
   }
 
   /* scroll_echo - blue, show progress toward free cast */
   {
-    int echo = PlayerEquipEffectMin( "scroll_echo" );
+    int echo = player.derived.effect_min[EQUIP_EFFECT_SCROLL_ECHO];
     if ( echo > 0 )
     {
-      ts.fg = (aColor_t){ 0x73, 0xbe, 0xd3, 255 };
       snprintf( buf, sizeof( buf ), "ECHO(%d/%d)", player.scroll_echo_counter, echo );
-      float pw = strlen( buf ) * 8.0f * TB_STAT_SCALE;
-      PassiveAdd( sx, ty + 4, pw, r.y + r.h - ( ty + 4 ), FindEquipByEffect( "scroll_echo" ) );
-      a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-      sx += pw + TB_STAT_GAP;
+      sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0x73, 0xbe, 0xd3, 255 },
+                   player.derived.effect_item[EQUIP_EFFECT_SCROLL_ECHO], buf ) + TB_STAT_GAP;
     }
   }
 
   /* berserk - red, show stacks based on missing HP */
   {
-    int bsk = PlayerEquipEffect( "berserk" );
+    int bsk = player.derived.effect[EQUIP_EFFECT_BERSERK];
     if ( bsk > 0 && player.max_hp > 0 )
     {
       int threshold  = ( bsk >= 2 ) ? 20 : 40;
@@ -206,95 +190,112 @@ int HUDDrawTopBar( int in_combat )
       int missing_pct = ( ( player.max_hp - player.hp ) * 100 ) / player.max_hp;
       int stacks = missing_pct / threshold;
       if ( stacks > max_stacks ) stacks = max_stacks;
-      ts.fg = ( stacks > 0 )
+      aColor_t fg = ( stacks > 0 )
         ? (aColor_t){ 0xa5, 0x30, 0x30, 255 }
         : (aColor_t){ 0x6e, 0x3b, 0x3b, 255 };
       snprintf( buf, sizeof( buf ), "BERSERK(+%d)", stacks );
-      float pw = strlen( buf ) * 8.0f * TB_STAT_SCALE;
-      PassiveAdd( sx, ty + 4, pw, r.y + r.h - ( ty + 4 ), FindEquipByEffect( "berserk" ) );
-      a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-      sx += pw + TB_STAT_GAP;
+      sx = SegAdd( sx, 4, TB_STAT_SCALE, fg,
+                   player.derived.effect_item[EQUIP_EFFECT_BERSERK], buf ) + TB_STAT_GAP;
     }
   }
 
   /* amplify - blue, always active when equipped */
   {
-    int amp = PlayerEquipEffect( "amplify" );
+    int amp = player.derived.effect[EQUIP_EFFECT_AMPLIFY];
     if ( amp > 0 )
     {
-      ts.fg = (aColor_t){ 0x73, 0xbe, 0xd3, 255 };
       snprintf( buf, sizeof( buf ), "AMPLIFY(%d)", amp );
-      float pw = strlen( buf ) * 8.0f * TB_STAT_SCALE;
-      PassiveAdd( sx, ty + 4, pw, r.y + r.h - ( ty + 4 ), FindEquipByEffect( "amplify" ) );
-      a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-      sx += pw + TB_STAT_GAP;
+      sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0x73, 0xbe, 0xd3, 255 },
+                   player.derived.effect_item[EQUIP_EFFECT_AMPLIFY], buf ) + TB_STAT_GAP;
     }
   }
 
   /* dodge - green, show counter progress */
   {
-    int dodge = PlayerEquipEffect( "dodge" );
+    int dodge = player.derived.effect[EQUIP_EFFECT_DODGE];
     if ( dodge > 0 )
     {
-      ts.fg = (aColor_t){ 0x75, 0xa7, 0x43, 255 };
       snprintf( buf, sizeof( buf ), "DODGE(%d/%d)", player.dodge_counter % dodge, dodge );
-      float pw = strlen( buf ) * 8.0f * TB_STAT_SCALE;
-      PassiveAdd( sx, ty + 4, pw, r.y + r.h - ( ty + 4 ), FindEquipByEffect( "dodge" ) );
-      a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-      sx += pw + TB_STAT_GAP;
+      sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0x75, 0xa7, 0x43, 255 },
+                   player.derived.effect_item[EQUIP_EFFECT_DODGE], buf ) + TB_STAT_GAP;
     }
   }
 
   /* armor_break - red, show counter progress */
   {
-    int ab = PlayerEquipEffect( "armor_break" );
+    int ab = player.derived.effect[EQUIP_EFFECT_ARMOR_BREAK];
     if ( ab > 0 )
     {
-      ts.fg = (aColor_t){ 0xcf, 0x57, 0x3c, 255 };
       snprintf( buf, sizeof( buf ), "BREAK(%d/%d)", player.attack_counter % ab, ab );
-      float pw = strlen( buf ) * 8.0f * TB_STAT_SCALE;
-      PassiveAdd( sx, ty + 4, pw, r.y + r.h - ( ty + 4 ), FindEquipByEffect( "armor_break" ) );
-      a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-      sx += pw + TB_STAT_GAP;
+      sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0xcf, 0x57, 0x3c, 255 },
+                   player.derived.effect_item[EQUIP_EFFECT_ARMOR_BREAK], buf ) + TB_STAT_GAP;
     }
   }
 
   /* mana_shield - blue, always active when equipped */
   {
-    int ms = PlayerEquipEffect( "mana_shield" );
+    int ms = player.derived.effect[EQUIP_EFFECT_MANA_SHIELD];
     if ( ms > 0 )
     {
-      ts.fg = (aColor_t){ 0x73, 0xbe, 0xd3, 255 };
-      snprintf( buf, sizeof( buf ), "SHIELD" );
-      float pw = strlen( buf ) * 8.0f * TB_STAT_SCALE;
-      PassiveAdd( sx, ty + 4, pw, r.y + r.h - ( ty + 4 ), FindEquipByEffect( "mana_shield" ) );
-      a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-      sx += pw + TB_STAT_GAP;
+      sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0x73, 0xbe, 0xd3, 255 },
+                   player.derived.effect_item[EQUIP_EFFECT_MANA_SHIELD], "SHIELD" ) + TB_STAT_GAP;
     }
   }
 
   /* companion (Bloop's Fang) - pink, show counter progress */
   {
-    int comp = PlayerEquipEffect( "companion" );
+    int comp = player.derived.effect[EQUIP_EFFECT_COMPANION];
     if ( comp > 0 )
     {
-      ts.fg = (aColor_t){ 140, 40, 80, 255 };
       snprintf( buf, sizeof( buf ), "FANG(%d/%d)", player.companion_counter, comp );
-      float pw = strlen( buf ) * 8.0f * TB_STAT_SCALE;
-      PassiveAdd( sx, ty + 4, pw, r.y + r.h - ( ty + 4 ), FindEquipByEffect( "companion" ) );
-      a_DrawText( buf, (int)sx, (int)( ty + 4 ), ts );
-      sx += pw + TB_STAT_GAP;
+      sx = SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 140, 40, 80, 255 },
+                   player.derived.effect_item[EQUIP_EFFECT_COMPANION], buf ) + TB_STAT_GAP;
     }
   }
 
   /* Combat indicator - red */
   if ( in_combat )
+    SegAdd( sx, 4, TB_STAT_SCALE, (aColor_t){ 0xa5, 0x30, 0x30, 255 }, -1, "IN COMBAT" );
+
+  g_built_player = PlayerVersion();
+  g_built_combat = in_combat;
+}
+
+int HUDDrawTopBar( int in_combat )
+{
+  aContainerWidget_t* tb = WidgetBindContainer( WB_TOP_BAR );
+  aRectf_t r = tb->rect;
+  r.y += TransitionGetTopBarOY();
+  float tb_alpha = TransitionGetUIAlpha();
+
+  /* Background + border */
+  aColor_t tb_bg = PANEL_BG;
+  tb_bg.a = (int)( tb_bg.a * tb_alpha );
+  aColor_t tb_fg = PANEL_FG;
+  tb_fg.a = (int)( tb_fg.a * tb_alpha );
+  a_DrawFilledRect( r, tb_bg );
+  a_DrawRect( r, tb_fg );
+
+  if ( PlayerVersion() != g_built_player || in_combat != g_built_combat )
+    TopBarRebuild( in_combat );
+
+  aTextStyle_t ts = a_default_text_style;
+  ts.bg    = (aColor_t){ 0, 0, 0, 0 };
+  ts.align = TEXT_ALIGN_LEFT;
+
+  float ty = r.y + TB_PAD_Y;
+
+  PassivesClear();
+  for ( int i = 0; i < g_num_segs; i++ )
   {
-    ts.fg = (aColor_t){ 0xa5, 0x30, 0x30, 255 };
-    ts.scale = TB_STAT_SCALE;
-    ts.align = TEXT_ALIGN_LEFT;
-    a_DrawText( "IN COMBAT", (int)sx, (int)( ty + 4 ), ts );
-    sx += 9 * 8.0f * TB_STAT_SCALE + TB_STAT_GAP;
+    TopBarSeg_t* sg = &g_segs[i];
+    float sx = r.x + sg->x;
+    ts.fg    = sg->color;
+    ts.scale = sg->scale;
+    a_DrawText( sg->text, (int)sx, (int)( ty + sg->dy ), ts );
+
+    if ( sg->equip_idx >= 0 )
+      PassiveAdd( sx, ty + sg->dy, sg->w, r.y + r.h - ( ty + sg->dy ), sg->equip_idx );
   }
 
   /* Pause[ESC] - far right, clickable */
@@ -336,7 +337,7 @@ void HUDDrawPassiveTooltip( void )
   EquipmentInfo_t* e = &g_equipment[ei];
   char buf[48];
 
-  aContainerWidget_t* tb = a_GetContainerFromWidget( "top_bar" );
+  aContainerWidget_t* tb = WidgetBindContainer( WB_TOP_BAR );
   aRectf_t r = tb->rect;
   r.y += TransitionGetTopBarOY();
 
@@ -348,7 +349,7 @@ void HUDDrawPassiveTooltip( void )
   float header_h = HUD_MODAL_PAD_Y + HUD_MODAL_LINE_LG;
   if ( e->damage > 0 )  header_h += HUD_MODAL_LINE_SM;
   if ( e->defense > 0 ) header_h += HUD_MODAL_LINE_SM;
-  if ( strcmp( e->effect, "none" ) != 0 )
+  if ( e->effect_id != EQUIP_EFFECT_NONE )
     header_h += HUD_MODAL_LINE_MD;
   else
     header_h += HUD_MODAL_LINE_SM;
@@ -391,7 +392,7 @@ void HUDDrawPassiveTooltip( void )
     a_DrawText( buf, (int)modal_tx, (int)modal_ty, ts );
     modal_ty += HUD_MODAL_LINE_SM;
   }
-  if ( strcmp( e->effect, "none" ) != 0 )
+  if ( e->effect_id != EQUIP_EFFECT_NONE )
   {
     ts.fg = (aColor_t){ 0xde, 0x9e, 0x41, 255 };
     snprintf( buf, sizeof( buf ), "%s (%d)", e->effect, e->effect_value );
@@ -14,6 +14,8 @@
 #include "ground_items.h"
 #include "movement.h"
 #include "shop.h"
+#include "widget_bind.h"
+#include "sound_bank.h"
 
 /* Panel colors */
 #define PANEL_FG  (aColor_t){ 0xc7, 0xcf, 0xcc, 255 }
@@ -156,9 +158,9 @@ static int BuildHotkeyMap( int hotkey_slots[MAX_HOTKEYS] )
     if ( s->type != INV_CONSUMABLE ) continue;
     if ( s->index < 0 || s->index >= g_num_consumables ) continue;
     ConsumableInfo_t* c = &g_consumables[s->index];
-    if ( strcmp( c->type, "food" ) == 0
-      || strcmp( c->type, "gadget" ) == 0
-      || strcmp( c->type, "scroll" ) == 0 )
+    if ( c->type_id == CONS_TYPE_FOOD
+      || c->type_id == CONS_TYPE_GADGET
+      || c->type_id == CONS_TYPE_SCROLL )
       hotkey_slots[n++] = i;
   }
   return n;
@@ -181,7 +183,7 @@ int InventoryUILogic( int mouse_moved )
       app.keyboard[SDL_SCANCODE_UP] = 0;
       eq_action_cursor--;
       if ( eq_action_cursor < 0 ) eq_action_cursor = EQ_ACTION_COUNT - 1;
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
     if ( app.keyboard[SDL_SCANCODE_S] == 1 || app.keyboard[SDL_SCANCODE_DOWN] == 1 )
     {
@@ -189,7 +191,7 @@ int InventoryUILogic( int mouse_moved )
       app.keyboard[SDL_SCANCODE_DOWN] = 0;
       eq_action_cursor++;
       if ( eq_action_cursor >= EQ_ACTION_COUNT ) eq_action_cursor = 0;
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
 
     /* Scroll wheel - navigate action menu */
@@ -198,7 +200,7 @@ int InventoryUILogic( int mouse_moved )
       eq_action_cursor += ( app.mouse.wheel < 0 ) ? 1 : -1;
       if ( eq_action_cursor < 0 ) eq_action_cursor = EQ_ACTION_COUNT - 1;
       if ( eq_action_cursor >= EQ_ACTION_COUNT ) eq_action_cursor = 0;
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
       app.mouse.wheel = 0;
     }
 
@@ -207,7 +209,7 @@ int InventoryUILogic( int mouse_moved )
     {
       int mx = app.mouse.x;
       int my = app.mouse.y;
-      aContainerWidget_t* kp = a_GetContainerFromWidget( "key_panel" );
+      aContainerWidget_t* kp = WidgetBindContainer( WB_KEY_PANEL );
       float mw = CalcModalW( INV_EQUIPMENT, eq_idx );
       float modal_x = kp->rect.x - mw - 8;
       float modal_y = kp->rect.y + EQ_TITLE_H + player.equip_cursor * ( EQ_ROW_H + EQ_PAD );
@@ -221,7 +223,7 @@ int InventoryUILogic( int mouse_moved )
         if ( PointInRect( mx, my, ax, ry, CTX_MENU_W, CTX_MENU_ROW_H ) )
         {
           if ( i != eq_action_cursor )
-            a_AudioPlaySound( sfx_move, NULL );
+            SoundBankPlay( sfx_move, NULL );
           eq_action_cursor = i;
           break;
         }
@@ -242,7 +244,7 @@ int InventoryUILogic( int mouse_moved )
 
       int mx = app.mouse.x;
       int my = app.mouse.y;
-      aContainerWidget_t* kp = a_GetContainerFromWidget( "key_panel" );
+      aContainerWidget_t* kp = WidgetBindContainer( WB_KEY_PANEL );
 
       float mw = CalcModalW( INV_EQUIPMENT, eq_idx );
       float modal_x = kp->rect.x - mw - 8;
@@ -277,13 +279,14 @@ int InventoryUILogic( int mouse_moved )
 
     if ( exec && e )
     {
-      a_AudioPlaySound( sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
       if ( eq_action_cursor == 0 ) /* Unequip */
       {
         int inv_slot = InventoryAdd( INV_EQUIPMENT, eq_idx );
         if ( inv_slot >= 0 )
         {
           player.equipment[player.equip_cursor] = -1;
+          PlayerTouch();
           GameEvent( EVT_UNEQUIP, eq_idx );
         }
       }
@@ -321,7 +324,7 @@ int InventoryUILogic( int mouse_moved )
       app.keyboard[SDL_SCANCODE_UP] = 0;
       inv_action_cursor--;
       if ( inv_action_cursor < 0 ) inv_action_cursor = INV_ACTION_COUNT - 1;
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
     if ( app.keyboard[SDL_SCANCODE_S] == 1 || app.keyboard[SDL_SCANCODE_DOWN] == 1 )
     {
@@ -329,7 +332,7 @@ int InventoryUILogic( int mouse_moved )
       app.keyboard[SDL_SCANCODE_DOWN] = 0;
       inv_action_cursor++;
       if ( inv_action_cursor >= INV_ACTION_COUNT ) inv_action_cursor = 0;
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
 
     /* Scroll wheel - navigate action menu */
@@ -338,7 +341,7 @@ int InventoryUILogic( int mouse_moved )
       inv_action_cursor += ( app.mouse.wheel < 0 ) ? 1 : -1;
       if ( inv_action_cursor < 0 ) inv_action_cursor = INV_ACTION_COUNT - 1;
       if ( inv_action_cursor >= INV_ACTION_COUNT ) inv_action_cursor = 0;
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
       app.mouse.wheel = 0;
     }
 
@@ -347,7 +350,7 @@ int InventoryUILogic( int mouse_moved )
     {
       int mx = app.mouse.x;
       int my = app.mouse.y;
-      aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+      aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
       aRectf_t r = ip->rect;
       float grid_y = r.y + INV_TITLE_H;
       float grid_w = r.w - INV_PAD * 2;
@@ -376,7 +379,7 @@ int InventoryUILogic( int mouse_moved )
         if ( PointInRect( mx, my, amx, ry, CTX_MENU_W, CTX_MENU_ROW_H ) )
         {
           if ( i != inv_action_cursor )
-            a_AudioPlaySound( sfx_move, NULL );
+            SoundBankPlay( sfx_move, NULL );
           inv_action_cursor = i;
           break;
         }
@@ -397,7 +400,7 @@ int InventoryUILogic( int mouse_moved )
 
       int mx = app.mouse.x;
       int my = app.mouse.y;
-      aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+      aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
       aRectf_t r = ip->rect;
       float grid_y = r.y + INV_TITLE_H;
       float grid_w = r.w - INV_PAD * 2;
@@ -459,7 +462,7 @@ int InventoryUILogic( int mouse_moved )
 
     if ( exec && slot->type != INV_EMPTY )
     {
-      a_AudioPlaySound( sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
       if ( inv_action_cursor == 0 ) /* Use / Equip */
       {
         if ( slot->type == INV_EQUIPMENT )
@@ -511,16 +514,14 @@ int InventoryUILogic( int mouse_moved )
           ConsumableInfo_t* ci = &g_consumables[slot->index];
 
           /* Quest items with no action — just look */
-          if ( strcmp( ci->type, "quest" ) == 0
-               && strcmp( ci->effect, "none" ) == 0
+          if ( ci->type_id == CONS_TYPE_QUEST
+               && ci->effect_id == CONS_EFFECT_NONE
                && ci->action[0] == '\0' )
           {
             GameEvent( EVT_LOOK_CONSUMABLE, slot->index );
           }
           /* Gadgets/scrolls/targeted food need targeting */
-          else if ( strcmp( ci->type, "gadget" ) == 0
-               || strcmp( ci->type, "scroll" ) == 0
-               || ( strcmp( ci->type, "food" ) == 0 && ci->range > 0 ) )
+          else if ( ConsumableTargeted( ci ) )
           {
             if ( GameEventsConsumableUsed() )
             {
@@ -600,7 +601,7 @@ int InventoryUILogic( int mouse_moved )
     app.keyboard[SDL_SCANCODE_TAB] = 0;
     ui_focus = !ui_focus;
     if ( ui_focus == 1 ) { player.inv_focused = 1; show_item_hover = 1; }
-    a_AudioPlaySound( sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
 
   /* --- Keyboard nav only when inventory is focused --- */
@@ -619,7 +620,7 @@ int InventoryUILogic( int mouse_moved )
       {
         player.inv_cursor -= INV_COLS;
       }
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
     if ( app.keyboard[SDL_SCANCODE_S] == 1 || app.keyboard[SDL_SCANCODE_DOWN] == 1 )
     {
@@ -634,7 +635,7 @@ int InventoryUILogic( int mouse_moved )
       {
         player.inv_cursor += INV_COLS;
       }
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
     if ( app.keyboard[SDL_SCANCODE_A] == 1 || app.keyboard[SDL_SCANCODE_LEFT] == 1 )
     {
@@ -644,7 +645,7 @@ int InventoryUILogic( int mouse_moved )
         player.inv_cursor--;
       else
         player.inv_cursor += INV_COLS - 1;
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
     if ( app.keyboard[SDL_SCANCODE_D] == 1 || app.keyboard[SDL_SCANCODE_RIGHT] == 1 )
     {
@@ -654,7 +655,7 @@ int InventoryUILogic( int mouse_moved )
         player.inv_cursor++;
       else
         player.inv_cursor -= INV_COLS - 1;
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
 
     /* Auto-scroll to keep cursor visible */
@@ -673,7 +674,7 @@ int InventoryUILogic( int mouse_moved )
       InvSlot_t* s = &player.inventory[player.inv_cursor];
       if ( s->type != INV_EMPTY )
       {
-        a_AudioPlaySound( sfx_click, NULL );
+        SoundBankPlay( sfx_click, NULL );
         inv_action_open = 1;
         inv_action_cursor = 0;
       }
@@ -698,7 +699,7 @@ int InventoryUILogic( int mouse_moved )
       {
         player.equip_cursor--;
       }
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
     if ( app.keyboard[SDL_SCANCODE_S] == 1 || app.keyboard[SDL_SCANCODE_DOWN] == 1 )
     {
@@ -713,7 +714,7 @@ int InventoryUILogic( int mouse_moved )
       {
         player.equip_cursor++;
       }
-      a_AudioPlaySound( sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
 
     /* Space/Enter - open action menu on equipped item */
@@ -723,7 +724,7 @@ int InventoryUILogic( int mouse_moved )
       app.keyboard[SDL_SCANCODE_RETURN] = 0;
       if ( player.equipment[player.equip_cursor] >= 0 )
       {
-        a_AudioPlaySound( sfx_click, NULL );
+        SoundBankPlay( sfx_click, NULL );
         eq_action_open = 1;
         eq_action_cursor = 0;
       }
@@ -734,7 +735,7 @@ int InventoryUILogic( int mouse_moved )
   {
     int mx = app.mouse.x;
     int my = app.mouse.y;
-    aContainerWidget_t* kp = a_GetContainerFromWidget( "key_panel" );
+    aContainerWidget_t* kp = WidgetBindContainer( WB_KEY_PANEL );
     aRectf_t r = kp->rect;
     float ey = r.y + EQ_TITLE_H;
 
@@ -746,7 +747,7 @@ int InventoryUILogic( int mouse_moved )
         if ( mouse_moved )
         {
           if ( i != player.equip_cursor || player.inv_focused || ui_focus == 0 )
-            a_AudioPlaySound( sfx_move, NULL );
+            SoundBankPlay( sfx_move, NULL );
           player.equip_cursor = i;
           player.inv_focused = 0;
           ui_focus = 1;
@@ -757,7 +758,7 @@ int InventoryUILogic( int mouse_moved )
         if ( app.mouse.pressed && app.mouse.button == SDL_BUTTON_LEFT && player.equipment[i] >= 0 )
         {
           app.mouse.pressed = 0;
-          a_AudioPlaySound( sfx_click, NULL );
+          SoundBankPlay( sfx_click, NULL );
           eq_action_open = 1;
           eq_action_cursor = 0;
         }
@@ -769,7 +770,7 @@ int InventoryUILogic( int mouse_moved )
   /* --- Mouse wheel scroll on inventory panel --- */
   if ( app.mouse.wheel != 0 && !inv_action_open && !eq_action_open )
   {
-    aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+    aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
     if ( PointInRect( app.mouse.x, app.mouse.y,
                       ip->rect.x, ip->rect.y, ip->rect.w, ip->rect.h ) )
     {
@@ -789,7 +790,7 @@ int InventoryUILogic( int mouse_moved )
   {
     int mx = app.mouse.x;
     int my = app.mouse.y;
-    aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+    aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
     aRectf_t r = ip->rect;
 
     float grid_y = r.y + INV_TITLE_H;
@@ -819,7 +820,7 @@ int InventoryUILogic( int mouse_moved )
           if ( mouse_moved )
           {
             if ( idx != player.inv_cursor || !player.inv_focused || ui_focus == 0 )
-              a_AudioPlaySound( sfx_move, NULL );
+              SoundBankPlay( sfx_move, NULL );
             player.inv_cursor = idx;
             player.inv_focused = 1;
             ui_focus = 1;
@@ -831,7 +832,7 @@ int InventoryUILogic( int mouse_moved )
                player.inventory[idx].type != INV_EMPTY )
           {
             app.mouse.pressed = 0;
-            a_AudioPlaySound( sfx_click, NULL );
+            SoundBankPlay( sfx_click, NULL );
             inv_action_open = 1;
             inv_action_cursor = 0;
           }
@@ -845,8 +846,8 @@ int InventoryUILogic( int mouse_moved )
   /* --- Click outside inventory/equipment panels - switch focus back to game --- */
   if ( app.mouse.pressed && app.mouse.button == SDL_BUTTON_LEFT && ui_focus == 1 )
   {
-    aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
-    aContainerWidget_t* kp = a_GetContainerFromWidget( "key_panel" );
+    aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
+    aContainerWidget_t* kp = WidgetBindContainer( WB_KEY_PANEL );
     int on_inv = PointInRect( app.mouse.x, app.mouse.y, ip->rect.x, ip->rect.y, ip->rect.w, ip->rect.h );
     int on_eq  = PointInRect( app.mouse.x, app.mouse.y, kp->rect.x, kp->rect.y, kp->rect.w, kp->rect.h );
     if ( !on_inv && !on_eq )
@@ -866,7 +867,7 @@ int InventoryUILogic( int mouse_moved )
 
 static void DrawInventoryGrid( void )
 {
-  aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+  aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
   aRectf_t r = ip->rect;
   r.x += ui_offset_x;
 
@@ -976,7 +977,7 @@ static void DrawInventoryGrid( void )
 
 static void DrawEquipmentRows( void )
 {
-  aContainerWidget_t* kp = a_GetContainerFromWidget( "key_panel" );
+  aContainerWidget_t* kp = WidgetBindContainer( WB_KEY_PANEL );
   aRectf_t r = kp->rect;
   r.x += ui_offset_x;
 
@@ -1027,7 +1028,7 @@ void InventoryUIDraw( void )
 {
   /* Inventory panel border */
   {
-    aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+    aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
     aRectf_t ir = ip->rect;
     ir.x += ui_offset_x;
     aColor_t ic = PANEL_FG;
@@ -1039,7 +1040,7 @@ void InventoryUIDraw( void )
 
   /* Equipment panel border */
   {
-    aContainerWidget_t* kp = a_GetContainerFromWidget( "key_panel" );
+    aContainerWidget_t* kp = WidgetBindContainer( WB_KEY_PANEL );
     aRectf_t kr = kp->rect;
     kr.x += ui_offset_x;
     aColor_t kc = PANEL_FG;
@@ -1051,15 +1052,15 @@ void InventoryUIDraw( void )
 
   /* Title highlights */
   {
-    aWidget_t* inv_t = a_GetWidget( "inv_title" );
-    aWidget_t* key_t = a_GetWidget( "key_title" );
+    aWidget_t* inv_t = WidgetBindWidget( WB_INV_TITLE );
+    aWidget_t* key_t = WidgetBindWidget( WB_KEY_TITLE );
     if ( inv_t ) inv_t->fg = ( ui_focus == 1 && player.inv_focused && inv_action_open ) ? GOLD : (aColor_t){ 0xeb, 0xed, 0xe9, 255 };
     if ( key_t ) key_t->fg = ( ui_focus == 1 && !player.inv_focused && eq_action_open ) ? GOLD : (aColor_t){ 0xeb, 0xed, 0xe9, 255 };
   }
 
   /* [Tab] hint */
   {
-    aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+    aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
     aTextStyle_t ht = a_default_text_style;
     ht.bg = (aColor_t){ 0, 0, 0, 0 };
     ht.fg = ui_focus == 1 ? GOLD : (aColor_t){ 0x57, 0x72, 0x77, 255 };
@@ -1080,7 +1081,7 @@ void InventoryUIDraw( void )
   {
     int eq_draw_idx = player.equipment[player.equip_cursor];
     EquipmentInfo_t* e = &g_equipment[eq_draw_idx];
-    aContainerWidget_t* kp = a_GetContainerFromWidget( "key_panel" );
+    aContainerWidget_t* kp = WidgetBindContainer( WB_KEY_PANEL );
 
     float mw = CalcModalW( INV_EQUIPMENT, eq_draw_idx );
     float mx = kp->rect.x - mw - 8;
@@ -1089,7 +1090,7 @@ void InventoryUIDraw( void )
     float header_h = EQ_MODAL_PAD_Y + EQ_MODAL_LINE_LG;
     if ( e->damage > 0 )  header_h += EQ_MODAL_LINE_SM;
     if ( e->defense > 0 ) header_h += EQ_MODAL_LINE_SM;
-    if ( strcmp( e->effect, "none" ) != 0 )
+    if ( e->effect_id != EQUIP_EFFECT_NONE )
       header_h += EQ_MODAL_LINE_MD;
     else
       header_h += EQ_MODAL_LINE_SM;
@@ -1130,7 +1131,7 @@ void InventoryUIDraw( void )
       a_DrawText( buf, (int)tx, (int)ty, ts );
       ty += EQ_MODAL_LINE_SM;
     }
-    if ( strcmp( e->effect, "none" ) != 0 )
+    if ( e->effect_id != EQUIP_EFFECT_NONE )
     {
       ts.fg = (aColor_t){ 0xde, 0x9e, 0x41, 255 };
       snprintf( buf, sizeof( buf ), "%s (%d)", e->effect, e->effect_value );
@@ -1168,7 +1169,7 @@ void InventoryUIDraw( void )
        player.inventory[player.inv_cursor].type != INV_EMPTY )
   {
     InvSlot_t* slot = &player.inventory[player.inv_cursor];
-    aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+    aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
 
     aRectf_t r = ip->rect;
     float grid_y = r.y + INV_TITLE_H;
@@ -1198,7 +1199,7 @@ void InventoryUIDraw( void )
       float header_h = EQ_MODAL_PAD_Y + EQ_MODAL_LINE_LG;
       if ( e->damage > 0 )  header_h += EQ_MODAL_LINE_SM;
       if ( e->defense > 0 ) header_h += EQ_MODAL_LINE_SM;
-      if ( strcmp( e->effect, "none" ) != 0 )
+      if ( e->effect_id != EQUIP_EFFECT_NONE )
         header_h += EQ_MODAL_LINE_MD;
       else
         header_h += EQ_MODAL_LINE_SM;
@@ -1239,7 +1240,7 @@ void InventoryUIDraw( void )
         a_DrawText( buf, (int)tx, (int)ty, ts );
         ty += EQ_MODAL_LINE_SM;
       }
-      if ( strcmp( e->effect, "none" ) != 0 )
+      if ( e->effect_id != EQUIP_EFFECT_NONE )
       {
         ts.fg = (aColor_t){ 0xde, 0x9e, 0x41, 255 };
         snprintf( buf, sizeof( buf ), "%s (%d)", e->effect, e->effect_value );
@@ -1264,7 +1265,7 @@ void InventoryUIDraw( void )
       /* Compute header height before description */
       float header_h = EQ_MODAL_PAD_Y + EQ_MODAL_LINE_LG;
       if ( c->bonus_damage > 0 ) header_h += EQ_MODAL_LINE_SM;
-      if ( strcmp( c->effect, "none" ) != 0 && strlen( c->effect ) > 0 )
+      if ( c->effect_id != CONS_EFFECT_NONE )
         header_h += EQ_MODAL_LINE_MD;
       else
         header_h += EQ_MODAL_LINE_SM;
@@ -1300,7 +1301,7 @@ void InventoryUIDraw( void )
         a_DrawText( buf, (int)tx, (int)ty, ts );
         ty += EQ_MODAL_LINE_SM;
       }
-      if ( strcmp( c->effect, "none" ) != 0 && strlen( c->effect ) > 0 )
+      if ( c->effect_id != CONS_EFFECT_NONE )
       {
         ts.fg = (aColor_t){ 0xde, 0x9e, 0x41, 255 };
         a_DrawText( c->effect, (int)tx, (int)ty, ts );
@@ -1366,8 +1367,8 @@ void InventoryUIDraw( void )
       if ( slot->type == INV_EQUIPMENT )
         inv_labels[0] = "Equip";
       else if ( slot->type == INV_CONSUMABLE
-                && strcmp( g_consumables[slot->index].type, "quest" ) == 0
-                && strcmp( g_consumables[slot->index].effect, "none" ) == 0
+                && g_consumables[slot->index].type_id == CONS_TYPE_QUEST
+                && g_consumables[slot->index].effect_id == CONS_EFFECT_NONE
                 && g_consumables[slot->index].action[0] == '\0' )
         inv_labels[0] = "Inspect";
       else if ( slot->type == INV_CONSUMABLE && g_consumables[slot->index].action[0] != '\0' )
@@ -1415,9 +1416,7 @@ int InventoryUIHotkey( void )
   ConsumableInfo_t* ci = &g_consumables[slot->index];
 
   /* Targeted items (gadget, scroll, ranged food) → enter target mode */
-  if ( strcmp( ci->type, "gadget" ) == 0
-    || strcmp( ci->type, "scroll" ) == 0
-    || ( strcmp( ci->type, "food" ) == 0 && ci->range > 0 ) )
+  if ( ConsumableTargeted( ci ) )
   {
     if ( GameEventsConsumableUsed() )
     {
@@ -7,6 +7,7 @@
 #include "draw_utils.h"
 #include "persist.h"
 #include "sound_manager.h"
+#include "sound_bank.h"
 
 /* State machine */
 enum { PM_CLOSED, PM_MAIN, PM_SETTINGS };
@@ -17,8 +18,8 @@ static int prev_mouse_down = 0;
 static int requested_exit = 0;
 
 /* Sound effects */
-static aSoundEffect_t sfx_move;
-static aSoundEffect_t sfx_click;
+static aSoundEffect_t* sfx_move = NULL;
+static aSoundEffect_t* sfx_click = NULL;
 static int sfx_loaded = 0;
 
 /* Layout constants */
@@ -53,8 +54,8 @@ static const char* pm_set_labels[] = { "Graphics", "Music Volume", "SFX Volume"
 static void load_sfx( void )
 {
   if ( sfx_loaded ) return;
-  a_AudioLoadSound( "resources/soundeffects/menu_move.wav", &sfx_move );
-  a_AudioLoadSound( "resources/soundeffects/menu_click.wav", &sfx_click );
+  SoundBankAcquire( &sfx_move, "resources/soundeffects/menu_move.wav" );
+  SoundBankAcquire( &sfx_click, "resources/soundeffects/menu_click.wav" );
   sfx_loaded = 1;
 }
 
@@ -117,6 +118,13 @@ void PauseMenuClose( void )
   state = PM_CLOSED;
 }
 
+void PauseMenuReleaseSounds( void )
+{
+  SoundBankRelease( &sfx_move );
+  SoundBankRelease( &sfx_click );
+  sfx_loaded = 0;
+}
+
 int PauseMenuActive( void )
 {
   return state != PM_CLOSED;
@@ -130,7 +138,7 @@ static int pm_MainLogic( void )
   if ( app.keyboard[SDL_SCANCODE_ESCAPE] == 1 )
   {
     app.keyboard[SDL_SCANCODE_ESCAPE] = 0;
-    a_AudioPlaySound( &sfx_click, NULL );
+    SoundBankPlay( sfx_click, NULL );
     PauseMenuClose();
     return 1;
   }
@@ -141,14 +149,14 @@ static int pm_MainLogic( void )
     app.keyboard[A_W] = 0;
     app.keyboard[A_UP] = 0;
     cursor = ( cursor - 1 + PM_NUM_BTNS ) % PM_NUM_BTNS;
-    a_AudioPlaySound( &sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
   if ( app.keyboard[A_S] == 1 || app.keyboard[A_DOWN] == 1 )
   {
     app.keyboard[A_S] = 0;
     app.keyboard[A_DOWN] = 0;
     cursor = ( cursor + 1 ) % PM_NUM_BTNS;
-    a_AudioPlaySound( &sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
 
   /* Enter / Space */
@@ -183,7 +191,7 @@ static int pm_MainLogic( void )
       if ( cursor != i )
       {
         cursor = i;
-        a_AudioPlaySound( &sfx_move, NULL );
+        SoundBankPlay( sfx_move, NULL );
       }
       if ( clicked ) activate = 1;
     }
@@ -191,7 +199,7 @@ static int pm_MainLogic( void )
 
   if ( activate )
   {
-    a_AudioPlaySound( &sfx_click, NULL );
+    SoundBankPlay( sfx_click, NULL );
     switch ( cursor )
     {
       case PM_RESUME:
@@ -215,7 +223,7 @@ static int pm_SettingsLogic( void )
   if ( app.keyboard[SDL_SCANCODE_ESCAPE] == 1 )
   {
     app.keyboard[SDL_SCANCODE_ESCAPE] = 0;
-    a_AudioPlaySound( &sfx_click, NULL );
+    SoundBankPlay( sfx_click, NULL );
     pm_SaveSettings();
     state = PM_MAIN;
     cursor = 0;
@@ -228,14 +236,14 @@ static int pm_SettingsLogic( void )
     app.keyboard[A_W] = 0;
     app.keyboard[A_UP] = 0;
     cursor = ( cursor - 1 + PM_SET_TOTAL ) % PM_SET_TOTAL;
-    a_AudioPlaySound( &sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
   if ( app.keyboard[A_S] == 1 || app.keyboard[A_DOWN] == 1 )
   {
     app.keyboard[A_S] = 0;
     app.keyboard[A_DOWN] = 0;
     cursor = ( cursor + 1 ) % PM_SET_TOTAL;
-    a_AudioPlaySound( &sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
 
   /* Left / Right - adjust (only on setting rows) */
@@ -246,14 +254,14 @@ static int pm_SettingsLogic( void )
       app.keyboard[A_A] = 0;
       app.keyboard[A_LEFT] = 0;
       pm_Adjust( cursor, -1 );
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
     }
     if ( app.keyboard[A_D] == 1 || app.keyboard[A_RIGHT] == 1 )
     {
       app.keyboard[A_D] = 0;
       app.keyboard[A_RIGHT] = 0;
       pm_Adjust( cursor, 1 );
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
     }
   }
 
@@ -266,11 +274,11 @@ static int pm_SettingsLogic( void )
     if ( cursor == PM_GFX )
     {
       pm_Adjust( cursor, 1 );
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
     }
     else if ( cursor == PM_BACK )
     {
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
       pm_SaveSettings();
       state = PM_MAIN;
       cursor = 0;
@@ -302,14 +310,14 @@ static int pm_SettingsLogic( void )
       if ( cursor != i )
       {
         cursor = i;
-        a_AudioPlaySound( &sfx_move, NULL );
+        SoundBankPlay( sfx_move, NULL );
       }
       if ( clicked )
       {
         float mid = px + 8 + ( PM_PANEL_W - 16 ) / 2.0f;
         int dir = ( mx < mid ) ? -1 : 1;
         pm_Adjust( i, dir );
-        a_AudioPlaySound( &sfx_click, NULL );
+        SoundBankPlay( sfx_click, NULL );
       }
     }
   }
@@ -321,11 +329,11 @@ static int pm_SettingsLogic( void )
     if ( cursor != PM_BACK )
     {
       cursor = PM_BACK;
-      a_AudioPlaySound( &sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
     if ( clicked )
     {
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
       pm_SaveSettings();
       state = PM_MAIN;
       cursor = 0;
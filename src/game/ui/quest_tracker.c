@@ -1,8 +1,12 @@
 #include <stdio.h>
+#include <string.h>
 #include <Archimedes.h>
+#include <Daedalus.h>
 
 #include "dialogue.h"
 #include "dungeon.h"
+#include "quest_tracker.h"
+#include "res_pack.h"
 
 #define QT_PAD_X   8.0f
 #define QT_PAD_Y   6.0f
@@ -11,246 +15,165 @@
 #define QT_YELLOW  (aColor_t){ 0xde, 0x9e, 0x41, 255 }
 #define QT_GREEN   (aColor_t){ 0x75, 0xa7, 0x43, 255 }
 
-void QuestTrackerDraw( aRectf_t vp_rect )
-{
-  aTextStyle_t ts = a_default_text_style;
-  ts.bg    = (aColor_t){ 0, 0, 0, 0 };
-  ts.scale = QT_SCALE;
-  ts.align = TEXT_ALIGN_LEFT;
+#define QT_PATH       "resources/data/quests.duf"
+#define MAX_QUESTS    32
+#define QT_TEXT_LEN   128
 
-  float x = vp_rect.x + QT_PAD_X;
-  float y = vp_rect.y + QT_PAD_Y;
-
-  char buf[128];
+/* Quest definition - loaded from quests.duf */
+typedef struct
+{
+  char requires[MAX_NAME_LENGTH];
+  char hidden_by[MAX_NAME_LENGTH];
+  char done_flag[MAX_NAME_LENGTH];
+  char counter[MAX_NAME_LENGTH];
+  char text[QT_TEXT_LEN];
+  char done_text[QT_TEXT_LEN];
+  int  floor;                       /* 0 = any floor */
+  int  goal;
+  int  ready;
+} QuestDef_t;
+
+/* Built tracker line - rebuilt only when flags or the floor change */
+typedef struct
+{
+  char     text[QT_TEXT_LEN];
+  aColor_t color;
+  float    y;                       /* offset from the tracker's top edge */
+} QuestLine_t;
 
-  /* Help Graf find a way out */
-  if ( FlagGet( "quest_help_graf" ) && !FlagGet( "got_sandwich" ) )
-  {
-    if ( FlagGet( "has_mayors_note" ) )
-    {
-      snprintf( buf, sizeof( buf ), "Give Graf the Mayor's Note" );
-      ts.fg = QT_GREEN;
-    }
-    else
-    {
-      snprintf( buf, sizeof( buf ), "Help Graf find a way out" );
-      ts.fg = QT_YELLOW;
-    }
+static QuestDef_t  g_quests[MAX_QUESTS];
+static int         g_num_quests = 0;
 
-    a_DrawText( buf, (int)x, (int)y, ts );
+static QuestLine_t g_lines[MAX_QUESTS];
+static int         g_num_lines    = 0;
+static int         g_built_flags  = -1;
+static int         g_built_floor  = -1;
 
-    float twg, thg;
-    a_CalcTextDimensions( buf, ts.type, &twg, &thg );
-    y += thg * QT_SCALE + QT_PAD_Y;
-  }
+static void qt_CopyString( char* dst, size_t size, dDUFValue_t* entry,
+                           const char* key )
+{
+  dDUFValue_t* v = d_DUFGetObjectItem( entry, key );
+  if ( v && v->value_string )
+    snprintf( dst, size, "%s", v->value_string );
+}
 
-  /* Eat the sandwich */
-  if ( FlagGet( "got_sandwich" ) && !FlagGet( "sandwich_eaten" ) )
+void QuestTrackerInit( void )
+{
+  g_num_quests  = 0;
+  g_num_lines   = 0;
+  g_built_flags = -1;
+  g_built_floor = -1;
+  memset( g_quests, 0, sizeof( g_quests ) );
+
+  dDUFValue_t* root = NULL;
+  dDUFError_t* err = ResParseDUF( QT_PATH, &root );
+  if ( err )
   {
-    snprintf( buf, sizeof( buf ), "Eat Graf's sandwich" );
-    ts.fg = QT_GREEN;
-
-    a_DrawText( buf, (int)x, (int)y, ts );
-
-    float tws, ths;
-    a_CalcTextDimensions( buf, ts.type, &tws, &ths );
-    y += ths * QT_SCALE + QT_PAD_Y;
+    printf( "QUESTS: parse error in %s - %s\n", QT_PATH,
+            d_StringPeek( err->message ) );
+    d_DUFErrorFree( err );
+    return;
   }
 
-  /* Find the next floor */
-  if ( g_current_floor == 1 && FlagGet( "sandwich_eaten" ) )
+  for ( dDUFValue_t* entry = root->child; entry; entry = entry->next )
   {
-    snprintf( buf, sizeof( buf ), "The dungeon goes deeper..." );
-    ts.fg = QT_YELLOW;
-
-    a_DrawText( buf, (int)x, (int)y, ts );
+    if ( !entry->key || g_num_quests >= MAX_QUESTS ) continue;
 
-    float twd, thd;
-    a_CalcTextDimensions( buf, ts.type, &twd, &thd );
-    y += thd * QT_SCALE + QT_PAD_Y;
-  }
+    QuestDef_t* q = &g_quests[g_num_quests];
+    qt_CopyString( q->requires,  sizeof( q->requires ),  entry, "requires" );
+    qt_CopyString( q->hidden_by, sizeof( q->hidden_by ), entry, "hidden_by" );
+    qt_CopyString( q->done_flag, sizeof( q->done_flag ), entry, "done_flag" );
+    qt_CopyString( q->counter,   sizeof( q->counter ),   entry, "counter" );
+    qt_CopyString( q->text,      sizeof( q->text ),      entry, "text" );
+    qt_CopyString( q->done_text, sizeof( q->done_text ), entry, "done_text" );
 
-  /* Rat quest */
-  if ( FlagGet( "quest_rats" ) )
-  {
-    int kills = FlagGet( "rat_kills" );
-    if ( kills > 3 ) kills = 3;
+    dDUFValue_t* v;
+    if ( ( v = d_DUFGetObjectItem( entry, "floor" ) ) ) q->floor = (int)v->value_int;
+    if ( ( v = d_DUFGetObjectItem( entry, "goal" ) ) )  q->goal  = (int)v->value_int;
+    if ( ( v = d_DUFGetObjectItem( entry, "ready" ) ) ) q->ready = (int)v->value_int;
 
-    if ( kills >= 3 )
-    {
-      snprintf( buf, sizeof( buf ), "Rats killed: %d/3 - Return to Graf", kills );
-      ts.fg = QT_GREEN;
-    }
-    else
+    if ( q->requires[0] == '\0' || q->text[0] == '\0' )
     {
-      snprintf( buf, sizeof( buf ), "Rats killed: %d/3", kills );
-      ts.fg = QT_YELLOW;
+      printf( "QUESTS: '%s' needs both requires and text, skipped\n", entry->key );
+      continue;
     }
-
-    a_DrawText( buf, (int)x, (int)y, ts );
-
-    float tw, th;
-    a_CalcTextDimensions( buf, ts.type, &tw, &th );
-    y += th * QT_SCALE + QT_PAD_Y;
+    g_num_quests++;
   }
 
-  /* Skeleton quest */
-  if ( FlagGet( "quest_skeletons" ) )
-  {
-    int kills = FlagGet( "skeleton_kills" );
-    if ( kills > 3 ) kills = 3;
-
-    if ( kills >= 3 )
-    {
-      snprintf( buf, sizeof( buf ), "Skeletons killed: %d/3 - Return to Jonathon", kills );
-      ts.fg = QT_GREEN;
-    }
-    else
-    {
-      snprintf( buf, sizeof( buf ), "Skeletons killed: %d/3", kills );
-      ts.fg = QT_YELLOW;
-    }
-
-    a_DrawText( buf, (int)x, (int)y, ts );
+  d_DUFFree( root );
+  printf( "QUESTS: loaded %d definitions from %s\n", g_num_quests, QT_PATH );
+}
 
-    float tw2, th2;
-    a_CalcTextDimensions( buf, ts.type, &tw2, &th2 );
-    y += th2 * QT_SCALE + QT_PAD_Y;
-  }
+static void qt_Rebuild( void )
+{
+  g_num_lines = 0;
+  float y = 0;
 
-  /* Relic quest */
-  if ( FlagGet( "quest_relic" ) && !FlagGet( "relic_returned" ) )
+  for ( int i = 0; i < g_num_quests; i++ )
   {
-    if ( FlagGet( "has_relic" ) )
-    {
-      snprintf( buf, sizeof( buf ), "Return Hearthstone to Thistlewick" );
-      ts.fg = QT_GREEN;
-    }
-    else
-    {
-      snprintf( buf, sizeof( buf ), "Retrieve the Goblin Hearthstone" );
-      ts.fg = QT_YELLOW;
-    }
-
-    a_DrawText( buf, (int)x, (int)y, ts );
+    QuestDef_t* q = &g_quests[i];
 
-    float tw3, th3;
-    a_CalcTextDimensions( buf, ts.type, &tw3, &th3 );
-    y += th3 * QT_SCALE + QT_PAD_Y;
-  }
+    if ( !FlagGet( q->requires ) ) continue;
+    if ( q->hidden_by[0] && FlagGet( q->hidden_by ) ) continue;
+    if ( q->floor && q->floor != g_current_floor ) continue;
 
-  /* Mushroom quest */
-  if ( FlagGet( "quest_mushrooms" ) )
-  {
-    int m = FlagGet( "mushrooms_collected" );
-    if ( m > 3 ) m = 3;
+    QuestLine_t* ln = &g_lines[g_num_lines];
+    int done = q->ready;
 
-    if ( m >= 3 )
-    {
-      snprintf( buf, sizeof( buf ), "Mushrooms: %d/3 - Deliver mushrooms", m );
-      ts.fg = QT_GREEN;
-    }
-    else
+    if ( q->counter[0] )
     {
-      snprintf( buf, sizeof( buf ), "Mushrooms: %d/3", m );
-      ts.fg = QT_YELLOW;
-    }
-
-    a_DrawText( buf, (int)x, (int)y, ts );
-
-    float tw4, th4;
-    a_CalcTextDimensions( buf, ts.type, &tw4, &th4 );
-    y += th4 * QT_SCALE + QT_PAD_Y;
-  }
-
-  /* Red slime quest */
-  if ( FlagGet( "quest_slimes" ) && !FlagGet( "quest_slimes_done" ) )
-  {
-    int kills = FlagGet( "red_slime_kills" );
-    if ( kills > 3 ) kills = 3;
+      int n = FlagGet( q->counter );
+      if ( n > q->goal ) n = q->goal;
+      done = done || n >= q->goal;
 
-    if ( kills >= 3 )
-    {
-      snprintf( buf, sizeof( buf ), "Red slimes killed: %d/3 - Return to Glorbnax", kills );
-      ts.fg = QT_GREEN;
-    }
-    else
-    {
-      snprintf( buf, sizeof( buf ), "Red slimes killed: %d/3", kills );
-      ts.fg = QT_YELLOW;
+      if ( done && q->done_text[0] )
+        snprintf( ln->text, sizeof( ln->text ), "%s: %d/%d - %s",
+                  q->text, n, q->goal, q->done_text );
+      else
+        snprintf( ln->text, sizeof( ln->text ), "%s: %d/%d",
+                  q->text, n, q->goal );
     }
-
-    a_DrawText( buf, (int)x, (int)y, ts );
-
-    float tw5, th5;
-    a_CalcTextDimensions( buf, ts.type, &tw5, &th5 );
-    y += th5 * QT_SCALE + QT_PAD_Y;
-  }
-
-  /* Spider quest */
-  if ( FlagGet( "quest_spiders" ) && !FlagGet( "quest_spiders_done" ) )
-  {
-    int kills = FlagGet( "spider_kills" );
-    if ( kills > 3 ) kills = 3;
-
-    if ( kills >= 3 )
+    else if ( q->done_flag[0] && FlagGet( q->done_flag ) )
     {
-      snprintf( buf, sizeof( buf ), "Spiders killed: %d/3 - Return to Burble", kills );
-      ts.fg = QT_GREEN;
+      done = 1;
+      snprintf( ln->text, sizeof( ln->text ), "%s",
+                q->done_text[0] ? q->done_text : q->text );
     }
     else
     {
-      snprintf( buf, sizeof( buf ), "Spiders killed: %d/3", kills );
-      ts.fg = QT_YELLOW;
+      snprintf( ln->text, sizeof( ln->text ), "%s", q->text );
     }
 
-    a_DrawText( buf, (int)x, (int)y, ts );
+    ln->color = done ? QT_GREEN : QT_YELLOW;
+    ln->y     = y;
 
-    float tw6, th6;
-    a_CalcTextDimensions( buf, ts.type, &tw6, &th6 );
-    y += th6 * QT_SCALE + QT_PAD_Y;
-  }
-
-  /* Meet Laura at south tunnel */
-  if ( FlagGet( "laura_relocated" ) && !FlagGet( "quest_return_laura" ) )
-  {
-    snprintf( buf, sizeof( buf ), "Meet Laura in the south tunnel" );
-    ts.fg = QT_GREEN;
-
-    a_DrawText( buf, (int)x, (int)y, ts );
+    float tw, th;
+    a_CalcTextDimensions( ln->text, a_default_text_style.type, &tw, &th );
+    y += th * QT_SCALE + QT_PAD_Y;
 
-    float tw7, th7;
-    a_CalcTextDimensions( buf, ts.type, &tw7, &th7 );
-    y += th7 * QT_SCALE + QT_PAD_Y;
+    g_num_lines++;
   }
 
-  /* Return to Laura */
-  if ( FlagGet( "quest_return_laura" ) )
-  {
-    snprintf( buf, sizeof( buf ), "Return to Laura" );
-    ts.fg = QT_GREEN;
+  g_built_flags = FlagsVersion();
+  g_built_floor = g_current_floor;
+}
 
-    a_DrawText( buf, (int)x, (int)y, ts );
+void QuestTrackerDraw( aRectf_t vp_rect )
+{
+  if ( FlagsVersion() != g_built_flags || g_current_floor != g_built_floor )
+    qt_Rebuild();
 
-    float tw8, th8;
-    a_CalcTextDimensions( buf, ts.type, &tw8, &th8 );
-    y += th8 * QT_SCALE + QT_PAD_Y;
-  }
+  aTextStyle_t ts = a_default_text_style;
+  ts.bg    = (aColor_t){ 0, 0, 0, 0 };
+  ts.scale = QT_SCALE;
+  ts.align = TEXT_ALIGN_LEFT;
 
-  /* Find Bloop */
-  if ( FlagGet( "quest_bloop" ) && !FlagGet( "told_drem_rescued" ) )
-  {
-    if ( FlagGet( "found_horror_rescued" ) )
-    {
-      snprintf( buf, sizeof( buf ), "Return to Drem" );
-      ts.fg = QT_GREEN;
-    }
-    else
-    {
-      snprintf( buf, sizeof( buf ), "Find Bloop" );
-      ts.fg = QT_YELLOW;
-    }
+  float x = vp_rect.x + QT_PAD_X;
+  float y = vp_rect.y + QT_PAD_Y;
 
-    a_DrawText( buf, (int)x, (int)y, ts );
+  for ( int i = 0; i < g_num_lines; i++ )
+  {
+    ts.fg = g_lines[i].color;
+    a_DrawText( g_lines[i].text, (int)x, (int)( y + g_lines[i].y ), ts );
   }
 }
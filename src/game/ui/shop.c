@@ -9,6 +9,7 @@
 #include "items.h"
 #include "player.h"
 #include "visibility.h"
+#include "res_pack.h"
 
 ShopItem_t  g_shop_items[MAX_SHOP_ITEMS];
 int         g_num_shop_items = 0;
@@ -23,14 +24,17 @@ static int             spawn_max  = 6;
 #define MAX_RUG_TILES 12   /* up to 2 rugs */
 static int rug[MAX_RUG_TILES][2];
 static int num_rug_tiles = 0;
-static const int rug_tile_ids[NUM_RUG_TILES] = { 6, 7, 8, 15, 16, 17 };
+static const TileType_t rug_tiles[NUM_RUG_TILES] = {
+  TILE_RUG_TL, TILE_RUG_T, TILE_RUG_TR,
+  TILE_RUG_BL, TILE_RUG_B, TILE_RUG_BR
+};
 
 #define RUG_COLOR (aColor_t){ 0x60, 0x2c, 0x2c, 255 }
 
 void ShopLoadPool( const char* path )
 {
   dDUFValue_t* root = NULL;
-  dDUFError_t* err = d_DUFParseFile( path, &root );
+  dDUFError_t* err = ResParseDUF( path, &root );
 
   if ( err != NULL )
   {
@@ -118,7 +122,7 @@ void ShopSpawn( World_t* world )
     int r = rug[i][0];
     int c = rug[i][1];
     int idx = c * world->width + r;
-    world->background[idx].tile = rug_tile_ids[i];
+    WorldSetBackground( world, idx, rug_tiles[i] );
   }
 
   g_num_shop_items = 0;
@@ -263,7 +267,7 @@ void ShopSpawnConsumableRug( World_t* world, const int pos[][2] )
     num_rug_tiles++;
 
     int idx = pos[i][1] * world->width + pos[i][0];
-    world->background[idx].tile = rug_tile_ids[i];
+    WorldSetBackground( world, idx, rug_tiles[i] );
   }
 
   /* Shuffle positions */
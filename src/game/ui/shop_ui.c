@@ -8,7 +8,9 @@
 #include "items.h"
 #include "player.h"
 #include "draw_utils.h"
+#include "sprite_atlas.h"
 #include "console.h"
+#include "sound_bank.h"
 
 extern Player_t player;
 
@@ -147,7 +149,7 @@ static void do_buy( void )
   if ( shop_console )
     ConsolePushF( shop_console, color,
                   "Bought %s for %dg.", name, si->cost );
-  if ( sfx_click ) a_AudioPlaySound( sfx_click, NULL );
+  if ( sfx_click ) SoundBankPlay( sfx_click, NULL );
 
   shop_ui_active = 0;
 }
@@ -174,7 +176,7 @@ int ShopUILogic( void )
         if ( i != shop_ui_cursor )
         {
           shop_ui_cursor = i;
-          if ( sfx_move ) a_AudioPlaySound( sfx_move, NULL );
+          if ( sfx_move ) SoundBankPlay( sfx_move, NULL );
         }
         break;
       }
@@ -212,7 +214,7 @@ int ShopUILogic( void )
     shop_ui_cursor += ( app.mouse.wheel < 0 ) ? 1 : -1;
     if ( shop_ui_cursor < 0 ) shop_ui_cursor = opt_count - 1;
     if ( shop_ui_cursor >= opt_count ) shop_ui_cursor = 0;
-    if ( sfx_move ) a_AudioPlaySound( sfx_move, NULL );
+    if ( sfx_move ) SoundBankPlay( sfx_move, NULL );
     app.mouse.wheel = 0;
   }
 
@@ -223,7 +225,7 @@ int ShopUILogic( void )
     app.keyboard[SDL_SCANCODE_UP] = 0;
     shop_ui_cursor--;
     if ( shop_ui_cursor < 0 ) shop_ui_cursor = opt_count - 1;
-    if ( sfx_move ) a_AudioPlaySound( sfx_move, NULL );
+    if ( sfx_move ) SoundBankPlay( sfx_move, NULL );
   }
   if ( app.keyboard[SDL_SCANCODE_S] == 1 || app.keyboard[SDL_SCANCODE_DOWN] == 1 )
   {
@@ -231,7 +233,7 @@ int ShopUILogic( void )
     app.keyboard[SDL_SCANCODE_DOWN] = 0;
     shop_ui_cursor++;
     if ( shop_ui_cursor >= opt_count ) shop_ui_cursor = 0;
-    if ( sfx_move ) a_AudioPlaySound( sfx_move, NULL );
+    if ( sfx_move ) SoundBankPlay( sfx_move, NULL );
   }
 
   /* Number keys 1-2 */
@@ -355,7 +357,7 @@ void ShopUIDraw( aRectf_t panel_rect )
   if ( img && settings.gfx_mode == GFX_IMAGE )
   {
     float scale = PORTRAIT_SZ / img->rect.w;
-    a_BlitRect( img, NULL, &(aRectf_t){ px, py, img->rect.w, img->rect.h }, scale );
+    a_BlitRect( img, AtlasSrc( img ), &(aRectf_t){ px, py, img->rect.w, img->rect.h }, scale );
   }
   else if ( glyph && glyph[0] )
   {
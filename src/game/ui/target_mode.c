@@ -9,6 +9,8 @@
 #include "movement.h"
 #include "visibility.h"
 #include "draw_utils.h"
+#include "widget_bind.h"
+#include "sound_bank.h"
 
 extern Player_t player;
 
@@ -57,20 +59,25 @@ void TargetModeInit( World_t* w, Console_t* con, GameCamera_t* c,
 /* Determine targeting style from consumable data */
 static int style_from_consumable( ConsumableInfo_t* c )
 {
-  if ( strcmp( c->effect, "smoke" ) == 0 )
+  if ( c->effect_id == CONS_EFFECT_SMOKE )
     return TGT_ADJACENT;
   if ( c->place_range > 0 )
     return TGT_ADJACENT;
-  if ( strcmp( c->effect, "shoot" ) == 0 || strcmp( c->effect, "poison" ) == 0
-       || strcmp( c->effect, "pierce" ) == 0 || strcmp( c->effect, "stew_throw" ) == 0 )
-    return TGT_CARDINAL;
-  if ( strcmp( c->effect, "reach" ) == 0 )
-    return TGT_CARDINAL;
-  if ( strcmp( c->effect, "fire_cone" ) == 0 )
-    return TGT_CARDINAL;
-  if ( strcmp( c->effect, "cleave" ) == 0 )
-    return TGT_ADJACENT;
-  return TGT_FREE;
+
+  switch ( c->effect_id )
+  {
+    case CONS_EFFECT_SHOOT:
+    case CONS_EFFECT_POISON:
+    case CONS_EFFECT_PIERCE:
+    case CONS_EFFECT_STEW_THROW:
+    case CONS_EFFECT_REACH:
+    case CONS_EFFECT_FIRE_CONE:
+      return TGT_CARDINAL;
+    case CONS_EFFECT_CLEAVE:
+      return TGT_ADJACENT;
+    default:
+      return TGT_FREE;
+  }
 }
 
 void TargetModeEnter( int consumable_idx, int inv_slot )
@@ -177,7 +184,7 @@ int TargetModeLogic( Enemy_t* enemies, int num_enemies )
 
   /* Mouse hover - move cursor to hovered tile if valid (only when mouse active) */
   {
-    aContainerWidget_t* vp = a_GetContainerFromWidget( "game_viewport" );
+    aContainerWidget_t* vp = WidgetBindContainer( WB_GAME_VIEWPORT );
     int mx = app.mouse.x;
     int my = app.mouse.y;
     if ( PointInRect( mx, my, vp->rect.x, vp->rect.y, vp->rect.w, vp->rect.h ) )
@@ -253,14 +260,14 @@ int TargetModeLogic( Enemy_t* enemies, int num_enemies )
         {
           cursor_row = nr;
           cursor_col = nc;
-          a_AudioPlaySound( sfx_move, NULL );
+          SoundBankPlay( sfx_move, NULL );
         }
       }
       else if ( valid_tile( nr, nc ) )
       {
         cursor_row = nr;
         cursor_col = nc;
-        a_AudioPlaySound( sfx_move, NULL );
+        SoundBankPlay( sfx_move, NULL );
       }
       else
       {
@@ -271,7 +278,7 @@ int TargetModeLogic( Enemy_t* enemies, int num_enemies )
         {
           cursor_row = nr;
           cursor_col = nc;
-          a_AudioPlaySound( sfx_move, NULL );
+          SoundBankPlay( sfx_move, NULL );
         }
       }
     }
@@ -282,7 +289,7 @@ int TargetModeLogic( Enemy_t* enemies, int num_enemies )
       {
         cursor_row = nr;
         cursor_col = nc;
-        a_AudioPlaySound( sfx_move, NULL );
+        SoundBankPlay( sfx_move, NULL );
       }
     }
   }
@@ -313,7 +320,7 @@ int TargetModeLogic( Enemy_t* enemies, int num_enemies )
 
 
 
-    a_AudioPlaySound( sfx_click, NULL );
+    SoundBankPlay( sfx_click, NULL );
     confirmed = 1;
     active    = 0;
     return 1;
@@ -421,7 +428,7 @@ void TargetModeDraw( aRectf_t vp_rect, GameCamera_t* cam, World_t* w )
   }
 
   /* Cleave splash preview - highlight all adjacent tiles that will be hit */
-  if ( cons_idx >= 0 && strcmp( g_consumables[cons_idx].effect, "cleave" ) == 0
+  if ( cons_idx >= 0 && g_consumables[cons_idx].effect_id == CONS_EFFECT_CLEAVE
        && ( cursor_row != player_row || cursor_col != player_col ) )
   {
     static const int dirs[8][2] = {
@@ -442,7 +449,7 @@ void TargetModeDraw( aRectf_t vp_rect, GameCamera_t* cam, World_t* w )
   }
 
   /* Fire cone preview - highlight expanding cone in the aimed direction */
-  if ( cons_idx >= 0 && strcmp( g_consumables[cons_idx].effect, "fire_cone" ) == 0
+  if ( cons_idx >= 0 && g_consumables[cons_idx].effect_id == CONS_EFFECT_FIRE_CONE
        && ( cursor_row != player_row || cursor_col != player_col ) )
   {
     int dr = ( cursor_row > player_row ) ? 1 : ( cursor_row < player_row ) ? -1 : 0;
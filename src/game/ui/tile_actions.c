@@ -21,6 +21,8 @@
 #include "poison_pool.h"
 #include "interactive_tile.h"
 #include "game_input.h"
+#include "widget_bind.h"
+#include "sound_bank.h"
 
 extern Player_t player;
 
@@ -41,7 +43,7 @@ static int tile_action_on_self = 0;
 static int tile_has_door( int r, int c )
 {
   int idx = c * world->width + r;
-  return DoorIsDoor( world->midground[idx].tile );
+  return DoorIsDoor( world->midground[idx] );
 }
 
 /* Try to open a door at (r,c). Returns 1 if opened, 0 if locked. */
@@ -203,7 +205,7 @@ int TileActionsLogic( int mouse_moved, Enemy_t* enemies, int num_enemies )
     app.keyboard[SDL_SCANCODE_UP] = 0;
     tile_action_cursor--;
     if ( tile_action_cursor < 0 ) tile_action_cursor = ta_count - 1;
-    a_AudioPlaySound( sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
   if ( app.keyboard[SDL_SCANCODE_S] == 1 || app.keyboard[SDL_SCANCODE_DOWN] == 1 )
   {
@@ -211,7 +213,7 @@ int TileActionsLogic( int mouse_moved, Enemy_t* enemies, int num_enemies )
     app.keyboard[SDL_SCANCODE_DOWN] = 0;
     tile_action_cursor++;
     if ( tile_action_cursor >= ta_count ) tile_action_cursor = 0;
-    a_AudioPlaySound( sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
 
   /* Scroll wheel */
@@ -220,14 +222,14 @@ int TileActionsLogic( int mouse_moved, Enemy_t* enemies, int num_enemies )
     tile_action_cursor += ( app.mouse.wheel < 0 ) ? 1 : -1;
     if ( tile_action_cursor < 0 ) tile_action_cursor = ta_count - 1;
     if ( tile_action_cursor >= ta_count ) tile_action_cursor = 0;
-    a_AudioPlaySound( sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
     app.mouse.wheel = 0;
   }
 
   /* Mouse hover on action menu rows */
   if ( mouse_moved )
   {
-    aContainerWidget_t* vp = a_GetContainerFromWidget( "game_viewport" );
+    aContainerWidget_t* vp = WidgetBindContainer( WB_GAME_VIEWPORT );
     float sx, sy, cl, ct;
     float aspect = vp->rect.w / vp->rect.h;
     float cam_w = camera->half_h * aspect;
@@ -247,7 +249,7 @@ int TileActionsLogic( int mouse_moved, Enemy_t* enemies, int num_enemies )
                         CTX_MENU_W, CTX_MENU_ROW_H ) )
       {
         if ( i != tile_action_cursor )
-          a_AudioPlaySound( sfx_move, NULL );
+          SoundBankPlay( sfx_move, NULL );
         tile_action_cursor = i;
         break;
       }
@@ -266,7 +268,7 @@ int TileActionsLogic( int mouse_moved, Enemy_t* enemies, int num_enemies )
   {
     app.mouse.pressed = 0;
     /* Only execute if click is on the menu, otherwise close */
-    aContainerWidget_t* vp = a_GetContainerFromWidget( "game_viewport" );
+    aContainerWidget_t* vp = WidgetBindContainer( WB_GAME_VIEWPORT );
     float sx, sy, cl, ct;
     float aspect = vp->rect.w / vp->rect.h;
     float cam_w = camera->half_h * aspect;
@@ -303,7 +305,7 @@ int TileActionsLogic( int mouse_moved, Enemy_t* enemies, int num_enemies )
 
   if ( exec )
   {
-    a_AudioPlaySound( sfx_click, NULL );
+    SoundBankPlay( sfx_click, NULL );
     const char* action = ta_labels[tile_action_cursor];
 
     if ( strcmp( action, "Skip Turn" ) == 0 )
@@ -541,7 +543,7 @@ int TileActionsLogic( int mouse_moved, Enemy_t* enemies, int num_enemies )
             {
               ITile_t* itile = ITileAt( tile_action_row, tile_action_col );
               int idx = tile_action_col * world->width + tile_action_row;
-              Tile_t* t = &world->background[idx];
+              const TileDef_t* t = TILE_DEF( world->background[idx] );
               if ( itile )
               {
                 if ( itile->type == ITILE_HIDDEN_WALL && !itile->revealed )
@@ -588,7 +590,7 @@ void TileActionsDraw( Enemy_t* enemies, int num_enemies )
 {
   if ( !tile_action_open || !world ) return;
 
-  aContainerWidget_t* vp = a_GetContainerFromWidget( "game_viewport" );
+  aContainerWidget_t* vp = WidgetBindContainer( WB_GAME_VIEWPORT );
   float sx, sy, cl, ct;
   float aspect = vp->rect.w / vp->rect.h;
   float cam_w = camera->half_h * aspect;
@@ -0,0 +1,269 @@
+#include <stdio.h>
+#include <string.h>
+#include <SDL2/SDL_image.h>
+#include <Archimedes.h>
+
+#include "asset_loader.h"
+#include "res_pack.h"
+
+/* Emscripten builds run without pthreads - the main thread decodes every
+   job itself, one pump-budget slice per frame. */
+#ifdef __EMSCRIPTEN__
+#define AL_THREADED 0
+#else
+#define AL_THREADED 1
+#endif
+
+typedef enum
+{
+  ASSET_JOB_IMAGE,
+  ASSET_JOB_CALL
+} AssetJobType_t;
+
+typedef enum
+{
+  JOB_QUEUED,
+  JOB_DECODING,
+  JOB_DECODED
+} AssetJobState_t;
+
+typedef struct
+{
+  AssetJobType_t     type;
+  AssetJobState_t    state;
+  char               path[ASSET_PATH_LEN];
+  SDL_Surface*       surface;
+  AssetImageDoneFn_t done;
+  AssetCallFn_t      call;
+  void*              user;
+} AssetJob_t;
+
+/* One batch at a time: jobs append, the main thread finishes them in order
+   (so atlas packing stays deterministic) and the batch resets once drained.
+   Workers only ever touch jobs they moved from QUEUED to DECODING. */
+static AssetJob_t g_jobs[ASSET_MAX_JOBS];
+static int        g_num_jobs    = 0;
+static int        g_next_decode = 0;    /* first job a worker might claim */
+static int        g_next_finish = 0;    /* next job to complete, main thread */
+
+static SDL_mutex*  g_lock = NULL;
+static SDL_cond*   g_wake = NULL;
+static SDL_Thread* g_workers[ASSET_WORKERS];
+static int         g_num_workers = 0;
+static int         g_quit = 0;
+
+static void al_Lock( void )   { if ( g_lock ) SDL_LockMutex( g_lock ); }
+static void al_Unlock( void ) { if ( g_lock ) SDL_UnlockMutex( g_lock ); }
+
+/* Claim the oldest queued image job, or NULL. Caller holds the lock. */
+static AssetJob_t* al_Claim( void )
+{
+  while ( g_next_decode < g_num_jobs )
+  {
+    AssetJob_t* j = &g_jobs[g_next_decode++];
+    if ( j->type == ASSET_JOB_IMAGE && j->state == JOB_QUEUED )
+    {
+      j->state = JOB_DECODING;
+      return j;
+    }
+  }
+  return NULL;
+}
+
+static int al_Worker( void* data )
+{
+  (void)data;
+
+  SDL_LockMutex( g_lock );
+  while ( !g_quit )
+  {
+    AssetJob_t* j = al_Claim();
+    if ( !j )
+    {
+      SDL_CondWait( g_wake, g_lock );
+      continue;
+    }
+
+    SDL_UnlockMutex( g_lock );
+    SDL_Surface* s = ResLoadSurface( j->path );
+    SDL_LockMutex( g_lock );
+
+    j->surface = s;
+    j->state   = JOB_DECODED;
+  }
+  SDL_UnlockMutex( g_lock );
+  return 0;
+}
+
+void AssetLoaderInit( void )
+{
+  if ( g_lock ) return;
+
+  g_num_jobs = g_next_decode = g_next_finish = 0;
+  g_quit = 0;
+
+#if AL_THREADED
+  g_lock = SDL_CreateMutex();
+  g_wake = SDL_CreateCond();
+  if ( !g_lock || !g_wake )
+  {
+    printf( "ASSETS: no mutex (%s), decoding on the main thread\n", SDL_GetError() );
+    if ( g_lock ) SDL_DestroyMutex( g_lock );
+    if ( g_wake ) SDL_DestroyCond( g_wake );
+    g_lock = NULL;
+    g_wake = NULL;
+    return;
+  }
+
+  for ( int i = 0; i < ASSET_WORKERS; i++ )
+  {
+    SDL_Thread* t = SDL_CreateThread( al_Worker, "asset_worker", NULL );
+    if ( t ) g_workers[g_num_workers++] = t;
+  }
+  printf( "ASSETS: %d decode worker(s)\n", g_num_workers );
+#endif
+}
+
+void AssetLoaderQuit( void )
+{
+  if ( !g_lock ) return;
+
+  SDL_LockMutex( g_lock );
+  g_quit = 1;
+  SDL_CondBroadcast( g_wake );
+  SDL_UnlockMutex( g_lock );
+
+  for ( int i = 0; i < g_num_workers; i++ )
+    SDL_WaitThread( g_workers[i], NULL );
+  g_num_workers = 0;
+
+  SDL_DestroyCond( g_wake );
+  SDL_DestroyMutex( g_lock );
+  g_wake = NULL;
+  g_lock = NULL;
+}
+
+/* Full batch: do the job right here rather than drop it */
+static int al_Overflow( void )
+{
+  if ( g_num_jobs < ASSET_MAX_JOBS ) return 0;
+  printf( "ASSETS: job queue full, loading synchronously\n" );
+  return 1;
+}
+
+void AssetQueueImage( const char* path, AssetImageDoneFn_t done, void* user )
+{
+  al_Lock();
+  if ( al_Overflow() )
+  {
+    al_Unlock();
+    done( path, ResLoadSurface( path ), user );
+    return;
+  }
+
+  AssetJob_t* j = &g_jobs[g_num_jobs++];
+  memset( j, 0, sizeof( AssetJob_t ) );
+  j->type  = ASSET_JOB_IMAGE;
+  j->state = JOB_QUEUED;
+  j->done  = done;
+  j->user  = user;
+  snprintf( j->path, sizeof( j->path ), "%s", path );
+
+  if ( g_wake ) SDL_CondSignal( g_wake );
+  al_Unlock();
+}
+
+void AssetQueueCall( AssetCallFn_t fn, void* user )
+{
+  al_Lock();
+  if ( al_Overflow() )
+  {
+    al_Unlock();
+    fn( user );
+    return;
+  }
+
+  AssetJob_t* j = &g_jobs[g_num_jobs++];
+  memset( j, 0, sizeof( AssetJob_t ) );
+  j->type  = ASSET_JOB_CALL;
+  j->state = JOB_QUEUED;
+  j->call  = fn;
+  j->user  = user;
+  al_Unlock();
+}
+
+int AssetLoaderPump( int budget_ms )
+{
+  uint32_t start = SDL_GetTicks();
+
+  for ( ;; )
+  {
+    al_Lock();
+    if ( g_next_finish >= g_num_jobs )
+    {
+      g_num_jobs = g_next_decode = g_next_finish = 0;
+      al_Unlock();
+      return 0;
+    }
+
+    AssetJob_t* j = &g_jobs[g_next_finish];
+
+    /* A worker has it - come back next frame */
+    if ( j->type == ASSET_JOB_IMAGE && j->state == JOB_DECODING )
+    {
+      al_Unlock();
+      return 1;
+    }
+
+    /* Nobody has picked it up yet, so the main thread decodes it */
+    if ( j->type == ASSET_JOB_IMAGE && j->state == JOB_QUEUED )
+    {
+      j->state = JOB_DECODING;
+      al_Unlock();
+      j->surface = ResLoadSurface( j->path );
+      al_Lock();
+      j->state = JOB_DECODED;
+    }
+
+    /* Copy out - a callback may queue more jobs into this batch */
+    AssetJob_t done = *j;
+    g_next_finish++;
+    al_Unlock();
+
+    if ( done.type == ASSET_JOB_IMAGE )
+    {
+      if ( !done.surface )
+        printf( "ASSETS: could not decode %s - %s\n", done.path, IMG_GetError() );
+      done.done( done.path, done.surface, done.user );
+    }
+    else
+    {
+      done.call( done.user );
+    }
+
+    if ( SDL_GetTicks() - start >= (uint32_t)budget_ms )
+      return AssetLoaderBusy();
+  }
+}
+
+void AssetLoaderFinish( void )
+{
+  while ( AssetLoaderPump( 1000 ) )
+    SDL_Delay( 1 );
+}
+
+int AssetLoaderBusy( void )
+{
+  al_Lock();
+  int busy = g_next_finish < g_num_jobs;
+  al_Unlock();
+  return busy;
+}
+
+float AssetLoaderProgress( void )
+{
+  al_Lock();
+  float p = ( g_num_jobs > 0 ) ? (float)g_next_finish / g_num_jobs : 1.0f;
+  al_Unlock();
+  return p;
+}
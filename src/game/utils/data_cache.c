@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "data_cache.h"
+#include "res_pack.h"
+
+/* Blob layout (native endianness, never shipped between machines):
+     DataCacheHeader_t
+     DataCacheSource_t  x num_sources
+     DataCacheTableHdr_t x num_tables
+     table payloads, back to back */
+
+#define DC_MAGIC  0x4344474du   /* "MGDC" */
+
+typedef struct
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t num_sources;
+  uint32_t num_tables;
+  uint32_t layout;        /* dc_Layout of the tables */
+} DataCacheHeader_t;
+
+typedef struct
+{
+  char    path[DATA_CACHE_PATH_LEN];
+  int64_t mtime;
+  int64_t size;
+} DataCacheSource_t;
+
+typedef struct
+{
+  uint32_t elem_size;
+  uint32_t count;
+} DataCacheTableHdr_t;
+
+/* FNV-1a, a fact at a time */
+#define DC_FNV_BASIS  2166136261u
+#define DC_FNV_PRIME  16777619u
+
+static uint32_t dc_Hash( uint32_t h, uint64_t v )
+{
+  for ( int i = 0; i < 8; i++, v >>= 8 )
+    h = ( h ^ (uint32_t)( v & 0xff ) ) * DC_FNV_PRIME;
+  return h;
+}
+
+uint32_t DataCacheLayout( const size_t* facts, int num_facts )
+{
+  uint32_t h = DC_FNV_BASIS;
+  for ( int i = 0; i < num_facts; i++ )
+    h = dc_Hash( h, (uint64_t)facts[i] );
+  return h;
+}
+
+/* Whole-blob layout: every table's element size and layout, in order */
+static uint32_t dc_Layout( const DataCacheTable_t* tables, int num_tables )
+{
+  uint32_t h = DC_FNV_BASIS;
+  for ( int i = 0; i < num_tables; i++ )
+  {
+    h = dc_Hash( h, (uint64_t)tables[i].elem_size );
+    h = dc_Hash( h, (uint64_t)tables[i].layout );
+  }
+  return h;
+}
+
+static void dc_BlobPath( char* out, size_t size, const char* name )
+{
+  snprintf( out, size, "%s/%s.bin", DATA_CACHE_DIR, name );
+}
+
+static int dc_Stamp( const char* path, DataCacheSource_t* out )
+{
+  struct stat st;
+  if ( stat( path, &st ) != 0 ) return 0;
+
+  memset( out, 0, sizeof( DataCacheSource_t ) );
+  snprintf( out->path, sizeof( out->path ), "%s", path );
+  out->mtime = (int64_t)st.st_mtime;
+  out->size  = (int64_t)st.st_size;
+  return 1;
+}
+
+/* Stamp every source, plus the mounted pack - ResParseDUF reads from it
+   instead of the loose files, so a rebuilt pack has to miss too. Returns
+   the number of stamps, or -1 if a source is missing. */
+static int dc_StampAll( const char* const* sources, int num_sources,
+                        DataCacheSource_t* out )
+{
+  if ( num_sources > DATA_CACHE_MAX_SOURCES ) return -1;
+
+  for ( int i = 0; i < num_sources; i++ )
+    if ( !dc_Stamp( sources[i], &out[i] ) ) return -1;
+
+  const char* pack = ResPackPath();
+  if ( !pack ) return num_sources;
+  return dc_Stamp( pack, &out[num_sources] ) ? num_sources + 1 : -1;
+}
+
+int DataCacheLoad( const char* name,
+                   const char* const* sources, int num_sources,
+                   DataCacheTable_t* tables, int num_tables )
+{
+  DataCacheSource_t now[DATA_CACHE_MAX_SOURCES + 1];
+  int num_stamps = dc_StampAll( sources, num_sources, now );
+  if ( num_stamps < 0 ) return 0;
+
+  char path[256];
+  dc_BlobPath( path, sizeof( path ), name );
+
+  FILE* fp = fopen( path, "rb" );
+  if ( !fp ) return 0;
+
+  fseek( fp, 0, SEEK_END );
+  long size = ftell( fp );
+  fseek( fp, 0, SEEK_SET );
+
+  char* blob = ( size > 0 ) ? malloc( size ) : NULL;
+  int ok = blob && fread( blob, 1, size, fp ) == (size_t)size;
+  fclose( fp );
+  if ( !ok ) { free( blob ); return 0; }
+
+  /* Header */
+  size_t off = sizeof( DataCacheHeader_t );
+  DataCacheHeader_t hdr;
+  if ( (size_t)size < off ) { free( blob ); return 0; }
+  memcpy( &hdr, blob, sizeof( hdr ) );
+
+  if ( hdr.magic != DC_MAGIC || hdr.version != DATA_CACHE_VERSION
+       || (int)hdr.num_sources != num_stamps
+       || (int)hdr.num_tables != num_tables
+       || hdr.layout != dc_Layout( tables, num_tables ) )
+  {
+    free( blob );
+    return 0;
+  }
+
+  size_t meta = off + sizeof( DataCacheSource_t ) * num_stamps
+                    + sizeof( DataCacheTableHdr_t ) * num_tables;
+  if ( (size_t)size < meta ) { free( blob ); return 0; }
+
+  /* Every source must be the same file, unchanged since the blob was built */
+  for ( int i = 0; i < num_stamps; i++, off += sizeof( DataCacheSource_t ) )
+  {
+    DataCacheSource_t stored;
+    memcpy( &stored, blob + off, sizeof( stored ) );
+    if ( strcmp( stored.path, now[i].path ) != 0
+         || stored.mtime != now[i].mtime || stored.size != now[i].size )
+    {
+      free( blob );
+      return 0;
+    }
+  }
+
+  /* Table headers - a struct layout change shows up as a size mismatch */
+  DataCacheTableHdr_t th[num_tables > 0 ? num_tables : 1];
+  size_t payload = meta;
+  for ( int i = 0; i < num_tables; i++, off += sizeof( DataCacheTableHdr_t ) )
+  {
+    memcpy( &th[i], blob + off, sizeof( DataCacheTableHdr_t ) );
+    if ( th[i].elem_size != tables[i].elem_size
+         || (int)th[i].count > tables[i].max )
+    {
+      free( blob );
+      return 0;
+    }
+    payload += (size_t)th[i].elem_size * th[i].count;
+  }
+  if ( (size_t)size != payload ) { free( blob ); return 0; }
+
+  for ( int i = 0; i < num_tables; i++ )
+  {
+    size_t bytes = (size_t)th[i].elem_size * th[i].count;
+    memcpy( tables[i].data, blob + off, bytes );
+    *tables[i].count = (int)th[i].count;
+    off += bytes;
+  }
+
+  free( blob );
+  printf( "CACHE: loaded %s\n", path );
+  return 1;
+}
+
+int DataCacheSave( const char* name,
+                   const char* const* sources, int num_sources,
+                   const DataCacheTable_t* tables, int num_tables )
+{
+  DataCacheSource_t stamps[DATA_CACHE_MAX_SOURCES + 1];
+  int num_stamps = dc_StampAll( sources, num_sources, stamps );
+  if ( num_stamps < 0 ) return 0;
+
+  mkdir( DATA_CACHE_DIR, 0755 );
+
+  char path[256], tmp[260];
+  dc_BlobPath( path, sizeof( path ), name );
+  snprintf( tmp, sizeof( tmp ), "%s.tmp", path );
+
+  FILE* fp = fopen( tmp, "wb" );
+  if ( !fp )
+  {
+    printf( "CACHE: could not write %s\n", tmp );
+    return 0;
+  }
+
+  DataCacheHeader_t hdr = { DC_MAGIC, DATA_CACHE_VERSION,
+                            (uint32_t)num_stamps, (uint32_t)num_tables,
+                            dc_Layout( tables, num_tables ) };
+  int ok = fwrite( &hdr, sizeof( hdr ), 1, fp ) == 1;
+  if ( num_stamps > 0 )
+    ok = ok && fwrite( stamps, sizeof( DataCacheSource_t ), num_stamps, fp )
+               == (size_t)num_stamps;
+
+  for ( int i = 0; i < num_tables && ok; i++ )
+  {
+    DataCacheTableHdr_t th = { (uint32_t)tables[i].elem_size,
+                               (uint32_t)*tables[i].count };
+    ok = fwrite( &th, sizeof( th ), 1, fp ) == 1;
+  }
+
+  for ( int i = 0; i < num_tables && ok; i++ )
+  {
+    int n = *tables[i].count;
+    if ( n > 0 )
+      ok = fwrite( tables[i].data, tables[i].elem_size, n, fp ) == (size_t)n;
+  }
+
+  ok = ( fclose( fp ) == 0 ) && ok;
+
+  /* Write-then-rename so a crash never leaves a half blob behind */
+  if ( !ok || rename( tmp, path ) != 0 )
+  {
+    remove( tmp );
+    printf( "CACHE: could not write %s\n", path );
+    return 0;
+  }
+
+  printf( "CACHE: rebuilt %s\n", path );
+  return 1;
+}
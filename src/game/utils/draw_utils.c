@@ -1,6 +1,7 @@
 #include <Archimedes.h>
 #include "defines.h"
 #include "draw_utils.h"
+#include "sprite_atlas.h"
 
 #define GLYPH_SCALE 2.0f
 
@@ -15,7 +16,7 @@ void DrawImageOrGlyph( aImage_t* img, const char* glyph, aColor_t color,
     float orig_w = img->rect.w;
     float orig_h = img->rect.h;
     float scale = size / orig_w;
-    a_BlitRect( img, NULL, &(aRectf_t){ x, y, orig_w, orig_h }, scale );
+    a_BlitRect( img, AtlasSrc( img ), &(aRectf_t){ x, y, orig_w, orig_h }, scale );
   }
   else if ( glyph && glyph[0] != '\0' )
   {
@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <SDL2/SDL_image.h>
+#include <Archimedes.h>
+#include <Daedalus.h>
+
+#ifndef __EMSCRIPTEN__
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+#include "res_pack.h"
+
+/* Native builds mmap the pack; Emscripten's preloaded MEMFS file is read
+   into one buffer instead. Either way entries point straight into it. */
+static const char*           g_pack      = NULL;
+static size_t                g_pack_size = 0;
+static const ResPackEntry_t* g_entries   = NULL;
+static int                   g_num_entries = 0;
+static char                  g_pack_path[256];
+
+static int rp_Valid( const char* base, size_t size )
+{
+  if ( size < sizeof( ResPackHeader_t ) ) return 0;
+
+  ResPackHeader_t hdr;
+  memcpy( &hdr, base, sizeof( hdr ) );
+  if ( hdr.magic != RES_PACK_MAGIC || hdr.version != RES_PACK_VERSION )
+    return 0;
+
+  size_t index_end = sizeof( ResPackHeader_t )
+                   + sizeof( ResPackEntry_t ) * (size_t)hdr.num_entries;
+  if ( index_end > size ) return 0;
+
+  const ResPackEntry_t* e = (const ResPackEntry_t*)( base + sizeof( ResPackHeader_t ) );
+  for ( uint32_t i = 0; i < hdr.num_entries; i++ )
+    if ( (size_t)e[i].offset + e[i].size + 1 > size
+         || e[i].path[RES_PATH_LEN - 1] != '\0' )
+      return 0;
+
+  g_entries     = e;
+  g_num_entries = (int)hdr.num_entries;
+  return 1;
+}
+
+int ResPackOpen( const char* path )
+{
+  ResPackClose();
+
+#ifndef __EMSCRIPTEN__
+  int fd = open( path, O_RDONLY );
+  if ( fd < 0 ) return 0;
+
+  struct stat st;
+  if ( fstat( fd, &st ) != 0 || st.st_size <= 0 ) { close( fd ); return 0; }
+
+  void* base = mmap( NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  close( fd );
+  if ( base == MAP_FAILED ) return 0;
+
+  g_pack      = base;
+  g_pack_size = (size_t)st.st_size;
+#else
+  FILE* fp = fopen( path, "rb" );
+  if ( !fp ) return 0;
+
+  fseek( fp, 0, SEEK_END );
+  long size = ftell( fp );
+  fseek( fp, 0, SEEK_SET );
+
+  char* base = ( size > 0 ) ? malloc( size ) : NULL;
+  int ok = base && fread( base, 1, size, fp ) == (size_t)size;
+  fclose( fp );
+  if ( !ok ) { free( base ); return 0; }
+
+  g_pack      = base;
+  g_pack_size = (size_t)size;
+#endif
+
+  if ( !rp_Valid( g_pack, g_pack_size ) )
+  {
+    printf( "RESPACK: %s is not a valid pack, using loose files\n", path );
+    ResPackClose();
+    return 0;
+  }
+
+  snprintf( g_pack_path, sizeof( g_pack_path ), "%s", path );
+  printf( "RESPACK: %s - %d files\n", path, g_num_entries );
+  return 1;
+}
+
+void ResPackClose( void )
+{
+  if ( !g_pack ) return;
+
+#ifndef __EMSCRIPTEN__
+  munmap( (void*)g_pack, g_pack_size );
+#else
+  free( (void*)g_pack );
+#endif
+
+  g_pack        = NULL;
+  g_pack_size   = 0;
+  g_entries     = NULL;
+  g_num_entries = 0;
+}
+
+int ResPackMounted( void )
+{
+  return g_pack != NULL;
+}
+
+const char* ResPackPath( void )
+{
+  return g_pack ? g_pack_path : NULL;
+}
+
+static int rp_CmpEntry( const void* key, const void* elem )
+{
+  return strcmp( (const char*)key, ( (const ResPackEntry_t*)elem )->path );
+}
+
+static const ResPackEntry_t* rp_Find( const char* path )
+{
+  if ( !g_pack ) return NULL;
+  return bsearch( path, g_entries, g_num_entries, sizeof( ResPackEntry_t ),
+                  rp_CmpEntry );
+}
+
+int ResOpen( const char* path, ResFile_t* out )
+{
+  memset( out, 0, sizeof( ResFile_t ) );
+
+  const ResPackEntry_t* e = rp_Find( path );
+  if ( e )
+  {
+    out->data = g_pack + e->offset;
+    out->size = e->size;
+    return 1;
+  }
+
+  FILE* fp = fopen( path, "rb" );
+  if ( !fp ) return 0;
+
+  fseek( fp, 0, SEEK_END );
+  long size = ftell( fp );
+  fseek( fp, 0, SEEK_SET );
+  if ( size < 0 ) { fclose( fp ); return 0; }
+
+  char* buf = malloc( size + 1 );
+  if ( !buf ) { fclose( fp ); return 0; }
+  size = (long)fread( buf, 1, size, fp );
+  buf[size] = '\0';
+  fclose( fp );
+
+  out->data  = buf;
+  out->size  = (size_t)size;
+  out->owned = buf;
+  return 1;
+}
+
+void ResClose( ResFile_t* f )
+{
+  free( f->owned );
+  memset( f, 0, sizeof( ResFile_t ) );
+}
+
+int ResExists( const char* path )
+{
+  return rp_Find( path ) != NULL || access( path, F_OK ) == 0;
+}
+
+static int rp_HasExt( const char* path, const char* ext )
+{
+  size_t len = strlen( path ), elen = strlen( ext );
+  return len > elen && strcmp( path + len - elen, ext ) == 0;
+}
+
+static int rp_ListLoose( const char* dir, const char* ext,
+                         ResListFn_t fn, void* user )
+{
+  DIR* d = opendir( dir );
+  if ( !d ) return 0;
+
+  int count = 0;
+  struct dirent* ent;
+  while ( ( ent = readdir( d ) ) != NULL )
+  {
+    if ( ent->d_name[0] == '.' ) continue;
+
+    char path[512];
+    snprintf( path, sizeof( path ), "%s/%s", dir, ent->d_name );
+
+    struct stat st;
+    if ( stat( path, &st ) == 0 && S_ISDIR( st.st_mode ) )
+    {
+      count += rp_ListLoose( path, ext, fn, user );
+      continue;
+    }
+
+    if ( !rp_HasExt( path, ext ) ) continue;
+    fn( path, user );
+    count++;
+  }
+
+  closedir( d );
+  return count;
+}
+
+int ResListDir( const char* dir, const char* ext, ResListFn_t fn, void* user )
+{
+  if ( !g_pack ) return rp_ListLoose( dir, ext, fn, user );
+
+  /* Entries are sorted, so a directory is one contiguous run */
+  size_t dlen = strlen( dir );
+  int count = 0;
+  for ( int i = 0; i < g_num_entries; i++ )
+  {
+    const char* p = g_entries[i].path;
+    if ( strncmp( p, dir, dlen ) != 0 || p[dlen] != '/' ) continue;
+    if ( !rp_HasExt( p, ext ) ) continue;
+    fn( p, user );
+    count++;
+  }
+  return count;
+}
+
+dDUFError_t* ResParseDUF( const char* path, dDUFValue_t** root )
+{
+  const ResPackEntry_t* e = rp_Find( path );
+  if ( !e ) return d_DUFParseFile( path, root );
+
+  return d_DUFParseString( g_pack + e->offset, root );
+}
+
+SDL_Surface* ResLoadSurface( const char* path )
+{
+  const ResPackEntry_t* e = rp_Find( path );
+  if ( !e ) return IMG_Load( path );
+
+  SDL_RWops* rw = SDL_RWFromConstMem( g_pack + e->offset, (int)e->size );
+  return rw ? IMG_Load_RW( rw, 1 ) : NULL;
+}
@@ -0,0 +1,61 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "slot_pool.h"
+
+void SlotPoolReset( SlotPool_t* p )
+{
+  /* Generations carry on - a handle from before the reset goes stale
+     as soon as its slot is handed out again */
+  p->num_free = 0;
+  p->num_live = 0;
+}
+
+int SlotPoolAlloc( SlotPool_t* p, int* count )
+{
+  int slot;
+  if ( p->num_free > 0 )       slot = p->free[--p->num_free];
+  else if ( *count < p->cap )  slot = ( *count )++;
+  else                         return -1;
+
+  p->gen[slot]++;
+  if ( p->num_live < p->cap ) p->live[p->num_live++] = (int16_t)slot;
+  return slot;
+}
+
+static int sp_Alive( const void* list, size_t stride, size_t alive_offset,
+                     int i )
+{
+  const char* e = (const char*)list + stride * (size_t)i;
+  return *(const int*)( e + alive_offset );
+}
+
+void SlotPoolCollect( SlotPool_t* p, const void* list, size_t stride,
+                      size_t alive_offset, int* count )
+{
+  while ( *count > 0 && !sp_Alive( list, stride, alive_offset, *count - 1 ) )
+    ( *count )--;
+
+  p->num_free = 0;
+  p->num_live = 0;
+  for ( int i = *count - 1; i >= 0; i-- )
+    if ( !sp_Alive( list, stride, alive_offset, i ) )
+      p->free[p->num_free++] = (int16_t)i;
+  for ( int i = 0; i < *count; i++ )
+    if ( sp_Alive( list, stride, alive_offset, i ) )
+      p->live[p->num_live++] = (int16_t)i;
+}
+
+SlotHandle_t SlotPoolHandle( const SlotPool_t* p, int slot )
+{
+  if ( slot < 0 || slot >= p->cap ) return SLOT_HANDLE_NONE;
+  return ( (uint32_t)p->gen[slot] << 16 ) | (uint32_t)slot;
+}
+
+int SlotPoolResolve( const SlotPool_t* p, SlotHandle_t h )
+{
+  if ( h == SLOT_HANDLE_NONE ) return -1;
+  int slot = SLOT_HANDLE_SLOT( h );
+  if ( slot >= p->cap || p->gen[slot] != ( h >> 16 ) ) return -1;
+  return slot;
+}
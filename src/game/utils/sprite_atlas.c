@@ -0,0 +1,262 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL_image.h>
+#include <Archimedes.h>
+
+#include "asset_loader.h"
+#include "sprite_atlas.h"
+#include "res_pack.h"
+
+#define ATLAS_PATH_LEN  128
+
+/* A region hands out its img to callers; img must stay the first member
+   so AtlasSrc can get back from the aImage_t* to the region. */
+typedef struct
+{
+  aImage_t img;
+  aRectf_t src;
+  int      page;
+  char     path[ATLAS_PATH_LEN];
+} AtlasRegion_t;
+
+/* Pages keep their CPU surface so sprites loaded later (next floor,
+   scene re-init) can be packed in and the page re-uploaded. */
+typedef struct
+{
+  SDL_Surface* surface;
+  SDL_Texture* texture;
+  int          shelf_y;     /* top of the shelf being filled */
+  int          shelf_h;     /* tallest sprite on that shelf */
+  int          cursor_x;
+  int          dirty;
+} AtlasPage_t;
+
+static AtlasRegion_t g_regions[ATLAS_MAX_REGIONS];
+static int           g_num_regions = 0;
+
+static AtlasPage_t   g_pages[ATLAS_MAX_PAGES];
+static int           g_num_pages = 0;
+
+static AtlasRegion_t* atlas_Find( const char* path )
+{
+  for ( int i = 0; i < g_num_regions; i++ )
+    if ( strcmp( g_regions[i].path, path ) == 0 )
+      return &g_regions[i];
+  return NULL;
+}
+
+static AtlasPage_t* atlas_NewPage( void )
+{
+  if ( g_num_pages >= ATLAS_MAX_PAGES ) return NULL;
+
+  SDL_Surface* s = SDL_CreateRGBSurfaceWithFormat( 0, ATLAS_PAGE_SIZE,
+                                                   ATLAS_PAGE_SIZE, 32,
+                                                   SDL_PIXELFORMAT_RGBA32 );
+  if ( !s )
+  {
+    printf( "ATLAS: could not create page - %s\n", SDL_GetError() );
+    return NULL;
+  }
+
+  AtlasPage_t* p = &g_pages[g_num_pages++];
+  memset( p, 0, sizeof( AtlasPage_t ) );
+  p->surface = s;
+  return p;
+}
+
+/* Shelf packing: fill left to right, open a new shelf under the tallest
+   sprite when the row is full. Sprites arrive in load order, which keeps
+   same-sized icons together on the same shelves. */
+static int atlas_Place( AtlasPage_t* p, int w, int h, int* x, int* y )
+{
+  int pw = w + ATLAS_PADDING;
+  int ph = h + ATLAS_PADDING;
+
+  if ( p->cursor_x + pw > ATLAS_PAGE_SIZE )
+  {
+    p->shelf_y += p->shelf_h;
+    p->shelf_h  = 0;
+    p->cursor_x = 0;
+  }
+  if ( p->shelf_y + ph > ATLAS_PAGE_SIZE ) return 0;
+
+  *x = p->cursor_x;
+  *y = p->shelf_y;
+  p->cursor_x += pw;
+  if ( ph > p->shelf_h ) p->shelf_h = ph;
+  return 1;
+}
+
+/* Claim a region for path before its pixels exist, so loaders can keep
+   the pointer while the decode runs elsewhere. */
+static AtlasRegion_t* atlas_Reserve( const char* path )
+{
+  if ( g_num_regions >= ATLAS_MAX_REGIONS ) return NULL;
+
+  AtlasRegion_t* r = &g_regions[g_num_regions++];
+  memset( r, 0, sizeof( AtlasRegion_t ) );
+  r->page = -1;
+  snprintf( r->path, sizeof( r->path ), "%s", path );
+  return r;
+}
+
+/* Upload src as an image of its own. Goes through the pack like every
+   other sprite, so it works where only the pack ships. Takes ownership
+   of src. */
+static void atlas_Standalone( aImage_t* out, SDL_Surface* src )
+{
+  SDL_Texture* tex = SDL_CreateTextureFromSurface( app.renderer, src );
+  if ( tex )
+  {
+    SDL_SetTextureBlendMode( tex, SDL_BLENDMODE_BLEND );
+    out->texture = tex;
+    out->rect    = (aRectf_t){ 0, 0, (float)src->w, (float)src->h };
+  }
+  else
+    printf( "ATLAS: could not upload standalone sprite - %s\n", SDL_GetError() );
+  SDL_FreeSurface( src );
+}
+
+/* Region table full: the image lives on the heap for the rest of the run */
+static aImage_t* atlas_Overflow( const char* path )
+{
+  printf( "ATLAS: region table full, loading %s standalone\n", path );
+
+  SDL_Surface* src = ResLoadSurface( path );
+  if ( !src )
+  {
+    printf( "ATLAS: could not load %s - %s\n", path, IMG_GetError() );
+    return NULL;
+  }
+
+  aImage_t* img = calloc( 1, sizeof( aImage_t ) );
+  if ( !img ) { SDL_FreeSurface( src ); return NULL; }
+  atlas_Standalone( img, src );
+  return img;
+}
+
+/* Copy a decoded sprite into a page, or fall back to a standalone image.
+   Takes ownership of src. */
+static void atlas_Pack( AtlasRegion_t* r, SDL_Surface* src )
+{
+  int x = 0, y = 0, page = g_num_pages - 1;
+
+  if ( src->w + ATLAS_PADDING > ATLAS_PAGE_SIZE
+       || src->h + ATLAS_PADDING > ATLAS_PAGE_SIZE )
+    page = -1;
+  /* Try the newest page first, open another when it is full */
+  else if ( page < 0 || !atlas_Place( &g_pages[page], src->w, src->h, &x, &y ) )
+  {
+    AtlasPage_t* p = atlas_NewPage();
+    if ( p && atlas_Place( p, src->w, src->h, &x, &y ) )
+      page = g_num_pages - 1;
+    else
+    {
+      printf( "ATLAS: out of pages, loading %s standalone\n", r->path );
+      page = -1;
+    }
+  }
+
+  if ( page < 0 )
+  {
+    atlas_Standalone( &r->img, src );
+    return;
+  }
+
+  /* Copy the pixels as-is - blending here would flatten the alpha */
+  SDL_Rect dst = { x, y, src->w, src->h };
+  SDL_SetSurfaceBlendMode( src, SDL_BLENDMODE_NONE );
+  SDL_BlitSurface( src, NULL, g_pages[page].surface, &dst );
+  g_pages[page].dirty = 1;
+
+  r->img.texture = g_pages[page].texture;
+  r->img.rect    = (aRectf_t){ 0, 0, (float)src->w, (float)src->h };
+  r->src         = (aRectf_t){ (float)x, (float)y, (float)src->w, (float)src->h };
+  r->page        = page;
+
+  SDL_FreeSurface( src );
+}
+
+aImage_t* AtlasImage( const char* path )
+{
+  AtlasRegion_t* r = atlas_Find( path );
+  if ( r ) return &r->img;
+
+  r = atlas_Reserve( path );
+  if ( !r ) return atlas_Overflow( path );
+
+  SDL_Surface* src = ResLoadSurface( path );
+  if ( !src )
+  {
+    printf( "ATLAS: could not load %s - %s\n", path, IMG_GetError() );
+    g_num_regions--;
+    return NULL;
+  }
+
+  atlas_Pack( r, src );
+  return &r->img;
+}
+
+static void atlas_OnDecoded( const char* path, SDL_Surface* surface, void* user )
+{
+  (void)path;
+  if ( surface ) atlas_Pack( (AtlasRegion_t*)user, surface );
+}
+
+aImage_t* AtlasQueue( const char* path )
+{
+  AtlasRegion_t* r = atlas_Find( path );
+  if ( r ) return &r->img;
+
+  r = atlas_Reserve( path );
+  if ( !r ) return atlas_Overflow( path );
+
+  AssetQueueImage( path, atlas_OnDecoded, r );
+  return &r->img;
+}
+
+void AtlasUpload( void )
+{
+  int uploaded = 0;
+
+  for ( int i = 0; i < g_num_pages; i++ )
+  {
+    AtlasPage_t* p = &g_pages[i];
+    if ( !p->dirty ) continue;
+
+    SDL_Texture* tex = SDL_CreateTextureFromSurface( app.renderer, p->surface );
+    if ( !tex )
+    {
+      printf( "ATLAS: could not upload page %d - %s\n", i, SDL_GetError() );
+      continue;
+    }
+    SDL_SetTextureBlendMode( tex, SDL_BLENDMODE_BLEND );
+
+    if ( p->texture ) SDL_DestroyTexture( p->texture );
+    p->texture = tex;
+    p->dirty   = 0;
+    uploaded++;
+
+    for ( int j = 0; j < g_num_regions; j++ )
+      if ( g_regions[j].page == i )
+        g_regions[j].img.texture = tex;
+  }
+
+  if ( uploaded > 0 )
+    printf( "ATLAS: %d sprites on %d page(s)\n", g_num_regions, g_num_pages );
+}
+
+aRectf_t* AtlasSrc( aImage_t* img )
+{
+  if ( !img ) return NULL;
+
+  /* Only pointers handed out by AtlasImage live inside g_regions */
+  const char* p  = (const char*)img;
+  const char* lo = (const char*)g_regions;
+  const char* hi = (const char*)( g_regions + g_num_regions );
+  if ( p < lo || p >= hi ) return NULL;
+
+  AtlasRegion_t* r = (AtlasRegion_t*)img;
+  return ( r->page >= 0 ) ? &r->src : NULL;
+}
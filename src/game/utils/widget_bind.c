@@ -0,0 +1,114 @@
+#include <string.h>
+#include <Archimedes.h>
+
+#include "widget_bind.h"
+
+/* Resolves every named widget of a layout once after a_WidgetsInit, so
+   draw/logic paths index an array instead of looking widgets up by name. */
+
+static const char* g_layout_paths[WB_LAYOUT_COUNT] = {
+  [WB_LAYOUT_MAIN_MENU]    = "resources/widgets/main_menu.auf",
+  [WB_LAYOUT_CLASS_SELECT] = "resources/widgets/class_select.auf",
+  [WB_LAYOUT_SETTINGS]     = "resources/widgets/settings.auf",
+  [WB_LAYOUT_LORE]         = "resources/widgets/lore.auf",
+  [WB_LAYOUT_GAME]         = "resources/widgets/game_scene.auf",
+};
+
+typedef struct
+{
+  const char* name;
+  int         layout;
+  int         container;    /* 1 = WT_CONTAINER, 0 = plain widget */
+} WidgetBindDef_t;
+
+static const WidgetBindDef_t g_defs[WB_COUNT] = {
+  [WB_MM_BUTTONS]        = { "mm_buttons",        WB_LAYOUT_MAIN_MENU,    1 },
+  [WB_MM_TITLE]          = { "mm_title",          WB_LAYOUT_MAIN_MENU,    1 },
+  [WB_MM_VERSION]        = { "mm_version",        WB_LAYOUT_MAIN_MENU,    1 },
+
+  [WB_CLASS_SELECT]      = { "class_select",      WB_LAYOUT_CLASS_SELECT, 1 },
+  [WB_CONSUMABLES_PANEL] = { "consumables_panel", WB_LAYOUT_CLASS_SELECT, 1 },
+  [WB_DOORS_PANEL]       = { "doors_panel",       WB_LAYOUT_CLASS_SELECT, 1 },
+  [WB_TITLE_PANEL]       = { "title_panel",       WB_LAYOUT_CLASS_SELECT, 1 },
+  [WB_INFO_PANEL]        = { "info_panel",        WB_LAYOUT_CLASS_SELECT, 1 },
+  [WB_IMAGE_PANEL]       = { "image_panel",       WB_LAYOUT_CLASS_SELECT, 1 },
+  [WB_GEAR_PANEL]        = { "gear_panel",        WB_LAYOUT_CLASS_SELECT, 1 },
+
+  [WB_SETTINGS_TITLE]    = { "settings_title",    WB_LAYOUT_SETTINGS,     1 },
+  [WB_SETTINGS_PANEL]    = { "settings_panel",    WB_LAYOUT_SETTINGS,     1 },
+  [WB_SETTINGS_BACK]     = { "settings_back",     WB_LAYOUT_SETTINGS,     1 },
+  [WB_SETTINGS_HINT]     = { "settings_hint",     WB_LAYOUT_SETTINGS,     1 },
+
+  [WB_LORE_TITLE]        = { "lore_title",        WB_LAYOUT_LORE,         1 },
+  [WB_LORE_CATEGORIES]   = { "lore_categories",   WB_LAYOUT_LORE,         1 },
+  [WB_LORE_ENTRIES]      = { "lore_entries",      WB_LAYOUT_LORE,         1 },
+  [WB_LORE_BACK]         = { "lore_back",         WB_LAYOUT_LORE,         1 },
+  [WB_LORE_HINT]         = { "lore_hint",         WB_LAYOUT_LORE,         1 },
+
+  [WB_TOP_BAR]           = { "top_bar",           WB_LAYOUT_GAME,         1 },
+  [WB_GAME_VIEWPORT]     = { "game_viewport",     WB_LAYOUT_GAME,         1 },
+  [WB_CONSOLE_PANEL]     = { "console_panel",     WB_LAYOUT_GAME,         1 },
+  [WB_INV_PANEL]         = { "inv_panel",         WB_LAYOUT_GAME,         1 },
+  [WB_INV_TITLE]         = { "inv_title",         WB_LAYOUT_GAME,         0 },
+  [WB_KEY_PANEL]         = { "key_panel",         WB_LAYOUT_GAME,         1 },
+  [WB_KEY_TITLE]         = { "key_title",         WB_LAYOUT_GAME,         0 },
+};
+
+static aWidget_t*          g_widgets[WB_COUNT];
+static aContainerWidget_t* g_containers[WB_COUNT];
+static int                 g_layout = -1;
+
+static void wb_Clear( void )
+{
+  memset( g_widgets, 0, sizeof( g_widgets ) );
+  memset( g_containers, 0, sizeof( g_containers ) );
+}
+
+static void wb_Resolve( void )
+{
+  wb_Clear();
+  for ( int i = 0; i < WB_COUNT; i++ )
+  {
+    if ( g_defs[i].layout != g_layout ) continue;
+
+    g_widgets[i] = a_GetWidget( g_defs[i].name );
+    if ( g_widgets[i] && g_defs[i].container )
+      g_containers[i] = a_GetContainerFromWidget( g_defs[i].name );
+  }
+}
+
+void WidgetBindLoad( WidgetLayout_t layout )
+{
+  if ( layout < 0 || layout >= WB_LAYOUT_COUNT ) return;
+
+  g_layout = layout;
+  a_WidgetsInit( g_layout_paths[layout] );
+  wb_Resolve();
+}
+
+void WidgetBindReload( void )
+{
+  if ( g_layout < 0 ) return;
+
+  a_WidgetsInit( g_layout_paths[g_layout] );
+  wb_Resolve();
+}
+
+void WidgetBindFree( void )
+{
+  wb_Clear();
+  g_layout = -1;
+  a_WidgetCacheFree();
+}
+
+aContainerWidget_t* WidgetBindContainer( WidgetBindId_t id )
+{
+  if ( id < 0 || id >= WB_COUNT ) return NULL;
+  return g_containers[id];
+}
+
+aWidget_t* WidgetBindWidget( WidgetBindId_t id )
+{
+  if ( id < 0 || id >= WB_COUNT ) return NULL;
+  return g_widgets[id];
+}
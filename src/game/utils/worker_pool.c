@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <Archimedes.h>
+
+#include "worker_pool.h"
+
+#ifdef __EMSCRIPTEN__
+#define WP_THREADED 0
+#else
+#define WP_THREADED 1
+#endif
+
+static SDL_mutex*  wp_lock = NULL;
+static SDL_cond*   wp_wake = NULL;      /* a batch started, or quit */
+static SDL_cond*   wp_done = NULL;      /* a worker ran out of jobs */
+static SDL_Thread* wp_threads[WORKER_POOL_MAX - 1];
+static int         wp_num_threads = 0;
+static int         wp_quit = 0;
+
+/* The batch being run - all under wp_lock */
+static WorkerJobFn_t wp_fn;
+static void*         wp_user;
+static int           wp_num_jobs;
+static int           wp_next;           /* next job to hand out */
+static int           wp_finished;
+static int           wp_want;           /* workers 0..wp_want-1 take part */
+static int           wp_busy;           /* pool threads inside the batch */
+static unsigned      wp_gen;            /* bumped per batch */
+
+/* Claim and run jobs until there are none left. Called and returns with
+   wp_lock held. */
+static void wp_Drain( int worker )
+{
+  while ( wp_next < wp_num_jobs )
+  {
+    int           job  = wp_next++;
+    WorkerJobFn_t fn   = wp_fn;
+    void*         user = wp_user;
+
+    SDL_UnlockMutex( wp_lock );
+    fn( job, worker, user );
+    SDL_LockMutex( wp_lock );
+
+    wp_finished++;
+  }
+}
+
+static int wp_Worker( void* data )
+{
+  int      worker = (int)(intptr_t)data;
+  unsigned seen   = 0;
+
+  SDL_LockMutex( wp_lock );
+  while ( !wp_quit )
+  {
+    if ( wp_gen == seen || worker >= wp_want )
+    {
+      seen = wp_gen;
+      SDL_CondWait( wp_wake, wp_lock );
+      continue;
+    }
+
+    seen = wp_gen;
+    wp_busy++;
+    wp_Drain( worker );
+    wp_busy--;
+    SDL_CondSignal( wp_done );
+  }
+  SDL_UnlockMutex( wp_lock );
+  return 0;
+}
+
+void WorkerPoolInit( void )
+{
+  if ( wp_lock ) return;
+
+  wp_quit = 0;
+  wp_gen  = 0;
+
+#if WP_THREADED
+  int cpus = SDL_GetCPUCount();
+  if ( cpus > WORKER_POOL_MAX ) cpus = WORKER_POOL_MAX;
+  if ( cpus < 2 ) return;
+
+  wp_lock = SDL_CreateMutex();
+  wp_wake = SDL_CreateCond();
+  wp_done = SDL_CreateCond();
+  if ( !wp_lock || !wp_wake || !wp_done )
+  {
+    printf( "WORKERS: no mutex (%s), running on the main thread\n", SDL_GetError() );
+    if ( wp_lock ) SDL_DestroyMutex( wp_lock );
+    if ( wp_wake ) SDL_DestroyCond( wp_wake );
+    if ( wp_done ) SDL_DestroyCond( wp_done );
+    wp_lock = NULL;
+    wp_wake = wp_done = NULL;
+    return;
+  }
+
+  for ( int i = 1; i < cpus; i++ )
+  {
+    SDL_Thread* t = SDL_CreateThread( wp_Worker, "worker",
+                                      (void*)(intptr_t)i );
+    if ( !t ) break;
+    wp_threads[wp_num_threads++] = t;
+  }
+  printf( "WORKERS: %d pool thread(s)\n", wp_num_threads );
+#endif
+}
+
+void WorkerPoolQuit( void )
+{
+  if ( !wp_lock ) return;
+
+  SDL_LockMutex( wp_lock );
+  wp_quit = 1;
+  SDL_CondBroadcast( wp_wake );
+  SDL_UnlockMutex( wp_lock );
+
+  for ( int i = 0; i < wp_num_threads; i++ )
+    SDL_WaitThread( wp_threads[i], NULL );
+  wp_num_threads = 0;
+
+  SDL_DestroyCond( wp_wake );
+  SDL_DestroyCond( wp_done );
+  SDL_DestroyMutex( wp_lock );
+  wp_lock = NULL;
+  wp_wake = wp_done = NULL;
+}
+
+int WorkerPoolSize( void )
+{
+  return wp_num_threads + 1;
+}
+
+void WorkerPoolRun( int num_jobs, WorkerJobFn_t fn, void* user, int threads )
+{
+  if ( threads > WorkerPoolSize() ) threads = WorkerPoolSize();
+
+  if ( !wp_lock || threads <= 1 || num_jobs <= 1 )
+  {
+    for ( int i = 0; i < num_jobs; i++ ) fn( i, 0, user );
+    return;
+  }
+
+  SDL_LockMutex( wp_lock );
+  wp_fn       = fn;
+  wp_user     = user;
+  wp_num_jobs = num_jobs;
+  wp_next     = 0;
+  wp_finished = 0;
+  wp_want     = threads;
+  wp_gen++;
+  SDL_CondBroadcast( wp_wake );
+
+  /* The caller is worker 0 */
+  wp_Drain( 0 );
+  while ( wp_finished < wp_num_jobs || wp_busy > 0 )
+    SDL_CondWait( wp_done, wp_lock );
+  SDL_UnlockMutex( wp_lock );
+}
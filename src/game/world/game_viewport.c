@@ -6,6 +6,7 @@
 #include "game_viewport.h"
 #include "visibility.h"
 #include "interactive_tile.h"
+#include "sprite_atlas.h"
 
 #define GV_ZOOM_STEP 0.9f  /* multiplier per scroll tick (< 1 = zoom in) */
 
@@ -44,19 +45,18 @@ void GV_DrawWorld( aRectf_t rect, GameCamera_t* cam,
     float dw = world->tile_w * sx;
     float dh = world->tile_h * sy;
 
-    Tile_t bg = world->background[i];
-    Tile_t mg = world->midground[i];
-    Tile_t fg = world->foreground[i];
-
-    if ( bg.tile == TILE_EMPTY )
+    if ( world->background[i] == TILE_EMPTY )
     {
       d_LogFatalF( "[GV_DrawWorld] background tile %d has TILE_EMPTY - "
-                   "background must always have a valid tile index", i );
+                   "background must always have a valid tile type", i );
       exit( 1 );
     }
 
-    int has_mg = ( mg.tile != TILE_EMPTY );
-    int has_fg = ( fg.tile != TILE_EMPTY );
+    const TileDef_t* bg = TILE_DEF( world->background[i] );
+    const TileDef_t* mg = TILE_DEF( world->midground[i] );
+    const TileDef_t* fg = TILE_DEF( world->foreground[i] );
+    int has_mg = ( world->midground[i] != TILE_EMPTY );
+    int has_fg = ( world->foreground[i] != TILE_EMPTY );
 
     if ( draw_ascii )
     {
@@ -66,12 +66,12 @@ void GV_DrawWorld( aRectf_t rect, GameCamera_t* cam,
       int nw = (int)( dx + dw + 0.5f ) - (int)dx;
       int nh = (int)( dy + dh + 0.5f ) - (int)dy;
 
-      a_DrawGlyph( bg.glyph, nx, ny, nw, nh,
-                   bg.glyph_fg, bg.glyph_bg, FONT_CODE_PAGE_437 );
+      a_DrawGlyph( bg->glyph, nx, ny, nw, nh,
+                   bg->fg, bg->bg, FONT_CODE_PAGE_437 );
 
-      if ( has_mg && mg.glyph[0] != '\0' )
-        a_DrawGlyph( mg.glyph, nx, ny, nw, nh,
-                     mg.glyph_fg, mg.glyph_bg, FONT_CODE_PAGE_437 );
+      if ( has_mg && mg->glyph[0] != '\0' )
+        a_DrawGlyph( mg->glyph, nx, ny, nw, nh,
+                     mg->fg, mg->bg, FONT_CODE_PAGE_437 );
 
       /* Gold hint on interactive tiles (glyph mode) */
       if ( has_mg )
@@ -95,9 +95,9 @@ void GV_DrawWorld( aRectf_t rect, GameCamera_t* cam,
         }
       }
 
-      if ( has_fg && fg.glyph[0] != '\0' )
-        a_DrawGlyph( fg.glyph, nx, ny, nw, nh,
-                     fg.glyph_fg, fg.glyph_bg, FONT_CODE_PAGE_437 );
+      if ( has_fg && fg->glyph[0] != '\0' )
+        a_DrawGlyph( fg->glyph, nx, ny, nw, nh,
+                     fg->fg, fg->bg, FONT_CODE_PAGE_437 );
     }
     else
     {
@@ -107,9 +107,10 @@ void GV_DrawWorld( aRectf_t rect, GameCamera_t* cam,
       float nw = (int)( dx + dw + 0.5f ) - (int)dx;
       float nh = (int)( dy + dh + 0.5f ) - (int)dy;
       aRectf_t dst = { nx, ny, nw, nh };
-      a_BlitRect( tileset[bg.tile].img, NULL, &dst, 1.0f );
-      if ( has_mg )
-        a_BlitRect( tileset[mg.tile].img, NULL, &dst, 1.0f );
+      if ( bg->sprite != TILE_SPRITE_NONE )
+        a_BlitRect( tileset[bg->sprite].img, NULL, &dst, 1.0f );
+      if ( mg->sprite != TILE_SPRITE_NONE )
+        a_BlitRect( tileset[mg->sprite].img, NULL, &dst, 1.0f );
 
       /* Gold hint on interactive tiles (image mode) — scale with tile size */
       if ( has_mg )
@@ -136,8 +137,8 @@ void GV_DrawWorld( aRectf_t rect, GameCamera_t* cam,
         }
       }
 
-      if ( has_fg )
-        a_BlitRect( tileset[fg.tile].img, NULL, &dst, 1.0f );
+      if ( fg->sprite != TILE_SPRITE_NONE )
+        a_BlitRect( tileset[fg->sprite].img, NULL, &dst, 1.0f );
     }
   }
 }
@@ -195,7 +196,7 @@ void GV_DrawSprite( aRectf_t rect, GameCamera_t* cam,
   float dh = wh * sy;
 
   aRectf_t dst = { dx, dy, dw, dh };
-  a_BlitRect( img, NULL, &dst, 1.0f );
+  a_BlitRect( img, AtlasSrc( img ), &dst, 1.0f );
 }
 
 void GV_DrawSpriteFlipped( aRectf_t rect, GameCamera_t* cam,
@@ -211,7 +212,7 @@ void GV_DrawSpriteFlipped( aRectf_t rect, GameCamera_t* cam,
   float dw = ww * sx;
 
   float scale = dw / img->rect.w;
-  a_BlitRectFlipped( img, NULL,
+  a_BlitRectFlipped( img, AtlasSrc( img ),
                      &(aRectf_t){ dx, dy, img->rect.w, img->rect.h },
                      scale, axis );
 }
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <string.h>
+#include <Archimedes.h>
+#include <Daedalus.h>
+
+#include "tile_defs.h"
+#include "res_pack.h"
+
+TileDef_t g_tile_defs[TILE_TYPE_COUNT];
+
+static const char* g_tile_names[TILE_TYPE_COUNT] = {
+  [TILE_EMPTY]        = "empty",
+  [TILE_FLOOR]        = "floor",
+  [TILE_WALL]         = "wall",
+  [TILE_DOOR_BLUE]    = "door_blue",
+  [TILE_DOOR_GREEN]   = "door_green",
+  [TILE_DOOR_RED]     = "door_red",
+  [TILE_DOOR_WHITE]   = "door_white",
+  [TILE_DOOR_BLUE_V]  = "door_blue_v",
+  [TILE_DOOR_GREEN_V] = "door_green_v",
+  [TILE_DOOR_RED_V]   = "door_red_v",
+  [TILE_DOOR_WHITE_V] = "door_white_v",
+  [TILE_RAT_HOLE]     = "rat_hole",
+  [TILE_HIDDEN_WALL]  = "hidden_wall",
+  [TILE_CRACKED_WALL] = "cracked_wall",
+  [TILE_SPIDER_WEB]   = "spider_web",
+  [TILE_OLD_CRATE]    = "old_crate",
+  [TILE_URN]          = "urn",
+  [TILE_VOID_PORTAL]  = "void_portal",
+  [TILE_EASEL]        = "easel",
+  [TILE_CHAIR]        = "chair",
+  [TILE_RUG_TL]       = "rug_tl",
+  [TILE_RUG_T]        = "rug_t",
+  [TILE_RUG_TR]       = "rug_tr",
+  [TILE_RUG_BL]       = "rug_bl",
+  [TILE_RUG_B]        = "rug_b",
+  [TILE_RUG_BR]       = "rug_br",
+};
+
+static aColor_t ParseDUFColor( dDUFValue_t* color_node, aColor_t c )
+{
+  if ( color_node == NULL || color_node->type != D_DUF_ARRAY ) return c;
+
+  dDUFValue_t* ch = color_node->child;
+  if ( ch ) { c.r = (uint8_t)ch->value_int; ch = ch->next; }
+  if ( ch ) { c.g = (uint8_t)ch->value_int; ch = ch->next; }
+  if ( ch ) { c.b = (uint8_t)ch->value_int; ch = ch->next; }
+  if ( ch ) { c.a = (uint8_t)ch->value_int; }
+  return c;
+}
+
+static int td_Lookup( const char* key )
+{
+  for ( int i = 0; i < TILE_TYPE_COUNT; i++ )
+    if ( g_tile_names[i] && strcmp( key, g_tile_names[i] ) == 0 ) return i;
+  return -1;
+}
+
+/* No sprite means nothing is drawn in image mode; opaque follows solid
+   unless the entry says otherwise */
+static void td_ParseEntry( dDUFValue_t* entry, TileDef_t* t )
+{
+  dDUFValue_t* sprite = d_DUFGetObjectItem( entry, "sprite" );
+  dDUFValue_t* glyph  = d_DUFGetObjectItem( entry, "glyph" );
+  dDUFValue_t* solid  = d_DUFGetObjectItem( entry, "solid" );
+  dDUFValue_t* opaque = d_DUFGetObjectItem( entry, "opaque" );
+
+  memset( t, 0, sizeof( TileDef_t ) );
+  t->sprite = sprite ? (int)sprite->value_int : TILE_SPRITE_NONE;
+  if ( glyph ) strncpy( t->glyph, glyph->value_string, sizeof( t->glyph ) - 1 );
+  t->fg     = ParseDUFColor( d_DUFGetObjectItem( entry, "fg" ),
+                             (aColor_t){ 0xc7, 0xcf, 0xcc, 255 } );
+  t->bg     = ParseDUFColor( d_DUFGetObjectItem( entry, "bg" ),
+                             (aColor_t){ 0, 0, 0, 0 } );
+  t->solid  = solid ? (uint8_t)( solid->value_int != 0 ) : 0;
+  t->opaque = opaque ? (uint8_t)( opaque->value_int != 0 ) : t->solid;
+}
+
+void TileDefsLoad( const char* path )
+{
+  int loaded[TILE_TYPE_COUNT] = { 0 };
+
+  dDUFValue_t* root = NULL;
+  dDUFError_t* err  = ResParseDUF( path, &root );
+
+  if ( err != NULL )
+  {
+    printf( "DUF parse error at %d:%d - %s\n",
+            err->line, err->column, d_StringPeek( err->message ) );
+    d_DUFErrorFree( err );
+  }
+  else
+  {
+    for ( dDUFValue_t* entry = root->child; entry != NULL; entry = entry->next )
+    {
+      int id = entry->key ? td_Lookup( entry->key ) : -1;
+      if ( id < 0 )
+      {
+        printf( "TILES: unknown tile '%s' in %s\n",
+                entry->key ? entry->key : "?", path );
+        continue;
+      }
+      td_ParseEntry( entry, &g_tile_defs[id] );
+      loaded[id] = 1;
+    }
+    d_DUFFree( root );
+  }
+
+  for ( int i = 0; i < TILE_TYPE_COUNT; i++ )
+  {
+    if ( loaded[i] ) continue;
+    if ( i != TILE_EMPTY )
+      printf( "TILES: no definition for '%s'\n", g_tile_names[i] );
+
+    memset( &g_tile_defs[i], 0, sizeof( TileDef_t ) );
+    g_tile_defs[i].sprite = TILE_SPRITE_NONE;
+    if ( i != TILE_EMPTY )
+    {
+      strcpy( g_tile_defs[i].glyph, "?" );
+      g_tile_defs[i].fg = (aColor_t){ 0xff, 0x00, 0xff, 255 };
+    }
+  }
+}
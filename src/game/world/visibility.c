@@ -10,10 +10,26 @@ static World_t* world;
 static float*   vis;
 static int (*npc_blocks)(int,int) = NULL;
 
+/* See-through tiles the player's rays reached on the last update -
+   whoever stands on one is in the player's line of sight, and so has
+   the player in theirs */
+static uint32_t* sees;
+static int       sees_r = -1, sees_c = -1;
+static int       sight_range = 0;
+
 void VisibilityInit( World_t* w )
 {
   world = w;
+  free( vis );
   vis   = calloc( w->tile_count, sizeof( float ) );
+  free( sees );
+  sees  = calloc( WORLD_GRID_WORDS( w->tile_count ), sizeof( uint32_t ) );
+  sees_r = sees_c = -1;
+}
+
+void VisibilitySetSightRange( int range )
+{
+  sight_range = range;
 }
 
 void VisibilitySetNPCBlocker( int (*fn)(int,int) )
@@ -22,8 +38,8 @@ void VisibilitySetNPCBlocker( int (*fn)(int,int) )
 }
 
 /* Bresenham line-of-sight check.
-   Returns 1 if (x1,y1) is visible from (x0,y0) - i.e. no solid tile
-   blocks the path.  The destination tile itself is allowed to be solid
+   Returns 1 if (x1,y1) is visible from (x0,y0) - i.e. no opaque tile
+   blocks the path.  The destination tile itself is allowed to be opaque
    (so you can "see" a wall or closed door). */
 int los_clear( int x0, int y0, int x1, int y1 )
 {
@@ -50,8 +66,7 @@ int los_clear( int x0, int y0, int x1, int y1 )
       return 0;
 
     int idx = cy * world->width + cx;
-    if ( world->background[idx].solid )  return 0;
-    if ( world->midground[idx].solid )   return 0;
+    if ( WORLD_BLOCKS_SIGHT( world, idx ) )  return 0;
     if ( npc_blocks && npc_blocks( cx, cy ) ) return 0;
   }
 
@@ -65,8 +80,11 @@ void VisibilityUpdate( int pr, int pc )
 
   /* Reset all tiles to dark */
   memset( vis, 0, world->tile_count * sizeof( float ) );
+  memset( sees, 0, WORLD_GRID_WORDS( world->tile_count ) * sizeof( uint32_t ) );
+  sees_r = pr;
+  sees_c = pc;
 
-  /* Pass 1 - light non-solid tiles (floor) via line-of-sight */
+  /* Pass 1 - light see-through tiles (floor) via line-of-sight */
   for ( int y = pc - VIS_RADIUS; y <= pc + VIS_RADIUS; y++ )
   {
     for ( int x = pr - VIS_RADIUS; x <= pr + VIS_RADIUS; x++ )
@@ -82,17 +100,39 @@ void VisibilityUpdate( int pr, int pc )
         continue;
 
       int idx = y * w + x;
-      int solid = world->background[idx].solid || world->midground[idx].solid;
-
-      if ( solid )
+      if ( WORLD_BLOCKS_SIGHT( world, idx ) )
         continue;  /* walls/doors handled in pass 2 */
 
       if ( dist <= 1 || los_clear( pr, pc, x, y ) )
+      {
         vis[idx] = 1.0f - ( (float)dist / ( VIS_RADIUS + 1.0f ) );
+        sees[idx >> 5] |= 1u << ( idx & 31 );
+      }
+    }
+  }
+
+  /* Enemies that see further than the player does - their rays are
+     the only ones that aren't free */
+  for ( int y = pc - sight_range; y <= pc + sight_range; y++ )
+  {
+    for ( int x = pr - sight_range; x <= pr + sight_range; x++ )
+    {
+      if ( x < 0 || x >= w || y < 0 || y >= h )
+        continue;
+
+      int dx = abs( x - pr );
+      int dy = abs( y - pc );
+      if ( dx + dy > sight_range )                      continue;
+      if ( ( dx > dy ? dx : dy ) <= VIS_RADIUS )        continue;
+
+      int idx = y * w + x;
+      if ( WORLD_BLOCKS_SIGHT( world, idx ) )          continue;
+      if ( los_clear( pr, pc, x, y ) )
+        sees[idx >> 5] |= 1u << ( idx & 31 );
     }
   }
 
-  /* Pass 2 - solid tiles (walls, doors) inherit from brightest
+  /* Pass 2 - opaque tiles (walls, doors) inherit from brightest
      visible neighbor.  If you can see the floor next to a wall,
      you can see that wall. */
   static const int ox[] = { -1, 1, 0, 0, -1, -1, 1, 1 };
@@ -108,8 +148,7 @@ void VisibilityUpdate( int pr, int pc )
       int idx = y * w + x;
       if ( vis[idx] > 0 )  continue;  /* already lit */
 
-      int solid = world->background[idx].solid || world->midground[idx].solid;
-      if ( !solid )  continue;
+      if ( !WORLD_BLOCKS_SIGHT( world, idx ) )  continue;
 
       float best = 0;
       for ( int d = 0; d < 8; d++ )
@@ -119,8 +158,8 @@ void VisibilityUpdate( int pr, int pc )
         if ( nx < 0 || nx >= w || ny < 0 || ny >= h )
           continue;
         int nidx = ny * w + nx;
-        /* Only inherit from non-solid (floor) tiles - prevents cascade */
-        if ( world->background[nidx].solid || world->midground[nidx].solid )
+        /* Only inherit from see-through (floor) tiles - prevents cascade */
+        if ( WORLD_BLOCKS_SIGHT( world, nidx ) )
           continue;
         if ( vis[nidx] > best ) best = vis[nidx];
       }
@@ -131,6 +170,25 @@ void VisibilityUpdate( int pr, int pc )
   }
 }
 
+int VisibilitySeesPlayer( int r, int c, int pr, int pc )
+{
+  if ( r < 0 || r >= world->width || c < 0 || c >= world->height )
+    return 0;
+
+  int idx = c * world->width + r;
+  int dr  = abs( r - pr );
+  int dc  = abs( c - pc );
+  int far = ( dr > dc ? dr : dc ) > VIS_RADIUS && dr + dc > sight_range;
+
+  /* The map only knows about the tile it was built from, and skips
+     opaque tiles and whatever lies past both radii */
+  if ( pr != sees_r || pc != sees_c || far
+       || WORLD_BLOCKS_SIGHT( world, idx ) )
+    return los_clear( pr, pc, r, c );
+
+  return (int)WORLD_BIT( sees, idx );
+}
+
 float VisibilityGet( int r, int c )
 {
   if ( DevModeNoclip() ) return 1.0f;
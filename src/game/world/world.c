@@ -10,6 +10,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <Archimedes.h>
 #include <Daedalus.h>
@@ -27,6 +28,7 @@ World_t* WorldCreate( int width, int height, int tile_w, int tile_h )
   new_world->tile_w = tile_w;
   new_world->tile_h = tile_h;
   new_world->tile_count = width * height;
+  new_world->move_rev   = 0;
 
   size_t layer_size = sizeof( Tile_t ) * new_world->tile_count;
 
@@ -54,39 +56,78 @@ World_t* WorldCreate( int width, int height, int tile_w, int tile_h )
     return NULL;
   }
 
-  for ( int i = 0; i < new_world->tile_count; i++ )
+  size_t grid_size = sizeof( uint32_t ) * WORLD_GRID_WORDS( new_world->tile_count );
+
+  new_world->blocks_move  = calloc( 1, grid_size );
+  new_world->blocks_sight = calloc( 1, grid_size );
+  if ( new_world->blocks_move == NULL || new_world->blocks_sight == NULL )
   {
-    new_world->background[i].solid    = 0;
-    new_world->background[i].tile     = 0;
-    new_world->background[i].glyph    = ".";
-    new_world->background[i].glyph_fg = (aColor_t){ 0x39, 0x4a, 0x50, 255 };
-    new_world->background[i].glyph_bg = (aColor_t){ 0x09, 0x0a, 0x14, 255 };
-
-    new_world->midground[i].solid    = 0;
-    new_world->midground[i].tile     = TILE_EMPTY;
-    new_world->midground[i].glyph    = "";
-    new_world->midground[i].glyph_fg = (aColor_t){ 0xc7, 0xcf, 0xcc, 255 };
-    new_world->midground[i].glyph_bg = (aColor_t){ 0, 0, 0, 0 };
-
-    new_world->foreground[i].solid    = 0;
-    new_world->foreground[i].tile     = TILE_EMPTY;
-    new_world->foreground[i].glyph    = "";
-    new_world->foreground[i].glyph_fg = (aColor_t){ 0xc7, 0xcf, 0xcc, 255 };
-    new_world->foreground[i].glyph_bg = (aColor_t){ 0, 0, 0, 0 };
+    free( new_world->blocks_sight );
+    free( new_world->blocks_move );
+    free( new_world->foreground );
+    free( new_world->midground );
+    free( new_world->background );
+    free( new_world );
+    return NULL;
   }
 
+  memset( new_world->background, TILE_FLOOR, layer_size );
+  memset( new_world->midground,  TILE_EMPTY, layer_size );
+  memset( new_world->foreground, TILE_EMPTY, layer_size );
+  WorldRefreshGrids( new_world );
+
   return new_world;
 }
 
 void WorldFree( World_t* w )
 {
   if ( !w ) return;
+  free( w->blocks_sight );
+  free( w->blocks_move );
   free( w->foreground );
   free( w->midground );
   free( w->background );
   free( w );
 }
 
+/* Returns 1 if the bit changed */
+static int world_SetBit( uint32_t* grid, int idx, int on )
+{
+  uint32_t mask = 1u << ( idx & 31 );
+  uint32_t old  = grid[idx >> 5];
+  grid[idx >> 5] = on ? ( old | mask ) : ( old & ~mask );
+  return grid[idx >> 5] != old;
+}
+
+static void world_UpdateGrids( World_t* w, int idx )
+{
+  const TileDef_t* bg = TILE_DEF( w->background[idx] );
+  const TileDef_t* mg = TILE_DEF( w->midground[idx] );
+  const TileDef_t* fg = TILE_DEF( w->foreground[idx] );
+
+  if ( world_SetBit( w->blocks_move, idx, bg->solid || mg->solid || fg->solid ) )
+    w->move_rev++;
+  world_SetBit( w->blocks_sight, idx, bg->opaque || mg->opaque || fg->opaque );
+}
+
+void WorldSetBackground( World_t* w, int idx, TileType_t t )
+{
+  w->background[idx] = (Tile_t)t;
+  world_UpdateGrids( w, idx );
+}
+
+void WorldSetMidground( World_t* w, int idx, TileType_t t )
+{
+  w->midground[idx] = (Tile_t)t;
+  world_UpdateGrids( w, idx );
+}
+
+void WorldRefreshGrids( World_t* w )
+{
+  for ( int i = 0; i < w->tile_count; i++ )
+    world_UpdateGrids( w, i );
+}
+
 /* Legacy renderer - used by the editor. Game uses GV_DrawWorld instead. */
 void WorldDraw( int x_off, int y_off,
                     World_t* world, aTileset_t* tile_set,
@@ -111,11 +152,12 @@ void WorldDraw( int x_off, int y_off,
       y = ( y_tile * world->tile_h ) + y_off;
     }
 
-    Tile_t bg = world->background[i];
-    Tile_t mg = world->midground[i];
-    Tile_t fg = world->foreground[i];
-    int has_mg = ( mg.tile != TILE_EMPTY );
-    int has_fg = ( fg.tile != TILE_EMPTY );
+    const TileDef_t* bg = TILE_DEF( world->background[i] );
+    const TileDef_t* mg = TILE_DEF( world->midground[i] );
+    const TileDef_t* fg = TILE_DEF( world->foreground[i] );
+    int has_bg = ( bg->sprite != TILE_SPRITE_NONE );
+    int has_mg = ( mg->sprite != TILE_SPRITE_NONE );
+    int has_fg = ( fg->sprite != TILE_SPRITE_NONE );
 
     int has_viewport = ( app.g_viewport.w != 0 && app.g_viewport.h != 0 );
 
@@ -129,35 +171,35 @@ void WorldDraw( int x_off, int y_off,
         .padding = 0
       };
 
-      ts.fg = bg.glyph_fg;
-      ts.bg = bg.glyph_bg;
-      a_DrawText( bg.glyph, x, y, ts );
+      ts.fg = bg->fg;
+      ts.bg = bg->bg;
+      a_DrawText( (char*)bg->glyph, x, y, ts );
 
-      if ( has_mg && mg.glyph[0] != '\0' )
+      if ( mg->glyph[0] != '\0' )
       {
-        ts.fg = mg.glyph_fg;
-        ts.bg = mg.glyph_bg;
-        a_DrawText( mg.glyph, x, y, ts );
+        ts.fg = mg->fg;
+        ts.bg = mg->bg;
+        a_DrawText( (char*)mg->glyph, x, y, ts );
       }
 
-      if ( has_fg && fg.glyph[0] != '\0' )
+      if ( fg->glyph[0] != '\0' )
       {
-        ts.fg = fg.glyph_fg;
-        ts.bg = fg.glyph_bg;
-        a_DrawText( fg.glyph, x, y, ts );
+        ts.fg = fg->fg;
+        ts.bg = fg->bg;
+        a_DrawText( (char*)fg->glyph, x, y, ts );
       }
     }
     else if ( has_viewport )
     {
-      a_ViewportBlit( tile_set[bg.tile].img, x, y );
-      if ( has_mg ) a_ViewportBlit( tile_set[mg.tile].img, x, y );
-      if ( has_fg ) a_ViewportBlit( tile_set[fg.tile].img, x, y );
+      if ( has_bg ) a_ViewportBlit( tile_set[bg->sprite].img, x, y );
+      if ( has_mg ) a_ViewportBlit( tile_set[mg->sprite].img, x, y );
+      if ( has_fg ) a_ViewportBlit( tile_set[fg->sprite].img, x, y );
     }
     else
     {
-      a_Blit( tile_set[bg.tile].img, x, y );
-      if ( has_mg ) a_Blit( tile_set[mg.tile].img, x, y );
-      if ( has_fg ) a_Blit( tile_set[fg.tile].img, x, y );
+      if ( has_bg ) a_Blit( tile_set[bg->sprite].img, x, y );
+      if ( has_mg ) a_Blit( tile_set[mg->sprite].img, x, y );
+      if ( has_fg ) a_Blit( tile_set[fg->sprite].img, x, y );
     }
   }
 }
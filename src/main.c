@@ -9,9 +9,14 @@
 #include <Archimedes.h>
 #include <Daedalus.h>
 #include "defines.h"
+#include "asset_loader.h"
+#include "worker_pool.h"
+#include "res_pack.h"
+#include "hot_reload.h"
 #include "sound_manager.h"
 #include "persist.h"
 #include "lore.h"
+#include "tile_defs.h"
 #include "main_menu.h"
 
 Player_t player;
@@ -54,7 +59,9 @@ int main( void )
   dLogger_t* logger = d_CreateLogger( log_cfg );
   d_SetGlobalLogger( logger );
 
-  SoundManagerInit();
+  ResPackOpen( RES_PACK_PATH );
+  AssetLoaderInit();
+  WorkerPoolInit();
   PersistInit();
 
   /* Load persisted settings */
@@ -70,6 +77,7 @@ int main( void )
     SoundManagerSetSfxVolume( settings.sfx_vol );
   }
 
+  TileDefsLoad( TILE_DEFS_PATH );
   LoreLoadDefinitions();
   LoreLoadSave();
   MainMenuInit();
@@ -84,6 +92,10 @@ int main( void )
     }
   #endif
   
+  HotReloadQuit();
+  WorkerPoolQuit();
+  AssetLoaderQuit();
+  ResPackClose();
   a_Quit();
 
   return 0;
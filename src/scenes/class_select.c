@@ -10,6 +10,10 @@
 #include "game_scene.h"
 #include "main_menu.h"
 #include "dungeon.h"
+#include "widget_bind.h"
+#include "loading_scene.h"
+#include "sprite_atlas.h"
+#include "sound_bank.h"
 
 static void cs_Logic( float );
 static void cs_Draw( float );
@@ -64,8 +68,8 @@ static int browsing_items = 0;
 static FilteredItem_t filtered[MAX_CONSUMABLES + MAX_DOORS];
 static int num_filtered = 0;
 
-static aSoundEffect_t sfx_hover;
-static aSoundEffect_t sfx_click;
+static aSoundEffect_t* sfx_hover = NULL;
+static aSoundEffect_t* sfx_click = NULL;
 static int back_hovered = 0;
 static int embark_hovered = 0;
 static int pending_class = -1;   /* set when embark triggers outro */
@@ -96,21 +100,28 @@ static void cs_RebuildFiltered( void )
   browsing_items = 1;
 }
 
+/* After the next scene's Init, so the sounds it shares stay loaded */
+static void cs_ReleaseSounds( void )
+{
+  SoundBankRelease( &sfx_hover );
+  SoundBankRelease( &sfx_click );
+}
+
 static void cs_SelectClass( int index )
 {
   PlayerFullReset( index );
   EquipStarterGear( g_class_keys[index] );
-  PlayerInitStats();
   PlayerRecalcStats();
 
   g_current_floor = 1;
-  a_WidgetCacheFree();
+  WidgetBindFree();
   GameSceneInit();
+  cs_ReleaseSounds();
 }
 
 static void cs_BindActions( void )
 {
-  aContainerWidget_t* class_container = a_GetContainerFromWidget( "class_select" );
+  aContainerWidget_t* class_container = WidgetBindContainer( WB_CLASS_SELECT );
   for ( int i = 0; i < class_container->num_components; i++ )
   {
     aWidget_t* current = &class_container->components[i];
@@ -141,12 +152,14 @@ void ClassSelectInit( void )
   back_hovered = 0;
   ItemsLoadAll();
 
-  a_AudioLoadSound( "resources/soundeffects/menu_move.wav", &sfx_hover );
-  a_AudioLoadSound( "resources/soundeffects/menu_click.wav", &sfx_click );
+  SoundBankAcquire( &sfx_hover, "resources/soundeffects/menu_move.wav" );
+  SoundBankAcquire( &sfx_click, "resources/soundeffects/menu_click.wav" );
 
-  a_WidgetsInit( "resources/widgets/class_select.auf" );
-  app.active_widget = a_GetWidget( "class_select" );
+  WidgetBindLoad( WB_LAYOUT_CLASS_SELECT );
+  app.active_widget = WidgetBindWidget( WB_CLASS_SELECT );
   cs_BindActions();
+
+  LoadingSceneBegin( "Loading", NULL );
 }
 
 static void cs_Logic( float dt )
@@ -181,22 +194,23 @@ static void cs_Logic( float dt )
   if ( app.keyboard[SDL_SCANCODE_ESCAPE] == 1 )
   {
     app.keyboard[SDL_SCANCODE_ESCAPE] = 0;
-    a_WidgetCacheFree();
+    WidgetBindFree();
     MainMenuInit();
+    cs_ReleaseSounds();
     return;
   }
 
   if ( app.keyboard[A_R] == 1 )
   {
     app.keyboard[A_R] = 0;
-    a_WidgetsInit( "resources/widgets/class_select.auf" );
+    WidgetBindReload();
     cs_BindActions();
   }
 
   /* Detect class change from hover and rebuild filtered items */
   {
     int idx = -1;
-    aContainerWidget_t* cc = a_GetContainerFromWidget( "class_select" );
+    aContainerWidget_t* cc = WidgetBindContainer( WB_CLASS_SELECT );
     for ( int i = 0; i < cc->num_components; i++ )
     {
       if ( cc->components[i].state == WI_HOVERING )
@@ -225,14 +239,14 @@ static void cs_Logic( float dt )
       app.keyboard[A_S] = 0;
       app.keyboard[A_DOWN] = 0;
       selected_item = ( selected_item + 1 ) % num_filtered;
-      a_AudioPlaySound( &sfx_hover, NULL );
+      SoundBankPlay( sfx_hover, NULL );
     }
     if ( app.keyboard[A_W] == 1 || app.keyboard[A_UP] == 1 )
     {
       app.keyboard[A_W] = 0;
       app.keyboard[A_UP] = 0;
       selected_item = ( selected_item - 1 + num_filtered ) % num_filtered;
-      a_AudioPlaySound( &sfx_hover, NULL );
+      SoundBankPlay( sfx_hover, NULL );
     }
   }
 
@@ -244,7 +258,7 @@ static void cs_Logic( float dt )
 
     /* Check consumables panel */
     {
-      aContainerWidget_t* cpanel = a_GetContainerFromWidget( "consumables_panel" );
+      aContainerWidget_t* cpanel = WidgetBindContainer( WB_CONSUMABLES_PANEL );
       aRectf_t cr = cpanel->rect;
       float title_h = SECTION_TITLE_H + LIST_TITLE_GAP;
       float cy_start = cr.y + title_h + LIST_PAD_Y;
@@ -261,7 +275,7 @@ static void cs_Logic( float dt )
             if ( selected_item != fi || !browsing_items )
             {
               if ( selected_item != fi )
-                a_AudioPlaySound( &sfx_hover, NULL );
+                SoundBankPlay( sfx_hover, NULL );
               selected_item = fi;
               browsing_items = 1;
             }
@@ -274,7 +288,7 @@ static void cs_Logic( float dt )
 
     /* Check trinkets panel */
     {
-      aContainerWidget_t* dpanel = a_GetContainerFromWidget( "doors_panel" );
+      aContainerWidget_t* dpanel = WidgetBindContainer( WB_DOORS_PANEL );
       aRectf_t dr = dpanel->rect;
       float title_h = SECTION_TITLE_H + LIST_TITLE_GAP;
       float dy_start = dr.y + title_h + LIST_PAD_Y;
@@ -291,7 +305,7 @@ static void cs_Logic( float dt )
             if ( selected_item != fi || !browsing_items )
             {
               if ( selected_item != fi )
-                a_AudioPlaySound( &sfx_hover, NULL );
+                SoundBankPlay( sfx_hover, NULL );
               selected_item = fi;
               browsing_items = 1;
             }
@@ -306,8 +320,8 @@ static void cs_Logic( float dt )
   /* Compute shared button anchor - below the taller item panel */
   float panel_bot;
   {
-    aContainerWidget_t* cp = a_GetContainerFromWidget( "consumables_panel" );
-    aContainerWidget_t* dp = a_GetContainerFromWidget( "doors_panel" );
+    aContainerWidget_t* cp = WidgetBindContainer( WB_CONSUMABLES_PANEL );
+    aContainerWidget_t* dp = WidgetBindContainer( WB_DOORS_PANEL );
     float cp_bot = cp->rect.y + cp->rect.h;
     float dp_bot = dp->rect.y + dp->rect.h;
     panel_bot = cp_bot > dp_bot ? cp_bot : dp_bot;
@@ -316,19 +330,19 @@ static void cs_Logic( float dt )
   /* Programmatic embark button - mouse hover + click */
   if ( last_class_idx >= 0 )
   {
-    aContainerWidget_t* cs = a_GetContainerFromWidget( "class_select" );
+    aContainerWidget_t* cs = WidgetBindContainer( WB_CLASS_SELECT );
     float ex = cs->rect.x + ( cs->rect.w - EMBARK_W ) / 2.0f;
     float ey = panel_bot + 30.0f;
 
     int hovering = PointInRect( app.mouse.x, app.mouse.y, ex, ey, EMBARK_W, EMBARK_H );
 
     if ( hovering && !embark_hovered )
-      a_AudioPlaySound( &sfx_hover, NULL );
+      SoundBankPlay( sfx_hover, NULL );
     embark_hovered = hovering;
 
     if ( hovering && app.mouse.pressed && app.mouse.button == SDL_BUTTON_LEFT )
     {
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
       pending_class = last_class_idx;
       SoundManagerCrossfadeToGame();
       TransitionOutroStart();
@@ -340,7 +354,7 @@ static void cs_Logic( float dt )
     {
       app.keyboard[SDL_SCANCODE_RETURN] = 0;
       app.keyboard[SDL_SCANCODE_SPACE] = 0;
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
       pending_class = last_class_idx;
       SoundManagerCrossfadeToGame();
       TransitionOutroStart();
@@ -350,21 +364,22 @@ static void cs_Logic( float dt )
 
   /* Programmatic back button - below embark */
   {
-    aContainerWidget_t* cs = a_GetContainerFromWidget( "class_select" );
+    aContainerWidget_t* cs = WidgetBindContainer( WB_CLASS_SELECT );
     float bx = cs->rect.x + ( cs->rect.w - BACK_W ) / 2.0f;
     float by = panel_bot + 30.0f + EMBARK_H + 30.0f;
 
     int hovering = PointInRect( app.mouse.x, app.mouse.y, bx, by, BACK_W, BACK_H );
 
     if ( hovering && !back_hovered )
-      a_AudioPlaySound( &sfx_hover, NULL );
+      SoundBankPlay( sfx_hover, NULL );
     back_hovered = hovering;
 
     if ( hovering && app.mouse.pressed && app.mouse.button == SDL_BUTTON_LEFT )
     {
-      a_AudioPlaySound( &sfx_click, NULL );
-      a_WidgetCacheFree();
+      SoundBankPlay( sfx_click, NULL );
+      WidgetBindFree();
       MainMenuInit();
+      cs_ReleaseSounds();
       return;
     }
   }
@@ -388,13 +403,13 @@ static void cs_Draw( float dt )
     aColor_t panel_bg = (aColor_t){ 0x09, 0x0a, 0x14, (int)( 200 * panel_a ) };
     aColor_t panel_fg = (aColor_t){ 0xc7, 0xcf, 0xcc, (int)( 255 * panel_a ) };
 
-    aContainerWidget_t* cp = a_GetContainerFromWidget( "consumables_panel" );
+    aContainerWidget_t* cp = WidgetBindContainer( WB_CONSUMABLES_PANEL );
     float cp_th = SECTION_TITLE_H + LIST_TITLE_GAP;
     float cp_h = cp_th + LIST_PAD_Y + nc * ( LIST_ITEM_SIZE + LIST_ROW_SPACING ) + LIST_PAD_Y;
     a_DrawFilledRect( (aRectf_t){ cp->rect.x, cp->rect.y, cp->rect.w, cp_h }, panel_bg );
     a_DrawRect( (aRectf_t){ cp->rect.x, cp->rect.y, cp->rect.w, cp_h }, panel_fg );
 
-    aContainerWidget_t* dp = a_GetContainerFromWidget( "doors_panel" );
+    aContainerWidget_t* dp = WidgetBindContainer( WB_DOORS_PANEL );
     float dp_th = SECTION_TITLE_H + LIST_TITLE_GAP;
     float dp_h = dp_th + LIST_PAD_Y + no * ( LIST_ITEM_SIZE + LIST_ROW_SPACING ) + LIST_PAD_Y;
     a_DrawFilledRect( (aRectf_t){ dp->rect.x, dp->rect.y, dp->rect.w, dp_h }, panel_bg );
@@ -425,7 +440,7 @@ static void cs_Draw( float dt )
   /* Title - draw directly */
   if ( !in_outro )
   {
-    aContainerWidget_t* tp = a_GetContainerFromWidget( "title_panel" );
+    aContainerWidget_t* tp = WidgetBindContainer( WB_TITLE_PANEL );
     aRectf_t tr = tp->rect;
     aTextStyle_t tts = a_default_text_style;
     tts.fg = (aColor_t){ 0xde, 0x9e, 0x41, 255 };
@@ -441,7 +456,7 @@ static void cs_Draw( float dt )
     /* Class info panel - draw directly */
     if ( !in_outro )
     {
-      aContainerWidget_t* ip = a_GetContainerFromWidget( "info_panel" );
+      aContainerWidget_t* ip = WidgetBindContainer( WB_INFO_PANEL );
       aRectf_t ir = ip->rect;
 
       a_DrawFilledRect( ir, (aColor_t){ 0x09, 0x0a, 0x14, 200 } );
@@ -481,7 +496,7 @@ static void cs_Draw( float dt )
 
     /* Draw character image or glyph - stays visible during outro */
     {
-      aContainerWidget_t* img_panel = a_GetContainerFromWidget( "image_panel" );
+      aContainerWidget_t* img_panel = WidgetBindContainer( WB_IMAGE_PANEL );
       aRectf_t ir = img_panel->rect;
       float portrait_size = ir.h * 1.2f;
       float gx = ir.x + ( ir.w - portrait_size ) / 2.0f;
@@ -504,7 +519,7 @@ static void cs_Draw( float dt )
         if ( TransitionGetOutroFlipped() && img && settings.gfx_mode == GFX_IMAGE )
         {
           float scale = cur_size / img->rect.w;
-          a_BlitRectFlipped( img, NULL,
+          a_BlitRectFlipped( img, AtlasSrc( img ),
                              &(aRectf_t){ cur_x, cur_y, img->rect.w, img->rect.h },
                              scale, 'x' );
         }
@@ -538,7 +553,7 @@ static void cs_Draw( float dt )
 
       if ( trinket )
       {
-        aContainerWidget_t* gp = a_GetContainerFromWidget( "gear_panel" );
+        aContainerWidget_t* gp = WidgetBindContainer( WB_GEAR_PANEL );
         aRectf_t gr = gp->rect;
 
         a_DrawFilledRect( gr, (aColor_t){ 0x09, 0x0a, 0x14, 200 } );
@@ -572,7 +587,7 @@ static void cs_Draw( float dt )
 
       /* Draw consumables for the hovered class (left panel) */
       {
-        aContainerWidget_t* cpanel = a_GetContainerFromWidget( "consumables_panel" );
+        aContainerWidget_t* cpanel = WidgetBindContainer( WB_CONSUMABLES_PANEL );
         float title_h = SECTION_TITLE_H + LIST_TITLE_GAP;
 
         aRectf_t cr = cpanel->rect;
@@ -618,7 +633,7 @@ static void cs_Draw( float dt )
 
       /* Draw trinkets for the hovered class (right panel) */
       {
-        aContainerWidget_t* dpanel = a_GetContainerFromWidget( "doors_panel" );
+        aContainerWidget_t* dpanel = WidgetBindContainer( WB_DOORS_PANEL );
         float title_h = SECTION_TITLE_H + LIST_TITLE_GAP;
 
         aRectf_t dr = dpanel->rect;
@@ -665,8 +680,8 @@ static void cs_Draw( float dt )
       /* Detail modal - centered between panels, shows consumable or trinket info */
       if ( browsing_items && num_filtered > 0 && selected_item < num_filtered )
       {
-        aContainerWidget_t* cpanel = a_GetContainerFromWidget( "consumables_panel" );
-        aContainerWidget_t* dpanel = a_GetContainerFromWidget( "doors_panel" );
+        aContainerWidget_t* cpanel = WidgetBindContainer( WB_CONSUMABLES_PANEL );
+        aContainerWidget_t* dpanel = WidgetBindContainer( WB_DOORS_PANEL );
         aRectf_t cr = cpanel->rect;
         aRectf_t dr = dpanel->rect;
 
@@ -756,8 +771,8 @@ static void cs_Draw( float dt )
       /* Compute shared button anchor */
       float btn_panel_bot;
       {
-        aContainerWidget_t* cp = a_GetContainerFromWidget( "consumables_panel" );
-        aContainerWidget_t* dp = a_GetContainerFromWidget( "doors_panel" );
+        aContainerWidget_t* cp = WidgetBindContainer( WB_CONSUMABLES_PANEL );
+        aContainerWidget_t* dp = WidgetBindContainer( WB_DOORS_PANEL );
         float cp_bot = cp->rect.y + cp->rect.h;
         float dp_bot = dp->rect.y + dp->rect.h;
         btn_panel_bot = cp_bot > dp_bot ? cp_bot : dp_bot;
@@ -765,7 +780,7 @@ static void cs_Draw( float dt )
 
       /* Draw embark button - only when a class is hovered */
       {
-        aContainerWidget_t* cs = a_GetContainerFromWidget( "class_select" );
+        aContainerWidget_t* cs = WidgetBindContainer( WB_CLASS_SELECT );
         float ex = cs->rect.x + ( cs->rect.w - EMBARK_W ) / 2.0f;
         float ey = btn_panel_bot + 30.0f;
 
@@ -776,7 +791,7 @@ static void cs_Draw( float dt )
 
       /* Draw back button - below embark */
       {
-        aContainerWidget_t* cs = a_GetContainerFromWidget( "class_select" );
+        aContainerWidget_t* cs = WidgetBindContainer( WB_CLASS_SELECT );
         float bx = cs->rect.x + ( cs->rect.w - BACK_W ) / 2.0f;
         float by = btn_panel_bot + 30.0f + EMBARK_H + 30.0f;
 
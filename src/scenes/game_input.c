@@ -21,7 +21,9 @@
 #include "dungeon.h"
 #include "dev_mode.h"
 #include "interactive_tile.h"
-#include "pathfinding.h"
+#include "room_graph.h"
+#include "widget_bind.h"
+#include "turn_scheduler.h"
 
 extern Player_t player;
 
@@ -114,7 +116,7 @@ void GameInputInventory( void )
   if ( app.keyboard[A_R] == 1 )
   {
     app.keyboard[A_R] = 0;
-    a_WidgetsInit( "resources/widgets/game_scene.auf" );
+    WidgetBindReload();
   }
 
   InventoryUILogic( mouse_moved );
@@ -143,10 +145,13 @@ int GameInputTargetMode( void )
     int res = GameEventResolveTarget( ci, si, tr, tc, gi_enemies, *gi_num_enemies );
     if ( res == 1 )
     {
-      GameTurnsSetEnemyDelay( 0.2f );
+      GameTurnsSetEnemyDelay( TurnPhaseTime( TURN_PHASE_DELAY ) );
       PlayerTickTurnsSinceHit();
-      for ( int i = 0; i < *gi_num_enemies; i++ )
-        if ( gi_enemies[i].alive ) gi_enemies[i].turns_since_hit++;
+      int num_live;
+      const int16_t* live = EnemiesLive( gi_enemies, *gi_num_enemies,
+                                         &num_live );
+      for ( int k = 0; k < num_live; k++ )
+        if ( gi_enemies[live[k]].alive ) gi_enemies[live[k]].turns_since_hit++;
     }
   }
 
@@ -217,8 +222,7 @@ void GameInputAutoMove( void )
   }
 
   /* Wait for player to be idle */
-  if ( PlayerIsMoving() || EnemiesTurning() || InventoryUIFocused()
-       || GameTurnsEnemyDelay() > 0 )
+  if ( PlayerIsMoving() || GameTurnsBusy() || InventoryUIFocused() )
     return;
 
   /* Check next step is still walkable and unoccupied */
@@ -252,8 +256,7 @@ void GameInputAutoMove( void )
 
 void GameInputMovement( void )
 {
-  if ( PlayerIsMoving() || EnemiesTurning() || InventoryUIFocused()
-       || GameTurnsEnemyDelay() > 0 )
+  if ( PlayerIsMoving() || GameTurnsBusy() || InventoryUIFocused() )
     return;
 
   /* Rooted — can attack adjacent enemies but can't move */
@@ -452,7 +455,7 @@ void GameInputMovement( void )
 
 void GameInputMouse( void )
 {
-  aContainerWidget_t* vp = a_GetContainerFromWidget( "game_viewport" );
+  aContainerWidget_t* vp = WidgetBindContainer( WB_GAME_VIEWPORT );
   int mx = app.mouse.x;
   int my = app.mouse.y;
   hover_row = -1;
@@ -473,8 +476,7 @@ void GameInputMouse( void )
   }
 
   if ( app.mouse.pressed && hover_row >= 0
-       && !PlayerIsMoving() && !EnemiesTurning()
-       && GameTurnsEnemyDelay() <= 0 )
+       && !PlayerIsMoving() && !GameTurnsBusy() )
   {
     int fpr, fpc;
     GameTurnsGetPlayerTile( &fpr, &fpc );
@@ -527,7 +529,7 @@ void GameInputZoom( void )
 {
   if ( app.mouse.wheel == 0 ) return;
 
-  aContainerWidget_t* cp = a_GetContainerFromWidget( "console_panel" );
+  aContainerWidget_t* cp = WidgetBindContainer( WB_CONSOLE_PANEL );
   if ( PointInRect( app.mouse.x, app.mouse.y,
                     cp->rect.x, cp->rect.y, cp->rect.w, cp->rect.h ) )
   {
@@ -546,9 +548,8 @@ void GameInputStartAutoPath( int goal_r, int goal_c )
   if ( player.root_turns > 0 ) return;
   int fpr, fpc;
   GameTurnsGetPlayerTile( &fpr, &fpc );
-  int len = PathfindAStar( fpr, fpc, goal_r, goal_c,
-                           gi_world->width, gi_world->height,
-                           player_path_blocked, NULL, auto_path );
+  int len = RoomGraphPath( fpr, fpc, goal_r, goal_c,
+                           player_path_blocked, NULL, NULL, auto_path );
   if ( len >= 2 )
   {
     auto_path_len  = len;
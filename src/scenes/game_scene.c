@@ -1,4 +1,6 @@
 #include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <Archimedes.h>
 
 #include "defines.h"
@@ -27,6 +29,8 @@
 #include "ground_items.h"
 #include "items.h"
 #include "dungeon.h"
+#include "doors.h"
+#include "interactive_tile.h"
 #include "quest_tracker.h"
 #include "objects.h"
 #include "maps.h"
@@ -40,6 +44,7 @@
 #include "game_over.h"
 #include "victory.h"
 #include "room_enumerator.h"
+#include "room_index.h"
 #include "game_camera.h"
 #include "game_turns.h"
 #include "game_input.h"
@@ -49,6 +54,10 @@
 #include "bank.h"
 #include "lore.h"
 #include "dungeon_spawner.h"
+#include "widget_bind.h"
+#include "loading_scene.h"
+#include "sound_bank.h"
+#include "hot_reload.h"
 
 static void gs_Logic( float );
 static void gs_Draw( float );
@@ -62,8 +71,8 @@ static aTileset_t*  tileset = NULL;
 static World_t*     world   = NULL;
 static GameCamera_t camera;
 
-static aSoundEffect_t sfx_move;
-static aSoundEffect_t sfx_click;
+static aSoundEffect_t* sfx_move = NULL;
+static aSoundEffect_t* sfx_click = NULL;
 
 static Console_t console;
 
@@ -99,6 +108,46 @@ static int          num_ground_items = 0;
 #define HINT_FADE      0.4f
 #define HINT_DURATION  2.5f
 
+static void gs_ReloadMap( const char* path )
+{
+  DungeonReloadMap( world, path );
+  RoomIndexRebuild();
+}
+
+static void gs_ReloadTiles( const char* path )
+{
+  TileDefsLoad( path );
+  WorldRefreshGrids( world );
+}
+
+/* Back to the menu. It takes its own click sounds first, so those stay
+   loaded; everything only the dungeon plays is dropped. A new floor
+   re-runs GameSceneInit without leaving and keeps them all. */
+static void gs_Leave( void )
+{
+  WidgetBindFree();
+  MainMenuInit();
+
+  SoundBankRelease( &sfx_move );
+  SoundBankRelease( &sfx_click );
+  GameTurnsReleaseSounds();
+  DoorsReleaseSounds();
+  CombatReleaseSounds();
+  GameEventsReleaseSounds();
+  ITileReleaseSounds();
+  MovementReleaseSounds();
+  PauseMenuReleaseSounds();
+  ItemsReleaseSounds();
+  SoundManagerReleaseGame();
+}
+
+/* Runs once the floor's assets are in */
+static void gs_Ready( void )
+{
+  SoundManagerPlayGame();
+  TransitionIntroStart();
+}
+
 void GameSceneInit( void )
 {
   app.delegate.logic = gs_Logic;
@@ -106,34 +155,38 @@ void GameSceneInit( void )
 
   app.options.scale_factor = 1;
 
-  a_WidgetsInit( "resources/widgets/game_scene.auf" );
-  app.active_widget = a_GetWidget( "inv_panel" );
+  WidgetBindLoad( WB_LAYOUT_GAME );
+  app.active_widget = WidgetBindWidget( WB_INV_PANEL );
 
   /* ---- Free previous run (prevents leak on menu→play→menu→play) ---- */
   if ( world ) { WorldFree( world ); world = NULL; }
 
   /* ---- Build dungeon ---- */
   tileset = a_TilesetCreate( "resources/assets/tiles/level01tilemap.png", 16, 16 );
-  world   = WorldCreate( DUNGEON_W, DUNGEON_H, 16, 16 );
   ConsoleInit( &console );
   ObjectsInit( &console );
-  DungeonBuild( world );
-  DungeonPlayerStart( &player.world_x, &player.world_y );
+  world   = DungeonBuild( 16, 16 );
+  if ( !world )
+  {
+    fprintf( stderr, "FATAL: could not build floor %d\n", g_current_floor );
+    exit( 1 );
+  }
+  DungeonPlayerStart( world, &player.world_x, &player.world_y );
 
   /* Initialize game camera centered on player */
   camera = (GameCamera_t){ player.world_x, player.world_y, 64.0f };
   app.g_viewport = (aRectf_t){ 0, 0, 0, 0 };
   GameCameraInit( &camera );
 
-  a_AudioLoadSound( "resources/soundeffects/menu_move.wav", &sfx_move );
-  a_AudioLoadSound( "resources/soundeffects/menu_click.wav", &sfx_click );
+  SoundBankAcquire( &sfx_move, "resources/soundeffects/menu_move.wav" );
+  SoundBankAcquire( &sfx_click, "resources/soundeffects/menu_click.wav" );
 
   /* Init subsystems */
   MovementInit( world );
-  TileActionsInit( world, &camera, &console, &sfx_move, &sfx_click );
-  LookModeInit( world, &console, &sfx_move, &sfx_click );
-  TargetModeInit( world, &console, &camera, &sfx_move, &sfx_click );
-  InventoryUIInit( &sfx_move, &sfx_click );
+  TileActionsInit( world, &camera, &console, sfx_move, sfx_click );
+  LookModeInit( world, &console, sfx_move, sfx_click );
+  TargetModeInit( world, &console, &camera, sfx_move, sfx_click );
+  InventoryUIInit( sfx_move, sfx_click );
   InventoryUISetGroundItems( ground_items, &num_ground_items,
                              world->tile_w, world->tile_h );
 
@@ -162,22 +215,23 @@ void GameSceneInit( void )
   /* Restore persistent lore discoveries as per-run flags */
   if ( LoreIsDiscovered( "shop_rats" ) )  FlagSet( "knows_shop_rats", 1 );
   BankInit( &console );
+  QuestTrackerInit();
   DialogueLoadAll();
   EnemiesSetNPCs( npcs, &num_npcs );
   NPCsInit( npcs, &num_npcs );
-  DialogueUIInit( &sfx_move, &sfx_click );
+  DialogueUIInit( sfx_move, sfx_click );
 
   /* Ground items */
   GroundItemsInit( ground_items, &num_ground_items );
 
   /* Shop */
-  if ( g_current_floor >= 3 )
-    ShopLoadPool( "resources/data/shops/floor_03_shop.duf" );
-  else if ( g_current_floor == 2 )
-    ShopLoadPool( "resources/data/shops/floor_02_shop.duf" );
-  else
-    ShopLoadPool( "resources/data/shops/floor_01_shop.duf" );
-  ShopUIInit( &sfx_move, &sfx_click, &console );
+  const char* shop_path = ( g_current_floor >= 3 )
+    ? "resources/data/shops/floor_03_shop.duf"
+    : ( g_current_floor == 2 )
+    ? "resources/data/shops/floor_02_shop.duf"
+    : "resources/data/shops/floor_01_shop.duf";
+  ShopLoadPool( shop_path );
+  ShopUIInit( sfx_move, sfx_click, &console );
 
   /* Poison pools */
   PoisonPoolInit( &console );
@@ -189,6 +243,8 @@ void GameSceneInit( void )
   SpellVFXInit( world );
 
   /* Spawn all dungeon entities (items, NPCs, enemies) */
+  RoomIndexSetLists( enemies, &num_enemies, npcs, &num_npcs,
+                     ground_items, &num_ground_items );
   DungeonSpawn( npcs, &num_npcs, enemies, &num_enemies,
                 ground_items, &num_ground_items, world );
   FloorCutsceneRegister( npcs, num_npcs, enemies, num_enemies );
@@ -198,7 +254,7 @@ void GameSceneInit( void )
 
   DungeonHandlerInit( world );
 
-  GameTurnsInit( &console, &sfx_click, enemies, &num_enemies,
+  GameTurnsInit( &console, sfx_click, enemies, &num_enemies,
                  npcs, &num_npcs, ground_items, &num_ground_items, world );
   GameInputInit( world, &camera, &console,
                  enemies, &num_enemies, npcs, &num_npcs );
@@ -206,10 +262,22 @@ void GameSceneInit( void )
   DevModeSetNPCs( npcs, &num_npcs );
   NPCRelocateInit( npcs, &num_npcs );
 
+  /* Dev builds: edited content is patched into the running floor */
+  HotReloadBegin( &console );
+  HotReloadWatchDir( "resources/data/enemies", ".duf", EnemiesReloadFile );
+  HotReloadWatchDir( "resources/data/npcs", ".duf", DialogueReloadFile );
+  HotReloadWatchFile( "resources/data/consumables.duf", ItemsReloadFile );
+  HotReloadWatchFile( shop_path, ShopLoadPool );
+  HotReloadWatchFile( DungeonRoomsPath(), RoomLoadData );
+  HotReloadWatchFile( DungeonMapPath(), gs_ReloadMap );
+  HotReloadWatchFile( TILE_DEFS_PATH, gs_ReloadTiles );
+
   GameOverReset();
   VictoryReset();
-  SoundManagerPlayGame();
-  TransitionIntroStart();
+
+  /* New floor sprites and the ambience decode behind a progress bar */
+  SoundManagerPrefetchGame();
+  LoadingSceneBegin( "Descending", gs_Ready );
 }
 
 /* ===== Main logic loop ===== */
@@ -235,7 +303,7 @@ static void gs_Logic( float dt )
   if ( VictoryActive() )
   {
     int r = VictoryLogic( dt );
-    if ( r == 2 ) { a_WidgetCacheFree(); MainMenuInit(); return; }
+    if ( r == 2 ) { gs_Leave(); return; }
     GameCameraFollow();
     return;
   }
@@ -245,7 +313,7 @@ static void gs_Logic( float dt )
   if ( GameOverActive() )
   {
     int r = GameOverLogic( dt );
-    if ( r == 2 ) { a_WidgetCacheFree(); MainMenuInit(); return; }
+    if ( r == 2 ) { gs_Leave(); return; }
     GameCameraFollow();
     return;
   }
@@ -253,7 +321,7 @@ static void gs_Logic( float dt )
   if ( PauseMenuActive() )
   {
     int r = PauseMenuLogic();
-    if ( r == 2 ) { a_WidgetCacheFree(); MainMenuInit(); return; }
+    if ( r == 2 ) { gs_Leave(); return; }
     GameCameraFollow();
     return;
   }
@@ -262,8 +330,7 @@ static void gs_Logic( float dt )
   if ( !DialogueActive() && FlagGet( "stair_leave" ) )
   {
     FlagClear( "stair_leave" );
-    a_WidgetCacheFree();
-    MainMenuInit();
+    gs_Leave();
     return;
   }
 
@@ -289,11 +356,12 @@ static void gs_Logic( float dt )
     g_current_floor++;
     PlayerResetFirstStrike();
     player.fs_visited = 0;
-    a_WidgetCacheFree();
+    WidgetBindFree();
     GameSceneInit();
     return;
   }
 
+  HotReloadPoll();
   if ( DevModeInput() )                { GameCameraFollow(); return; }
   if ( GameInputOverlays() )          { GameCameraFollow(); return; }
   if ( GameInputEsc() )               return;
@@ -323,7 +391,7 @@ static void gs_Draw( float dt )
 
   /* Game viewport - shrink 1px on right so it doesn't overlap right panels */
   {
-    aContainerWidget_t* vp = a_GetContainerFromWidget( "game_viewport" );
+    aContainerWidget_t* vp = WidgetBindContainer( WB_GAME_VIEWPORT );
     aRectf_t vr = { vp->rect.x, vp->rect.y, vp->rect.w - 1, vp->rect.h };
     float va = TransitionGetViewportAlpha();
     a_DrawFilledRect( vr, (aColor_t){ 0, 0, 0, (int)( 255 * va ) } );
@@ -332,7 +400,7 @@ static void gs_Draw( float dt )
 
   /* Inventory panel background */
   {
-    aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+    aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
     aRectf_t ir = ip->rect;
     ir.x += TransitionGetRightOX();
     a_DrawFilledRect( ir, PANEL_BG );
@@ -340,7 +408,7 @@ static void gs_Draw( float dt )
 
   /* Equipment panel background */
   {
-    aContainerWidget_t* kp = a_GetContainerFromWidget( "key_panel" );
+    aContainerWidget_t* kp = WidgetBindContainer( WB_KEY_PANEL );
     aRectf_t kr = kp->rect;
     kr.x += TransitionGetRightOX();
     a_DrawFilledRect( kr, PANEL_BG );
@@ -349,7 +417,7 @@ static void gs_Draw( float dt )
   /* Console panel (dialogue/shop UI drawn later, on top of viewport) */
   if ( !DialogueActive() && !ShopUIActive() )
   {
-    aContainerWidget_t* cp = a_GetContainerFromWidget( "console_panel" );
+    aContainerWidget_t* cp = WidgetBindContainer( WB_CONSOLE_PANEL );
     aRectf_t cr = cp->rect;
     cr.y += TransitionGetConsoleOY();
     aColor_t con_bg = PANEL_BG;
@@ -363,7 +431,7 @@ static void gs_Draw( float dt )
 
   /* World + Player - clipped to game_viewport panel */
   {
-    aContainerWidget_t* vp = a_GetContainerFromWidget( "game_viewport" );
+    aContainerWidget_t* vp = WidgetBindContainer( WB_GAME_VIEWPORT );
     aRectf_t clip = { vp->rect.x + 1, vp->rect.y + 1, vp->rect.w - 3, vp->rect.h - 2 };
     a_SetClipRect( clip );
 
@@ -502,14 +570,14 @@ static void gs_Draw( float dt )
   /* Dialogue UI - drawn on top of viewport */
   if ( DialogueActive() )
   {
-    aContainerWidget_t* cp = a_GetContainerFromWidget( "console_panel" );
+    aContainerWidget_t* cp = WidgetBindContainer( WB_CONSOLE_PANEL );
     aRectf_t cr = cp->rect;
     cr.y += TransitionGetConsoleOY();
     DialogueUIDraw( cr );
   }
   else if ( ShopUIActive() )
   {
-    aContainerWidget_t* cp = a_GetContainerFromWidget( "console_panel" );
+    aContainerWidget_t* cp = WidgetBindContainer( WB_CONSOLE_PANEL );
     aRectf_t cr = cp->rect;
     cr.y += TransitionGetConsoleOY();
     ShopUIDraw( cr );
@@ -538,7 +606,7 @@ static void gs_Draw( float dt )
       alpha = ht / HINT_FADE;
 
     /* Locate first inventory slot (replicate grid math from inventory_ui) */
-    aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+    aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
     aRectf_t ir = ip->rect;
     ir.x += TransitionGetRightOX();
 
@@ -601,7 +669,7 @@ static void gs_Draw( float dt )
       float alpha = 1.0f;
       if ( st < HINT_FADE ) alpha = st / HINT_FADE;
 
-      aContainerWidget_t* cp = a_GetContainerFromWidget( "console_panel" );
+      aContainerWidget_t* cp = WidgetBindContainer( WB_CONSOLE_PANEL );
       aRectf_t cr = cp->rect;
       cr.y += TransitionGetConsoleOY();
 
@@ -623,7 +691,7 @@ static void gs_Draw( float dt )
       float alpha = 1.0f;
       if ( et < HINT_FADE ) alpha = et / HINT_FADE;
 
-      aContainerWidget_t* ip = a_GetContainerFromWidget( "inv_panel" );
+      aContainerWidget_t* ip = WidgetBindContainer( WB_INV_PANEL );
       aRectf_t ir = ip->rect;
       ir.x += TransitionGetRightOX();
 
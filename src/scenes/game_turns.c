@@ -17,15 +17,18 @@
 #include "poison_pool.h"
 #include "spell_vfx.h"
 #include "room_enumerator.h"
+#include "room_index.h"
 #include "dialogue.h"
 #include "interactive_tile.h"
 #include "placed_traps.h"
+#include "sound_bank.h"
+#include "turn_scheduler.h"
 
 extern Player_t player;
 
 static Console_t*      gt_console;
 static aSoundEffect_t* gt_sfx_click;
-static aSoundEffect_t  gt_sfx_powerup;
+static aSoundEffect_t* gt_sfx_powerup = NULL;
 static Enemy_t*        gt_enemies;
 static int*            gt_num_enemies;
 static NPC_t*          gt_npcs;
@@ -57,6 +60,51 @@ static int   turn_count = 0;
 static int   inv_expand_hint_shown = 0;
 static float inv_expand_hint_timer = 0.0f;
 
+/* Turn systems - the scheduler calls these in registration order */
+static void gt_PoisonPools( void ) { PoisonPoolTick( frame_pr, frame_pc ); }
+static void gt_NPCsIdle( void )    { NPCsIdleTick( gt_npcs, *gt_num_npcs, gt_console ); }
+
+static void gt_SkipHint( void )
+{
+  turn_count++;
+  if ( turn_count == 5 && !skip_hint_shown )
+  {
+    skip_hint_shown = 1;
+    skip_hint_timer = HINT_DURATION;
+  }
+}
+
+/* Whatever died last turn gives up its slot here, before anything new
+   can spawn into it */
+static void gt_Collect( void )
+{
+  EnemiesCollect( gt_enemies, gt_num_enemies );
+  NPCsCollect( gt_npcs, gt_num_npcs );
+  GroundItemsCollect( gt_items, gt_num_items );
+}
+
+static void gt_EnemiesSinceHit( void )
+{
+  int num_live;
+  const int16_t* live = EnemiesLive( gt_enemies, *gt_num_enemies, &num_live );
+  for ( int k = 0; k < num_live; k++ )
+    if ( gt_enemies[live[k]].alive ) gt_enemies[live[k]].turns_since_hit++;
+}
+
+static void gt_RegisterSystems( void )
+{
+  TurnSystemsClear();
+  TurnSystemRegister( TURN_STAGE_WORLD, "poison_pools",     gt_PoisonPools );
+  TurnSystemRegister( TURN_STAGE_WORLD, "itiles",           ITileTick );
+  TurnSystemRegister( TURN_STAGE_WORLD, "game_events",      GameEventsNewTurn );
+  TurnSystemRegister( TURN_STAGE_WORLD, "player_since_hit", PlayerTickTurnsSinceHit );
+  TurnSystemRegister( TURN_STAGE_WORLD, "companion",        CombatCompanionTick );
+  TurnSystemRegister( TURN_STAGE_WORLD, "skip_hint",        gt_SkipHint );
+  TurnSystemRegister( TURN_STAGE_WORLD, "collect",          gt_Collect );
+  TurnSystemRegister( TURN_STAGE_WORLD, "enemy_since_hit",  gt_EnemiesSinceHit );
+  TurnSystemRegister( TURN_STAGE_AFTER, "npcs_idle",        gt_NPCsIdle );
+}
+
 void GameTurnsInit( Console_t* con, aSoundEffect_t* click,
                     Enemy_t* enemies, int* num_enemies,
                     NPC_t* npcs, int* num_npcs,
@@ -65,7 +113,7 @@ void GameTurnsInit( Console_t* con, aSoundEffect_t* click,
 {
   gt_console     = con;
   gt_sfx_click   = click;
-  a_AudioLoadSound( "resources/soundeffects/powerup.wav", &gt_sfx_powerup );
+  SoundBankAcquire( &gt_sfx_powerup, "resources/soundeffects/powerup.wav" );
   gt_enemies     = enemies;
   gt_num_enemies = num_enemies;
   gt_npcs        = npcs;
@@ -82,13 +130,20 @@ void GameTurnsInit( Console_t* con, aSoundEffect_t* click,
   turn_count = 0;
   inv_expand_hint_shown = 0;
   inv_expand_hint_timer = 0.0f;
+  gt_RegisterSystems();
+}
+
+/* The click belongs to the game scene - only the powerup is ours */
+void GameTurnsReleaseSounds( void )
+{
+  SoundBankRelease( &gt_sfx_powerup );
+  gt_sfx_click = NULL;
 }
 
 void GameTurnsUpdateSystems( float dt )
 {
   MovementUpdate( dt );
   EnemiesUpdate( dt );
-  NPCsUpdate( dt );
   EnemyProjectileUpdate( dt );
   CombatUpdate( dt );
   CombatVFXUpdate( dt );
@@ -132,7 +187,8 @@ void GameTurnsHandleTurnEnd( float dt, int turn_skipped )
               if ( slot >= 0 )
               {
                 gi->alive = 0;
-                a_AudioPlaySound( gt_sfx_click, NULL );
+                RoomIndexItem( gi );
+                SoundBankPlay( gt_sfx_click, NULL );
                 ConsolePushF( gt_console, eq->color, "Picked up %s.", eq->name );
               }
               else
@@ -158,31 +214,33 @@ void GameTurnsHandleTurnEnd( float dt, int turn_skipped )
               icolor = g_consumables[gi->item_idx].color;
             }
 
+            ConsumableInfo_t* ci = ( inv_type == INV_CONSUMABLE )
+                                   ? &g_consumables[gi->item_idx] : NULL;
+
             /* Cave mushrooms go straight to flag counter, no inventory slot */
-            if ( inv_type == INV_CONSUMABLE
-                 && strcmp( g_consumables[gi->item_idx].key, "cave_mushroom" ) == 0 )
+            if ( ci && ci->special_id == CONS_SPECIAL_CAVE_MUSHROOM )
             {
               gi->alive = 0;
+              RoomIndexItem( gi );
               FlagIncr( "mushrooms_collected" );
-              a_AudioPlaySound( gt_sfx_click, NULL );
+              SoundBankPlay( gt_sfx_click, NULL );
               int m = FlagGet( "mushrooms_collected" );
               ConsolePushF( gt_console, icolor,
                             "Picked up %s. (%d/3)", iname, m > 3 ? 3 : m );
             }
             /* Bags and sacks — instant inventory expansion, no slot used */
-            else if ( inv_type == INV_CONSUMABLE
-                      && strcmp( g_consumables[gi->item_idx].type, "pickup" ) == 0 )
+            else if ( ci && ci->type_id == CONS_TYPE_PICKUP )
             {
-              const char* ckey = g_consumables[gi->item_idx].key;
               int expand = 0;
-              if ( strcmp( ckey, "bag" ) == 0 )       expand = 1;
-              else if ( strcmp( ckey, "sack" ) == 0 ) expand = 2;
+              if ( ci->special_id == CONS_SPECIAL_BAG )       expand = 1;
+              else if ( ci->special_id == CONS_SPECIAL_SACK ) expand = 2;
 
               if ( expand > 0 && player.max_inventory + expand <= MAX_INVENTORY )
               {
                 gi->alive = 0;
+                RoomIndexItem( gi );
                 player.max_inventory += expand;
-                a_AudioPlaySound( &gt_sfx_powerup, NULL );
+                SoundBankPlay( gt_sfx_powerup, NULL );
                 ConsolePushF( gt_console, icolor,
                               "Found a %s! +%d inventory slot%s. (%d/%d)",
                               iname, expand, expand > 1 ? "s" : "",
@@ -193,13 +251,15 @@ void GameTurnsHandleTurnEnd( float dt, int turn_skipped )
                   inv_expand_hint_timer = HINT_DURATION;
                 }
               }
-              else if ( strcmp( ckey, "max_health" ) == 0 )
+              else if ( ci->special_id == CONS_SPECIAL_MAX_HEALTH )
               {
                 gi->alive = 0;
+                RoomIndexItem( gi );
                 player.max_hp += 1;
                 player.hp    += 1;
                 player.max_health_ups += 1;
-                a_AudioPlaySound( &gt_sfx_powerup, NULL );
+                PlayerTouch();
+                SoundBankPlay( gt_sfx_powerup, NULL );
                 int m = player.max_health_ups;
                 ConsolePushF( gt_console, (aColor_t){ 50, 205, 50, 255 },
                               "Max Health +1! (%d/3)", m > 3 ? 3 : m );
@@ -214,12 +274,12 @@ void GameTurnsHandleTurnEnd( float dt, int turn_skipped )
               if ( slot >= 0 )
               {
                 gi->alive = 0;
-                a_AudioPlaySound( gt_sfx_click, NULL );
+                RoomIndexItem( gi );
+                SoundBankPlay( gt_sfx_click, NULL );
                 ConsolePushF( gt_console, icolor, "Picked up %s.", iname );
 
                 /* Quest item pickup flags */
-                if ( inv_type == INV_CONSUMABLE
-                     && strcmp( g_consumables[gi->item_idx].key, "hearthstone" ) == 0 )
+                if ( ci && ci->special_id == CONS_SPECIAL_HEARTHSTONE )
                   FlagSet( "has_relic", 1 );
 
                 if ( !hint_shown && inv_type == INV_CONSUMABLE )
@@ -275,33 +335,20 @@ void GameTurnsHandleTurnEnd( float dt, int turn_skipped )
     }
 
     /* Turn tick (skip when shop prompt just opened - browsing is free) */
-    if ( !ShopUIActive() && !EnemiesTurning() && !NPCsTurning() )
+    if ( !ShopUIActive() && !EnemiesTurning() )
     {
-      PoisonPoolTick( frame_pr, frame_pc );
-      ITileTick();
-      GameEventsNewTurn();
-      PlayerTickTurnsSinceHit();
-      CombatCompanionTick();
-      turn_count++;
-      if ( turn_count == 5 && !skip_hint_shown )
-      {
-        skip_hint_shown = 1;
-        skip_hint_timer = HINT_DURATION;
-      }
-      for ( int i = 0; i < *gt_num_enemies; i++ )
-        if ( gt_enemies[i].alive ) gt_enemies[i].turns_since_hit++;
+      TurnSystemsRun( TURN_STAGE_WORLD );
 
       if ( EnemiesInCombat( gt_enemies, *gt_num_enemies ) )
       {
-        turn.enemy_delay = 0.2f;
+        turn.enemy_delay = TurnPhaseTime( TURN_PHASE_DELAY );
       }
       else
       {
         EnemiesStartTurn( gt_enemies, *gt_num_enemies, frame_pr, frame_pc, TileWalkable );
       }
 
-      NPCsCombatTick( gt_npcs, *gt_num_npcs, gt_enemies, *gt_num_enemies );
-      NPCsIdleTick( gt_npcs, *gt_num_npcs, gt_console );
+      TurnSystemsRun( TURN_STAGE_AFTER );
     }
   }
   turn.was_moving = PlayerIsMoving();
@@ -332,6 +379,10 @@ void GameTurnsGetPlayerTile( int* r, int* c )
 
 float GameTurnsEnemyDelay( void )  { return turn.enemy_delay; }
 void  GameTurnsSetEnemyDelay( float d ) { turn.enemy_delay = d; }
+int   GameTurnsBusy( void )
+{
+  return EnemiesTurning() || turn.enemy_delay > 0;
+}
 
 float GameTurnsHintTimer( void )   { return hint_timer; }
 void  GameTurnsTickHint( float dt )
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <Archimedes.h>
+
+#include "defines.h"
+#include "asset_loader.h"
+#include "sprite_atlas.h"
+#include "loading_scene.h"
+
+static void ld_Logic( float );
+static void ld_Draw( float );
+
+#define LD_BAR_W   320.0f
+#define LD_BAR_H    12.0f
+
+static void ( *ld_scene_logic )( float );
+static void ( *ld_scene_draw )( float );
+static void ( *ld_on_done )( void );
+static char  ld_label[64];
+
+static void ld_Finish( void )
+{
+  AtlasUpload();
+
+  app.delegate.logic = ld_scene_logic;
+  app.delegate.draw  = ld_scene_draw;
+
+  if ( ld_on_done ) ld_on_done();
+}
+
+void LoadingSceneBegin( const char* label, void ( *on_done )( void ) )
+{
+  ld_scene_logic = app.delegate.logic;
+  ld_scene_draw  = app.delegate.draw;
+  ld_on_done     = on_done;
+  snprintf( ld_label, sizeof( ld_label ), "%s", label );
+
+  if ( !AssetLoaderBusy() )
+  {
+    ld_Finish();
+    return;
+  }
+
+  app.delegate.logic = ld_Logic;
+  app.delegate.draw  = ld_Draw;
+}
+
+static void ld_Logic( float dt )
+{
+  (void)dt;
+  a_DoInput();
+
+  if ( !AssetLoaderPump( ASSET_FRAME_BUDGET_MS ) )
+    ld_Finish();
+}
+
+static void ld_Draw( float dt )
+{
+  (void)dt;
+
+  float x = ( SCREEN_WIDTH - LD_BAR_W ) / 2.0f;
+  float y = SCREEN_HEIGHT / 2.0f;
+  float p = AssetLoaderProgress();
+
+  aTextStyle_t ts = a_default_text_style;
+  ts.bg    = (aColor_t){ 0, 0, 0, 0 };
+  ts.fg    = (aColor_t){ 0x81, 0x97, 0x96, 255 };
+  ts.align = TEXT_ALIGN_CENTER;
+  ts.scale = 1.0f;
+  a_DrawText( ld_label, (int)( SCREEN_WIDTH / 2.0f ), (int)( y - 28.0f ), ts );
+
+  a_DrawFilledRect( (aRectf_t){ x, y, LD_BAR_W, LD_BAR_H },
+                    (aColor_t){ 0x10, 0x14, 0x1f, 255 } );
+  a_DrawFilledRect( (aRectf_t){ x, y, LD_BAR_W * p, LD_BAR_H },
+                    (aColor_t){ 0xde, 0x9e, 0x41, 255 } );
+  a_DrawRect( (aRectf_t){ x, y, LD_BAR_W, LD_BAR_H },
+              (aColor_t){ 0x57, 0x72, 0x77, 255 } );
+}
@@ -7,6 +7,8 @@
 #include "lore.h"
 #include "lore_scene.h"
 #include "main_menu.h"
+#include "widget_bind.h"
+#include "sound_bank.h"
 
 static void ls_Logic( float );
 static void ls_Draw( float );
@@ -36,8 +38,8 @@ static int back_hovered;
 static int sidebar_hover;       /* last hovered sidebar index (-1 = none) */
 static float sidebar_scroll;    /* scroll offset in pixels */
 
-static aSoundEffect_t sfx_move;
-static aSoundEffect_t sfx_click;
+static aSoundEffect_t* sfx_move = NULL;
+static aSoundEffect_t* sfx_click = NULL;
 
 /* ---- Build sidebar items from lore data ---- */
 
@@ -135,16 +137,20 @@ void LoreSceneInit( void )
   build_sidebar();
   sidebar_cursor = sidebar_first_selectable();
 
-  a_AudioLoadSound( "resources/soundeffects/menu_move.wav", &sfx_move );
-  a_AudioLoadSound( "resources/soundeffects/menu_click.wav", &sfx_click );
+  SoundBankAcquire( &sfx_move, "resources/soundeffects/menu_move.wav" );
+  SoundBankAcquire( &sfx_click, "resources/soundeffects/menu_click.wav" );
 
-  a_WidgetsInit( "resources/widgets/lore.auf" );
+  WidgetBindLoad( WB_LAYOUT_LORE );
 }
 
 static void ls_Leave( void )
 {
-  a_WidgetCacheFree();
+  WidgetBindFree();
   MainMenuInit();
+
+  /* The menu holds these too, so they stay loaded */
+  SoundBankRelease( &sfx_move );
+  SoundBankRelease( &sfx_click );
 }
 
 static void ls_Logic( float dt )
@@ -164,7 +170,7 @@ static void ls_Logic( float dt )
   if ( app.keyboard[A_R] == 1 )
   {
     app.keyboard[A_R] = 0;
-    a_WidgetsInit( "resources/widgets/lore.auf" );
+    WidgetBindReload();
   }
 
   /* Left/Right - switch panels */
@@ -173,7 +179,7 @@ static void ls_Logic( float dt )
     app.keyboard[A_LEFT] = 0;
     app.keyboard[A_RIGHT] = 0;
     focus_panel = !focus_panel;
-    a_AudioPlaySound( &sfx_click, NULL );
+    SoundBankPlay( sfx_click, NULL );
 
     if ( focus_panel == 1 && sidebar_cursor >= 0 &&
          sidebar_cursor < num_sidebar && !sidebar[sidebar_cursor].is_header )
@@ -208,7 +214,7 @@ static void ls_Logic( float dt )
       if ( count > 0 )
         entry_cursor = ( entry_cursor - 1 + count ) % count;
     }
-    a_AudioPlaySound( &sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
 
   if ( app.keyboard[A_S] == 1 || app.keyboard[A_DOWN] == 1 )
@@ -221,7 +227,7 @@ static void ls_Logic( float dt )
       sidebar_cursor = sidebar_next_selectable( sidebar_cursor, 1 );
       entry_cursor = 0;
       /* Auto-scroll to keep cursor visible */
-      aContainerWidget_t* cc = a_GetContainerFromWidget( "lore_categories" );
+      aContainerWidget_t* cc = WidgetBindContainer( WB_LORE_CATEGORIES );
       float cy = 0;
       for ( int i = 0; i <= sidebar_cursor; i++ )
         cy += ( sidebar[i].is_header ? HEADER_H : ITEM_H ) + ITEM_SPACING;
@@ -235,7 +241,7 @@ static void ls_Logic( float dt )
       if ( count > 0 )
         entry_cursor = ( entry_cursor + 1 ) % count;
     }
-    a_AudioPlaySound( &sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
 
   /* Enter - switch to entries panel if on sidebar */
@@ -249,7 +255,7 @@ static void ls_Logic( float dt )
     {
       focus_panel = 1;
       entry_cursor = 0;
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
     }
   }
 
@@ -261,17 +267,17 @@ static void ls_Logic( float dt )
 
   /* Back button */
   {
-    aContainerWidget_t* bc = a_GetContainerFromWidget( "lore_back" );
+    aContainerWidget_t* bc = WidgetBindContainer( WB_LORE_BACK );
     aRectf_t br = bc->rect;
     int hit = PointInRect( mx, my, br.x, br.y, br.w, br.h );
 
     if ( hit && !back_hovered )
-      a_AudioPlaySound( &sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     back_hovered = hit;
 
     if ( hit && clicked )
     {
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
       ls_Leave();
       return;
     }
@@ -279,7 +285,7 @@ static void ls_Logic( float dt )
 
   /* Sidebar panel - mouse hover selects, scroll wheel */
   {
-    aContainerWidget_t* cc = a_GetContainerFromWidget( "lore_categories" );
+    aContainerWidget_t* cc = WidgetBindContainer( WB_LORE_CATEGORIES );
     aRectf_t r = cc->rect;
     int in_sidebar = PointInRect( mx, my, r.x, r.y, r.w, r.h );
 
@@ -321,7 +327,7 @@ static void ls_Logic( float dt )
       sidebar_cursor = new_hover;
       entry_cursor = 0;
       focus_panel = 0;
-      a_AudioPlaySound( &sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     }
     if ( !in_sidebar )
       sidebar_hover = -1;
@@ -331,7 +337,7 @@ static void ls_Logic( float dt )
   if ( sidebar_cursor >= 0 && sidebar_cursor < num_sidebar &&
        !sidebar[sidebar_cursor].is_header )
   {
-    aContainerWidget_t* ec = a_GetContainerFromWidget( "lore_entries" );
+    aContainerWidget_t* ec = WidgetBindContainer( WB_LORE_ENTRIES );
     aRectf_t r = ec->rect;
     SidebarItem_t* si = &sidebar[sidebar_cursor];
     int count = entries_in_floor_cat( si->floor, si->category );
@@ -347,7 +353,7 @@ static void ls_Logic( float dt )
         {
           focus_panel = 1;
           entry_cursor = i;
-          a_AudioPlaySound( &sfx_move, NULL );
+          SoundBankPlay( sfx_move, NULL );
         }
       }
     }
@@ -366,7 +372,7 @@ static void ls_Draw( float dt )
 
   /* Title */
   {
-    aContainerWidget_t* tc = a_GetContainerFromWidget( "lore_title" );
+    aContainerWidget_t* tc = WidgetBindContainer( WB_LORE_TITLE );
     aRectf_t tr = tc->rect;
 
     char title[64];
@@ -384,7 +390,7 @@ static void ls_Draw( float dt )
 
   /* Sidebar panel (floors + categories) */
   {
-    aContainerWidget_t* cc = a_GetContainerFromWidget( "lore_categories" );
+    aContainerWidget_t* cc = WidgetBindContainer( WB_LORE_CATEGORIES );
     aRectf_t r = cc->rect;
 
     a_DrawFilledRect( r, (aColor_t){ 0x08, 0x0a, 0x10, 200 } );
@@ -462,7 +468,7 @@ static void ls_Draw( float dt )
 
   /* Entries panel */
   {
-    aContainerWidget_t* ec = a_GetContainerFromWidget( "lore_entries" );
+    aContainerWidget_t* ec = WidgetBindContainer( WB_LORE_ENTRIES );
     aRectf_t r = ec->rect;
 
     a_DrawFilledRect( r, (aColor_t){ 0x08, 0x0a, 0x10, 200 } );
@@ -529,7 +535,7 @@ static void ls_Draw( float dt )
 
   /* Back button */
   {
-    aContainerWidget_t* bc = a_GetContainerFromWidget( "lore_back" );
+    aContainerWidget_t* bc = WidgetBindContainer( WB_LORE_BACK );
     aRectf_t br = bc->rect;
     DrawButton( br.x, br.y, br.w, br.h, "Back [ESC]", 1.4f, back_hovered,
                 bg_norm, bg_hover, fg_norm, fg_hover );
@@ -537,7 +543,7 @@ static void ls_Draw( float dt )
 
   /* Hint */
   {
-    aContainerWidget_t* hc = a_GetContainerFromWidget( "lore_hint" );
+    aContainerWidget_t* hc = WidgetBindContainer( WB_LORE_HINT );
     aRectf_t hr = hc->rect;
     aTextStyle_t ts = a_default_text_style;
     ts.fg    = dim;
@@ -10,6 +10,11 @@
 #include "lore_scene.h"
 #include "settings.h"
 #include "sound_manager.h"
+#include "widget_bind.h"
+#include "loading_scene.h"
+#include "sprite_atlas.h"
+#include "sound_bank.h"
+#include "res_pack.h"
 
 static void mm_Logic( float );
 static void mm_Draw( float );
@@ -25,8 +30,8 @@ static const char* btn_labels[NUM_BUTTONS] = { "Play", "Lore", "Settings", "Quit
 static int cursor = 0;
 static int hovered[NUM_BUTTONS] = { 0 };
 
-static aSoundEffect_t sfx_hover;
-static aSoundEffect_t sfx_click;
+static aSoundEffect_t* sfx_hover = NULL;
+static aSoundEffect_t* sfx_click = NULL;
 
 /* ---- background dungeon ---- */
 #define MM_MAP_W  100
@@ -303,16 +308,23 @@ static void mm_load_bg( void )
 
   memset( mm_solid, 1, sizeof( mm_solid ) );
 
-  FILE* fp = fopen( "resources/data/floors/floor_01/floor_01.map", "r" );
-  if ( !fp ) return;
+  /* Through the pack, like the dungeon builder - the web build only
+     ships the map inside it */
+  ResFile_t f;
+  if ( !ResOpen( "resources/data/floors/floor_01/floor_01.map", &f ) ) return;
 
-  char buf[256];
+  const char* p   = f.data;
+  const char* end = f.data + f.size;
   int y = 0;
-  while ( y < MM_MAP_H && fgets( buf, sizeof( buf ), fp ) )
+  while ( y < MM_MAP_H && p < end )
   {
-    size_t len = strlen( buf );
-    while ( len > 0 && ( buf[len-1] == '\n' || buf[len-1] == '\r' ) )
-      buf[--len] = '\0';
+    const char* eol = memchr( p, '\n', end - p );
+    if ( !eol ) eol = end;
+    const char* buf = p;
+    size_t len = eol - p;
+    p = ( eol < end ) ? eol + 1 : end;
+
+    if ( len > 0 && buf[len-1] == '\r' ) len--;
     if ( len >= 2 && buf[0] == '/' && buf[1] == '/' )
       continue;
 
@@ -326,7 +338,7 @@ static void mm_load_bg( void )
     }
     y++;
   }
-  fclose( fp );
+  ResClose( &f );
 
   /* Find the bounding box of actual walkable content */
   int min_x = MM_MAP_W, max_x = 0, min_y = MM_MAP_H, max_y = 0;
@@ -352,7 +364,7 @@ static void mm_load_bg( void )
   sprite_image_count = 0;
   for ( int i = 0; sprite_paths[i] != NULL; i++ )
   {
-    aImage_t* img = a_ImageLoad( sprite_paths[i] );
+    aImage_t* img = AtlasQueue( sprite_paths[i] );
     if ( img )
     {
       sprite_is_enemy[sprite_image_count] = ( strstr( sprite_paths[i], "enemies/" ) != NULL );
@@ -468,11 +480,11 @@ static void mm_draw_bg( void )
 
     float scale = dpw / s->img->rect.w;
     if ( s->flipped )
-      a_BlitRectFlipped( s->img, NULL,
+      a_BlitRectFlipped( s->img, AtlasSrc( s->img ),
                          &(aRectf_t){ dpx, dpy, s->img->rect.w, s->img->rect.h },
                          scale, 'x' );
     else
-      a_BlitRect( s->img, NULL,
+      a_BlitRect( s->img, AtlasSrc( s->img ),
                   &(aRectf_t){ dpx, dpy, s->img->rect.w, s->img->rect.h },
                   scale );
   }
@@ -526,34 +538,46 @@ void MainMenuInit( void )
   for ( int i = 0; i < NUM_BUTTONS; i++ )
     hovered[i] = 0;
 
-  a_AudioLoadSound( "resources/soundeffects/menu_move.wav", &sfx_hover );
-  a_AudioLoadSound( "resources/soundeffects/menu_click.wav", &sfx_click );
+  SoundBankAcquire( &sfx_hover, "resources/soundeffects/menu_move.wav" );
+  SoundBankAcquire( &sfx_click, "resources/soundeffects/menu_click.wav" );
 
-  a_WidgetsInit( "resources/widgets/main_menu.auf" );
-  app.active_widget = a_GetWidget( "mm_buttons" );
+  WidgetBindLoad( WB_LAYOUT_MAIN_MENU );
+  app.active_widget = WidgetBindWidget( WB_MM_BUTTONS );
 
   mm_load_bg();
 
-  SoundManagerPlayMenu();
+  /* First visit waits on the startup batch (music, sfx, sprites) */
+  LoadingSceneBegin( "Loading", SoundManagerPlayMenu );
+}
+
+/* Called after the next scene's Init, so sounds it shares with us are
+   already held again and stay loaded */
+static void mm_ReleaseSounds( void )
+{
+  SoundBankRelease( &sfx_hover );
+  SoundBankRelease( &sfx_click );
 }
 
 static void mm_Execute( int index )
 {
-  a_AudioPlaySound( &sfx_click, NULL );
+  SoundBankPlay( sfx_click, NULL );
 
   switch ( index )
   {
     case BTN_PLAY:
-      a_WidgetCacheFree();
+      WidgetBindFree();
       ClassSelectInit();
+      mm_ReleaseSounds();
       break;
     case BTN_LORE:
-      a_WidgetCacheFree();
+      WidgetBindFree();
       LoreSceneInit();
+      mm_ReleaseSounds();
       break;
     case BTN_SETTINGS:
-      a_WidgetCacheFree();
+      WidgetBindFree();
       SettingsInit();
+      mm_ReleaseSounds();
       break;
     case BTN_QUIT:
       app.running = 0;
@@ -580,7 +604,7 @@ static void mm_Logic( float dt )
   if ( app.keyboard[A_R] == 1 )
   {
     app.keyboard[A_R] = 0;
-    a_WidgetsInit( "resources/widgets/main_menu.auf" );
+    WidgetBindReload();
   }
 
   /* Keyboard nav */
@@ -589,7 +613,7 @@ static void mm_Logic( float dt )
     app.keyboard[A_W] = 0;
     app.keyboard[A_UP] = 0;
     cursor = ( cursor - 1 + NUM_BUTTONS ) % NUM_BUTTONS;
-    a_AudioPlaySound( &sfx_hover, NULL );
+    SoundBankPlay( sfx_hover, NULL );
   }
 
   if ( app.keyboard[A_S] == 1 || app.keyboard[A_DOWN] == 1 )
@@ -597,7 +621,7 @@ static void mm_Logic( float dt )
     app.keyboard[A_S] = 0;
     app.keyboard[A_DOWN] = 0;
     cursor = ( cursor + 1 ) % NUM_BUTTONS;
-    a_AudioPlaySound( &sfx_hover, NULL );
+    SoundBankPlay( sfx_hover, NULL );
   }
 
   if ( app.keyboard[SDL_SCANCODE_RETURN] == 1 || app.keyboard[SDL_SCANCODE_SPACE] == 1 )
@@ -609,7 +633,7 @@ static void mm_Logic( float dt )
   }
 
   /* Mouse - hit test each button rect */
-  aContainerWidget_t* bc = a_GetContainerFromWidget( "mm_buttons" );
+  aContainerWidget_t* bc = WidgetBindContainer( WB_MM_BUTTONS );
   aRectf_t r = bc->rect;
   float btn_w = r.w;
   float total_h = NUM_BUTTONS * BTN_H + ( NUM_BUTTONS - 1 ) * BTN_SPACING;
@@ -625,7 +649,7 @@ static void mm_Logic( float dt )
     if ( hit && !hovered[i] )
     {
       cursor = i;
-      a_AudioPlaySound( &sfx_hover, NULL );
+      SoundBankPlay( sfx_hover, NULL );
     }
     hovered[i] = hit;
 
@@ -644,7 +668,7 @@ static void mm_Draw( float dt )
 
   /* Title — "Open Door Dungeon" with colored door icons inline */
   {
-    aContainerWidget_t* tc = a_GetContainerFromWidget( "mm_title" );
+    aContainerWidget_t* tc = WidgetBindContainer( WB_MM_TITLE );
     aRectf_t tr = tc->rect;
 
     aTextStyle_t ts = a_default_text_style;
@@ -705,7 +729,7 @@ static void mm_Draw( float dt )
 
   /* Buttons */
   {
-    aContainerWidget_t* bc = a_GetContainerFromWidget( "mm_buttons" );
+    aContainerWidget_t* bc = WidgetBindContainer( WB_MM_BUTTONS );
     aRectf_t r = bc->rect;
     float btn_w = r.w;
     float total_h = NUM_BUTTONS * BTN_H + ( NUM_BUTTONS - 1 ) * BTN_SPACING;
@@ -729,7 +753,7 @@ static void mm_Draw( float dt )
 
   /* Version hint */
   {
-    aContainerWidget_t* vc = a_GetContainerFromWidget( "mm_version" );
+    aContainerWidget_t* vc = WidgetBindContainer( WB_MM_VERSION );
     aRectf_t vr = vc->rect;
 
     aTextStyle_t ts = a_default_text_style;
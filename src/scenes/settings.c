@@ -9,6 +9,8 @@
 #include "main_menu.h"
 #include "sound_manager.h"
 #include "lore.h"
+#include "widget_bind.h"
+#include "sound_bank.h"
 
 static void st_Logic( float );
 static void st_Draw( float );
@@ -33,8 +35,8 @@ static const char* setting_labels[] = {
   "Graphics", "Music Volume", "SFX Volume", "Delete Save Data"
 };
 
-static aSoundEffect_t sfx_move;
-static aSoundEffect_t sfx_click;
+static aSoundEffect_t* sfx_move = NULL;
+static aSoundEffect_t* sfx_click = NULL;
 
 /* --- helpers --- */
 
@@ -87,8 +89,12 @@ static void st_Save( void )
 static void st_Leave( void )
 {
   st_Save();
-  a_WidgetCacheFree();
+  WidgetBindFree();
   MainMenuInit();
+
+  /* The menu holds these too, so they stay loaded */
+  SoundBankRelease( &sfx_move );
+  SoundBankRelease( &sfx_click );
 }
 
 /* --- init --- */
@@ -106,10 +112,10 @@ void SettingsInit( void )
   confirm_state   = ST_NORMAL;
   confirm_cursor  = 1;
 
-  a_AudioLoadSound( "resources/soundeffects/menu_move.wav", &sfx_move );
-  a_AudioLoadSound( "resources/soundeffects/menu_click.wav", &sfx_click );
+  SoundBankAcquire( &sfx_move, "resources/soundeffects/menu_move.wav" );
+  SoundBankAcquire( &sfx_click, "resources/soundeffects/menu_click.wav" );
 
-  a_WidgetsInit( "resources/widgets/settings.auf" );
+  WidgetBindLoad( WB_LAYOUT_SETTINGS );
 }
 
 /* --- delete save data --- */
@@ -136,7 +142,7 @@ static void st_ConfirmLogic( void )
   if ( app.keyboard[SDL_SCANCODE_ESCAPE] == 1 )
   {
     app.keyboard[SDL_SCANCODE_ESCAPE] = 0;
-    a_AudioPlaySound( &sfx_click, NULL );
+    SoundBankPlay( sfx_click, NULL );
     confirm_state = ST_NORMAL;
     return;
   }
@@ -147,14 +153,14 @@ static void st_ConfirmLogic( void )
     app.keyboard[A_A] = 0;
     app.keyboard[A_LEFT] = 0;
     confirm_cursor = 0;
-    a_AudioPlaySound( &sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
   if ( app.keyboard[A_D] == 1 || app.keyboard[A_RIGHT] == 1 )
   {
     app.keyboard[A_D] = 0;
     app.keyboard[A_RIGHT] = 0;
     confirm_cursor = 1;
-    a_AudioPlaySound( &sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
 
   /* Enter / Space */
@@ -197,7 +203,7 @@ static void st_ConfirmLogic( void )
 
   if ( !activate ) return;
 
-  a_AudioPlaySound( &sfx_click, NULL );
+  SoundBankPlay( sfx_click, NULL );
 
   if ( confirm_cursor == 1 ) /* No */
   {
@@ -235,7 +241,7 @@ static void st_Logic( float dt )
   if ( app.keyboard[SDL_SCANCODE_ESCAPE] == 1 )
   {
     app.keyboard[SDL_SCANCODE_ESCAPE] = 0;
-    a_AudioPlaySound( &sfx_click, NULL );
+    SoundBankPlay( sfx_click, NULL );
     st_Leave();
     return;
   }
@@ -244,7 +250,7 @@ static void st_Logic( float dt )
   if ( app.keyboard[A_R] == 1 )
   {
     app.keyboard[A_R] = 0;
-    a_WidgetsInit( "resources/widgets/settings.auf" );
+    WidgetBindReload();
   }
 
   /* Up / Down - move cursor */
@@ -253,7 +259,7 @@ static void st_Logic( float dt )
     app.keyboard[A_W] = 0;
     app.keyboard[A_UP] = 0;
     cursor = ( cursor - 1 + NUM_SETTINGS ) % NUM_SETTINGS;
-    a_AudioPlaySound( &sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
 
   if ( app.keyboard[A_S] == 1 || app.keyboard[A_DOWN] == 1 )
@@ -261,7 +267,7 @@ static void st_Logic( float dt )
     app.keyboard[A_S] = 0;
     app.keyboard[A_DOWN] = 0;
     cursor = ( cursor + 1 ) % NUM_SETTINGS;
-    a_AudioPlaySound( &sfx_move, NULL );
+    SoundBankPlay( sfx_move, NULL );
   }
 
   /* Left / Right - adjust value (skip delete row) */
@@ -272,7 +278,7 @@ static void st_Logic( float dt )
       app.keyboard[A_A] = 0;
       app.keyboard[A_LEFT] = 0;
       st_Adjust( cursor, -1 );
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
     }
 
     if ( app.keyboard[A_D] == 1 || app.keyboard[A_RIGHT] == 1 )
@@ -280,7 +286,7 @@ static void st_Logic( float dt )
       app.keyboard[A_D] = 0;
       app.keyboard[A_RIGHT] = 0;
       st_Adjust( cursor, 1 );
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
     }
   }
 
@@ -294,11 +300,11 @@ static void st_Logic( float dt )
     if ( cursor == SET_GFX )
     {
       st_Adjust( cursor, 1 );
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
     }
     else if ( cursor == SET_DELETE )
     {
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
       confirm_state = ST_CONFIRM_1;
       confirm_cursor = 1;
     }
@@ -313,17 +319,17 @@ static void st_Logic( float dt )
 
   /* Back button */
   {
-    aContainerWidget_t* bc = a_GetContainerFromWidget( "settings_back" );
+    aContainerWidget_t* bc = WidgetBindContainer( WB_SETTINGS_BACK );
     aRectf_t br = bc->rect;
     int hit = PointInRect( mx, my, br.x, br.y, br.w, br.h );
 
     if ( hit && !back_hovered )
-      a_AudioPlaySound( &sfx_move, NULL );
+      SoundBankPlay( sfx_move, NULL );
     back_hovered = hit;
 
     if ( hit && clicked )
     {
-      a_AudioPlaySound( &sfx_click, NULL );
+      SoundBankPlay( sfx_click, NULL );
       st_Leave();
       return;
     }
@@ -331,7 +337,7 @@ static void st_Logic( float dt )
 
   /* Setting rows */
   {
-    aContainerWidget_t* pc = a_GetContainerFromWidget( "settings_panel" );
+    aContainerWidget_t* pc = WidgetBindContainer( WB_SETTINGS_PANEL );
     aRectf_t r = pc->rect;
     float by = r.y + 16;
 
@@ -346,14 +352,14 @@ static void st_Logic( float dt )
         if ( cursor != i )
         {
           cursor = i;
-          a_AudioPlaySound( &sfx_move, NULL );
+          SoundBankPlay( sfx_move, NULL );
         }
 
         if ( clicked )
         {
           if ( i == SET_DELETE )
           {
-            a_AudioPlaySound( &sfx_click, NULL );
+            SoundBankPlay( sfx_click, NULL );
             confirm_state = ST_CONFIRM_1;
             confirm_cursor = 1;
           }
@@ -362,7 +368,7 @@ static void st_Logic( float dt )
             float mid = bx + ( r.w - 8 ) / 2.0f;
             int dir = ( mx < mid ) ? -1 : 1;
             st_Adjust( i, dir );
-            a_AudioPlaySound( &sfx_click, NULL );
+            SoundBankPlay( sfx_click, NULL );
           }
         }
       }
@@ -383,7 +389,7 @@ static void st_Draw( float dt )
 
   /* Title */
   {
-    aContainerWidget_t* tc = a_GetContainerFromWidget( "settings_title" );
+    aContainerWidget_t* tc = WidgetBindContainer( WB_SETTINGS_TITLE );
     aRectf_t tr = tc->rect;
 
     aTextStyle_t ts = a_default_text_style;
@@ -397,7 +403,7 @@ static void st_Draw( float dt )
 
   /* Panel */
   {
-    aContainerWidget_t* pc = a_GetContainerFromWidget( "settings_panel" );
+    aContainerWidget_t* pc = WidgetBindContainer( WB_SETTINGS_PANEL );
     aRectf_t r = pc->rect;
 
     a_DrawFilledRect( r, (aColor_t){ 0x08, 0x0a, 0x10, 200 } );
@@ -458,7 +464,7 @@ static void st_Draw( float dt )
 
   /* Back button */
   {
-    aContainerWidget_t* bc = a_GetContainerFromWidget( "settings_back" );
+    aContainerWidget_t* bc = WidgetBindContainer( WB_SETTINGS_BACK );
     aRectf_t br = bc->rect;
     DrawButton( br.x, br.y, br.w, br.h, "Back [ESC]", 1.4f, back_hovered,
                 bg_norm, bg_hover, fg_norm, fg_hover );
@@ -466,7 +472,7 @@ static void st_Draw( float dt )
 
   /* Hint */
   {
-    aContainerWidget_t* hc = a_GetContainerFromWidget( "settings_hint" );
+    aContainerWidget_t* hc = WidgetBindContainer( WB_SETTINGS_HINT );
     aRectf_t hr = hc->rect;
     aTextStyle_t ts = a_default_text_style;
     ts.fg    = dim;
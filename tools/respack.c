@@ -0,0 +1,170 @@
+/* respack - bundle resources/ into a single pack file.
+   Usage: respack <resource dir> <out.pak>        (see `make pack`) */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#define RES_PACK_NO_LOADERS
+#include "res_pack.h"
+
+/* Left out of the pack:
+   - cache: rebuilt on the player's machine
+   - fonts, sound effects, widgets with their button art, and the
+     tileset: opened by path through SDL_ttf / SDL_mixer / Archimedes,
+     which never look in the pack, so they ship loose (see EM_LOOSE in
+     the Makefile) */
+static const char* g_skip[] = {
+  "resources/cache",
+  "resources/fonts",
+  "resources/soundeffects",
+  "resources/widgets",
+  "resources/assets/UI",
+  "resources/assets/tiles/level01tilemap.png",
+  NULL
+};
+
+static ResPackEntry_t* g_entries = NULL;
+static int             g_num = 0;
+static int             g_cap = 0;
+
+static int rp_Skipped( const char* path )
+{
+  for ( int i = 0; g_skip[i]; i++ )
+    if ( strcmp( path, g_skip[i] ) == 0 ) return 1;
+  return 0;
+}
+
+static void rp_Walk( const char* dir )
+{
+  DIR* d = opendir( dir );
+  if ( !d )
+  {
+    fprintf( stderr, "respack: cannot open %s\n", dir );
+    exit( 1 );
+  }
+
+  struct dirent* ent;
+  while ( ( ent = readdir( d ) ) != NULL )
+  {
+    if ( ent->d_name[0] == '.' ) continue;
+
+    /* Anything that does not fit an entry - or a directory whose
+       children could not - stops the build rather than being cut */
+    size_t dir_len  = strlen( dir );
+    size_t name_len = strlen( ent->d_name );
+    if ( dir_len + 1 + name_len >= RES_PATH_LEN )
+    {
+      fprintf( stderr, "respack: path too long: %s/%s\n", dir, ent->d_name );
+      exit( 1 );
+    }
+
+    char path[RES_PATH_LEN];
+    memcpy( path, dir, dir_len );
+    path[dir_len] = '/';
+    memcpy( path + dir_len + 1, ent->d_name, name_len + 1 );
+    if ( rp_Skipped( path ) ) continue;
+
+    struct stat st;
+    if ( stat( path, &st ) != 0 ) continue;
+    if ( S_ISDIR( st.st_mode ) ) { rp_Walk( path ); continue; }
+
+    if ( g_num >= g_cap )
+    {
+      g_cap = g_cap ? g_cap * 2 : 256;
+      g_entries = realloc( g_entries, sizeof( ResPackEntry_t ) * g_cap );
+      if ( !g_entries ) { fprintf( stderr, "respack: out of memory\n" ); exit( 1 ); }
+    }
+
+    ResPackEntry_t* e = &g_entries[g_num++];
+    memset( e, 0, sizeof( ResPackEntry_t ) );
+    memcpy( e->path, path, dir_len + 1 + name_len + 1 );
+    e->size = (uint32_t)st.st_size;
+  }
+
+  closedir( d );
+}
+
+static int rp_Cmp( const void* a, const void* b )
+{
+  return strcmp( ( (const ResPackEntry_t*)a )->path,
+                 ( (const ResPackEntry_t*)b )->path );
+}
+
+static void rp_Pad( FILE* out, long* pos )
+{
+  static const char zero[RES_PACK_ALIGN] = { 0 };
+  long pad = ( RES_PACK_ALIGN - ( *pos % RES_PACK_ALIGN ) ) % RES_PACK_ALIGN;
+  if ( pad ) fwrite( zero, 1, pad, out );
+  *pos += pad;
+}
+
+int main( int argc, char** argv )
+{
+  if ( argc != 3 )
+  {
+    fprintf( stderr, "usage: %s <resource dir> <out.pak>\n", argv[0] );
+    return 1;
+  }
+
+  rp_Walk( argv[1] );
+  qsort( g_entries, g_num, sizeof( ResPackEntry_t ), rp_Cmp );
+
+  /* Lay out blobs after the index: aligned, each with a trailing NUL */
+  long pos = (long)( sizeof( ResPackHeader_t ) + sizeof( ResPackEntry_t ) * g_num );
+  for ( int i = 0; i < g_num; i++ )
+  {
+    pos += ( RES_PACK_ALIGN - ( pos % RES_PACK_ALIGN ) ) % RES_PACK_ALIGN;
+    g_entries[i].offset = (uint32_t)pos;
+    pos += g_entries[i].size + 1;
+  }
+
+  char tmp[512];
+  snprintf( tmp, sizeof( tmp ), "%s.tmp", argv[2] );
+  FILE* out = fopen( tmp, "wb" );
+  if ( !out ) { fprintf( stderr, "respack: cannot write %s\n", tmp ); return 1; }
+
+  ResPackHeader_t hdr = { RES_PACK_MAGIC, RES_PACK_VERSION, (uint32_t)g_num, 0 };
+  fwrite( &hdr, sizeof( hdr ), 1, out );
+  fwrite( g_entries, sizeof( ResPackEntry_t ), g_num, out );
+
+  pos = (long)( sizeof( ResPackHeader_t ) + sizeof( ResPackEntry_t ) * g_num );
+  for ( int i = 0; i < g_num; i++ )
+  {
+    rp_Pad( out, &pos );
+
+    FILE* in = fopen( g_entries[i].path, "rb" );
+    if ( !in ) { fprintf( stderr, "respack: cannot read %s\n", g_entries[i].path ); return 1; }
+
+    char buf[8192];
+    size_t n, total = 0;
+    while ( ( n = fread( buf, 1, sizeof( buf ), in ) ) > 0 )
+    {
+      fwrite( buf, 1, n, out );
+      total += n;
+    }
+    fclose( in );
+
+    if ( total != g_entries[i].size )
+    {
+      fprintf( stderr, "respack: %s changed while packing\n", g_entries[i].path );
+      return 1;
+    }
+
+    fputc( '\0', out );
+    pos += (long)total + 1;
+  }
+
+  if ( fclose( out ) != 0 || rename( tmp, argv[2] ) != 0 )
+  {
+    remove( tmp );
+    fprintf( stderr, "respack: cannot write %s\n", argv[2] );
+    return 1;
+  }
+
+  printf( "respack: %d files, %ld bytes -> %s\n", g_num, pos, argv[2] );
+  free( g_entries );
+  return 0;
+}